@@ -0,0 +1,133 @@
+/**
+ * @file utf16_transcoder_bench.cpp
+ * @brief Microbenchmark for the UTF-16 to UTF-8 transcoder
+ *
+ * Compares Utf16ToUtf8() against a two-pass scalar conversion (size, then
+ * convert, as WideStringToString used to do) and, on Windows, against
+ * WideCharToMultiByte itself, on identifier-like ASCII and on mixed text.
+ *
+ * Built with the CMake project (HWID_BUILD_BENCHMARKS, on by default) and
+ * run from the build directory:
+ *   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release
+ *   cmake --build build --target utf16_transcoder_bench
+ *   build/utf16_transcoder_bench
+ * Set HWID_DISABLE_CPU_FEATURES=all to time the scalar kernels.
+ */
+
+#include "utf16_transcoder.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ * @brief Two-pass scalar reference conversion
+ */
+static std::string TwoPassScalar(const std::u16string& input) {
+    size_t size = 0;
+    for (size_t i = 0; i < input.size(); i++) {
+        char16_t unit = input[i];
+        if (unit < 0x80) {
+            size += 1;
+        } else if (unit < 0x800) {
+            size += 2;
+        } else if (unit >= 0xD800 && unit <= 0xDBFF && i + 1 < input.size() &&
+                   input[i + 1] >= 0xDC00 && input[i + 1] <= 0xDFFF) {
+            size += 4;
+            i++;
+        } else {
+            size += 3;
+        }
+    }
+
+    std::string output(size, '\0');
+    size_t out = 0;
+    for (size_t i = 0; i < input.size(); i++) {
+        uint32_t unit = input[i];
+        if (unit < 0x80) {
+            output[out++] = static_cast<char>(unit);
+        } else if (unit < 0x800) {
+            output[out++] = static_cast<char>(0xC0 | (unit >> 6));
+            output[out++] = static_cast<char>(0x80 | (unit & 0x3F));
+        } else if (unit >= 0xD800 && unit <= 0xDBFF && i + 1 < input.size() &&
+                   input[i + 1] >= 0xDC00 && input[i + 1] <= 0xDFFF) {
+            uint32_t codePoint = 0x10000 + ((unit - 0xD800) << 10) + (input[++i] - 0xDC00);
+            output[out++] = static_cast<char>(0xF0 | (codePoint >> 18));
+            output[out++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            output[out++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            output[out++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            if (unit >= 0xD800 && unit <= 0xDFFF) {
+                unit = 0xFFFD;
+            }
+            output[out++] = static_cast<char>(0xE0 | (unit >> 12));
+            output[out++] = static_cast<char>(0x80 | ((unit >> 6) & 0x3F));
+            output[out++] = static_cast<char>(0x80 | (unit & 0x3F));
+        }
+    }
+    return output;
+}
+
+#ifdef _WIN32
+static std::string WinApi(const std::u16string& input) {
+    const wchar_t* data = reinterpret_cast<const wchar_t*>(input.data());
+    int size = WideCharToMultiByte(CP_UTF8, 0, data, (int)input.size(), NULL, 0, NULL, NULL);
+    std::string output(size, '\0');
+    WideCharToMultiByte(CP_UTF8, 0, data, (int)input.size(), &output[0], size, NULL, NULL);
+    return output;
+}
+#endif
+
+template <typename Convert>
+static void Run(const char* name, const std::vector<std::u16string>& inputs, Convert convert) {
+    const int kRounds = 200;
+    size_t units = 0;
+    size_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; round++) {
+        for (const std::u16string& input : inputs) {
+            std::string output = convert(input);
+            checksum += output.size();
+            units += input.size();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("  %-16s %8.1f ns/string %8.2f GB/s (checksum %zu)\n", name,
+           seconds * 1e9 / (kRounds * inputs.size()), units * 2 / seconds / 1e9, checksum);
+}
+
+static void Bench(const char* title, const std::vector<std::u16string>& inputs) {
+    for (const std::u16string& input : inputs) {
+        if (Utf16ToUtf8(input.data(), input.size()) != TwoPassScalar(input)) {
+            printf("MISMATCH in %s\n", title);
+            return;
+        }
+    }
+
+    printf("%s (%zu strings)\n", title, inputs.size());
+    Run("two-pass scalar", inputs, TwoPassScalar);
+    Run("Utf16ToUtf8", inputs, [](const std::u16string& s) { return Utf16ToUtf8(s.data(), s.size()); });
+#ifdef _WIN32
+    Run("WideCharToMulti", inputs, WinApi);
+#endif
+}
+
+int main() {
+    std::vector<std::u16string> identifiers;
+    std::vector<std::u16string> mixed;
+    for (int i = 0; i < 10000; i++) {
+        std::u16string serial = u"WD-WCC4N" + std::u16string(1, u'0' + i % 10) + u"KXRZ9P3TQ7 BFEBFBFF000906EA";
+        identifiers.push_back(serial);
+        mixed.push_back(serial + u" Équipement 主板 \U0001F5A5 " + serial);
+    }
+
+    Bench("Identifier-like ASCII", identifiers);
+    Bench("Mixed text", mixed);
+    return 0;
+}
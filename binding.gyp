@@ -4,7 +4,31 @@
       "target_name": "hardware_id_addon",
       "sources": [
         "src/hardware_id_addon.cpp",
-        "src/hardware_identifier.cpp"
+        "src/hardware_identifier.cpp",
+        "src/hardware_info.cpp",
+        "src/collection_scheduler.cpp",
+        "src/change_monitor.cpp",
+        "src/sysfs_collector.cpp",
+        "src/arena_snapshot.cpp",
+        "src/hardware_snapshot.cpp",
+        "src/snapshot_refresher.cpp",
+        "src/string_interner.cpp",
+        "src/fleet_registry.cpp",
+        "src/fleet_table.cpp",
+        "src/fleet_file.cpp",
+        "src/mac_address.cpp",
+        "src/utf16_transcoder.cpp",
+        "src/cpu_features.cpp",
+        "src/crc32c.cpp",
+        "src/snapshot_codec.cpp",
+        "src/json_writer.cpp",
+        "src/json_reader.cpp",
+        "src/component_watchdog.cpp",
+        "src/hedged_request.cpp",
+        "src/smbios_table.cpp",
+        "src/digest_encoding.cpp",
+        "src/sha256.cpp",
+        "src/attestation_token.cpp"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")",
@@ -16,9 +40,18 @@
       "defines": [
         "NAPI_DISABLE_CPP_EXCEPTIONS"
       ],
+      "cflags_cc": [
+        "-std=c++17"
+      ],
+      "xcode_settings": {
+        "CLANG_CXX_LANGUAGE_STANDARD": "c++17"
+      },
       "msvs_settings": {
         "VCCLCompilerTool": {
-          "ExceptionHandling": 1
+          "ExceptionHandling": 1,
+          "AdditionalOptions": [
+            "/std:c++17"
+          ]
         }
       },
       "conditions": [
@@ -28,7 +61,9 @@
             "libraries": [
               "-lwbemuuid",
               "-lole32",
-              "-loleaut32"
+              "-loleaut32",
+              "-liphlpapi",
+              "-lcfgmgr32"
             ]
           }
         ]
@@ -19,8 +19,410 @@ declare module 'hardware-identification-addon' {
         diskSerials: string[];
         /** Array of network adapter MAC addresses */
         macAddresses: string[];
-        /** Unique hardware fingerprint (hash) */
+        /** Unique hardware fingerprint (hash), empty if a required component timed out */
         fingerprint: string;
+        /** Components abandoned by the per-component watchdog */
+        timedOut: HardwareComponentName[];
+    }
+
+    /**
+     * Per-component watchdog and fingerprint profile options
+     */
+    export interface WatchdogOptions {
+        /** Deadline for each component collection, an integer number of milliseconds up to 2^32 - 1 (RangeError otherwise); 0 or omitted disables the watchdog */
+        componentTimeoutMs?: number;
+        /** Fingerprint profile: components that must not time out for a fingerprint (default: all) */
+        requiredComponents?: HardwareComponentName[];
+    }
+
+    /**
+     * Text encodings of the SHA-256 fingerprint digest
+     */
+    export type DigestEncoding = 'hex' | 'base32' | 'base64url';
+
+    /**
+     * Options for getHardwareFingerprint()
+     */
+    export interface FingerprintOptions extends WatchdogOptions {
+        /**
+         * 'legacy' (default) returns the variable-length hex hash; 'raw',
+         * 'hex', 'base32' and 'base64url' return the 32-byte SHA-256 digest
+         * as a Buffer or as fixed-width text
+         */
+        encoding?: 'legacy' | 'raw' | DigestEncoding;
+    }
+
+    /**
+     * Result of a steady-state refresh
+     */
+    export interface RefreshResult {
+        /** Components whose value changed since the previous refresh */
+        changed: HardwareComponentName[];
+        /** True if the fingerprint changed */
+        fingerprintChanged: boolean;
+        /** Buffer allocations made by the native refresh path (0 when nothing changed) */
+        allocations: number;
+        /** Current values, null if nothing changed */
+        current: HardwareInfo | null;
+    }
+
+    /**
+     * Priority class of an asynchronous collection request
+     */
+    export type CollectionPriority = 'interactive' | 'normal' | 'background';
+
+    /**
+     * Options for asynchronous hardware collection
+     */
+    export interface CollectionOptions extends WatchdogOptions {
+        /** Priority class, defaults to 'normal' */
+        priority?: CollectionPriority;
+    }
+
+    /**
+     * Scheduler counters for one priority class
+     */
+    export interface CollectionPriorityStats {
+        submitted: number;
+        completed: number;
+        avgWaitMs: number;
+        maxWaitMs: number;
+        avgRunMs: number;
+        maxRunMs: number;
+    }
+
+    /**
+     * Native collection statistics
+     */
+    export interface HedgeStats {
+        requests: number;
+        /** Requests where the secondary source was started */
+        hedged: number;
+        primaryWins: number;
+        secondaryWins: number;
+        /** Requests where neither source produced a value */
+        empty: number;
+        /** Current delay before hedging (95th percentile of primary latency) */
+        hedgeDelayMs: number;
+        lastLatencyMs: number;
+        lastWinner: 'primary' | 'secondary' | 'none';
+    }
+
+    export interface CollectionStats {
+        /** Hedged identifiers by source pair, e.g. 'wmi.biosSerial' or 'sysfs.biosSerial' */
+        hedging: { [name: string]: HedgeStats };
+        cpu: {
+            /** Instruction set extensions detected at load, e.g. 'sse4.2', 'avx2', 'sha' */
+            features: string[];
+            /** Variant selected per native kernel, e.g. { 'utf16.copyAsciiPrefix': 'avx2' } */
+            kernels: { [kernel: string]: string };
+        };
+        watchdog: {
+            /** Component collections that finished before their deadline */
+            completed: number;
+            /** Component collections abandoned at their deadline */
+            timedOut: number;
+            /** Component collections that threw; reported in `timedOut` like a missed deadline */
+            failed: number;
+            /** Collections not started because too many threads were stuck */
+            rejected: number;
+            threads: number;
+            stuckThreads: number;
+        };
+        scheduler: {
+            interactive: CollectionPriorityStats;
+            normal: CollectionPriorityStats;
+            background: CollectionPriorityStats;
+            /** Times a partially collected request yielded to a higher priority one */
+            preemptions: number;
+            /** Requests currently waiting or partially collected */
+            queued: number;
+        };
+    }
+
+    /**
+     * Component names reported in a hardware change event
+     */
+    export type HardwareComponentName = 'cpuId' | 'motherboardSerial' | 'biosSerial' | 'diskSerials' | 'macAddresses';
+
+    /**
+     * Entry of the native identifier table, see getComponents()
+     */
+    export interface ComponentDescription {
+        name: HardwareComponentName;
+        /** Name of the single-component getter, e.g. 'getCpuId' */
+        getter: string;
+        /** 'string' for one identifier, 'list' for one per device */
+        type: 'string' | 'list';
+        /** Where the value can be read from */
+        sources: Array<'wmi' | 'smbios' | 'procfs' | 'sysfs'>;
+        /** Relative collection cost class */
+        cost: 'attribute' | 'hedged' | 'enumeration';
+        /** 'hotplug' values change when devices are attached or removed */
+        volatility: 'fixed' | 'hotplug';
+    }
+
+    /**
+     * Hardware change event delivered to watch() callbacks
+     */
+    export interface HardwareChangeEvent {
+        /** Components whose values differ between previous and current */
+        changed: HardwareComponentName[];
+        /** Notification sources that triggered the refresh */
+        sources: Array<'network' | 'device'>;
+        /** Snapshot before the change */
+        previous: HardwareInfo;
+        /** Snapshot after the change */
+        current: HardwareInfo;
+    }
+
+    /**
+     * Options for watch()
+     */
+    export interface WatchOptions {
+        /**
+         * Quiet period after the last notification before re-collecting, defaults to 500.
+         * Watchers share one monitor, which uses the shortest period of the active watchers.
+         */
+        debounceMs?: number;
+    }
+
+    /**
+     * Options for initialize()
+     */
+    export interface InitializeOptions {
+        /** Read identifiers from a captured sysfs tree or mounted image at this path; omit for the live system */
+        root?: string;
+    }
+
+    /**
+     * Options for collectRoots()
+     */
+    export interface CollectRootsOptions {
+        /** Native worker threads, defaults to the CPU count */
+        concurrency?: number;
+        /** Also add successful results to the fleet registry */
+        register?: boolean;
+    }
+
+    /**
+     * Hardware information collected from one alternate root
+     */
+    export interface RootHardwareInfo extends HardwareInfo {
+        /** Root directory the values were read from */
+        root: string;
+        /** False if the root does not exist or is not a directory */
+        success: boolean;
+        /** Fleet registry index, present when registered */
+        registryIndex?: number;
+    }
+
+    /**
+     * Options for normalizeMacAddresses()
+     */
+    export interface MacNormalizeOptions {
+        /** Output style, default 'colon' */
+        format?: 'colon' | 'dash' | 'dot' | 'bare';
+        /** Use lower-case hex digits */
+        lowercase?: boolean;
+        /** Sort and remove duplicates */
+        unique?: boolean;
+        /** Drop multicast (group) addresses */
+        excludeMulticast?: boolean;
+        /** Drop locally administered addresses */
+        excludeLocallyAdministered?: boolean;
+    }
+
+    /**
+     * Fleet registry memory statistics
+     */
+    export interface RegistryStats {
+        /** Registered records */
+        records: number;
+        /** Distinct interned string values */
+        uniqueStrings: number;
+        /** Bytes of distinct string values */
+        internedBytes: number;
+        /** Bytes the registered values would take without interning */
+        logicalBytes: number;
+        /** Bytes of records, hash-consed tuples and list identifiers */
+        recordBytes: number;
+        /** Bytes of the columnar scan table */
+        columnBytes: number;
+        /** Distinct processor, board and firmware tuples */
+        uniquePlatforms: number;
+        /** Distinct disk serial and MAC address lists */
+        uniqueLists: number;
+        /** Distinct snapshots */
+        uniqueSnapshots: number;
+    }
+
+    /**
+     * Filter for queryRegistry(); all given values must match
+     */
+    export interface RegistryFilter {
+        cpuId?: string;
+        motherboardSerial?: string;
+        biosSerial?: string;
+        fingerprint?: string;
+        /** First disk serial */
+        diskSerial?: string;
+        /** Prefix of the first MAC address, e.g. an OUI '00:1A:2B'; records without one never match */
+        macPrefix?: string;
+    }
+
+    /**
+     * Options for queryRegistry()
+     */
+    export interface RegistryQueryOptions {
+        /** Scan threads, defaults to the CPU count */
+        threads?: number;
+    }
+
+    /**
+     * Options for loadRegistrations()
+     */
+    export interface LoadRegistrationsOptions {
+        /** Parse threads (default: CPU count) */
+        threads?: number;
+    }
+
+    /**
+     * Output format of encodeSnapshot()
+     */
+    export type SnapshotFormat = 'binary' | 'msgpack' | 'cbor';
+
+    /**
+     * Options for encodeTelemetry()
+     */
+    export interface TelemetryOptions {
+        /** Send a keyframe, e.g. after a receiver asked for one */
+        keyframe?: boolean;
+        /** Frames between keyframes (default 60, 0 for keyframes on request only) */
+        keyframeInterval?: number;
+    }
+
+    /**
+     * Result of applying one telemetry frame
+     */
+    export interface TelemetryFrame {
+        /** Sequence number of the last applied frame */
+        sequence: number;
+        /** The frame was a keyframe */
+        keyframe: boolean;
+        /** The frame was a delta that did not follow the last applied frame; ask for a keyframe */
+        needKeyframe: boolean;
+        /** Components changed by a delta frame */
+        changed: string[];
+        /** Reconstructed snapshot of the device, null before its first keyframe */
+        snapshot: HardwareInfo | null;
+    }
+
+    /**
+     * Options for createToken()
+     */
+    export interface CreateTokenOptions {
+        /** Key identifier recorded in the token, default 0 */
+        keyId?: number;
+        /** 16-byte nonce, random if omitted */
+        nonce?: Uint8Array;
+        /** Issue time in milliseconds since the epoch, now if omitted */
+        issuedAt?: number;
+        /** Snapshot to attest, collected natively if omitted */
+        info?: Partial<HardwareInfo>;
+    }
+
+    /**
+     * Options for verifyTokens()
+     */
+    export interface VerifyTokensOptions {
+        /** Reject tokens issued longer ago than this, or in the future */
+        maxAgeMs?: number;
+        /** Current time in milliseconds for the age check, default Date.now() */
+        now?: number;
+    }
+
+    /**
+     * Claims read from an attestation token
+     */
+    export interface AttestationClaims {
+        keyId: number;
+        /** Issue time in milliseconds since the epoch */
+        issuedAt: number;
+        nonce: Buffer;
+        fingerprint: string;
+        /** Hex digest per component that had a value */
+        componentDigests: Partial<Record<'cpuId' | 'motherboardSerial' | 'biosSerial' | 'diskSerials' | 'macAddresses', string>>;
+    }
+
+    /**
+     * Options for encodeJson() and createJsonStream()
+     */
+    export interface JsonStreamOptions {
+        /** Write newline-delimited JSON instead of an array (default false) */
+        ndjson?: boolean;
+        /** Entries serialized per chunk (default 1024) */
+        batchSize?: number;
+        /** Approximate registry chunk size in bytes (default 65536) */
+        chunkSize?: number;
+    }
+
+    /**
+     * Entry accepted by the native JSON writer: a snapshot or batch result,
+     * or a diff given as before/after (or previous/current) snapshots
+     */
+    export type JsonEntry =
+        | Partial<HardwareInfo> & Record<string, unknown>
+        | { before: Partial<HardwareInfo>; after: Partial<HardwareInfo> }
+        | { previous: Partial<HardwareInfo>; current: Partial<HardwareInfo> };
+
+    /**
+     * Result of exportRegistry()
+     */
+    export interface FleetFileExport {
+        rows: number;
+        rowGroups: number;
+    }
+
+    /**
+     * Filter for queryFleetFile(); all given values must match
+     */
+    export interface FleetFileFilter extends RegistryFilter {
+        /** Earliest registration time (inclusive) */
+        registeredAfter?: number | Date;
+        /** Latest registration time (exclusive) */
+        registeredBefore?: number | Date;
+    }
+
+    /**
+     * Row of a fleet file
+     */
+    export interface FleetFileRow {
+        row: number;
+        cpuId: string;
+        motherboardSerial: string;
+        biosSerial: string;
+        fingerprint: string;
+        /** First disk serial */
+        diskSerial: string;
+        /** First MAC address, empty if none */
+        macAddress: string;
+        /** Registration time in milliseconds since the epoch */
+        registeredAt: number;
+    }
+
+    /**
+     * Result of queryFleetFile()
+     */
+    export interface FleetFileQueryResult {
+        rows: FleetFileRow[];
+        stats: {
+            rowGroups: number;
+            /** Row groups ruled out by footer statistics */
+            skippedRowGroups: number;
+            /** Column chunk bytes read */
+            bytesScanned: number;
+        };
     }
 
     /**
@@ -54,9 +456,10 @@ declare module 'hardware-identification-addon' {
 
         /**
          * Initialize the hardware identification system
+         * @param options Initialization options
          * @returns True if initialization successful, false otherwise
          */
-        initialize(): boolean;
+        initialize(options?: InitializeOptions): boolean;
 
         /**
          * Clean up resources
@@ -104,19 +507,251 @@ declare module 'hardware-identification-addon' {
          */
         getMacAddresses(): string[];
 
+        /**
+         * Collect a single component by name
+         * @param name Component name
+         * @returns Component value
+         * @throws Error if not initialized, the name is unknown or the operation fails
+         */
+        getComponent(name: HardwareComponentName): string | string[];
+
+        /**
+         * Describe the collectable components, generated from the native identifier table
+         */
+        getComponents(): ComponentDescription[];
+
         /**
          * Get hardware fingerprint (combined hash of hardware identifiers)
-         * @returns Hardware fingerprint
+         * @param options Collection options and output encoding
+         * @returns Hardware fingerprint, a Buffer for the 'raw' encoding
          * @throws Error if not initialized or operation fails
          */
-        getHardwareFingerprint(): string;
+        getHardwareFingerprint(options: FingerprintOptions & { encoding: 'raw' }): Buffer;
+        getHardwareFingerprint(options?: FingerprintOptions): string;
 
         /**
          * Get all hardware information at once
+         * @param options Per-component watchdog deadline and fingerprint profile
          * @returns Object containing all hardware information
          * @throws Error if not initialized or operation fails
          */
-        getAllHardwareInfo(): HardwareInfo;
+        getAllHardwareInfo(options?: WatchdogOptions): HardwareInfo;
+
+        /**
+         * Refresh hardware information, comparing with the previous refresh in place
+         * @param options Per-component watchdog deadline and fingerprint profile
+         * @returns Changed components and the current values if anything changed
+         * @throws Error if not initialized or operation fails
+         */
+        refresh(options?: WatchdogOptions): RefreshResult;
+
+        /**
+         * Get all hardware information asynchronously through the native scheduler
+         * @param options Collection options
+         * @returns Promise resolving to all hardware information
+         * @throws Error if not initialized or the priority is invalid
+         */
+        getAllHardwareInfoAsync(options?: CollectionOptions): Promise<HardwareInfo>;
+
+        /**
+         * Get native collection statistics
+         * @returns Scheduler counters per priority class
+         */
+        getCollectionStats(): CollectionStats;
+
+        /**
+         * Collect and fingerprint many alternate roots concurrently
+         * @param roots Captured sysfs trees or mounted images
+         * @param options Batch options
+         * @returns One result per root, in input order
+         */
+        collectRoots(roots: string[], options?: CollectRootsOptions): Promise<RootHardwareInfo[]>;
+
+        /**
+         * Add hardware records to the native fleet registry
+         * @param records Objects in the getAllHardwareInfo() shape
+         * @returns Registry index of each record
+         */
+        registerRecords(records: Partial<HardwareInfo>[]): number[];
+
+        /**
+         * Register records from JSON registration files, NDJSON or record arrays
+         * @param source File path or UTF-8 JSON
+         * @param options Load options
+         * @returns Registry index of each record, in input order
+         * @throws Error with the byte offset if the JSON is malformed or a registeredAt is not a timestamp
+         */
+        loadRegistrations(source: string | Uint8Array, options?: LoadRegistrationsOptions): Uint32Array;
+
+        /**
+         * Get a record from the fleet registry
+         * @param index Registry index
+         * @returns Hardware information, null for an unknown index
+         */
+        getRegisteredRecord(index: number): HardwareInfo | null;
+
+        /**
+         * Get the snapshot ID of a registry record; records with equal values share it
+         * @param index Registry index
+         * @returns Snapshot ID, null for an unknown index
+         */
+        getRegisteredSnapshotId(index: number): number | null;
+
+        /**
+         * Find fleet registry records by fingerprint
+         * @param fingerprint Fingerprint to match
+         * @returns Registry indices of matching records
+         */
+        findRegisteredRecords(fingerprint: string): number[];
+
+        /**
+         * Filter the fleet registry with native columnar SIMD scans
+         * @param filter Values that must match
+         * @param options Scan options
+         * @returns Matching registry indices in ascending order
+         */
+        queryRegistry(filter: RegistryFilter, options?: RegistryQueryOptions): Uint32Array;
+
+        /**
+         * Write the fleet registry to a memory-mapped columnar fleet file
+         * @param path Output file path
+         */
+        exportRegistry(path: string): FleetFileExport;
+
+        /**
+         * Query a columnar fleet file, skipping row groups by footer statistics
+         * @param path Fleet file path
+         * @param filter Values that must match
+         */
+        queryFleetFile(path: string, filter?: FleetFileFilter): FleetFileQueryResult;
+
+        /**
+         * Get fleet registry memory statistics
+         */
+        getRegistryStats(): RegistryStats;
+
+        /**
+         * Remove every record from the fleet registry
+         */
+        clearRegistry(): void;
+
+        /**
+         * Parse, filter and reformat MAC addresses as 48-bit integers
+         * @param macs Addresses in colon, dash, dot or bare form
+         * @param options Output format and filters
+         * @returns Normalized addresses; invalid entries are skipped
+         */
+        normalizeMacAddresses(macs: string[], options?: MacNormalizeOptions): string[];
+
+        /**
+         * Encode a snapshot natively; binary encodings of equal snapshots are equal bytes
+         * @param format Output format, defaults to 'binary'
+         */
+        encodeSnapshot(format?: SnapshotFormat): Buffer;
+
+        /**
+         * Encode a given snapshot
+         * @param info Snapshot to encode
+         * @param format Output format, defaults to 'binary'
+         */
+        encodeSnapshot(info: Partial<HardwareInfo>, format?: SnapshotFormat): Buffer;
+
+        /**
+         * Decode one binary snapshot frame
+         * @param buffer Encoded frame
+         */
+        decodeSnapshot(buffer: Uint8Array): HardwareInfo;
+
+        /**
+         * Decode concatenated binary snapshot frames
+         * @param buffer Encoded frames
+         */
+        decodeSnapshots(buffer: Uint8Array): HardwareInfo[];
+
+        /**
+         * Encode the next telemetry heartbeat: a keyframe or the changed components
+         * @param info Snapshot to send, collected natively if omitted
+         * @param options Stream options
+         */
+        encodeTelemetry(info?: Partial<HardwareInfo> | null, options?: TelemetryOptions): Buffer;
+
+        /**
+         * Apply telemetry frames received from a device
+         *
+         * State is kept once a keyframe of the device is applied, for up to
+         * 16384 devices; the least recently decoded device is dropped first.
+         * @param deviceId Identifier of the sending device
+         * @param buffer One or more concatenated frames
+         * @throws Error with the offset of a truncated or corrupt frame
+         */
+        decodeTelemetry(deviceId: string, buffer: Uint8Array): TelemetryFrame[];
+
+        /**
+         * Forget the telemetry state of a device, or of every device
+         * @param deviceId Device to forget
+         */
+        resetTelemetry(deviceId?: string): void;
+
+        /**
+         * Encode a binary fingerprint digest as text
+         * @param digest Digest bytes
+         * @param encoding Text encoding, defaults to 'hex'
+         */
+        encodeFingerprint(digest: Uint8Array, encoding?: DigestEncoding): string;
+
+        /**
+         * Decode a fingerprint digest from text
+         * @param text Encoded digest
+         * @param encoding Text encoding, defaults to 'hex'
+         * @returns Digest bytes, or null if the text is not valid in the encoding
+         */
+        decodeFingerprint(text: string, encoding?: DigestEncoding): Buffer | null;
+
+        /**
+         * Create a signed 208-byte attestation token for this machine
+         * @param key HMAC key
+         * @param options Token options
+         */
+        createToken(key: Uint8Array | string, options?: CreateTokenOptions): Buffer;
+
+        /**
+         * Verify many attestation tokens with multi-buffer HMAC-SHA256
+         * @param tokens Concatenated tokens, or an array of tokens
+         * @param key HMAC key
+         * @param options Verification options
+         * @returns 1 for each valid token, 0 otherwise
+         */
+        verifyTokens(tokens: Uint8Array | Uint8Array[], key: Uint8Array | string, options?: VerifyTokensOptions): Uint8Array;
+
+        /**
+         * Read the claims of an attestation token without verifying it
+         * @param token Token bytes
+         * @returns Claims, or null if the token is malformed
+         */
+        decodeToken(token: Uint8Array): AttestationClaims | null;
+
+        /**
+         * Serialize snapshots, batch results or diffs to JSON natively
+         * @param entries Entries to serialize
+         * @param options Output options
+         */
+        encodeJson(entries: JsonEntry[], options?: JsonStreamOptions): Buffer;
+
+        /**
+         * Stream entries or the fleet registry as JSON, serialized natively in batches
+         * @param source Entries to serialize, or 'registry'
+         * @param options Output options
+         */
+        createJsonStream(source: JsonEntry[] | 'registry', options?: JsonStreamOptions): import('stream').Readable;
+
+        /**
+         * Watch for hardware changes using native event-loop notifications
+         * @param callback Receives an event when an identifier changes
+         * @param options Watch options
+         * @returns Function that stops this watcher
+         * @throws Error if not initialized or no change source is available
+         */
+        watch(callback: (event: HardwareChangeEvent) => void, options?: WatchOptions): () => void;
 
         /**
          * Get hardware summary (formatted for display)
@@ -129,15 +764,46 @@ declare module 'hardware-identification-addon' {
      * Native addon functions (advanced use)
      */
     export interface NativeAddon {
-        initialize(): boolean;
+        initialize(root?: string): boolean;
         cleanup(): void;
         getCpuId(): string;
         getMotherboardSerial(): string;
         getBiosSerial(): string;
         getDiskSerials(): string[];
         getMacAddresses(): string[];
-        getHardwareFingerprint(): string;
-        getAllHardwareInfo(): HardwareInfo;
+        getComponent(name: HardwareComponentName): string | string[];
+        getComponentTable(): ComponentDescription[];
+        getHardwareFingerprint(options?: FingerprintOptions): string | Buffer;
+        fingerprintEncode(digest: Uint8Array, encoding: DigestEncoding): string;
+        fingerprintDecode(text: string, encoding: DigestEncoding): Buffer | null;
+        getAllHardwareInfo(options?: WatchdogOptions): HardwareInfo;
+        refreshHardwareInfo(options?: WatchdogOptions): RefreshResult;
+        getAllHardwareInfoAsync(priority?: CollectionPriority, options?: WatchdogOptions): Promise<HardwareInfo>;
+        getCollectionStats(): CollectionStats;
+        startChangeMonitor(listener: (sources: Array<'network' | 'device'>) => void, debounceMs?: number): boolean;
+        stopChangeMonitor(): void;
+        collectRoots(roots: string[], concurrency?: number, register?: boolean): Promise<RootHardwareInfo[]>;
+        registryAdd(records: Partial<HardwareInfo>[]): number[];
+        registryLoadJson(data: Uint8Array, threads?: number): Uint32Array;
+        registryGet(index: number): HardwareInfo | null;
+        registrySnapshotId(index: number): number | null;
+        registryFind(fingerprint: string): number[];
+        registryQuery(filter: RegistryFilter, threads?: number): Uint32Array;
+        registryStats(): RegistryStats;
+        registryClear(): void;
+        registryExport(path: string): FleetFileExport;
+        fleetFileQuery(path: string, filter: FleetFileFilter): FleetFileQueryResult;
+        normalizeMacAddresses(macs: string[], options?: MacNormalizeOptions): string[];
+        encodeSnapshot(info?: Partial<HardwareInfo> | null, format?: SnapshotFormat): Buffer;
+        decodeSnapshots(buffer: Uint8Array): HardwareInfo[];
+        telemetryEncode(info?: Partial<HardwareInfo> | null, keyframe?: boolean, keyframeInterval?: number): Buffer;
+        telemetryDecode(deviceId: string, buffer: Uint8Array): TelemetryFrame[];
+        telemetryReset(deviceId?: string): void;
+        attestationCreate(key: Uint8Array | string, keyId?: number, nonce?: Uint8Array, issuedAt?: number, info?: Partial<HardwareInfo>): Buffer;
+        attestationVerify(key: Uint8Array | string, tokens: Uint8Array | Uint8Array[], maxAgeMs?: number, now?: number): Uint8Array;
+        attestationDecode(token: Uint8Array): AttestationClaims | null;
+        jsonEncode(entries: JsonEntry[], ndjson?: boolean, first?: boolean): Buffer;
+        jsonEncodeRegistry(start: number, chunkSize: number, ndjson?: boolean, first?: boolean): { chunk: Buffer; next: number };
     }
 
     // Singleton instance
@@ -147,14 +813,47 @@ declare module 'hardware-identification-addon' {
     export const native: NativeAddon;
 
     // Convenience functions using singleton
-    export function initialize(): boolean;
+    export function initialize(options?: InitializeOptions): boolean;
     export function cleanup(): void;
     export function getCpuId(): string;
     export function getMotherboardSerial(): string;
     export function getBiosSerial(): string;
     export function getDiskSerials(): string[];
     export function getMacAddresses(): string[];
-    export function getHardwareFingerprint(): string;
-    export function getAllHardwareInfo(): HardwareInfo;
+    export function getComponent(name: HardwareComponentName): string | string[];
+    export function getComponents(): ComponentDescription[];
+    export function getHardwareFingerprint(options: FingerprintOptions & { encoding: 'raw' }): Buffer;
+    export function getHardwareFingerprint(options?: FingerprintOptions): string;
+    export function encodeFingerprint(digest: Uint8Array, encoding?: DigestEncoding): string;
+    export function decodeFingerprint(text: string, encoding?: DigestEncoding): Buffer | null;
+    export function getAllHardwareInfo(options?: WatchdogOptions): HardwareInfo;
+    export function refresh(options?: WatchdogOptions): RefreshResult;
+    export function getAllHardwareInfoAsync(options?: CollectionOptions): Promise<HardwareInfo>;
+    export function getCollectionStats(): CollectionStats;
+    export function collectRoots(roots: string[], options?: CollectRootsOptions): Promise<RootHardwareInfo[]>;
+    export function registerRecords(records: Partial<HardwareInfo>[]): number[];
+    export function loadRegistrations(source: string | Uint8Array, options?: LoadRegistrationsOptions): Uint32Array;
+    export function getRegisteredRecord(index: number): HardwareInfo | null;
+    export function getRegisteredSnapshotId(index: number): number | null;
+    export function findRegisteredRecords(fingerprint: string): number[];
+    export function queryRegistry(filter: RegistryFilter, options?: RegistryQueryOptions): Uint32Array;
+    export function getRegistryStats(): RegistryStats;
+    export function clearRegistry(): void;
+    export function exportRegistry(path: string): FleetFileExport;
+    export function queryFleetFile(path: string, filter?: FleetFileFilter): FleetFileQueryResult;
+    export function normalizeMacAddresses(macs: string[], options?: MacNormalizeOptions): string[];
+    export function encodeSnapshot(format?: SnapshotFormat): Buffer;
+    export function encodeSnapshot(info: Partial<HardwareInfo>, format?: SnapshotFormat): Buffer;
+    export function decodeSnapshot(buffer: Uint8Array): HardwareInfo;
+    export function decodeSnapshots(buffer: Uint8Array): HardwareInfo[];
+    export function encodeTelemetry(info?: Partial<HardwareInfo> | null, options?: TelemetryOptions): Buffer;
+    export function decodeTelemetry(deviceId: string, buffer: Uint8Array): TelemetryFrame[];
+    export function resetTelemetry(deviceId?: string): void;
+    export function createToken(key: Uint8Array | string, options?: CreateTokenOptions): Buffer;
+    export function verifyTokens(tokens: Uint8Array | Uint8Array[], key: Uint8Array | string, options?: VerifyTokensOptions): Uint8Array;
+    export function decodeToken(token: Uint8Array): AttestationClaims | null;
+    export function encodeJson(entries: JsonEntry[], options?: JsonStreamOptions): Buffer;
+    export function createJsonStream(source: JsonEntry[] | 'registry', options?: JsonStreamOptions): import('stream').Readable;
+    export function watch(callback: (event: HardwareChangeEvent) => void, options?: WatchOptions): () => void;
     export function getHardwareSummary(): HardwareSummary;
 }
@@ -9,8 +9,88 @@
  * @version 1.0.0
  */
 
+const fs = require('fs');
+const { Readable } = require('stream');
 const hardwareAddon = require('./build/Release/hardware_id_addon');
 
+/**
+ * Components compared when a change notification arrives
+ * @private
+ */
+const WATCHED_COMPONENTS = ['cpuId', 'motherboardSerial', 'biosSerial', 'diskSerials', 'macAddresses'];
+
+/**
+ * Watchers registered through HardwareId#watch(). The native change monitor
+ * is process-wide, so watchers of all instances share it.
+ * @private
+ */
+const changeWatchers = new Set();
+const pendingChangeSources = new Set();
+let lastWatchedInfo = null;
+let watchRefreshRunning = false;
+
+/**
+ * Get the names of components that differ between two snapshots
+ * @private
+ */
+function changedComponents(previous, current) {
+    return WATCHED_COMPONENTS.filter((name) =>
+        JSON.stringify(previous[name]) !== JSON.stringify(current[name]));
+}
+
+/**
+ * Apply the shortest debounce period of the active watchers to the running
+ * native monitor; pending notifications are kept.
+ * @private
+ */
+function updateWatchDebounce() {
+    const debounceMs = Math.min(...[...changeWatchers].map((watcher) => watcher.debounceMs));
+    hardwareAddon.startChangeMonitor(onHardwareChange, debounceMs);
+}
+
+/**
+ * Native change monitor listener. Notifications arriving while a refresh is
+ * running are coalesced into the next refresh.
+ * @private
+ */
+function onHardwareChange(sources) {
+    sources.forEach((source) => pendingChangeSources.add(source));
+    if (watchRefreshRunning) {
+        return;
+    }
+
+    watchRefreshRunning = true;
+    (async () => {
+        try {
+            while (pendingChangeSources.size > 0 && changeWatchers.size > 0) {
+                const batch = [...pendingChangeSources];
+                pendingChangeSources.clear();
+
+                const current = await hardwareAddon.getAllHardwareInfoAsync('background');
+                const previous = lastWatchedInfo;
+                lastWatchedInfo = current;
+                if (!previous) {
+                    continue;
+                }
+
+                const changed = changedComponents(previous, current);
+                if (changed.length === 0) {
+                    continue;
+                }
+
+                const event = { changed, sources: batch, previous, current };
+                for (const watcher of [...changeWatchers]) {
+                    watcher.callback(event);
+                }
+            }
+        } catch (error) {
+            console.error('Failed to refresh hardware information after change:', error.message);
+        } finally {
+            watchRefreshRunning = false;
+        }
+    })();
+}
+
 /**
  * @class HardwareId
  * @description Main class for hardware identification functionality
@@ -22,11 +102,15 @@ class HardwareId {
 
     /**
      * Initialize the hardware identification system
+     * @param {Object} [options] Initialization options
+     * @param {string} [options.root] Read identifiers from a captured sysfs tree
+     *     or mounted system image at this path instead of the live system;
+     *     without it the live system is read, even after an earlier root
      * @returns {boolean} True if initialization successful, false otherwise
      */
-    initialize() {
+    initialize(options = {}) {
         try {
-            this.initialized = hardwareAddon.initialize();
+            this.initialized = hardwareAddon.initialize(options.root);
             return this.initialized;
         } catch (error) {
             console.error('Failed to initialize hardware identification:', error.message);
@@ -40,6 +124,11 @@ class HardwareId {
     cleanup() {
         try {
             if (this.initialized) {
+                for (const watcher of [...changeWatchers]) {
+                    if (watcher.owner === this) {
+                        this._removeWatcher(watcher);
+                    }
+                }
                 hardwareAddon.cleanup();
                 this.initialized = false;
             }
@@ -106,24 +195,550 @@ class HardwareId {
         return hardwareAddon.getMacAddresses();
     }
 
+    /**
+     * Collect a single component by name
+     * @param {string} name Component name, as listed by getComponents()
+     * @returns {string|string[]} Component value
+     * @throws {Error} If not initialized, the name is unknown or the operation fails
+     */
+    getComponent(name) {
+        this._ensureInitialized();
+        return hardwareAddon.getComponent(name);
+    }
+
+    /**
+     * Describe the collectable components
+     *
+     * Generated from the native identifier table, so it lists every
+     * component the addon was built with.
+     *
+     * @returns {Object[]} Per component: name, getter, type ('string' or 'list'), sources, cost and volatility
+     */
+    getComponents() {
+        return hardwareAddon.getComponentTable();
+    }
+
     /**
      * Get hardware fingerprint (combined hash of hardware identifiers)
-     * @returns {string} Hardware fingerprint
+     * @param {Object} [options] Collection options, see getAllHardwareInfo()
+     * @param {string} [options.encoding] 'legacy' (default) for the variable-length hex hash; 'raw', 'hex', 'base32' or 'base64url' for the SHA-256 digest
+     * @returns {string|Buffer} Hardware fingerprint (a Buffer for 'raw'), empty if a required component timed out
      * @throws {Error} If not initialized or operation fails
      */
-    getHardwareFingerprint() {
+    getHardwareFingerprint(options) {
         this._ensureInitialized();
-        return hardwareAddon.getHardwareFingerprint();
+        return hardwareAddon.getHardwareFingerprint(options);
     }
 
     /**
      * Get all hardware information at once
+     * @param {Object} [options] Collection options
+     * @param {number} [options.componentTimeoutMs] Per-component watchdog deadline;
+     *     components that miss it are abandoned and listed in `timedOut`
+     * @param {string[]} [options.requiredComponents] Fingerprint profile: components
+     *     that must not time out for a fingerprint to be produced (default: all)
      * @returns {Object} Object containing all hardware information
      * @throws {Error} If not initialized or operation fails
      */
-    getAllHardwareInfo() {
+    getAllHardwareInfo(options) {
         this._ensureInitialized();
-        return hardwareAddon.getAllHardwareInfo();
+        return hardwareAddon.getAllHardwareInfo(options);
+    }
+
+    /**
+     * Refresh hardware information in steady state
+     *
+     * Re-collects every component and compares it natively with the
+     * previous refresh. When nothing changed the native refresh path
+     * performs no allocation and `current` is null.
+     *
+     * @param {Object} [options] Collection options, as for getAllHardwareInfo()
+     * @returns {Object} { changed, fingerprintChanged, allocations, current }
+     * @throws {Error} If not initialized or operation fails
+     */
+    refresh(options) {
+        this._ensureInitialized();
+        return hardwareAddon.refreshHardwareInfo(options);
+    }
+
+    /**
+     * Get all hardware information asynchronously through the native scheduler
+     *
+     * Requests are served by priority class: interactive requests jump ahead
+     * of queued background refreshes and preempt a running one between
+     * component collections.
+     *
+     * @param {Object} [options] Collection options
+     * @param {string} [options.priority='normal'] 'interactive', 'normal' or 'background'
+     * @param {number} [options.componentTimeoutMs] Per-component watchdog deadline
+     * @param {string[]} [options.requiredComponents] Fingerprint profile
+     * @returns {Promise<Object>} Object containing all hardware information
+     * @throws {Error} If not initialized or the priority is invalid
+     */
+    getAllHardwareInfoAsync(options = {}) {
+        this._ensureInitialized();
+        return hardwareAddon.getAllHardwareInfoAsync(options.priority, options);
+    }
+
+    /**
+     * Get native collection statistics
+     * @returns {Object} Scheduler counters per priority class
+     */
+    getCollectionStats() {
+        return hardwareAddon.getCollectionStats();
+    }
+
+    /**
+     * Collect and fingerprint many alternate roots concurrently
+     *
+     * Each root is a captured sysfs/procfs tree or a mounted system image.
+     * Collection runs on native worker threads and does not require
+     * initialize().
+     *
+     * @param {string[]} roots Root directories to collect
+     * @param {Object} [options] Batch options
+     * @param {number} [options.concurrency] Worker threads, defaults to the CPU count
+     * @param {boolean} [options.register=false] Also add successful results to the fleet registry
+     * @returns {Promise<Object[]>} Hardware information plus root and success per root
+     */
+    collectRoots(roots, options = {}) {
+        return hardwareAddon.collectRoots(roots, options.concurrency, options.register === true);
+    }
+
+    /**
+     * Add hardware records to the native fleet registry
+     *
+     * Repeated values are interned, so each distinct string is stored once
+     * no matter how many records share it.
+     *
+     * @param {Object[]} records Objects in the getAllHardwareInfo() shape
+     * @returns {number[]} Registry index of each record
+     */
+    registerRecords(records) {
+        return hardwareAddon.registryAdd(records);
+    }
+
+    /**
+     * Register hardware records from JSON registration data
+     *
+     * Accepts files written by registration tools (registeredAt,
+     * fingerprint and a hardware object), NDJSON streams, concatenated
+     * JSON documents and arrays of getAllHardwareInfo()-shaped records.
+     * The text is parsed natively, in parallel chunks for large inputs,
+     * straight into the registry without creating JavaScript objects.
+     *
+     * @param {string|Buffer|Uint8Array} source File path or UTF-8 JSON
+     * @param {Object} [options] Load options
+     * @param {number} [options.threads] Parse threads, defaults to the CPU count
+     * @returns {Uint32Array} Registry index of each record, in input order
+     */
+    loadRegistrations(source, options = {}) {
+        const data = typeof source === 'string' ? fs.readFileSync(source) : source;
+        return hardwareAddon.registryLoadJson(data, options.threads);
+    }
+
+    /**
+     * Get a record from the fleet registry
+     * @param {number} index Registry index
+     * @returns {Object|null} Hardware information, null for an unknown index
+     */
+    getRegisteredRecord(index) {
+        return hardwareAddon.registryGet(index);
+    }
+
+    /**
+     * Get the snapshot ID of a fleet registry record
+     *
+     * Identical snapshots are stored once, so two records have equal
+     * snapshot IDs exactly when all their collected values are equal.
+     *
+     * @param {number} index Registry index
+     * @returns {number|null} Snapshot ID, null for an unknown index
+     */
+    getRegisteredSnapshotId(index) {
+        return hardwareAddon.registrySnapshotId(index);
+    }
+
+    /**
+     * Find fleet registry records by fingerprint
+     * @param {string} fingerprint Fingerprint to match
+     * @returns {number[]} Registry indices of matching records
+     */
+    findRegisteredRecords(fingerprint) {
+        return hardwareAddon.registryFind(fingerprint);
+    }
+
+    /**
+     * Filter the fleet registry with native columnar scans
+     *
+     * String filters match exactly through interned identifiers; macPrefix
+     * matches the first MAC address by prefix. All given filters must match.
+     *
+     * @param {Object} filter Filter values
+     * @param {string} [filter.cpuId] CPU ID
+     * @param {string} [filter.motherboardSerial] Motherboard serial
+     * @param {string} [filter.biosSerial] BIOS serial
+     * @param {string} [filter.fingerprint] Fingerprint
+     * @param {string} [filter.diskSerial] First disk serial
+     * @param {string} [filter.macPrefix] First MAC address prefix, e.g. an OUI '00:1A:2B'
+     * @param {Object} [options] Scan options
+     * @param {number} [options.threads] Scan threads, defaults to the CPU count
+     * @returns {Uint32Array} Matching registry indices in ascending order
+     */
+    queryRegistry(filter, options = {}) {
+        return hardwareAddon.registryQuery(filter, options.threads);
+    }
+
+    /**
+     * Write the fleet registry to a memory-mapped columnar fleet file
+     *
+     * Columns are dictionary, fixed-width or delta encoded in row groups
+     * whose footer keeps min/max values and Bloom filters.
+     *
+     * @param {string} path Output file path
+     * @returns {Object} Row and row group counts
+     */
+    exportRegistry(path) {
+        return hardwareAddon.registryExport(path);
+    }
+
+    /**
+     * Query a columnar fleet file without loading it
+     *
+     * Accepts the queryRegistry() filters plus a registration time range.
+     * Row groups ruled out by footer statistics are skipped unread.
+     *
+     * @param {string} path Fleet file path
+     * @param {Object} filter Filter values
+     * @param {number|Date} [filter.registeredAfter] Earliest registration time (inclusive)
+     * @param {number|Date} [filter.registeredBefore] Latest registration time (exclusive)
+     * @returns {Object} Matching rows and scan statistics
+     */
+    queryFleetFile(path, filter = {}) {
+        const toTime = (value) => (value instanceof Date ? value.getTime() : value);
+        return hardwareAddon.fleetFileQuery(path, {
+            ...filter,
+            registeredAfter: toTime(filter.registeredAfter),
+            registeredBefore: toTime(filter.registeredBefore)
+        });
+    }
+
+    /**
+     * Get fleet registry memory statistics
+     * @returns {Object} Record, unique string and byte counts
+     */
+    getRegistryStats() {
+        return hardwareAddon.registryStats();
+    }
+
+    /**
+     * Remove every record from the fleet registry
+     */
+    clearRegistry() {
+        hardwareAddon.registryClear();
+    }
+
+    /**
+     * Encode a snapshot natively into a Buffer
+     *
+     * 'binary' is the compact wire format: a schema id, a presence bitmap,
+     * varint-length fields and a CRC-32C. Equal snapshots encode to
+     * identical bytes, so Buffer.equals() is an equality test. 'msgpack'
+     * and 'cbor' produce a map in the getAllHardwareInfo() shape.
+     *
+     * Called without a snapshot, the current hardware is collected and
+     * encoded natively without building a JavaScript object.
+     *
+     * @param {Object|string} [info] Snapshot in the getAllHardwareInfo() shape, or the format
+     * @param {string} [format='binary'] 'binary', 'msgpack' or 'cbor'
+     * @returns {Buffer} Encoded snapshot
+     */
+    encodeSnapshot(info, format = 'binary') {
+        if (typeof info === 'string') {
+            format = info;
+            info = undefined;
+        }
+        if (info === undefined) {
+            this._ensureInitialized();
+        }
+        return hardwareAddon.encodeSnapshot(info, format);
+    }
+
+    /**
+     * Decode one binary snapshot frame
+     * @param {Buffer|Uint8Array} buffer Encoded frame
+     * @returns {Object} Snapshot in the getAllHardwareInfo() shape
+     */
+    decodeSnapshot(buffer) {
+        const snapshots = hardwareAddon.decodeSnapshots(buffer);
+        if (snapshots.length !== 1) {
+            throw new Error(`Expected one encoded snapshot, found ${snapshots.length}`);
+        }
+        return snapshots[0];
+    }
+
+    /**
+     * Decode a buffer of concatenated binary snapshot frames
+     * @param {Buffer|Uint8Array} buffer Encoded frames
+     * @returns {Object[]} Snapshots in the getAllHardwareInfo() shape
+     */
+    decodeSnapshots(buffer) {
+        return hardwareAddon.decodeSnapshots(buffer);
+    }
+
+    /**
+     * Encode the next heartbeat of this machine's telemetry stream
+     *
+     * The first frame, every keyframeInterval-th frame and frames after
+     * requestKeyframe are keyframes with the full snapshot; other frames
+     * only carry the components that changed, so an unchanged heartbeat is
+     * a few bytes.
+     *
+     * @param {Object} [info] Snapshot in the getAllHardwareInfo() shape, collected natively if omitted
+     * @param {Object} [options] Stream options
+     * @param {boolean} [options.keyframe=false] Send a keyframe, e.g. after a receiver asked for one
+     * @param {number} [options.keyframeInterval] Frames between keyframes (default 60, 0 for on request only)
+     * @returns {Buffer} One stream frame
+     */
+    encodeTelemetry(info, options = {}) {
+        if (info === undefined || info === null) {
+            this._ensureInitialized();
+        }
+        return hardwareAddon.telemetryEncode(info, !!options.keyframe, options.keyframeInterval);
+    }
+
+    /**
+     * Apply telemetry frames received from a device
+     *
+     * Each device keeps its reconstructed state natively. A delta that does
+     * not follow the last applied frame is reported with needKeyframe set;
+     * the sender should then pass keyframe: true on its next heartbeat.
+     * State is kept once a keyframe of the device is applied, for up to
+     * 16384 devices; the least recently decoded device is dropped first.
+     *
+     * @param {string} deviceId Identifier of the sending device
+     * @param {Buffer|Uint8Array} buffer One or more concatenated frames
+     * @returns {Object[]} Per frame: sequence, keyframe, needKeyframe, changed component names and the snapshot
+     */
+    decodeTelemetry(deviceId, buffer) {
+        return hardwareAddon.telemetryDecode(deviceId, buffer);
+    }
+
+    /**
+     * Forget the telemetry state of a device, or of every device
+     * @param {string} [deviceId] Device to forget
+     */
+    resetTelemetry(deviceId) {
+        hardwareAddon.telemetryReset(deviceId);
+    }
+
+    /**
+     * Create a signed attestation token for this machine
+     *
+     * Tokens are 208 bytes: the fingerprint, a truncated SHA-256 digest per
+     * component, the issue time and a nonce, signed with HMAC-SHA256.
+     *
+     * @param {Buffer|string} key HMAC key
+     * @param {Object} [options] Token options
+     * @param {number} [options.keyId] Key identifier recorded in the token (default 0)
+     * @param {Buffer} [options.nonce] 16-byte nonce, random if omitted
+     * @param {number} [options.issuedAt] Issue time in milliseconds, now if omitted
+     * @param {Object} [options.info] Snapshot to attest, collected natively if omitted
+     * @returns {Buffer} Token bytes
+     */
+    createToken(key, options = {}) {
+        if (!options.info) {
+            this._ensureInitialized();
+        }
+        return hardwareAddon.attestationCreate(key, options.keyId, options.nonce, options.issuedAt, options.info);
+    }
+
+    /**
+     * Verify many attestation tokens at once
+     *
+     * Signatures are checked with multi-buffer SHA-256, several tokens per
+     * pass, and compared in constant time.
+     *
+     * @param {Buffer|Buffer[]} tokens Concatenated 208-byte tokens, or an array of tokens
+     * @param {Buffer|string} key HMAC key
+     * @param {Object} [options] Verification options
+     * @param {number} [options.maxAgeMs] Reject tokens issued longer ago than this, or in the future
+     * @param {number} [options.now] Current time in milliseconds for the age check
+     * @returns {Uint8Array} 1 for each valid token, 0 otherwise
+     */
+    verifyTokens(tokens, key, options = {}) {
+        return hardwareAddon.attestationVerify(key, tokens, options.maxAgeMs, options.now);
+    }
+
+    /**
+     * Read the claims of an attestation token without verifying it
+     * @param {Buffer} token Token bytes
+     * @returns {Object|null} keyId, issuedAt, nonce, fingerprint and componentDigests, or null if malformed
+     */
+    decodeToken(token) {
+        return hardwareAddon.attestationDecode(token);
+    }
+
+    /**
+     * Encode a binary fingerprint digest as text
+     * @param {Buffer|Uint8Array} digest Digest bytes, e.g. from getHardwareFingerprint({ encoding: 'raw' })
+     * @param {string} [encoding] 'hex' (default), 'base32' or 'base64url'
+     * @returns {string} Encoded digest
+     */
+    encodeFingerprint(digest, encoding = 'hex') {
+        return hardwareAddon.fingerprintEncode(digest, encoding);
+    }
+
+    /**
+     * Decode a fingerprint digest from text
+     * @param {string} text Encoded digest
+     * @param {string} [encoding] 'hex' (default), 'base32' or 'base64url'
+     * @returns {Buffer|null} Digest bytes, or null if the text is not valid in the encoding
+     */
+    decodeFingerprint(text, encoding = 'hex') {
+        return hardwareAddon.fingerprintDecode(text, encoding);
+    }
+
+    /**
+     * Serialize snapshots, batch results or diffs to JSON natively
+     *
+     * Objects with before/after (or previous/current) snapshots are written
+     * as diffs listing the changed components. Other properties are written
+     * as JSON.stringify() would; circular entries throw a TypeError.
+     *
+     * @param {Object[]} entries Entries to serialize
+     * @param {Object} [options] Options
+     * @param {boolean} [options.ndjson=false] Write newline-delimited JSON instead of an array
+     * @returns {Buffer} UTF-8 JSON
+     */
+    encodeJson(entries, options = {}) {
+        const body = hardwareAddon.jsonEncode(entries, !!options.ndjson, true);
+        return options.ndjson ? body : Buffer.concat([Buffer.from('['), body, Buffer.from(']')]);
+    }
+
+    /**
+     * Stream snapshots, batch results, diffs or the fleet registry as JSON
+     *
+     * Entries are serialized natively in batches, so large exports never
+     * hold the whole document in memory.
+     *
+     * @param {Object[]|string} source Entries to serialize, or 'registry'
+     * @param {Object} [options] Options
+     * @param {boolean} [options.ndjson=false] Write newline-delimited JSON instead of an array
+     * @param {number} [options.batchSize=1024] Entries serialized per chunk
+     * @param {number} [options.chunkSize=65536] Approximate registry chunk size in bytes
+     * @returns {Readable} Readable stream of UTF-8 JSON
+     */
+    createJsonStream(source, options = {}) {
+        const ndjson = !!options.ndjson;
+        const batchSize = options.batchSize || 1024;
+        const chunkSize = options.chunkSize || 65536;
+        if (source !== 'registry' && !Array.isArray(source)) {
+            throw new TypeError("Source must be an array or 'registry'");
+        }
+        let position = 0;
+        let first = true;
+        let done = false;
+
+        return new Readable({
+            read() {
+                if (done) {
+                    return;
+                }
+                let chunk;
+                if (source === 'registry') {
+                    const result = hardwareAddon.jsonEncodeRegistry(position, chunkSize, ndjson, first);
+                    chunk = result.chunk;
+                    position = result.next;
+                } else {
+                    const batch = source.slice(position, position + batchSize);
+                    chunk = hardwareAddon.jsonEncode(batch, ndjson, first);
+                    position += batch.length;
+                }
+
+                const finished = chunk.length === 0 ||
+                    (source !== 'registry' && position >= source.length);
+                if (!ndjson && first) {
+                    chunk = Buffer.concat([Buffer.from('['), chunk]);
+                }
+                first = false;
+                if (finished) {
+                    done = true;
+                    if (!ndjson) {
+                        chunk = Buffer.concat([chunk, Buffer.from(']')]);
+                    }
+                    this.push(chunk);
+                    this.push(null);
+                    return;
+                }
+                this.push(chunk);
+            }
+        });
+    }
+
+    /**
+     * Parse, filter and reformat MAC addresses
+     *
+     * Accepts colon, dash, dot (Cisco) and bare forms in either case.
+     * Addresses are processed natively as 48-bit integers; entries that are
+     * not MAC addresses are skipped.
+     *
+     * @param {string[]} macs Addresses to normalize
+     * @param {Object} [options] Normalization options
+     * @param {string} [options.format='colon'] 'colon', 'dash', 'dot' or 'bare'
+     * @param {boolean} [options.lowercase=false] Use lower-case hex digits
+     * @param {boolean} [options.unique=false] Sort and remove duplicates
+     * @param {boolean} [options.excludeMulticast=false] Drop group addresses
+     * @param {boolean} [options.excludeLocallyAdministered=false] Drop locally administered addresses
+     * @returns {string[]} Normalized addresses
+     */
+    normalizeMacAddresses(macs, options = {}) {
+        return hardwareAddon.normalizeMacAddresses(macs, options);
+    }
+
+    /**
+     * Watch for hardware changes
+     *
+     * Uses native operating system notifications on the Node event loop
+     * instead of polling. Bursts of notifications are debounced, the hardware
+     * is re-collected at background priority, and the callback runs only if
+     * an identifier actually changed.
+     *
+     * @param {Function} callback Receives { changed, sources, previous, current }
+     * @param {Object} [options] Watch options
+     * @param {number} [options.debounceMs=500] Quiet period before re-collecting;
+     *     watchers share one monitor, which uses the shortest period requested
+     * @returns {Function} Function that stops this watcher
+     * @throws {Error} If not initialized, debounceMs is invalid or no change source is available
+     */
+    watch(callback, options = {}) {
+        this._ensureInitialized();
+        if (typeof callback !== 'function') {
+            throw new TypeError('Watch callback must be a function');
+        }
+        const debounceMs = options.debounceMs === undefined ? 500 : options.debounceMs;
+        if (typeof debounceMs !== 'number' || !(debounceMs >= 0)) {
+            throw new TypeError('debounceMs must be a non-negative number');
+        }
+
+        const watcher = { owner: this, callback, debounceMs };
+        if (changeWatchers.size === 0) {
+            if (!hardwareAddon.startChangeMonitor(onHardwareChange, debounceMs)) {
+                throw new Error('No hardware change notification source is available');
+            }
+            hardwareAddon.getAllHardwareInfoAsync('background')
+                .then((info) => {
+                    if (!lastWatchedInfo) {
+                        lastWatchedInfo = info;
+                    }
+                })
+                .catch(() => {});
+            changeWatchers.add(watcher);
+        } else {
+            changeWatchers.add(watcher);
+            updateWatchDebounce();
+        }
+        return () => this._removeWatcher(watcher);
     }
 
     /**
@@ -148,6 +763,23 @@ class HardwareId {
         };
     }
 
+    /**
+     * Remove a change watcher, stopping the native monitor after the last one
+     * @private
+     */
+    _removeWatcher(watcher) {
+        if (!changeWatchers.delete(watcher)) {
+            return;
+        }
+        if (changeWatchers.size > 0) {
+            updateWatchDebounce();
+            return;
+        }
+        hardwareAddon.stopChangeMonitor();
+        pendingChangeSources.clear();
+        lastWatchedInfo = null;
+    }
+
     /**
      * Ensure the system is initialized
      * @private
@@ -177,14 +809,45 @@ module.exports = {
     native: hardwareAddon,
     
     // Convenience functions using singleton
-    initialize: () => hardwareId.initialize(),
+    initialize: (options) => hardwareId.initialize(options),
     cleanup: () => hardwareId.cleanup(),
     getCpuId: () => hardwareId.getCpuId(),
     getMotherboardSerial: () => hardwareId.getMotherboardSerial(),
     getBiosSerial: () => hardwareId.getBiosSerial(),
     getDiskSerials: () => hardwareId.getDiskSerials(),
     getMacAddresses: () => hardwareId.getMacAddresses(),
-    getHardwareFingerprint: () => hardwareId.getHardwareFingerprint(),
-    getAllHardwareInfo: () => hardwareId.getAllHardwareInfo(),
+    getComponent: (name) => hardwareId.getComponent(name),
+    getComponents: () => hardwareId.getComponents(),
+    getHardwareFingerprint: (options) => hardwareId.getHardwareFingerprint(options),
+    encodeFingerprint: (digest, encoding) => hardwareId.encodeFingerprint(digest, encoding),
+    decodeFingerprint: (text, encoding) => hardwareId.decodeFingerprint(text, encoding),
+    getAllHardwareInfo: (options) => hardwareId.getAllHardwareInfo(options),
+    refresh: (options) => hardwareId.refresh(options),
+    getAllHardwareInfoAsync: (options) => hardwareId.getAllHardwareInfoAsync(options),
+    getCollectionStats: () => hardwareId.getCollectionStats(),
+    watch: (callback, options) => hardwareId.watch(callback, options),
+    collectRoots: (roots, options) => hardwareId.collectRoots(roots, options),
+    registerRecords: (records) => hardwareId.registerRecords(records),
+    loadRegistrations: (source, options) => hardwareId.loadRegistrations(source, options),
+    getRegisteredRecord: (index) => hardwareId.getRegisteredRecord(index),
+    getRegisteredSnapshotId: (index) => hardwareId.getRegisteredSnapshotId(index),
+    findRegisteredRecords: (fingerprint) => hardwareId.findRegisteredRecords(fingerprint),
+    queryRegistry: (filter, options) => hardwareId.queryRegistry(filter, options),
+    getRegistryStats: () => hardwareId.getRegistryStats(),
+    clearRegistry: () => hardwareId.clearRegistry(),
+    exportRegistry: (path) => hardwareId.exportRegistry(path),
+    queryFleetFile: (path, filter) => hardwareId.queryFleetFile(path, filter),
+    normalizeMacAddresses: (macs, options) => hardwareId.normalizeMacAddresses(macs, options),
+    encodeSnapshot: (info, format) => hardwareId.encodeSnapshot(info, format),
+    decodeSnapshot: (buffer) => hardwareId.decodeSnapshot(buffer),
+    decodeSnapshots: (buffer) => hardwareId.decodeSnapshots(buffer),
+    encodeTelemetry: (info, options) => hardwareId.encodeTelemetry(info, options),
+    decodeTelemetry: (deviceId, buffer) => hardwareId.decodeTelemetry(deviceId, buffer),
+    resetTelemetry: (deviceId) => hardwareId.resetTelemetry(deviceId),
+    createToken: (key, options) => hardwareId.createToken(key, options),
+    verifyTokens: (tokens, key, options) => hardwareId.verifyTokens(tokens, key, options),
+    decodeToken: (token) => hardwareId.decodeToken(token),
+    encodeJson: (entries, options) => hardwareId.encodeJson(entries, options),
+    createJsonStream: (source, options) => hardwareId.createJsonStream(source, options),
     getHardwareSummary: () => hardwareId.getHardwareSummary()
 };
@@ -0,0 +1,187 @@
+#include "arena_snapshot.h"
+#include <cstring>
+#include <new>
+
+/**
+ * @brief Bump allocator over a pre-sized block
+ */
+class BumpWriter {
+public:
+    explicit BumpWriter(char* block, uint32_t offset)
+        : m_block(block)
+        , m_offset(offset) {
+    }
+
+    /**
+     * @brief Append string bytes and return their location
+     */
+    void Append(const std::string& value, uint32_t& offset, uint32_t& length) {
+        offset = m_offset;
+        length = static_cast<uint32_t>(value.size());
+        if (!value.empty()) {
+            memcpy(m_block + m_offset, value.data(), value.size());
+        }
+        m_offset += length;
+    }
+
+private:
+    char* m_block;
+    uint32_t m_offset;
+};
+
+/**
+ * @brief Constructor - Empty snapshot
+ */
+ArenaSnapshot::ArenaSnapshot() {
+}
+
+/**
+ * @brief Constructor - Copy a collected snapshot into a single arena block
+ */
+ArenaSnapshot::ArenaSnapshot(const HardwareInfo& info) {
+    // Size everything first so the block is allocated exactly once
+    size_t tableSize = sizeof(Header) + (info.diskSerials.size() + info.macAddresses.size()) * sizeof(Span);
+    size_t stringSize = info.cpuId.size() + info.motherboardSerial.size() +
+                        info.biosSerial.size() + info.fingerprint.size();
+    for (const std::string& serial : info.diskSerials) {
+        stringSize += serial.size();
+    }
+    for (const std::string& address : info.macAddresses) {
+        stringSize += address.size();
+    }
+
+    uint32_t blockSize = static_cast<uint32_t>(tableSize + stringSize);
+    m_block.reset(new char[blockSize]);
+
+    Header* header = new (m_block.get()) Header();
+    header->blockSize = blockSize;
+    header->timedOutComponents = info.timedOutComponents;
+    header->diskCount = static_cast<uint32_t>(info.diskSerials.size());
+    header->macCount = static_cast<uint32_t>(info.macAddresses.size());
+
+    Span* disks = reinterpret_cast<Span*>(m_block.get() + sizeof(Header));
+    Span* macs = disks + header->diskCount;
+
+    BumpWriter writer(m_block.get(), static_cast<uint32_t>(tableSize));
+    writer.Append(info.cpuId, header->scalars[kFieldCpuId].offset, header->scalars[kFieldCpuId].length);
+    writer.Append(info.motherboardSerial, header->scalars[kFieldMotherboardSerial].offset,
+                  header->scalars[kFieldMotherboardSerial].length);
+    writer.Append(info.biosSerial, header->scalars[kFieldBiosSerial].offset, header->scalars[kFieldBiosSerial].length);
+    writer.Append(info.fingerprint, header->scalars[kFieldFingerprint].offset,
+                  header->scalars[kFieldFingerprint].length);
+    for (size_t i = 0; i < info.diskSerials.size(); i++) {
+        Span* span = new (&disks[i]) Span();
+        writer.Append(info.diskSerials[i], span->offset, span->length);
+    }
+    for (size_t i = 0; i < info.macAddresses.size(); i++) {
+        Span* span = new (&macs[i]) Span();
+        writer.Append(info.macAddresses[i], span->offset, span->length);
+    }
+}
+
+ArenaSnapshot::ArenaSnapshot(ArenaSnapshot&& other) noexcept
+    : m_block(std::move(other.m_block)) {
+}
+
+ArenaSnapshot& ArenaSnapshot::operator=(ArenaSnapshot&& other) noexcept {
+    m_block = std::move(other.m_block);
+    return *this;
+}
+
+/**
+ * @brief Copy constructor - Offsets are block-relative, so a copy is one memcpy
+ */
+ArenaSnapshot::ArenaSnapshot(const ArenaSnapshot& other) {
+    if (other.m_block) {
+        uint32_t blockSize = other.GetHeader()->blockSize;
+        m_block.reset(new char[blockSize]);
+        memcpy(m_block.get(), other.m_block.get(), blockSize);
+    }
+}
+
+ArenaSnapshot& ArenaSnapshot::operator=(const ArenaSnapshot& other) {
+    if (this != &other) {
+        ArenaSnapshot copy(other);
+        m_block = std::move(copy.m_block);
+    }
+    return *this;
+}
+
+bool ArenaSnapshot::IsEmpty() const {
+    return !m_block;
+}
+
+const ArenaSnapshot::Header* ArenaSnapshot::GetHeader() const {
+    return reinterpret_cast<const Header*>(m_block.get());
+}
+
+std::string_view ArenaSnapshot::View(const Span& span) const {
+    return std::string_view(m_block.get() + span.offset, span.length);
+}
+
+const ArenaSnapshot::Span* ArenaSnapshot::DiskSpans() const {
+    return reinterpret_cast<const Span*>(m_block.get() + sizeof(Header));
+}
+
+const ArenaSnapshot::Span* ArenaSnapshot::MacSpans() const {
+    return DiskSpans() + GetHeader()->diskCount;
+}
+
+std::string_view ArenaSnapshot::CpuId() const {
+    return m_block ? View(GetHeader()->scalars[kFieldCpuId]) : std::string_view();
+}
+
+std::string_view ArenaSnapshot::MotherboardSerial() const {
+    return m_block ? View(GetHeader()->scalars[kFieldMotherboardSerial]) : std::string_view();
+}
+
+std::string_view ArenaSnapshot::BiosSerial() const {
+    return m_block ? View(GetHeader()->scalars[kFieldBiosSerial]) : std::string_view();
+}
+
+std::string_view ArenaSnapshot::Fingerprint() const {
+    return m_block ? View(GetHeader()->scalars[kFieldFingerprint]) : std::string_view();
+}
+
+size_t ArenaSnapshot::DiskSerialCount() const {
+    return m_block ? GetHeader()->diskCount : 0;
+}
+
+std::string_view ArenaSnapshot::DiskSerial(size_t index) const {
+    return View(DiskSpans()[index]);
+}
+
+size_t ArenaSnapshot::MacAddressCount() const {
+    return m_block ? GetHeader()->macCount : 0;
+}
+
+std::string_view ArenaSnapshot::MacAddress(size_t index) const {
+    return View(MacSpans()[index]);
+}
+
+uint32_t ArenaSnapshot::TimedOutComponents() const {
+    return m_block ? GetHeader()->timedOutComponents : 0;
+}
+
+size_t ArenaSnapshot::AllocatedBytes() const {
+    return m_block ? GetHeader()->blockSize : 0;
+}
+
+/**
+ * @brief Expand into separately allocated strings
+ */
+HardwareInfo ArenaSnapshot::ToHardwareInfo() const {
+    HardwareInfo info;
+    info.cpuId = std::string(CpuId());
+    info.motherboardSerial = std::string(MotherboardSerial());
+    info.biosSerial = std::string(BiosSerial());
+    info.fingerprint = std::string(Fingerprint());
+    info.timedOutComponents = TimedOutComponents();
+    for (size_t i = 0; i < DiskSerialCount(); i++) {
+        info.diskSerials.emplace_back(DiskSerial(i));
+    }
+    for (size_t i = 0; i < MacAddressCount(); i++) {
+        info.macAddresses.emplace_back(MacAddress(i));
+    }
+    return info;
+}
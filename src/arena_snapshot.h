@@ -0,0 +1,121 @@
+#ifndef ARENA_SNAPSHOT_H
+#define ARENA_SNAPSHOT_H
+
+#include "hardware_info.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+/**
+ * @brief Immutable hardware snapshot stored in a single allocation
+ *
+ * All strings of a snapshot - including every disk serial and MAC address -
+ * live in one bump-allocated block together with their offset/length
+ * table, and are handed out as std::string_view. Building a snapshot costs
+ * one allocation and destroying it one deallocation, which keeps allocator
+ * overhead and fragmentation flat when millions of snapshots are held.
+ *
+ * Block layout:
+ *   Header | Span disks[diskCount] | Span macs[macCount] | string bytes
+ */
+class ArenaSnapshot {
+public:
+    /**
+     * @brief Construct an empty snapshot (no allocation)
+     */
+    ArenaSnapshot();
+
+    /**
+     * @brief Copy a collected snapshot into a single arena block
+     * @param info Collected hardware identifiers
+     */
+    explicit ArenaSnapshot(const HardwareInfo& info);
+
+    ArenaSnapshot(ArenaSnapshot&& other) noexcept;
+    ArenaSnapshot& operator=(ArenaSnapshot&& other) noexcept;
+    ArenaSnapshot(const ArenaSnapshot& other);
+    ArenaSnapshot& operator=(const ArenaSnapshot& other);
+
+    /**
+     * @brief Check whether the snapshot holds data
+     * @return true if constructed from collected identifiers
+     */
+    bool IsEmpty() const;
+
+    std::string_view CpuId() const;
+    std::string_view MotherboardSerial() const;
+    std::string_view BiosSerial() const;
+    std::string_view Fingerprint() const;
+
+    /**
+     * @brief Get the number of disk serials
+     */
+    size_t DiskSerialCount() const;
+
+    /**
+     * @brief Get a disk serial
+     * @param index Index below DiskSerialCount()
+     */
+    std::string_view DiskSerial(size_t index) const;
+
+    /**
+     * @brief Get the number of MAC addresses
+     */
+    size_t MacAddressCount() const;
+
+    /**
+     * @brief Get a MAC address
+     * @param index Index below MacAddressCount()
+     */
+    std::string_view MacAddress(size_t index) const;
+
+    /**
+     * @brief Get the components abandoned by the watchdog
+     * @return ComponentBit mask
+     */
+    uint32_t TimedOutComponents() const;
+
+    /**
+     * @brief Get the size of the arena block
+     * @return Allocated bytes, 0 for an empty snapshot
+     */
+    size_t AllocatedBytes() const;
+
+    /**
+     * @brief Expand into separately allocated strings
+     * @return Equivalent HardwareInfo
+     */
+    HardwareInfo ToHardwareInfo() const;
+
+private:
+    struct Span {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    enum ScalarField : uint32_t {
+        kFieldCpuId = 0,
+        kFieldMotherboardSerial,
+        kFieldBiosSerial,
+        kFieldFingerprint,
+        kScalarFieldCount
+    };
+
+    struct Header {
+        uint32_t blockSize;
+        uint32_t timedOutComponents;
+        uint32_t diskCount;
+        uint32_t macCount;
+        Span scalars[kScalarFieldCount];
+    };
+
+    const Header* GetHeader() const;
+    std::string_view View(const Span& span) const;
+    const Span* DiskSpans() const;
+    const Span* MacSpans() const;
+
+    std::unique_ptr<char[]> m_block;
+};
+
+#endif // ARENA_SNAPSHOT_H
@@ -0,0 +1,233 @@
+#include "attestation_token.h"
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Tokens verified per multi-buffer pass
+ */
+static constexpr size_t kVerifyBatch = 64;
+
+static void StoreLittleEndian(uint8_t* p, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static uint64_t LoadLittleEndian(const uint8_t* p, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Fill the length field of a final SHA-256 block
+ */
+static void StoreBitLength(uint8_t* block, uint64_t bytes) {
+    uint64_t bits = bytes * 8;
+    for (int i = 0; i < 8; i++) {
+        block[kSha256BlockSize - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+/**
+ * @brief Check the fixed fields of a token
+ */
+static bool IsWellFormed(const uint8_t* token) {
+    if (token[0] != kAttestationTokenVersion || token[3] != 0 ||
+        (token[1] & ~kAllHardwareComponents) != 0 || token[2] > kAttestationMaxFingerprint) {
+        return false;
+    }
+    // Padding after the fingerprint must be zero so each token has one encoding
+    uint8_t padding = 0;
+    for (size_t i = 32 + token[2]; i < kAttestationComponentDigestOffset; i++) {
+        padding |= token[i];
+    }
+    return padding == 0;
+}
+
+/**
+ * @brief Constructor
+ */
+HmacSha256Key::HmacSha256Key(const void* key, size_t size) {
+    uint8_t block[kSha256BlockSize] = {};
+    if (size > kSha256BlockSize) {
+        Sha256Digest(key, size, block);
+    } else if (size > 0) {
+        memcpy(block, key, size);
+    }
+
+    uint8_t pad[kSha256BlockSize];
+    for (size_t i = 0; i < kSha256BlockSize; i++) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    m_inner.Update(pad, sizeof(pad));
+    for (size_t i = 0; i < kSha256BlockSize; i++) {
+        pad[i] = block[i] ^ 0x5c;
+    }
+    m_outer.Update(pad, sizeof(pad));
+}
+
+/**
+ * @brief Compute the HMAC of a message
+ */
+void HmacSha256Key::Sign(const void* data, size_t size, uint8_t* mac) const {
+    uint8_t innerDigest[kSha256DigestSize];
+    Sha256 inner = m_inner;
+    inner.Update(data, size);
+    inner.Final(innerDigest);
+    Sha256 outer = m_outer;
+    outer.Update(innerDigest, sizeof(innerDigest));
+    outer.Final(mac);
+}
+
+/**
+ * @brief Get the state after the inner padded key block
+ */
+const Sha256State& HmacSha256Key::InnerState() const {
+    return m_inner.State();
+}
+
+/**
+ * @brief Get the state after the outer padded key block
+ */
+const Sha256State& HmacSha256Key::OuterState() const {
+    return m_outer.State();
+}
+
+/**
+ * @brief Fill the fingerprint and component digests of claims from a snapshot
+ */
+void SetAttestationHardware(const HardwareInfo& info, AttestationClaims& claims) {
+    claims.fingerprint = info.fingerprint;
+    claims.components = 0;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        Sha256 hasher;
+        bool present = false;
+        auto add = [&](const std::string& value) {
+            if (present) {
+                hasher.Update("\n", 1);
+            }
+            hasher.Update(value.data(), value.size());
+            present = true;
+        };
+        VisitComponent(component, info, [&add](const auto& value) {
+            if constexpr (std::is_same<std::decay_t<decltype(value)>, ComponentList>::value) {
+                for (const std::string& entry : value) {
+                    add(entry);
+                }
+            } else if (!value.empty()) {
+                add(value);
+            }
+        });
+
+        uint8_t digest[kSha256DigestSize] = {};
+        if (present) {
+            hasher.Final(digest);
+            claims.components |= ComponentBit(component);
+        }
+        memcpy(claims.componentDigests[i], digest, kAttestationComponentDigestSize);
+    }
+}
+
+/**
+ * @brief Serialize and sign an attestation token
+ */
+bool EncodeAttestationToken(const AttestationClaims& claims, const HmacSha256Key& key, uint8_t* token) {
+    if (claims.fingerprint.size() > kAttestationMaxFingerprint) {
+        return false;
+    }
+    memset(token, 0, kAttestationTokenSize);
+    token[0] = kAttestationTokenVersion;
+    token[1] = static_cast<uint8_t>(claims.components & kAllHardwareComponents);
+    token[2] = static_cast<uint8_t>(claims.fingerprint.size());
+    StoreLittleEndian(token + 4, claims.keyId, 4);
+    StoreLittleEndian(token + 8, static_cast<uint64_t>(claims.issuedAtMs), 8);
+    memcpy(token + 16, claims.nonce, kAttestationNonceSize);
+    memcpy(token + 32, claims.fingerprint.data(), claims.fingerprint.size());
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        if (claims.components & ComponentBit(static_cast<HardwareComponent>(i))) {
+            memcpy(token + kAttestationComponentDigestOffset + i * kAttestationComponentDigestSize, claims.componentDigests[i],
+                   kAttestationComponentDigestSize);
+        }
+    }
+    key.Sign(token, kAttestationSignedSize, token + kAttestationSignedSize);
+    return true;
+}
+
+/**
+ * @brief Read the claims of a token without checking its signature
+ */
+bool DecodeAttestationToken(const uint8_t* token, size_t size, AttestationClaims& claims) {
+    if (size != kAttestationTokenSize || !IsWellFormed(token)) {
+        return false;
+    }
+    claims.components = token[1];
+    claims.keyId = static_cast<uint32_t>(LoadLittleEndian(token + 4, 4));
+    claims.issuedAtMs = static_cast<int64_t>(LoadLittleEndian(token + 8, 8));
+    memcpy(claims.nonce, token + 16, kAttestationNonceSize);
+    claims.fingerprint.assign(reinterpret_cast<const char*>(token + 32), token[2]);
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        memcpy(claims.componentDigests[i], token + kAttestationComponentDigestOffset + i * kAttestationComponentDigestSize,
+               kAttestationComponentDigestSize);
+    }
+    return true;
+}
+
+/**
+ * @brief Verify the signatures of many tokens at once
+ */
+void VerifyAttestationTokens(const HmacSha256Key& key, const uint8_t* const* tokens, size_t count, uint8_t* valid) {
+    // The signed part is two full blocks and a 48-byte tail after the key block
+    static_assert(kAttestationSignedSize == 2 * kSha256BlockSize + 48, "token layout changed");
+    Sha256State states[kVerifyBatch];
+    const uint8_t* blocks[kVerifyBatch];
+    uint8_t finalBlocks[kVerifyBatch][kSha256BlockSize];
+
+    for (size_t first = 0; first < count; first += kVerifyBatch) {
+        size_t lanes = count - first < kVerifyBatch ? count - first : kVerifyBatch;
+        const uint8_t* const* batch = tokens + first;
+
+        for (size_t i = 0; i < lanes; i++) {
+            states[i] = key.InnerState();
+            blocks[i] = batch[i];
+        }
+        Sha256CompressBatch(states, blocks, lanes);
+        for (size_t i = 0; i < lanes; i++) {
+            blocks[i] = batch[i] + kSha256BlockSize;
+        }
+        Sha256CompressBatch(states, blocks, lanes);
+        for (size_t i = 0; i < lanes; i++) {
+            uint8_t* block = finalBlocks[i];
+            memcpy(block, batch[i] + 2 * kSha256BlockSize, 48);
+            block[48] = 0x80;
+            memset(block + 49, 0, kSha256BlockSize - 49);
+            StoreBitLength(block, kSha256BlockSize + kAttestationSignedSize);
+            blocks[i] = block;
+        }
+        Sha256CompressBatch(states, blocks, lanes);
+
+        // Outer hash: the inner digest padded to one block
+        for (size_t i = 0; i < lanes; i++) {
+            uint8_t* block = finalBlocks[i];
+            Sha256StoreDigest(states[i], block);
+            block[kSha256DigestSize] = 0x80;
+            memset(block + kSha256DigestSize + 1, 0, kSha256BlockSize - kSha256DigestSize - 1);
+            StoreBitLength(block, kSha256BlockSize + kSha256DigestSize);
+            states[i] = key.OuterState();
+        }
+        Sha256CompressBatch(states, blocks, lanes);
+
+        for (size_t i = 0; i < lanes; i++) {
+            uint8_t mac[kSha256DigestSize];
+            Sha256StoreDigest(states[i], mac);
+            uint8_t difference = 0;
+            for (size_t j = 0; j < kSha256DigestSize; j++) {
+                difference |= mac[j] ^ batch[i][kAttestationSignedSize + j];
+            }
+            valid[first + i] = (difference == 0 && IsWellFormed(batch[i])) ? 1 : 0;
+        }
+    }
+}
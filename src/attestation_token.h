@@ -0,0 +1,130 @@
+#ifndef ATTESTATION_TOKEN_H
+#define ATTESTATION_TOKEN_H
+
+#include "hardware_info.h"
+#include "sha256.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Attestation token layout
+ *
+ * Tokens are fixed-size, so a batch of them shares one block schedule:
+ *
+ *   offset  size  field
+ *   0       1     version (kAttestationTokenVersion)
+ *   1       1     ComponentBit mask of the components that had a value
+ *   2       1     fingerprint length
+ *   3       1     reserved, zero
+ *   4       4     key identifier, little-endian
+ *   8       8     issue time in milliseconds since the epoch, little-endian
+ *   16      16    nonce
+ *   32      64    fingerprint, zero-padded
+ *   96      80    per component, the first 16 bytes of the SHA-256 of its
+ *                 value (list entries joined with '\n'), zero if absent
+ *   176     32    HMAC-SHA256 of bytes 0-175
+ */
+constexpr uint8_t kAttestationTokenVersion = 1;
+constexpr size_t kAttestationTokenSize = 208;
+constexpr size_t kAttestationSignedSize = 176;
+constexpr size_t kAttestationNonceSize = 16;
+constexpr size_t kAttestationMaxFingerprint = 64;
+constexpr size_t kAttestationComponentDigestSize = 16;
+constexpr size_t kAttestationComponentDigestOffset = 96;
+
+// The component mask is one byte and the digests end where the signature starts
+static_assert(kHardwareComponentCount <= 8, "attestation component mask is one byte");
+static_assert(kAttestationComponentDigestOffset + kHardwareComponentCount * kAttestationComponentDigestSize ==
+              kAttestationSignedSize, "attestation token layout assumes 5 hardware components");
+
+/**
+ * @brief Claims carried by an attestation token
+ */
+struct AttestationClaims {
+    uint32_t keyId = 0;
+    int64_t issuedAtMs = 0;
+    uint8_t nonce[kAttestationNonceSize] = {};
+    std::string fingerprint;
+    uint32_t components = 0;    // ComponentBit mask of digested components
+    uint8_t componentDigests[kHardwareComponentCount][kAttestationComponentDigestSize] = {};
+};
+
+/**
+ * @brief HMAC-SHA256 key with its padded inner and outer blocks pre-hashed
+ *
+ * Signing or verifying then costs the message blocks plus one block.
+ */
+class HmacSha256Key {
+public:
+    /**
+     * @brief Constructor
+     * @param key Key bytes; keys longer than a block are hashed first
+     * @param size Number of key bytes
+     */
+    HmacSha256Key(const void* key, size_t size);
+
+    /**
+     * @brief Compute the HMAC of a message
+     * @param data Message bytes
+     * @param size Number of bytes
+     * @param mac Receives kSha256DigestSize bytes
+     */
+    void Sign(const void* data, size_t size, uint8_t* mac) const;
+
+    /**
+     * @brief Get the state after the inner padded key block
+     */
+    const Sha256State& InnerState() const;
+
+    /**
+     * @brief Get the state after the outer padded key block
+     */
+    const Sha256State& OuterState() const;
+
+private:
+    Sha256 m_inner;
+    Sha256 m_outer;
+};
+
+/**
+ * @brief Fill the fingerprint and component digests of claims from a snapshot
+ * @param info Collected identifiers
+ * @param claims Receives the fingerprint, component mask and digests
+ */
+void SetAttestationHardware(const HardwareInfo& info, AttestationClaims& claims);
+
+/**
+ * @brief Serialize and sign an attestation token
+ * @param claims Token claims
+ * @param key Signing key
+ * @param token Receives kAttestationTokenSize bytes
+ * @return false if the fingerprint is longer than kAttestationMaxFingerprint
+ */
+bool EncodeAttestationToken(const AttestationClaims& claims, const HmacSha256Key& key, uint8_t* token);
+
+/**
+ * @brief Read the claims of a token without checking its signature
+ * @param token Token bytes
+ * @param size Number of bytes
+ * @param claims Receives the claims
+ * @return false if the token is not a well-formed version 1 token
+ */
+bool DecodeAttestationToken(const uint8_t* token, size_t size, AttestationClaims& claims);
+
+/**
+ * @brief Verify the signatures of many tokens at once
+ *
+ * The three inner and one outer HMAC blocks of every token are hashed
+ * with the multi-buffer SHA-256 kernel, so tokens are verified in lanes
+ * rather than one message at a time. Signatures are compared in
+ * constant time.
+ *
+ * @param key Verification key
+ * @param tokens Pointer to the kAttestationTokenSize bytes of each token
+ * @param count Number of tokens
+ * @param valid Receives 1 for each well-formed, correctly signed token, else 0
+ */
+void VerifyAttestationTokens(const HmacSha256Key& key, const uint8_t* const* tokens, size_t count, uint8_t* valid);
+
+#endif // ATTESTATION_TOKEN_H
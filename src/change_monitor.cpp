@@ -0,0 +1,400 @@
+#include "change_monitor.h"
+#include <uv.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2ipdef.h>
+#include <iphlpapi.h>
+#include <cfgmgr32.h>
+#include <initguid.h>
+#include <ntddstor.h>
+#else
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// A continuous stream of notifications is flushed after this many debounce periods
+static const uint64_t kMaxDebounceFactor = 4;
+
+/**
+ * @brief Monitor state shared with libuv handles and system callbacks
+ *
+ * Lives on the heap so it can outlive ChangeMonitor::Stop() until libuv has
+ * finished closing every handle.
+ */
+struct ChangeMonitor::State {
+    uv_loop_t* loop;
+    uint32_t debounceMs;
+    Listener listener;
+    uv_timer_t debounceTimer;
+    uint32_t pendingSources;
+    bool burstActive;
+    uint64_t burstStartedAt;
+    int openHandles;
+#ifdef _WIN32
+    uv_async_t wakeup;
+    std::atomic<uint32_t> signaledSources;
+    HANDLE ipNotification;
+    HCMNOTIFICATION deviceNotification;
+#else
+    int ueventFd;
+    int routeFd;
+    uv_poll_t ueventPoll;
+    uv_poll_t routePoll;
+#endif
+};
+
+/**
+ * @brief Debounce timer expiry - deliver the coalesced sources
+ */
+static void OnDebounceTimer(uv_timer_t* handle) {
+    ChangeMonitor::State* state = static_cast<ChangeMonitor::State*>(handle->data);
+    uint32_t sources = state->pendingSources;
+    state->pendingSources = 0;
+    state->burstActive = false;
+
+    // The listener may stop the monitor; state stays valid until handles close
+    if (sources != 0 && state->listener) {
+        state->listener(sources);
+    }
+}
+
+/**
+ * @brief (Re)arm the debounce timer for the current burst
+ */
+static void ArmDebounceTimer(ChangeMonitor::State* state) {
+    uint64_t now = uv_now(state->loop);
+
+    // Trailing debounce, bounded so a chatty source cannot postpone delivery forever
+    uint64_t deadline = state->burstStartedAt + state->debounceMs * kMaxDebounceFactor;
+    uint64_t remaining = deadline > now ? deadline - now : 0;
+    uint64_t delay = std::min<uint64_t>(state->debounceMs, remaining);
+    uv_timer_start(&state->debounceTimer, OnDebounceTimer, delay, 0);
+}
+
+/**
+ * @brief Record change sources on the loop thread and (re)arm the debounce timer
+ */
+static void QueueChange(ChangeMonitor::State* state, uint32_t sources) {
+    if (sources == 0) {
+        return;
+    }
+
+    if (!state->burstActive) {
+        state->burstActive = true;
+        state->burstStartedAt = uv_now(state->loop);
+    }
+    state->pendingSources |= sources;
+    ArmDebounceTimer(state);
+}
+
+/**
+ * @brief Close callback - free the state once every handle is closed
+ */
+static void OnHandleClosed(uv_handle_t* handle) {
+    ChangeMonitor::State* state = static_cast<ChangeMonitor::State*>(handle->data);
+#ifndef _WIN32
+    if (handle == reinterpret_cast<uv_handle_t*>(&state->ueventPoll)) {
+        close(state->ueventFd);
+    } else if (handle == reinterpret_cast<uv_handle_t*>(&state->routePoll)) {
+        close(state->routeFd);
+    }
+#endif
+    if (--state->openHandles == 0) {
+        delete state;
+    }
+}
+
+#ifdef _WIN32
+
+/**
+ * @brief Forward a system-pool notification to the loop thread
+ */
+static void SignalChange(ChangeMonitor::State* state, uint32_t sources) {
+    state->signaledSources.fetch_or(sources);
+    uv_async_send(&state->wakeup);
+}
+
+/**
+ * @brief Loop-thread side of SignalChange()
+ */
+static void OnWakeup(uv_async_t* handle) {
+    ChangeMonitor::State* state = static_cast<ChangeMonitor::State*>(handle->data);
+    QueueChange(state, state->signaledSources.exchange(0));
+}
+
+/**
+ * @brief IP interface change notification (system thread pool)
+ */
+static VOID NETIOAPI_API_ OnIpInterfaceChange(PVOID context,
+                                              PMIB_IPINTERFACE_ROW row,
+                                              MIB_NOTIFICATION_TYPE notificationType) {
+    if (notificationType != MibInitialNotification) {
+        SignalChange(static_cast<ChangeMonitor::State*>(context), kChangeSourceNetwork);
+    }
+}
+
+/**
+ * @brief Disk interface arrival/removal notification (system thread pool)
+ */
+static DWORD CALLBACK OnDeviceNotification(HCMNOTIFICATION notification,
+                                           PVOID context,
+                                           CM_NOTIFY_ACTION action,
+                                           PCM_NOTIFY_EVENT_DATA eventData,
+                                           DWORD eventDataSize) {
+    if (action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL ||
+        action == CM_NOTIFY_ACTION_DEVICEINTERFACEREMOVAL) {
+        SignalChange(static_cast<ChangeMonitor::State*>(context), kChangeSourceDevice);
+    }
+    return ERROR_SUCCESS;
+}
+
+#else
+
+/**
+ * @brief Open a non-blocking netlink socket subscribed to multicast groups
+ * @return Socket descriptor, -1 on failure
+ */
+static int OpenNetlinkSocket(int protocol, uint32_t groups) {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct sockaddr_nl address;
+    memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = groups;
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Classify a kernel uevent by its SUBSYSTEM key
+ * @return ChangeSource bits, 0 for subsystems that carry no identifiers
+ */
+static uint32_t ClassifyUevent(const char* message, size_t length) {
+    // Layout: "action@devpath\0KEY=value\0KEY=value\0..."
+    size_t offset = 0;
+    while (offset < length) {
+        const char* field = message + offset;
+        size_t fieldLength = strnlen(field, length - offset);
+        if (fieldLength > 10 && memcmp(field, "SUBSYSTEM=", 10) == 0) {
+            const char* subsystem = field + 10;
+            if (strcmp(subsystem, "block") == 0) {
+                return kChangeSourceDevice;
+            }
+            if (strcmp(subsystem, "net") == 0) {
+                return kChangeSourceNetwork;
+            }
+            return 0;
+        }
+        offset += fieldLength + 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Uevent socket readable - drain and classify pending messages
+ */
+static void OnUeventReadable(uv_poll_t* handle, int status, int events) {
+    ChangeMonitor::State* state = static_cast<ChangeMonitor::State*>(handle->data);
+    if (status < 0) {
+        return;
+    }
+
+    char buffer[8192];
+    uint32_t sources = 0;
+    ssize_t received;
+    while ((received = recv(state->ueventFd, buffer, sizeof(buffer) - 1, 0)) > 0) {
+        buffer[received] = '\0';
+        sources |= ClassifyUevent(buffer, static_cast<size_t>(received));
+    }
+    QueueChange(state, sources);
+}
+
+/**
+ * @brief Route socket readable - drain link notifications
+ */
+static void OnRouteReadable(uv_poll_t* handle, int status, int events) {
+    ChangeMonitor::State* state = static_cast<ChangeMonitor::State*>(handle->data);
+    if (status < 0) {
+        return;
+    }
+
+    alignas(struct nlmsghdr) char buffer[8192];
+    uint32_t sources = 0;
+    ssize_t received;
+    while ((received = recv(state->routeFd, buffer, sizeof(buffer), 0)) > 0) {
+        int remaining = static_cast<int>(received);
+        for (struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer);
+             NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == RTM_NEWLINK || header->nlmsg_type == RTM_DELLINK) {
+                sources |= kChangeSourceNetwork;
+            }
+        }
+    }
+    QueueChange(state, sources);
+}
+
+#endif
+
+/**
+ * @brief Constructor - Initialize member variables
+ */
+ChangeMonitor::ChangeMonitor()
+    : m_state(nullptr) {
+}
+
+/**
+ * @brief Destructor - Stop monitoring
+ */
+ChangeMonitor::~ChangeMonitor() {
+    Stop();
+}
+
+/**
+ * @brief Start monitoring on the given loop
+ */
+bool ChangeMonitor::Start(uv_loop_t* loop, uint32_t debounceMs, Listener listener) {
+    if (m_state) {
+        SetDebounce(debounceMs);
+        return true;
+    }
+
+    State* state = new State();
+    state->loop = loop;
+    state->debounceMs = debounceMs;
+    state->listener = std::move(listener);
+    state->pendingSources = 0;
+    state->burstActive = false;
+    state->burstStartedAt = 0;
+    state->openHandles = 0;
+
+    uv_timer_init(loop, &state->debounceTimer);
+    state->debounceTimer.data = state;
+    state->openHandles++;
+
+    bool registered = false;
+
+#ifdef _WIN32
+    state->signaledSources = 0;
+    state->ipNotification = NULL;
+    state->deviceNotification = NULL;
+
+    uv_async_init(loop, &state->wakeup, OnWakeup);
+    state->wakeup.data = state;
+    state->openHandles++;
+    // Watching alone must not keep the process alive
+    uv_unref(reinterpret_cast<uv_handle_t*>(&state->wakeup));
+
+    if (NotifyIpInterfaceChange(AF_UNSPEC, OnIpInterfaceChange, state, FALSE,
+                                &state->ipNotification) == NO_ERROR) {
+        registered = true;
+    }
+
+    CM_NOTIFY_FILTER filter;
+    ZeroMemory(&filter, sizeof(filter));
+    filter.cbSize = sizeof(filter);
+    filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+    filter.u.DeviceInterface.ClassGuid = GUID_DEVINTERFACE_DISK;
+    if (CM_Register_Notification(&filter, state, OnDeviceNotification,
+                                 &state->deviceNotification) == CR_SUCCESS) {
+        registered = true;
+    }
+#else
+    state->ueventFd = OpenNetlinkSocket(NETLINK_KOBJECT_UEVENT, 1);
+    if (state->ueventFd >= 0) {
+        uv_poll_init(loop, &state->ueventPoll, state->ueventFd);
+        state->ueventPoll.data = state;
+        state->openHandles++;
+        uv_unref(reinterpret_cast<uv_handle_t*>(&state->ueventPoll));
+        uv_poll_start(&state->ueventPoll, UV_READABLE, OnUeventReadable);
+        registered = true;
+    }
+
+    state->routeFd = OpenNetlinkSocket(NETLINK_ROUTE, RTMGRP_LINK);
+    if (state->routeFd >= 0) {
+        uv_poll_init(loop, &state->routePoll, state->routeFd);
+        state->routePoll.data = state;
+        state->openHandles++;
+        uv_unref(reinterpret_cast<uv_handle_t*>(&state->routePoll));
+        uv_poll_start(&state->routePoll, UV_READABLE, OnRouteReadable);
+        registered = true;
+    }
+#endif
+
+    m_state = state;
+    if (!registered) {
+        Stop();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Change the debounce period of a running monitor
+ */
+void ChangeMonitor::SetDebounce(uint32_t debounceMs) {
+    State* state = m_state;
+    if (!state || state->debounceMs == debounceMs) {
+        return;
+    }
+    state->debounceMs = debounceMs;
+    if (state->burstActive) {
+        ArmDebounceTimer(state);
+    }
+}
+
+/**
+ * @brief Stop monitoring and release all handles
+ */
+void ChangeMonitor::Stop() {
+    State* state = m_state;
+    if (!state) {
+        return;
+    }
+    m_state = nullptr;
+
+#ifdef _WIN32
+    // Both calls wait for callbacks already running on the system pool
+    if (state->ipNotification) {
+        CancelMibChangeNotify2(state->ipNotification);
+        state->ipNotification = NULL;
+    }
+    if (state->deviceNotification) {
+        CM_Unregister_Notification(state->deviceNotification);
+        state->deviceNotification = NULL;
+    }
+    uv_close(reinterpret_cast<uv_handle_t*>(&state->wakeup), OnHandleClosed);
+#else
+    if (state->ueventFd >= 0) {
+        uv_poll_stop(&state->ueventPoll);
+        uv_close(reinterpret_cast<uv_handle_t*>(&state->ueventPoll), OnHandleClosed);
+    }
+    if (state->routeFd >= 0) {
+        uv_poll_stop(&state->routePoll);
+        uv_close(reinterpret_cast<uv_handle_t*>(&state->routePoll), OnHandleClosed);
+    }
+#endif
+
+    uv_timer_stop(&state->debounceTimer);
+    uv_close(reinterpret_cast<uv_handle_t*>(&state->debounceTimer), OnHandleClosed);
+}
+
+/**
+ * @brief Check whether the monitor is running
+ */
+bool ChangeMonitor::IsRunning() const {
+    return m_state != nullptr;
+}
@@ -0,0 +1,97 @@
+#ifndef CHANGE_MONITOR_H
+#define CHANGE_MONITOR_H
+
+#include <cstdint>
+#include <functional>
+
+typedef struct uv_loop_s uv_loop_t;
+
+/**
+ * @brief Sources of hardware change notifications
+ *
+ * Values are bits so coalesced notifications can report several sources.
+ */
+enum ChangeSource : uint32_t {
+    kChangeSourceNetwork = 1u << 0,  // Network interface added, removed or re-addressed
+    kChangeSourceDevice = 1u << 1    // Storage or other device arrival/removal
+};
+
+/**
+ * @brief Event-loop integrated hardware change monitor
+ *
+ * Subscribes to operating system change notifications and delivers them on
+ * the libuv loop thread without a dedicated monitoring thread:
+ * - Windows: NotifyIpInterfaceChange and CM_Register_Notification, whose
+ *   system-pool callbacks wake the loop through a uv_async_t
+ * - Linux: netlink uevent and route sockets registered with uv_poll
+ *
+ * Bursts of notifications are coalesced and debounced, so the listener
+ * sees one call per settled change with the union of all sources.
+ */
+class ChangeMonitor {
+public:
+    /**
+     * @brief Listener invoked on the loop thread with a mask of ChangeSource bits
+     */
+    using Listener = std::function<void(uint32_t sources)>;
+
+    /**
+     * @brief Opaque monitor state shared with libuv and system callbacks
+     */
+    struct State;
+
+    /**
+     * @brief Construct an idle change monitor
+     */
+    ChangeMonitor();
+
+    /**
+     * @brief Destroy the change monitor, stopping it if running
+     */
+    ~ChangeMonitor();
+
+    ChangeMonitor(const ChangeMonitor&) = delete;
+    ChangeMonitor& operator=(const ChangeMonitor&) = delete;
+
+    /**
+     * @brief Start monitoring on the given loop
+     *
+     * The notification handles do not keep the loop alive. If the monitor
+     * is already running only the debounce period is changed, as by
+     * SetDebounce(); the listener is kept.
+     *
+     * @param loop libuv loop that will run the listener (must be the calling thread's loop)
+     * @param debounceMs Quiet period after the last notification before the listener runs
+     * @param listener Listener receiving coalesced change sources
+     * @return true if at least one notification source was registered
+     */
+    bool Start(uv_loop_t* loop, uint32_t debounceMs, Listener listener);
+
+    /**
+     * @brief Change the debounce period of a running monitor
+     *
+     * Must be called on the loop thread. A pending burst is rescheduled
+     * with the new period; notifications are not dropped.
+     *
+     * @param debounceMs Quiet period after the last notification before the listener runs
+     */
+    void SetDebounce(uint32_t debounceMs);
+
+    /**
+     * @brief Stop monitoring and release all handles
+     *
+     * Must be called on the loop thread. Pending notifications are dropped.
+     */
+    void Stop();
+
+    /**
+     * @brief Check whether the monitor is running
+     * @return true if started and not stopped
+     */
+    bool IsRunning() const;
+
+private:
+    State* m_state;  // Owned until its libuv handles finish closing
+};
+
+#endif // CHANGE_MONITOR_H
@@ -0,0 +1,196 @@
+#include "collection_scheduler.h"
+#include "hardware_identifier.h"
+#include <algorithm>
+
+/**
+ * @brief Elapsed microseconds between two time points
+ */
+static uint64_t ElapsedMicros(std::chrono::steady_clock::time_point from,
+                              std::chrono::steady_clock::time_point to) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+}
+
+/**
+ * @brief Constructor - Start the worker thread
+ */
+CollectionScheduler::CollectionScheduler(std::shared_ptr<HardwareIdentifier> identifier)
+    : m_identifier(std::move(identifier))
+    , m_stopping(false) {
+    m_worker = std::thread(&CollectionScheduler::WorkerLoop, this);
+}
+
+/**
+ * @brief Destructor - Stop the worker thread
+ */
+CollectionScheduler::~CollectionScheduler() {
+    Shutdown();
+}
+
+/**
+ * @brief Queue a full hardware collection
+ */
+bool CollectionScheduler::Submit(CollectionPriority priority, const CollectionOptions& options, Completion done) {
+    uint32_t index = std::min(static_cast<uint32_t>(priority), kCollectionPriorityCount - 1);
+
+    std::unique_ptr<Job> job(new Job());
+    job->priority = static_cast<CollectionPriority>(index);
+    job->options = options;
+    job->nextComponent = 0;
+    job->started = false;
+    job->submittedAt = Clock::now();
+    job->done = std::move(done);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return false;
+        }
+        m_queues[index].push_back(std::move(job));
+        m_stats.priorities[index].submitted++;
+    }
+
+    m_wakeup.notify_one();
+    return true;
+}
+
+/**
+ * @brief Stop the worker thread and fail all queued requests
+ */
+void CollectionScheduler::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+
+    // Fail whatever is left without holding the lock, completions may re-enter
+    std::deque<std::unique_ptr<Job>> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (uint32_t i = 0; i < kCollectionPriorityCount; i++) {
+            for (auto& job : m_queues[i]) {
+                abandoned.push_back(std::move(job));
+            }
+            m_queues[i].clear();
+        }
+    }
+
+    for (auto& job : abandoned) {
+        job->done(std::move(job->info), false);
+    }
+}
+
+/**
+ * @brief Get a copy of the scheduler counters
+ */
+CollectionSchedulerStats CollectionScheduler::GetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CollectionSchedulerStats stats = m_stats;
+    stats.queued = 0;
+    for (uint32_t i = 0; i < kCollectionPriorityCount; i++) {
+        stats.queued += static_cast<uint32_t>(m_queues[i].size());
+    }
+    return stats;
+}
+
+/**
+ * @brief Pop the next job to advance
+ */
+std::unique_ptr<CollectionScheduler::Job> CollectionScheduler::PopNextJob() {
+    for (uint32_t i = 0; i < kCollectionPriorityCount; i++) {
+        if (!m_queues[i].empty()) {
+            std::unique_ptr<Job> job = std::move(m_queues[i].front());
+            m_queues[i].pop_front();
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Record completion counters for a finished job
+ */
+void CollectionScheduler::RecordCompletion(const Job& job) {
+    CollectionPriorityStats& stats = m_stats.priorities[static_cast<uint32_t>(job.priority)];
+    uint64_t runMicros = ElapsedMicros(job.submittedAt, Clock::now());
+    stats.completed++;
+    stats.totalRunMicros += runMicros;
+    stats.maxRunMicros = std::max(stats.maxRunMicros, runMicros);
+}
+
+/**
+ * @brief Worker thread main loop
+ *
+ * Each iteration advances the highest priority job by exactly one component.
+ * A job that still has components left goes back to the front of its queue,
+ * so it resumes next unless a higher priority request arrived meanwhile.
+ */
+void CollectionScheduler::WorkerLoop() {
+    bool threadInitialized = HardwareIdentifier::InitializeWorkerThread();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        std::unique_ptr<Job> job;
+        m_wakeup.wait(lock, [this, &job] {
+            if (m_stopping) {
+                return true;
+            }
+            job = PopNextJob();
+            return job != nullptr;
+        });
+
+        if (m_stopping) {
+            // Put the popped job back so Shutdown() can fail it
+            if (job) {
+                m_queues[static_cast<uint32_t>(job->priority)].push_front(std::move(job));
+            }
+            break;
+        }
+
+        if (!job->started) {
+            CollectionPriorityStats& stats = m_stats.priorities[static_cast<uint32_t>(job->priority)];
+            uint64_t waitMicros = ElapsedMicros(job->submittedAt, Clock::now());
+            stats.totalWaitMicros += waitMicros;
+            stats.maxWaitMicros = std::max(stats.maxWaitMicros, waitMicros);
+            job->started = true;
+        }
+
+        lock.unlock();
+        m_identifier->CollectComponent(static_cast<HardwareComponent>(job->nextComponent), job->info,
+                                       job->options.componentTimeoutMs);
+        job->nextComponent++;
+
+        if (job->nextComponent == kHardwareComponentCount) {
+            ApplyFingerprintProfile(job->info, job->options.requiredComponents);
+            lock.lock();
+            RecordCompletion(*job);
+            lock.unlock();
+
+            job->done(std::move(job->info), true);
+            lock.lock();
+            continue;
+        }
+
+        lock.lock();
+
+        // Preemption point between components
+        uint32_t index = static_cast<uint32_t>(job->priority);
+        for (uint32_t i = 0; i < index; i++) {
+            if (!m_queues[i].empty()) {
+                m_stats.preemptions++;
+                break;
+            }
+        }
+        m_queues[index].push_front(std::move(job));
+    }
+    lock.unlock();
+
+    if (threadInitialized) {
+        HardwareIdentifier::UninitializeWorkerThread();
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef COLLECTION_SCHEDULER_H
+#define COLLECTION_SCHEDULER_H
+
+#include "hardware_info.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class HardwareIdentifier;
+
+/**
+ * @brief Priority class of a collection request
+ *
+ * Lower values are served first.
+ */
+enum class CollectionPriority : uint32_t {
+    Interactive = 0,
+    Normal,
+    Background,
+    Count
+};
+
+/**
+ * @brief Number of collection priority classes
+ */
+constexpr uint32_t kCollectionPriorityCount = static_cast<uint32_t>(CollectionPriority::Count);
+
+/**
+ * @brief Per-priority counters reported by CollectionScheduler
+ */
+struct CollectionPriorityStats {
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t totalWaitMicros = 0;  // Time from submit until first component started
+    uint64_t maxWaitMicros = 0;
+    uint64_t totalRunMicros = 0;   // Time from submit until completion
+    uint64_t maxRunMicros = 0;
+};
+
+/**
+ * @brief Snapshot of scheduler counters
+ */
+struct CollectionSchedulerStats {
+    CollectionPriorityStats priorities[kCollectionPriorityCount];
+    uint64_t preemptions = 0;      // Times a partially collected job yielded to a higher priority one
+    uint32_t queued = 0;
+};
+
+/**
+ * @brief Prioritized, preemptible hardware collection scheduler
+ *
+ * Collection requests are queued by priority class and served by a single
+ * worker thread, one component at a time. Between components the worker
+ * re-checks the queues, so an interactive request waits for at most one
+ * in-flight component collection of a running background refresh instead
+ * of the whole refresh.
+ */
+class CollectionScheduler {
+public:
+    /**
+     * @brief Callback invoked on the worker thread when a request finishes
+     * @param info Collected snapshot including fingerprint
+     * @param success false if the scheduler shut down before collection completed
+     */
+    using Completion = std::function<void(HardwareInfo&& info, bool success)>;
+
+    /**
+     * @brief Construct a scheduler for the given hardware identifier
+     * @param identifier Initialized hardware identifier shared with the caller
+     */
+    explicit CollectionScheduler(std::shared_ptr<HardwareIdentifier> identifier);
+
+    /**
+     * @brief Destroy the scheduler, failing any requests still queued
+     */
+    ~CollectionScheduler();
+
+    CollectionScheduler(const CollectionScheduler&) = delete;
+    CollectionScheduler& operator=(const CollectionScheduler&) = delete;
+
+    /**
+     * @brief Queue a full hardware collection
+     * @param priority Priority class of the request
+     * @param options Watchdog deadline and fingerprint profile
+     * @param done Completion callback, invoked on the worker thread
+     * @return true if queued, false if the scheduler is shutting down
+     */
+    bool Submit(CollectionPriority priority, const CollectionOptions& options, Completion done);
+
+    /**
+     * @brief Stop the worker thread and fail all queued requests
+     *
+     * Waits for the component currently being collected, if any.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Get a copy of the scheduler counters
+     * @return Scheduler statistics
+     */
+    CollectionSchedulerStats GetStats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        CollectionPriority priority;
+        CollectionOptions options;
+        uint32_t nextComponent;
+        bool started;
+        Clock::time_point submittedAt;
+        HardwareInfo info;
+        Completion done;
+    };
+
+    /**
+     * @brief Worker thread main loop
+     */
+    void WorkerLoop();
+
+    /**
+     * @brief Pop the next job to advance (caller holds m_mutex)
+     * @return Highest priority job, nullptr if all queues are empty
+     */
+    std::unique_ptr<Job> PopNextJob();
+
+    /**
+     * @brief Record completion counters for a finished job (caller holds m_mutex)
+     */
+    void RecordCompletion(const Job& job);
+
+    std::shared_ptr<HardwareIdentifier> m_identifier;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::deque<std::unique_ptr<Job>> m_queues[kCollectionPriorityCount];
+    CollectionSchedulerStats m_stats;
+    bool m_stopping;
+    std::thread m_worker;
+};
+
+#endif // COLLECTION_SCHEDULER_H
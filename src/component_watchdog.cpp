@@ -0,0 +1,288 @@
+#include "component_watchdog.h"
+#include "hardware_identifier.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Upper bound on threads that may be stuck in abandoned tasks at once
+static const uint32_t kMaxStuckThreads = 8;
+
+// Idle period after which a worker thread exits
+static const std::chrono::seconds kIdleThreadTimeout(60);
+
+/**
+ * @brief Completion state of one task, shared by the waiter and the worker
+ */
+struct ComponentWatchdog::TaskState {
+    std::function<void()> task;
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    bool failed = false;
+    bool abandoned = false;
+    bool orphaned = false;  // Counted as stuck because its parent was abandoned
+    std::shared_ptr<ComponentWatchdog::TaskState> parent;  // Task that queued this one, if any
+    std::vector<std::weak_ptr<ComponentWatchdog::TaskState>> children;
+};
+
+// Task running on the current watchdog thread, parent of the tasks it posts
+static thread_local std::shared_ptr<ComponentWatchdog::TaskState> t_runningTask;
+
+/**
+ * @brief Watchdog state shared with its detached worker threads
+ */
+struct ComponentWatchdog::Shared {
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<std::shared_ptr<ComponentWatchdog::TaskState>> pending;
+    uint32_t threads = 0;
+    uint32_t idleThreads = 0;
+    ComponentWatchdogStats stats;
+};
+
+/**
+ * @brief Check whether nobody waits for a task any more (caller holds shared->mutex)
+ */
+static bool IsAbandoned(const ComponentWatchdog::TaskState& state) {
+    return state.abandoned || state.orphaned;
+}
+
+/**
+ * @brief Worker thread main loop
+ */
+static void WatchdogWorker(ComponentWatchdog::Shared* shared) {
+    bool threadInitialized = HardwareIdentifier::InitializeWorkerThread();
+
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    while (true) {
+        shared->idleThreads++;
+        bool hasTask = shared->available.wait_for(lock, kIdleThreadTimeout,
+                                                  [shared] { return !shared->pending.empty(); });
+        shared->idleThreads--;
+        if (!hasTask) {
+            break;
+        }
+
+        std::shared_ptr<ComponentWatchdog::TaskState> state = shared->pending.front();
+        shared->pending.pop_front();
+        if (state->parent && IsAbandoned(*state->parent)) {
+            std::lock_guard<std::mutex> taskLock(state->mutex);
+            state->orphaned = true;
+            shared->stats.stuckThreads++;
+        }
+        lock.unlock();
+
+        // An exception must not escape the thread; the waiter sees a failed task
+        bool failed = false;
+        t_runningTask = state;
+        try {
+            state->task();
+        } catch (...) {
+            failed = true;
+        }
+        t_runningTask.reset();
+
+        lock.lock();
+        {
+            std::lock_guard<std::mutex> taskLock(state->mutex);
+            state->done = true;
+            state->failed = failed;
+            if (IsAbandoned(*state)) {
+                shared->stats.stuckThreads--;
+            }
+        }
+        state->finished.notify_one();
+    }
+
+    // Idle since the timeout; decided under the lock, so EnqueueTask no longer counts this thread
+    shared->threads--;
+    shared->stats.threads = shared->threads;
+    lock.unlock();
+
+    if (threadInitialized) {
+        HardwareIdentifier::UninitializeWorkerThread();
+    }
+}
+
+/**
+ * @brief Queue a task and start a thread if none is idle (caller holds shared->mutex)
+ *
+ * A task queued from a watchdog thread becomes a child of the task running
+ * there, so abandoning that task also counts the child's thread as stuck.
+ */
+static void EnqueueTask(ComponentWatchdog::Shared* shared, const std::shared_ptr<ComponentWatchdog::TaskState>& state) {
+    if (t_runningTask) {
+        state->parent = t_runningTask;
+        std::vector<std::weak_ptr<ComponentWatchdog::TaskState>>& children = t_runningTask->children;
+        children.erase(std::remove_if(children.begin(), children.end(),
+                                      [](const std::weak_ptr<ComponentWatchdog::TaskState>& child) {
+                                          return child.expired();
+                                      }),
+                       children.end());
+        children.push_back(state);
+    }
+    shared->pending.push_back(state);
+    if (shared->idleThreads < shared->pending.size()) {
+        shared->threads++;
+        shared->stats.threads = shared->threads;
+        std::thread(WatchdogWorker, shared).detach();
+    }
+}
+
+/**
+ * @brief Count the running tasks an abandoned task posted as stuck (caller holds shared->mutex)
+ *
+ * Queued ones are left to run, so whatever they settle is not lost; they
+ * are counted when a thread picks them up.
+ */
+static void OrphanChildren(ComponentWatchdog::Shared* shared, const ComponentWatchdog::TaskState& state) {
+    for (const std::weak_ptr<ComponentWatchdog::TaskState>& weakChild : state.children) {
+        std::shared_ptr<ComponentWatchdog::TaskState> child = weakChild.lock();
+        if (!child) {
+            continue;
+        }
+        bool running;
+        {
+            std::lock_guard<std::mutex> taskLock(child->mutex);
+            running = !child->done && !IsAbandoned(*child) &&
+                      std::find(shared->pending.begin(), shared->pending.end(), child) == shared->pending.end();
+            if (running) {
+                child->orphaned = true;
+                shared->stats.stuckThreads++;
+            }
+        }
+        if (running) {
+            OrphanChildren(shared, *child);
+        }
+    }
+}
+
+/**
+ * @brief Mark a task its caller no longer waits for (caller holds shared->mutex and the task mutex)
+ *
+ * A task that has not started is dropped; a running one counts as a stuck
+ * thread until it returns.
+ *
+ * @return true if the task was still queued and has been dropped
+ */
+static bool AbandonTask(ComponentWatchdog::Shared* shared, const std::shared_ptr<ComponentWatchdog::TaskState>& state) {
+    state->abandoned = true;
+    for (auto it = shared->pending.begin(); it != shared->pending.end(); ++it) {
+        if (*it == state) {
+            shared->pending.erase(it);
+            return true;
+        }
+    }
+    shared->stats.stuckThreads++;
+    OrphanChildren(shared, *state);
+    return false;
+}
+
+/**
+ * @brief Get the process-wide watchdog
+ */
+ComponentWatchdog& ComponentWatchdog::Instance() {
+    static ComponentWatchdog* instance = new ComponentWatchdog();
+    return *instance;
+}
+
+/**
+ * @brief Constructor - Create the shared state
+ */
+ComponentWatchdog::ComponentWatchdog()
+    : m_shared(new Shared()) {
+}
+
+
+/**
+ * @brief Start a task on a watchdog thread without waiting for it
+ */
+bool ComponentWatchdog::Post(std::function<void()> task, Ticket* ticket) {
+    std::shared_ptr<ComponentWatchdog::TaskState> state = std::make_shared<ComponentWatchdog::TaskState>();
+    state->task = std::move(task);
+
+    {
+        std::lock_guard<std::mutex> lock(m_shared->mutex);
+        if (m_shared->stats.stuckThreads >= kMaxStuckThreads) {
+            m_shared->stats.rejected++;
+            return false;
+        }
+        EnqueueTask(m_shared, state);
+    }
+    m_shared->available.notify_one();
+    if (ticket) {
+        *ticket = state;
+    }
+    return true;
+}
+
+/**
+ * @brief Run a task and wait at most until its deadline
+ */
+bool ComponentWatchdog::RunWithDeadline(std::function<void()> task, std::chrono::milliseconds timeout) {
+    std::shared_ptr<ComponentWatchdog::TaskState> state = std::make_shared<ComponentWatchdog::TaskState>();
+    state->task = std::move(task);
+
+    {
+        std::lock_guard<std::mutex> lock(m_shared->mutex);
+        if (m_shared->stats.stuckThreads >= kMaxStuckThreads) {
+            m_shared->stats.rejected++;
+            return false;
+        }
+
+        EnqueueTask(m_shared, state);
+    }
+    m_shared->available.notify_one();
+
+    {
+        std::unique_lock<std::mutex> taskLock(state->mutex);
+        state->finished.wait_for(taskLock, timeout, [&state] { return state->done; });
+    }
+
+    // Decide under both locks (same order as the worker) so a task finishing
+    // right at the deadline is either completed or abandoned, never both
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    std::lock_guard<std::mutex> taskLock(state->mutex);
+    if (state->done) {
+        if (state->failed) {
+            m_shared->stats.failed++;
+            return false;
+        }
+        m_shared->stats.completed++;
+        return true;
+    }
+
+    // Missed the deadline: a queued task is dropped, a running one counts as
+    // stuck unless its abandoned parent already counted it
+    m_shared->stats.timedOut++;
+    if (!state->orphaned) {
+        AbandonTask(m_shared, state);
+    }
+    return false;
+}
+
+/**
+ * @brief Stop waiting for a task started with Post()
+ */
+void ComponentWatchdog::Abandon(const Ticket& ticket) {
+    if (!ticket) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    std::lock_guard<std::mutex> taskLock(ticket->mutex);
+    if (!ticket->done && !IsAbandoned(*ticket)) {
+        AbandonTask(m_shared, ticket);
+    }
+}
+
+/**
+ * @brief Get a copy of the watchdog counters
+ */
+ComponentWatchdogStats ComponentWatchdog::GetStats() {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    return m_shared->stats;
+}
@@ -0,0 +1,110 @@
+#ifndef COMPONENT_WATCHDOG_H
+#define COMPONENT_WATCHDOG_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief Counters reported by ComponentWatchdog
+ */
+struct ComponentWatchdogStats {
+    uint64_t completed = 0;     // Tasks that finished before their deadline
+    uint64_t timedOut = 0;      // Tasks abandoned at their deadline
+    uint64_t failed = 0;        // Tasks that threw before their deadline
+    uint64_t rejected = 0;      // Tasks not started because every thread was stuck
+    uint32_t threads = 0;       // Watchdog threads alive
+    uint32_t stuckThreads = 0;  // Threads still running an abandoned task
+};
+
+/**
+ * @brief Runs collection tasks under a deadline on reusable worker threads
+ *
+ * A task that misses its deadline is abandoned: the caller gets control
+ * back immediately while the task keeps running on its thread until the
+ * underlying query returns, after which the thread is reused. Tasks must
+ * therefore only touch state they own (typically through shared_ptr),
+ * never the caller's stack.
+ *
+ * The number of threads stuck in abandoned tasks is bounded; once the
+ * bound is reached new tasks are rejected instead of piling up threads
+ * behind a hung device. Tasks may queue further tasks, as a hedged source
+ * does: abandoning a task also counts the threads still running the tasks
+ * it queued, since nothing waits for them but the stuck task. Threads left
+ * idle for a minute exit.
+ *
+ * An exception thrown by a task is caught on its thread and the task
+ * reported as failed.
+ */
+class ComponentWatchdog {
+public:
+    /**
+     * @brief Completion state of one task
+     */
+    struct TaskState;
+
+    /**
+     * @brief Reference to a task started with Post(), for Abandon()
+     */
+    using Ticket = std::shared_ptr<TaskState>;
+
+    /**
+     * @brief Get the process-wide watchdog
+     *
+     * The instance is intentionally never destroyed so process exit does
+     * not wait for threads stuck in hung queries.
+     */
+    static ComponentWatchdog& Instance();
+
+    /**
+     * @brief Run a task and wait at most until its deadline
+     * @param task Task to run on a watchdog thread
+     * @param timeout Deadline measured from the call
+     * @return true if the task finished in time, false if it threw, was abandoned or rejected
+     */
+    bool RunWithDeadline(std::function<void()> task, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Start a task on a watchdog thread without waiting for it
+     *
+     * Used to race redundant sources: the caller synchronizes with the task
+     * through state the task owns, and passes the ticket to Abandon() once it
+     * stops waiting, so a hung task counts against the stuck thread bound.
+     * An exception is caught on the thread and not reported, so a task must
+     * settle that state itself when its query throws.
+     *
+     * @param task Task to run on a watchdog thread
+     * @param ticket Receives a reference to the task (optional)
+     * @return true if queued, false if rejected because too many threads are stuck
+     */
+    bool Post(std::function<void()> task, Ticket* ticket = nullptr);
+
+    /**
+     * @brief Stop waiting for a task started with Post()
+     *
+     * A task that has not started is dropped. One still running counts as a
+     * stuck thread until it returns; finished tasks are unaffected.
+     *
+     * @param ticket Ticket from Post(), may be empty
+     */
+    void Abandon(const Ticket& ticket);
+
+    /**
+     * @brief Get a copy of the watchdog counters
+     * @return Watchdog statistics
+     */
+    ComponentWatchdogStats GetStats();
+
+    /**
+     * @brief State shared with the detached worker threads
+     */
+    struct Shared;
+
+private:
+    ComponentWatchdog();
+
+    Shared* m_shared;
+};
+
+#endif // COMPONENT_WATCHDOG_H
@@ -0,0 +1,200 @@
+#include "cpu_features.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#if defined(HWID_ARCH_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+#endif
+
+#if defined(HWID_ARCH_X86)
+/**
+ * @brief Execute CPUID
+ */
+static void Cpuid(uint32_t leaf, uint32_t subleaf, uint32_t (&registers)[4]) {
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; i++) {
+        registers[i] = static_cast<uint32_t>(values[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+/**
+ * @brief Read the XCR0 register (state components enabled by the OS)
+ */
+static uint64_t ReadXcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t low;
+    uint32_t high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+}
+#endif
+
+/**
+ * @brief Probe the running CPU
+ */
+static CpuFeatures ProbeCpuFeatures() {
+    CpuFeatures features;
+
+#if defined(HWID_ARCH_X86)
+    uint32_t registers[4];
+    Cpuid(0, 0, registers);
+    uint32_t maxLeaf = registers[0];
+    if (maxLeaf >= 1) {
+        Cpuid(1, 0, registers);
+        uint32_t ecx = registers[2];
+        uint32_t edx = registers[3];
+        features.sse2 = (edx >> 26) & 1;
+        features.ssse3 = (ecx >> 9) & 1;
+        features.sse41 = (ecx >> 19) & 1;
+        features.sse42 = (ecx >> 20) & 1;
+        features.popcnt = (ecx >> 23) & 1;
+
+        // AVX registers are only usable if the OS saves their state
+        bool osxsave = (ecx >> 27) & 1;
+        uint64_t xcr0 = osxsave ? ReadXcr0() : 0;
+        bool avxState = (xcr0 & 0x6) == 0x6;
+        bool avx512State = avxState && (xcr0 & 0xE0) == 0xE0;
+
+        if (maxLeaf >= 7) {
+            Cpuid(7, 0, registers);
+            uint32_t ebx = registers[1];
+            features.avx2 = avxState && ((ebx >> 5) & 1);
+            features.avx512f = avx512State && ((ebx >> 16) & 1);
+            features.avx512bw = avx512State && ((ebx >> 30) & 1);
+            features.sha = (ebx >> 29) & 1;
+        }
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    features.neon = true;
+#if defined(__linux__) && defined(HWCAP_SHA2)
+    features.sha = (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#elif defined(__APPLE__)
+    features.sha = true;
+#elif defined(_WIN32)
+    features.sha = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#endif
+#endif
+
+    return features;
+}
+
+/**
+ * @brief Feature names and their fields
+ */
+static const struct {
+    const char* name;
+    bool CpuFeatures::*field;
+} kFeatureNames[] = {
+    { "sse2", &CpuFeatures::sse2 },
+    { "ssse3", &CpuFeatures::ssse3 },
+    { "sse4.1", &CpuFeatures::sse41 },
+    { "sse4.2", &CpuFeatures::sse42 },
+    { "popcnt", &CpuFeatures::popcnt },
+    { "avx2", &CpuFeatures::avx2 },
+    { "avx512f", &CpuFeatures::avx512f },
+    { "avx512bw", &CpuFeatures::avx512bw },
+    { "sha", &CpuFeatures::sha },
+    { "neon", &CpuFeatures::neon }
+};
+
+/**
+ * @brief Clear the features named in HWID_DISABLE_CPU_FEATURES
+ */
+static void ApplyDisabledFeatures(CpuFeatures& features) {
+    const char* disabled = std::getenv("HWID_DISABLE_CPU_FEATURES");
+    if (!disabled) {
+        return;
+    }
+    std::string list(disabled);
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string name = list.substr(begin, end - begin);
+        for (const auto& feature : kFeatureNames) {
+            if (name == feature.name || name == "all") {
+                features.*feature.field = false;
+            }
+        }
+        begin = end + 1;
+    }
+}
+
+/**
+ * @brief Get the features of the running CPU
+ */
+const CpuFeatures& GetCpuFeatures() {
+    static const CpuFeatures features = [] {
+        CpuFeatures probed = ProbeCpuFeatures();
+        ApplyDisabledFeatures(probed);
+        return probed;
+    }();
+    return features;
+}
+
+/**
+ * @brief Get the names of the detected features
+ */
+std::vector<std::string> CpuFeatureNames(const CpuFeatures& features) {
+    std::vector<std::string> names;
+    for (const auto& feature : kFeatureNames) {
+        if (features.*feature.field) {
+            names.push_back(feature.name);
+        }
+    }
+    return names;
+}
+
+/**
+ * @brief Registry of selected kernel variants
+ */
+struct KernelVariantRegistry {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::string>> variants;
+};
+
+static KernelVariantRegistry& GetKernelVariantRegistry() {
+    static KernelVariantRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Record the variant selected for a dispatched kernel
+ */
+void RecordKernelVariant(const char* kernel, const char* variant) {
+    KernelVariantRegistry& registry = GetKernelVariantRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.variants.emplace_back(kernel, variant);
+}
+
+/**
+ * @brief Get the variant selected for every dispatched kernel
+ */
+std::vector<std::pair<std::string, std::string>> GetKernelVariants() {
+    KernelVariantRegistry& registry = GetKernelVariantRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.variants;
+}
@@ -0,0 +1,80 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define HWID_ARCH_X86 1
+#endif
+
+/**
+ * @brief Function attribute for kernels compiled for an instruction set
+ *        the build does not target by default
+ *
+ * GCC and Clang need the attribute to emit AVX2 (or SHA) instructions in
+ * a translation unit built for the baseline; MSVC accepts the intrinsics
+ * anywhere. Such functions must only be called after a CPU feature check.
+ */
+#if defined(HWID_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define HWID_TARGET(isa) __attribute__((target(isa)))
+#else
+#define HWID_TARGET(isa)
+#endif
+
+/**
+ * @brief Instruction set extensions of the running CPU
+ *
+ * Extensions that need operating system support (AVX state saving) are
+ * only reported when the OS enables them.
+ */
+struct CpuFeatures {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool popcnt = false;
+    bool avx2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool sha = false;       // SHA-NI on x86, SHA2 extension on ARM
+    bool neon = false;
+};
+
+/**
+ * @brief Get the features of the running CPU
+ *
+ * The CPU is probed once, on first call. Features listed in the
+ * HWID_DISABLE_CPU_FEATURES environment variable (comma-separated names
+ * as returned by CpuFeatureNames) are reported as absent, which forces
+ * the fallback kernels for testing and benchmarking.
+ *
+ * @return Detected features
+ */
+const CpuFeatures& GetCpuFeatures();
+
+/**
+ * @brief Get the names of the detected features
+ * @param features Detected features
+ * @return Names such as "sse2" or "avx2"
+ */
+std::vector<std::string> CpuFeatureNames(const CpuFeatures& features);
+
+/**
+ * @brief Record the variant selected for a dispatched kernel
+ *
+ * Called once per kernel when its implementation pointer is resolved.
+ *
+ * @param kernel Kernel name
+ * @param variant Variant name, e.g. "avx2" or "scalar"
+ */
+void RecordKernelVariant(const char* kernel, const char* variant);
+
+/**
+ * @brief Get the variant selected for every dispatched kernel
+ * @return Kernel and variant names in resolution order
+ */
+std::vector<std::pair<std::string, std::string>> GetKernelVariants();
+
+#endif // CPU_FEATURES_H
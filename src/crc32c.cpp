@@ -0,0 +1,106 @@
+#include "crc32c.h"
+#include "cpu_features.h"
+#include <cstring>
+
+#if defined(HWID_ARCH_X86)
+#include <nmmintrin.h>
+#endif
+
+/**
+ * @brief Checksum bytes with the current CRC register (not inverted)
+ */
+using Crc32cFn = uint32_t (*)(const uint8_t* data, size_t size, uint32_t crc);
+
+/**
+ * @brief Slicing-by-8 lookup tables for the reflected Castagnoli polynomial
+ */
+struct Crc32cTables {
+    uint32_t values[8][256];
+
+    Crc32cTables() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+            }
+            values[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int table = 1; table < 8; table++) {
+                values[table][i] = (values[table - 1][i] >> 8) ^ values[0][values[table - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+static uint32_t Crc32cScalar(const uint8_t* data, size_t size, uint32_t crc) {
+    static const Crc32cTables tables;
+    const auto& t = tables.values;
+    while (size >= 8) {
+        uint32_t low;
+        uint32_t high;
+        memcpy(&low, data, sizeof(low));
+        memcpy(&high, data + 4, sizeof(high));
+        low ^= crc;
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+    while (size--) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(HWID_ARCH_X86)
+HWID_TARGET("sse4.2")
+static uint32_t Crc32cSse42(const uint8_t* data, size_t size, uint32_t crc) {
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t wide = crc;
+    while (size >= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        wide = _mm_crc32_u64(wide, word);
+        data += 8;
+        size -= 8;
+    }
+    crc = static_cast<uint32_t>(wide);
+#endif
+    while (size >= 4) {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+        size -= 4;
+    }
+    while (size--) {
+        crc = _mm_crc32_u8(crc, *data++);
+    }
+    return crc;
+}
+#endif
+
+/**
+ * @brief Select the CRC-32C kernel for the running CPU
+ */
+static Crc32cFn SelectCrc32c() {
+#if defined(HWID_ARCH_X86)
+    if (GetCpuFeatures().sse42) {
+        RecordKernelVariant("crc32c", "sse4.2");
+        return Crc32cSse42;
+    }
+#endif
+    RecordKernelVariant("crc32c", "scalar");
+    return Crc32cScalar;
+}
+
+// Resolved while the module loads, before any checksum
+static const Crc32cFn Crc32cKernel = SelectCrc32c();
+
+/**
+ * @brief Compute or extend a CRC-32C checksum
+ */
+uint32_t Crc32c(const void* data, size_t size, uint32_t crc) {
+    return ~Crc32cKernel(static_cast<const uint8_t*>(data), size, ~crc);
+}
@@ -0,0 +1,20 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Compute or extend a CRC-32C (Castagnoli) checksum
+ *
+ * Uses the SSE4.2 CRC32 instruction when the running CPU has it (see
+ * cpu_features.h), otherwise a slicing-by-8 table implementation.
+ *
+ * @param data Bytes to checksum
+ * @param size Number of bytes
+ * @param crc Checksum of the preceding bytes, 0 to start
+ * @return Checksum of all bytes so far
+ */
+uint32_t Crc32c(const void* data, size_t size, uint32_t crc = 0);
+
+#endif // CRC32C_H
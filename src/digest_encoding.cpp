@@ -0,0 +1,571 @@
+#include "digest_encoding.h"
+#include "cpu_features.h"
+#include <cstring>
+
+#if defined(HWID_ARCH_X86)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DIGEST_ENCODING_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define DIGEST_ENCODING_NEON 1
+#endif
+
+static const char kHexDigits[] = "0123456789abcdef";
+static const char kBase32Digits[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+static const char kBase64UrlDigits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/**
+ * @brief Character to digit value table, kInvalidDigit for other characters
+ */
+struct DigitTable {
+    uint8_t value[256];
+};
+
+static constexpr uint8_t kInvalidDigit = 0xFF;
+
+static constexpr DigitTable MakeDigitTable(const char* digits, size_t count, bool foldCase) {
+    DigitTable table{};
+    for (size_t c = 0; c < 256; c++) {
+        table.value[c] = kInvalidDigit;
+    }
+    for (size_t i = 0; i < count; i++) {
+        unsigned char c = static_cast<unsigned char>(digits[i]);
+        table.value[c] = static_cast<uint8_t>(i);
+        if (foldCase && c >= 'a' && c <= 'z') {
+            table.value[c - 32] = static_cast<uint8_t>(i);
+        } else if (foldCase && c >= 'A' && c <= 'Z') {
+            table.value[c + 32] = static_cast<uint8_t>(i);
+        }
+    }
+    return table;
+}
+
+static constexpr DigitTable MakeBase32Table() {
+    DigitTable table = MakeDigitTable(kBase32Digits, 32, true);
+    // Crockford decodes the letters it leaves out as the digits they resemble
+    table.value['I'] = table.value['i'] = 1;
+    table.value['L'] = table.value['l'] = 1;
+    table.value['O'] = table.value['o'] = 0;
+    return table;
+}
+
+static constexpr DigitTable kHexTable = MakeDigitTable(kHexDigits, 16, true);
+static constexpr DigitTable kBase32Table = MakeBase32Table();
+static constexpr DigitTable kBase64UrlTable = MakeDigitTable(kBase64UrlDigits, 64, false);
+
+using EncodeDigestFn = void (*)(const uint8_t* data, size_t size, char* out);
+using DecodeDigestFn = bool (*)(const char* text, size_t length, uint8_t* out);
+
+/**
+ * @brief Encode and decode kernels of one encoding
+ */
+struct DigestCodec {
+    EncodeDigestFn encode;
+    DecodeDigestFn decode;
+};
+
+static void HexEncodeScalar(const uint8_t* data, size_t size, char* out) {
+    for (size_t i = 0; i < size; i++) {
+        out[2 * i] = kHexDigits[data[i] >> 4];
+        out[2 * i + 1] = kHexDigits[data[i] & 0x0F];
+    }
+}
+
+static bool HexDecodeScalar(const char* text, size_t length, uint8_t* out) {
+    for (size_t i = 0; i + 1 < length; i += 2) {
+        uint8_t high = kHexTable.value[static_cast<unsigned char>(text[i])];
+        uint8_t low = kHexTable.value[static_cast<unsigned char>(text[i + 1])];
+        if (high == kInvalidDigit || low == kInvalidDigit) {
+            return false;
+        }
+        out[i / 2] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+static void Base32EncodeScalar(const uint8_t* data, size_t size, char* out) {
+    size_t i = 0;
+    for (; i + 5 <= size; i += 5, out += 8) {
+        uint64_t group = 0;
+        for (size_t j = 0; j < 5; j++) {
+            group = (group << 8) | data[i + j];
+        }
+        for (int k = 0; k < 8; k++) {
+            out[k] = kBase32Digits[(group >> (35 - 5 * k)) & 0x1F];
+        }
+    }
+    size_t rest = size - i;
+    if (rest > 0) {
+        uint64_t group = 0;
+        for (size_t j = 0; j < rest; j++) {
+            group |= static_cast<uint64_t>(data[i + j]) << (32 - 8 * j);
+        }
+        size_t digits = (rest * 8 + 4) / 5;
+        for (size_t k = 0; k < digits; k++) {
+            out[k] = kBase32Digits[(group >> (35 - 5 * k)) & 0x1F];
+        }
+    }
+}
+
+static bool Base32DecodeScalar(const char* text, size_t length, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8, out += 5) {
+        uint64_t group = 0;
+        for (size_t k = 0; k < 8; k++) {
+            uint8_t digit = kBase32Table.value[static_cast<unsigned char>(text[i + k])];
+            if (digit == kInvalidDigit) {
+                return false;
+            }
+            group = (group << 5) | digit;
+        }
+        for (int j = 0; j < 5; j++) {
+            out[j] = static_cast<uint8_t>(group >> (32 - 8 * j));
+        }
+    }
+    size_t rest = length - i;
+    if (rest > 0) {
+        uint64_t group = 0;
+        for (size_t k = 0; k < rest; k++) {
+            uint8_t digit = kBase32Table.value[static_cast<unsigned char>(text[i + k])];
+            if (digit == kInvalidDigit) {
+                return false;
+            }
+            group = (group << 5) | digit;
+        }
+        size_t bytes = rest * 5 / 8;
+        size_t unused = rest * 5 - bytes * 8;
+        if (group & ((1u << unused) - 1)) {
+            return false;
+        }
+        group >>= unused;
+        for (size_t j = 0; j < bytes; j++) {
+            out[j] = static_cast<uint8_t>(group >> (8 * (bytes - 1 - j)));
+        }
+    }
+    return true;
+}
+
+static void Base64UrlEncodeScalar(const uint8_t* data, size_t size, char* out) {
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3, out += 4) {
+        uint32_t group = (static_cast<uint32_t>(data[i]) << 16) | (data[i + 1] << 8) | data[i + 2];
+        out[0] = kBase64UrlDigits[group >> 18];
+        out[1] = kBase64UrlDigits[(group >> 12) & 0x3F];
+        out[2] = kBase64UrlDigits[(group >> 6) & 0x3F];
+        out[3] = kBase64UrlDigits[group & 0x3F];
+    }
+    size_t rest = size - i;
+    if (rest > 0) {
+        uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+        if (rest > 1) {
+            group |= data[i + 1] << 8;
+        }
+        out[0] = kBase64UrlDigits[group >> 18];
+        out[1] = kBase64UrlDigits[(group >> 12) & 0x3F];
+        if (rest > 1) {
+            out[2] = kBase64UrlDigits[(group >> 6) & 0x3F];
+        }
+    }
+}
+
+static bool Base64UrlDecodeScalar(const char* text, size_t length, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4, out += 3) {
+        uint32_t group = 0;
+        for (size_t k = 0; k < 4; k++) {
+            uint8_t digit = kBase64UrlTable.value[static_cast<unsigned char>(text[i + k])];
+            if (digit == kInvalidDigit) {
+                return false;
+            }
+            group = (group << 6) | digit;
+        }
+        out[0] = static_cast<uint8_t>(group >> 16);
+        out[1] = static_cast<uint8_t>(group >> 8);
+        out[2] = static_cast<uint8_t>(group);
+    }
+    size_t rest = length - i;
+    if (rest > 0) {
+        uint32_t group = 0;
+        for (size_t k = 0; k < rest; k++) {
+            uint8_t digit = kBase64UrlTable.value[static_cast<unsigned char>(text[i + k])];
+            if (digit == kInvalidDigit) {
+                return false;
+            }
+            group = (group << 6) | digit;
+        }
+        size_t bytes = rest * 6 / 8;
+        size_t unused = rest * 6 - bytes * 8;
+        if (group & ((1u << unused) - 1)) {
+            return false;
+        }
+        group >>= unused;
+        for (size_t j = 0; j < bytes; j++) {
+            out[j] = static_cast<uint8_t>(group >> (8 * (bytes - 1 - j)));
+        }
+    }
+    return true;
+}
+
+#if defined(DIGEST_ENCODING_SSE2)
+static void HexEncodeSse2(const uint8_t* data, size_t size, char* out) {
+    const __m128i lowNibble = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i letterOffset = _mm_set1_epi8('a' - '0' - 10);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowNibble);
+        __m128i low = _mm_and_si128(bytes, lowNibble);
+        __m128i nibbles[2] = { _mm_unpacklo_epi8(high, low), _mm_unpackhi_epi8(high, low) };
+        for (int half = 0; half < 2; half++) {
+            __m128i ascii = _mm_add_epi8(nibbles[half], _mm_set1_epi8('0'));
+            ascii = _mm_add_epi8(ascii, _mm_and_si128(_mm_cmpgt_epi8(nibbles[half], nine), letterOffset));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16 * half), ascii);
+        }
+    }
+    HexEncodeScalar(data + i, size - i, out + 2 * i);
+}
+
+/**
+ * @brief Get the nibble values of 16 hex digits
+ * @return false if any character is not a hex digit
+ */
+static inline bool HexNibblesSse2(__m128i chars, __m128i& nibbles) {
+    // Characters at or above 0x80 compare as negative and fail both ranges
+    __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                    _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                     _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+        return false;
+    }
+    nibbles = _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+                           _mm_and_si128(isLetter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+    return true;
+}
+
+static bool HexDecodeSse2(const char* text, size_t length, uint8_t* out) {
+    const __m128i lowByte = _mm_set1_epi16(0x00FF);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m128i nibbles[2];
+        for (int half = 0; half < 2; half++) {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + 16 * half));
+            if (!HexNibblesSse2(chars, nibbles[half])) {
+                return false;
+            }
+            // Each 16-bit lane holds the high nibble in its low byte
+            nibbles[half] = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles[half], lowByte), 4),
+                                         _mm_srli_epi16(nibbles[half], 8));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), _mm_packus_epi16(nibbles[0], nibbles[1]));
+    }
+    return HexDecodeScalar(text + i, length - i, out + i / 2);
+}
+#elif defined(DIGEST_ENCODING_NEON)
+static void HexEncodeNeon(const uint8_t* data, size_t size, char* out) {
+    const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t*>(kHexDigits));
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t bytes = vld1q_u8(data + i);
+        uint8x16x2_t ascii;
+        ascii.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+        ascii.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+        vst2q_u8(reinterpret_cast<uint8_t*>(out + 2 * i), ascii);
+    }
+    HexEncodeScalar(data + i, size - i, out + 2 * i);
+}
+
+/**
+ * @brief Get the nibble values of 16 hex digits
+ * @return false if any character is not a hex digit
+ */
+static inline bool HexNibblesNeon(uint8x16_t chars, uint8x16_t& nibbles) {
+    uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+    uint8x16_t letter = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t isDigit = vcltq_u8(digit, vdupq_n_u8(10));
+    uint8x16_t isLetter = vcltq_u8(letter, vdupq_n_u8(6));
+    if (vminvq_u8(vorrq_u8(isDigit, isLetter)) != 0xFF) {
+        return false;
+    }
+    nibbles = vbslq_u8(isDigit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+    return true;
+}
+
+static bool HexDecodeNeon(const char* text, size_t length, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        // De-interleave into the high and low digit of each byte
+        uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t*>(text + i));
+        uint8x16_t high;
+        uint8x16_t low;
+        if (!HexNibblesNeon(chars.val[0], high) || !HexNibblesNeon(chars.val[1], low)) {
+            return false;
+        }
+        vst1q_u8(out + i / 2, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+    return HexDecodeScalar(text + i, length - i, out + i / 2);
+}
+#endif
+
+#if defined(HWID_ARCH_X86)
+/**
+ * @brief Map 16 values below 32 to Crockford base32 digits
+ */
+HWID_TARGET("ssse3")
+static inline __m128i Base32DigitsSsse3(__m128i values) {
+    const __m128i low = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+    const __m128i high = _mm_setr_epi8('G', 'H', 'J', 'K', 'M', 'N', 'P', 'Q', 'R', 'S', 'T', 'V', 'W', 'X', 'Y', 'Z');
+    __m128i isHigh = _mm_cmpgt_epi8(values, _mm_set1_epi8(15));
+    return _mm_or_si128(_mm_andnot_si128(isHigh, _mm_shuffle_epi8(low, values)),
+                        _mm_and_si128(isHigh, _mm_shuffle_epi8(high, values)));
+}
+
+HWID_TARGET("ssse3")
+static void Base32EncodeSsse3(const uint8_t* data, size_t size, char* out) {
+    // Digit k of a 5-byte group is bits 5k..5k+4 from the top. Gather the
+    // big-endian 16-bit word holding it into lane k, then shift each lane
+    // right by its own amount with a high multiply.
+    const __m128i gatherFirst = _mm_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4);
+    const __m128i gatherSecond = _mm_setr_epi8(6, 5, 6, 5, 7, 6, 7, 6, 8, 7, 9, 8, 9, 8, 10, 9);
+    const __m128i shift = _mm_setr_epi16(1 << 5, 1 << 10, 1 << 7, 1 << 12, 1 << 9, 1 << 6, 1 << 11, 1 << 8);
+    const __m128i mask = _mm_set1_epi16(0x1F);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 10) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i first = _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(bytes, gatherFirst), shift), mask);
+        __m128i second = _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(bytes, gatherSecond), shift), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 5 * 8), Base32DigitsSsse3(_mm_packus_epi16(first, second)));
+    }
+    Base32EncodeScalar(data + i, size - i, out + i / 5 * 8);
+}
+
+HWID_TARGET("ssse3")
+static bool Base32DecodeSsse3(const char* text, size_t length, uint8_t* out) {
+    // Values by low nibble for digits, for A-O and for P-Z; lowercase
+    // letters share the tables of their uppercase forms
+    const __m128i digits = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, -1, -1, -1, -1);
+    const __m128i lettersA = _mm_setr_epi8(-1, 10, 11, 12, 13, 14, 15, 16, 17, 1, 18, 19, 1, 20, 21, 0);
+    const __m128i lettersP = _mm_setr_epi8(22, 23, 24, 25, 26, -1, 27, 28, 29, 30, 31, -1, -1, -1, -1, -1);
+    const __m128i lowNibble = _mm_set1_epi8(0x0F);
+    const __m128i invalid = _mm_set1_epi8(-1);
+    const __m128i extract = _mm_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(chars, 4), lowNibble);
+        __m128i low = _mm_and_si128(chars, lowNibble);
+        __m128i isDigit = _mm_cmpeq_epi8(high, _mm_set1_epi8(3));
+        __m128i isLetterA = _mm_or_si128(_mm_cmpeq_epi8(high, _mm_set1_epi8(4)), _mm_cmpeq_epi8(high, _mm_set1_epi8(6)));
+        __m128i isLetterP = _mm_or_si128(_mm_cmpeq_epi8(high, _mm_set1_epi8(5)), _mm_cmpeq_epi8(high, _mm_set1_epi8(7)));
+        __m128i values = _mm_or_si128(_mm_or_si128(_mm_and_si128(isDigit, _mm_shuffle_epi8(digits, low)),
+                                                   _mm_and_si128(isLetterA, _mm_shuffle_epi8(lettersA, low))),
+                                      _mm_and_si128(isLetterP, _mm_shuffle_epi8(lettersP, low)));
+        __m128i known = _mm_or_si128(_mm_or_si128(isDigit, isLetterA), isLetterP);
+        if (_mm_movemask_epi8(_mm_andnot_si128(_mm_cmpeq_epi8(values, invalid), known)) != 0xFFFF) {
+            return false;
+        }
+        // Merge digit pairs to 10 bits, pairs of those to 20 bits, and the
+        // two halves of each group to its 40 bits
+        __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0120));
+        __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010400));
+        __m128i groups = _mm_or_si128(_mm_slli_epi64(_mm_and_si128(quads, _mm_set1_epi64x(0xFFFFFFFF)), 20),
+                                      _mm_srli_epi64(quads, 32));
+        alignas(16) uint8_t bytes[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(bytes), _mm_shuffle_epi8(groups, extract));
+        memcpy(out + i / 8 * 5, bytes, 10);
+    }
+    return Base32DecodeScalar(text + i, length - i, out + i / 8 * 5);
+}
+
+HWID_TARGET("ssse3")
+static void Base64UrlEncodeSsse3(const uint8_t* data, size_t size, char* out) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 12) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        // Spread each 3-byte group over a 32-bit lane, then move its four
+        // 6-bit fields into separate bytes with multiplies
+        bytes = _mm_shuffle_epi8(bytes, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        __m128i upper = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        __m128i lower = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        __m128i values = _mm_or_si128(upper, lower);
+
+        // Offset to add per range: A-Z, a-z, 0-9, '-' and '_'
+        __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+        const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                              '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+        __m128i ascii = _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 3 * 4), ascii);
+    }
+    Base64UrlEncodeScalar(data + i, size - i, out + i / 3 * 4);
+}
+
+/**
+ * @brief Select the characters of a vector inside [first, last]
+ */
+HWID_TARGET("ssse3")
+static inline __m128i InRange(__m128i chars, char first, char last) {
+    return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(static_cast<char>(first - 1))),
+                         _mm_cmplt_epi8(chars, _mm_set1_epi8(static_cast<char>(last + 1))));
+}
+
+HWID_TARGET("ssse3")
+static bool Base64UrlDecodeSsse3(const char* text, size_t length, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        __m128i upper = InRange(chars, 'A', 'Z');
+        __m128i lower = InRange(chars, 'a', 'z');
+        __m128i digit = InRange(chars, '0', '9');
+        __m128i dash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('-'));
+        __m128i underscore = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));
+        __m128i known = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, dash), underscore));
+        if (_mm_movemask_epi8(known) != 0xFFFF) {
+            return false;
+        }
+        __m128i offset = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+            _mm_or_si128(_mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8(52 - '0')), _mm_and_si128(dash, _mm_set1_epi8(62 - '-'))),
+                         _mm_and_si128(underscore, _mm_set1_epi8(63 - '_'))));
+        __m128i values = _mm_add_epi8(chars, offset);
+
+        // Merge 6-bit pairs to 12 bits, then pairs of those to 24 bits
+        __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        groups = _mm_shuffle_epi8(groups, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        alignas(16) uint8_t bytes[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(bytes), groups);
+        memcpy(out + i / 4 * 3, bytes, 12);
+    }
+    return Base64UrlDecodeScalar(text + i, length - i, out + i / 4 * 3);
+}
+#endif
+
+/**
+ * @brief Select the best hex kernels for the running CPU
+ */
+static DigestCodec SelectHexCodec() {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    (void)cpu;
+#if defined(DIGEST_ENCODING_SSE2)
+    if (cpu.sse2) {
+        RecordKernelVariant("digest.hex", "sse2");
+        return { HexEncodeSse2, HexDecodeSse2 };
+    }
+#elif defined(DIGEST_ENCODING_NEON)
+    if (cpu.neon) {
+        RecordKernelVariant("digest.hex", "neon");
+        return { HexEncodeNeon, HexDecodeNeon };
+    }
+#endif
+    RecordKernelVariant("digest.hex", "scalar");
+    return { HexEncodeScalar, HexDecodeScalar };
+}
+
+/**
+ * @brief Select the best base32 kernels for the running CPU
+ */
+static DigestCodec SelectBase32Codec() {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    (void)cpu;
+#if defined(HWID_ARCH_X86)
+    if (cpu.ssse3) {
+        RecordKernelVariant("digest.base32", "ssse3");
+        return { Base32EncodeSsse3, Base32DecodeSsse3 };
+    }
+#endif
+    RecordKernelVariant("digest.base32", "scalar");
+    return { Base32EncodeScalar, Base32DecodeScalar };
+}
+
+/**
+ * @brief Select the best base64url kernels for the running CPU
+ */
+static DigestCodec SelectBase64UrlCodec() {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    (void)cpu;
+#if defined(HWID_ARCH_X86)
+    if (cpu.ssse3) {
+        RecordKernelVariant("digest.base64url", "ssse3");
+        return { Base64UrlEncodeSsse3, Base64UrlDecodeSsse3 };
+    }
+#endif
+    RecordKernelVariant("digest.base64url", "scalar");
+    return { Base64UrlEncodeScalar, Base64UrlDecodeScalar };
+}
+
+// Resolved while the module loads, before any digest is encoded
+static const DigestCodec HexCodec = SelectHexCodec();
+static const DigestCodec Base32Codec = SelectBase32Codec();
+static const DigestCodec Base64UrlCodec = SelectBase64UrlCodec();
+
+static const DigestCodec& CodecFor(DigestEncoding encoding) {
+    switch (encoding) {
+        case DigestEncoding::Base32:    return Base32Codec;
+        case DigestEncoding::Base64Url: return Base64UrlCodec;
+        default:                        return HexCodec;
+    }
+}
+
+/**
+ * @brief Get the encoded length of a digest
+ */
+size_t EncodedDigestLength(DigestEncoding encoding, size_t size) {
+    switch (encoding) {
+        case DigestEncoding::Base32:    return (size * 8 + 4) / 5;
+        case DigestEncoding::Base64Url: return (size * 8 + 5) / 6;
+        default:                        return size * 2;
+    }
+}
+
+/**
+ * @brief Get the number of bytes a digest text decodes to
+ */
+bool DecodedDigestLength(DigestEncoding encoding, size_t length, size_t& size) {
+    switch (encoding) {
+        case DigestEncoding::Base32: {
+            // A final group of 1, 3 or 6 digits cannot come from whole bytes
+            size_t rest = length % 8;
+            if (rest == 1 || rest == 3 || rest == 6) {
+                return false;
+            }
+            size = length / 8 * 5 + rest * 5 / 8;
+            return true;
+        }
+        case DigestEncoding::Base64Url:
+            if (length % 4 == 1) {
+                return false;
+            }
+            size = length / 4 * 3 + length % 4 * 6 / 8;
+            return true;
+        default:
+            if (length % 2 != 0) {
+                return false;
+            }
+            size = length / 2;
+            return true;
+    }
+}
+
+/**
+ * @brief Encode a digest into a caller-provided buffer
+ */
+void EncodeDigest(DigestEncoding encoding, const uint8_t* data, size_t size, char* out) {
+    CodecFor(encoding).encode(data, size, out);
+}
+
+/**
+ * @brief Decode a digest text into a caller-provided buffer
+ */
+bool DecodeDigest(DigestEncoding encoding, const char* text, size_t length, uint8_t* out) {
+    size_t size;
+    if (!DecodedDigestLength(encoding, length, size)) {
+        return false;
+    }
+    return CodecFor(encoding).decode(text, length, out);
+}
@@ -0,0 +1,62 @@
+#ifndef DIGEST_ENCODING_H
+#define DIGEST_ENCODING_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Text encodings for binary digests
+ */
+enum class DigestEncoding {
+    Hex,        // Lowercase hex, two characters per byte
+    Base32,     // Crockford base32, uppercase, no padding
+    Base64Url   // RFC 4648 base64url, no padding
+};
+
+/**
+ * @brief Get the encoded length of a digest
+ * @param encoding Text encoding
+ * @param size Number of digest bytes
+ * @return Number of characters EncodeDigest writes
+ */
+size_t EncodedDigestLength(DigestEncoding encoding, size_t size);
+
+/**
+ * @brief Get the number of bytes a digest text decodes to
+ * @param encoding Text encoding
+ * @param length Number of characters
+ * @param size Receives the number of bytes DecodeDigest writes
+ * @return false if no text of this length is valid in the encoding
+ */
+bool DecodedDigestLength(DigestEncoding encoding, size_t length, size_t& size);
+
+/**
+ * @brief Encode a digest into a caller-provided buffer
+ *
+ * Full blocks are encoded with a vector kernel where the running CPU has
+ * one (SSE2 or NEON for hex, SSSE3 for base32 and base64url).
+ *
+ * @param encoding Text encoding
+ * @param data Digest bytes
+ * @param size Number of bytes
+ * @param out Receives EncodedDigestLength(encoding, size) characters, not terminated
+ */
+void EncodeDigest(DigestEncoding encoding, const uint8_t* data, size_t size, char* out);
+
+/**
+ * @brief Decode a digest text into a caller-provided buffer
+ *
+ * Hex and base32 accept either case; base32 also reads I and L as 1 and
+ * O as 0, as Crockford specifies, but does not skip hyphens. Unused bits
+ * of a final partial base32 or base64url character must be zero, so each
+ * digest has exactly one accepted text per encoding and case.
+ *
+ * @param encoding Text encoding
+ * @param text Digest text
+ * @param length Number of characters
+ * @param out Receives the bytes given by DecodedDigestLength
+ * @return false if the text is not valid in the encoding
+ */
+bool DecodeDigest(DigestEncoding encoding, const char* text, size_t length, uint8_t* out);
+
+#endif // DIGEST_ENCODING_H
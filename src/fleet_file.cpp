@@ -0,0 +1,908 @@
+#include "fleet_file.h"
+#include <algorithm>
+#include <bitset>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// On-disk structures are little-endian PODs written and read with memcpy
+
+static const char kFileMagic[8] = {'H', 'W', 'I', 'D', 'C', 'O', 'L', '1'};
+static const char kTrailerMagic[8] = {'H', 'W', 'I', 'D', 'C', 'O', 'L', 'F'};
+static constexpr uint32_t kFileVersion = 2;
+static constexpr uint32_t kColumnCount = static_cast<uint32_t>(FleetFileColumn::Count);
+static_assert(kHardwareComponentCount == 5 && kColumnCount == 7,
+              "fleet file columns are the scalar components, fingerprint, first disk, primary MAC and registration time");
+static constexpr size_t kBloomBytes = 128;
+
+// PrimaryMac values carry this bit above the 48 address bits when the row has a MAC
+static constexpr uint64_t kMacPresent = 1ULL << 48;
+static constexpr uint64_t kMacBits = kMacPresent - 1;
+static constexpr uint32_t kBloomBits = kBloomBytes * 8;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t columnCount;
+};
+
+struct ColumnInfo {
+    uint32_t encoding;
+    uint32_t reserved;
+    uint64_t dictionaryOffset;      // Offsets table (count + 1 entries) followed by string bytes
+    uint64_t dictionaryCount;
+};
+
+struct ChunkInfo {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t minValue;              // Code, value, or int64 bits for Delta
+    uint64_t maxValue;
+    uint64_t bloomOffset;           // 0 if the chunk has no Bloom filter
+};
+
+struct GroupInfo {
+    uint64_t firstRow;
+    uint32_t rows;
+    uint32_t reserved;
+    ChunkInfo chunks[kColumnCount];
+};
+
+struct FooterHeader {
+    uint64_t rowCount;
+    uint32_t groupCount;
+    uint32_t rowsPerGroup;
+    ColumnInfo columns[kColumnCount];
+};
+
+struct Trailer {
+    uint64_t footerOffset;
+    uint64_t footerSize;
+    char magic[8];
+};
+
+/**
+ * @brief Check whether a column holds strings
+ */
+static bool IsStringColumn(uint32_t column) {
+    return column <= static_cast<uint32_t>(FleetFileColumn::FirstDiskSerial);
+}
+
+/**
+ * @brief Get the encoding the writer uses for a column
+ *
+ * The fingerprint column may also be FixedWidth.
+ */
+static FleetFileEncoding ExpectedEncoding(uint32_t column) {
+    switch (static_cast<FleetFileColumn>(column)) {
+        case FleetFileColumn::PrimaryMac:   return FleetFileEncoding::FixedWidth;
+        case FleetFileColumn::RegisteredAt: return FleetFileEncoding::Delta;
+        default:                            return FleetFileEncoding::Dictionary;
+    }
+}
+
+/**
+ * @brief Get a string column value of a row
+ */
+static std::string_view StringValue(const FleetScalarRow& row, uint32_t column) {
+    switch (static_cast<FleetFileColumn>(column)) {
+        case FleetFileColumn::CpuId:             return row.cpuId;
+        case FleetFileColumn::MotherboardSerial: return row.motherboardSerial;
+        case FleetFileColumn::BiosSerial:        return row.biosSerial;
+        case FleetFileColumn::Fingerprint:       return row.fingerprint;
+        case FleetFileColumn::FirstDiskSerial:   return row.firstDiskSerial;
+        default:                                 return std::string_view();
+    }
+}
+
+/**
+ * @brief Parse a canonical lower-case hex digest of 1 to 16 digits
+ *
+ * Canonical means no leading zeros (except "0" itself), so formatting the
+ * value with %llx restores the exact text.
+ */
+static bool ParseDigest(std::string_view text, uint64_t& value) {
+    if (text.empty() || text.size() > 16 || (text.size() > 1 && text[0] == '0')) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c >= '0' && c <= '9') {
+            value = (value << 4) | static_cast<uint64_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            value = (value << 4) | static_cast<uint64_t>(c - 'a' + 10);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Mix a value for Bloom filter positions
+ */
+static uint64_t BloomHash(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+static void BloomAdd(uint8_t* bloom, uint64_t value) {
+    uint64_t hash = BloomHash(value);
+    for (int i = 0; i < 3; i++) {
+        uint32_t bit = static_cast<uint32_t>(hash >> (i * 20)) % kBloomBits;
+        bloom[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+    }
+}
+
+static bool BloomMayContain(const uint8_t* bloom, uint64_t value) {
+    uint64_t hash = BloomHash(value);
+    for (int i = 0; i < 3; i++) {
+        uint32_t bit = static_cast<uint32_t>(hash >> (i * 20)) % kBloomBits;
+        if (!(bloom[bit / 8] & (1u << (bit % 8)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint64_t ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t UnZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * @brief Buffered file output tracking the current offset
+ */
+class FileOutput {
+public:
+    explicit FileOutput(const std::string& path)
+        : m_stream(path, std::ios::binary | std::ios::trunc)
+        , m_offset(0) {
+    }
+
+    bool IsOpen() const {
+        return m_stream.is_open();
+    }
+
+    bool Good() const {
+        return m_stream.good();
+    }
+
+    uint64_t Offset() const {
+        return m_offset;
+    }
+
+    void Write(const void* data, size_t size) {
+        m_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        m_offset += size;
+    }
+
+    /**
+     * @brief Pad to an 8-byte boundary so mapped arrays are aligned
+     */
+    void Align() {
+        static const char kZeros[8] = {};
+        size_t padding = static_cast<size_t>((8 - m_offset % 8) % 8);
+        Write(kZeros, padding);
+    }
+
+private:
+    std::ofstream m_stream;
+    uint64_t m_offset;
+};
+
+/**
+ * @brief Write a columnar fleet file
+ */
+bool WriteFleetFile(const std::string& path, uint64_t rowCount, const FleetFileRowSource& source, std::string& error) {
+    // Pass 1: column dictionaries and the fingerprint encoding
+    std::vector<std::unordered_set<std::string>> distinct(kColumnCount);
+    bool fixedFingerprint = true;
+    FleetScalarRow row;
+    for (uint64_t i = 0; i < rowCount; i++) {
+        if (!source(i, row)) {
+            error = "Row source failed";
+            return false;
+        }
+        uint64_t digest;
+        if (fixedFingerprint && !ParseDigest(row.fingerprint, digest)) {
+            fixedFingerprint = false;
+        }
+        for (uint32_t c = 0; c < kColumnCount; c++) {
+            if (IsStringColumn(c)) {
+                distinct[c].emplace(StringValue(row, c));
+            }
+        }
+    }
+
+    FooterHeader footer = {};
+    footer.rowCount = rowCount;
+    footer.rowsPerGroup = kFleetFileRowsPerGroup;
+    footer.groupCount = static_cast<uint32_t>((rowCount + kFleetFileRowsPerGroup - 1) / kFleetFileRowsPerGroup);
+    for (uint32_t c = 0; c < kColumnCount; c++) {
+        FleetFileEncoding encoding = ExpectedEncoding(c);
+        if (c == static_cast<uint32_t>(FleetFileColumn::Fingerprint) && fixedFingerprint) {
+            encoding = FleetFileEncoding::FixedWidth;
+        }
+        footer.columns[c].encoding = static_cast<uint32_t>(encoding);
+    }
+
+    FileOutput output(path);
+    if (!output.IsOpen()) {
+        error = "Cannot create " + path;
+        return false;
+    }
+
+    FileHeader header = {};
+    memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kFileVersion;
+    header.columnCount = kColumnCount;
+    output.Write(&header, sizeof(header));
+
+    // Sorted dictionaries, so codes compare like their strings
+    std::vector<std::unordered_map<std::string_view, uint32_t>> codes(kColumnCount);
+    std::vector<std::vector<std::string_view>> sorted(kColumnCount);
+    for (uint32_t c = 0; c < kColumnCount; c++) {
+        if (footer.columns[c].encoding != static_cast<uint32_t>(FleetFileEncoding::Dictionary)) {
+            continue;
+        }
+        sorted[c].assign(distinct[c].begin(), distinct[c].end());
+        std::sort(sorted[c].begin(), sorted[c].end());
+
+        output.Align();
+        footer.columns[c].dictionaryOffset = output.Offset();
+        footer.columns[c].dictionaryCount = sorted[c].size();
+        uint64_t stringOffset = 0;
+        for (size_t i = 0; i < sorted[c].size(); i++) {
+            codes[c].emplace(sorted[c][i], static_cast<uint32_t>(i));
+            output.Write(&stringOffset, sizeof(stringOffset));
+            stringOffset += sorted[c][i].size();
+        }
+        output.Write(&stringOffset, sizeof(stringOffset));
+        for (std::string_view value : sorted[c]) {
+            output.Write(value.data(), value.size());
+        }
+    }
+
+    // Pass 2: row groups
+    std::vector<GroupInfo> groups(footer.groupCount);
+    std::vector<uint32_t> codeChunk;
+    std::vector<uint64_t> fixedChunk;
+    std::vector<uint8_t> deltaChunk;
+    uint8_t bloom[kBloomBytes];
+
+    for (uint32_t g = 0; g < footer.groupCount; g++) {
+        GroupInfo& group = groups[g];
+        group.firstRow = static_cast<uint64_t>(g) * kFleetFileRowsPerGroup;
+        group.rows = static_cast<uint32_t>(std::min<uint64_t>(kFleetFileRowsPerGroup, rowCount - group.firstRow));
+
+        // Materialize the group's rows once; views stay valid per the source contract
+        std::vector<FleetScalarRow> rows(group.rows);
+        for (uint32_t r = 0; r < group.rows; r++) {
+            if (!source(group.firstRow + r, rows[r])) {
+                error = "Row source failed";
+                return false;
+            }
+        }
+
+        for (uint32_t c = 0; c < kColumnCount; c++) {
+            ChunkInfo& chunk = group.chunks[c];
+            FleetFileEncoding encoding = static_cast<FleetFileEncoding>(footer.columns[c].encoding);
+            memset(bloom, 0, sizeof(bloom));
+            chunk.minValue = UINT64_MAX;
+            chunk.maxValue = 0;
+
+            output.Align();
+            chunk.offset = output.Offset();
+            if (encoding == FleetFileEncoding::Dictionary) {
+                codeChunk.resize(group.rows);
+                for (uint32_t r = 0; r < group.rows; r++) {
+                    uint32_t code = codes[c].at(StringValue(rows[r], c));
+                    codeChunk[r] = code;
+                    chunk.minValue = std::min<uint64_t>(chunk.minValue, code);
+                    chunk.maxValue = std::max<uint64_t>(chunk.maxValue, code);
+                    BloomAdd(bloom, code);
+                }
+                output.Write(codeChunk.data(), codeChunk.size() * sizeof(uint32_t));
+            } else if (encoding == FleetFileEncoding::FixedWidth) {
+                fixedChunk.resize(group.rows);
+                for (uint32_t r = 0; r < group.rows; r++) {
+                    uint64_t value = rows[r].hasPrimaryMac ? (rows[r].primaryMac & kMacBits) | kMacPresent : 0;
+                    if (c == static_cast<uint32_t>(FleetFileColumn::Fingerprint)) {
+                        ParseDigest(rows[r].fingerprint, value);
+                    }
+                    fixedChunk[r] = value;
+                    chunk.minValue = std::min(chunk.minValue, value);
+                    chunk.maxValue = std::max(chunk.maxValue, value);
+                    BloomAdd(bloom, value);
+                }
+                output.Write(fixedChunk.data(), fixedChunk.size() * sizeof(uint64_t));
+            } else {
+                deltaChunk.clear();
+                int64_t previous = 0;
+                int64_t minimum = INT64_MAX;
+                int64_t maximum = INT64_MIN;
+                for (uint32_t r = 0; r < group.rows; r++) {
+                    int64_t value = rows[r].registeredAtMs;
+                    minimum = std::min(minimum, value);
+                    maximum = std::max(maximum, value);
+                    if (r == 0) {
+                        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                        deltaChunk.insert(deltaChunk.end(), bytes, bytes + sizeof(value));
+                    } else {
+                        uint64_t encoded = ZigZag(value - previous);
+                        do {
+                            uint8_t byte = static_cast<uint8_t>(encoded & 0x7F);
+                            encoded >>= 7;
+                            deltaChunk.push_back(static_cast<uint8_t>(byte | (encoded ? 0x80 : 0)));
+                        } while (encoded);
+                    }
+                    previous = value;
+                }
+                chunk.minValue = static_cast<uint64_t>(minimum);
+                chunk.maxValue = static_cast<uint64_t>(maximum);
+                output.Write(deltaChunk.data(), deltaChunk.size());
+            }
+            chunk.size = output.Offset() - chunk.offset;
+
+            // A saturated filter only costs space, so high-cardinality chunks go without
+            size_t setBits = 0;
+            for (uint8_t byte : bloom) {
+                setBits += std::bitset<8>(byte).count();
+            }
+            if (encoding != FleetFileEncoding::Delta && setBits <= kBloomBits / 2) {
+                chunk.bloomOffset = output.Offset();
+                output.Write(bloom, sizeof(bloom));
+            }
+        }
+    }
+
+    output.Align();
+    Trailer trailer = {};
+    trailer.footerOffset = output.Offset();
+    output.Write(&footer, sizeof(footer));
+    output.Write(groups.data(), groups.size() * sizeof(GroupInfo));
+    trailer.footerSize = output.Offset() - trailer.footerOffset;
+    memcpy(trailer.magic, kTrailerMagic, sizeof(kTrailerMagic));
+    output.Write(&trailer, sizeof(trailer));
+
+    if (!output.Good()) {
+        error = "Failed to write " + path;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Read-only file mapping
+ */
+class MappedFile {
+public:
+    MappedFile()
+        : m_data(nullptr)
+        , m_size(0)
+#ifdef _WIN32
+        , m_file(INVALID_HANDLE_VALUE)
+        , m_mapping(NULL)
+#endif
+    {
+    }
+
+    ~MappedFile() {
+        Unmap();
+    }
+
+    bool Map(const std::string& path) {
+#ifdef _WIN32
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            Unmap();
+            return false;
+        }
+        m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!m_mapping) {
+            Unmap();
+            return false;
+        }
+        m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        m_data = static_cast<const uint8_t*>(data);
+        m_size = static_cast<size_t>(info.st_size);
+#endif
+        if (!m_data) {
+            Unmap();
+            return false;
+        }
+        return true;
+    }
+
+    void Unmap() {
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+        m_mapping = NULL;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_data) {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    const uint8_t* Data() const {
+        return m_data;
+    }
+
+    size_t Size() const {
+        return m_size;
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    HANDLE m_file;
+    HANDLE m_mapping;
+#endif
+};
+
+/**
+ * @brief Footer and mapping state of an open fleet file
+ */
+struct FleetFileReader::State {
+    MappedFile file;
+    FooterHeader footer;
+    std::vector<GroupInfo> groups;
+    uint64_t dictionaryBytes[kColumnCount] = {};    // String bytes after each offsets table
+
+    // Lazily decoded timestamp chunk
+    uint32_t decodedGroup = UINT32_MAX;
+    std::vector<int64_t> timestamps;
+
+    char fingerprint[17];
+
+    /**
+     * @brief Check that a byte range lies inside the mapping
+     */
+    bool InRange(uint64_t offset, uint64_t size) const {
+        return offset <= file.Size() && size <= file.Size() - offset;
+    }
+
+    /**
+     * @brief Get a dictionary entry
+     */
+    std::string_view DictionaryValue(uint32_t column, uint32_t code) const {
+        const ColumnInfo& info = footer.columns[column];
+        if (code >= info.dictionaryCount) {
+            return std::string_view();
+        }
+        const uint8_t* base = file.Data() + info.dictionaryOffset;
+        uint64_t begin;
+        uint64_t end;
+        memcpy(&begin, base + code * sizeof(uint64_t), sizeof(begin));
+        memcpy(&end, base + (code + 1) * sizeof(uint64_t), sizeof(end));
+        if (begin > end || end > dictionaryBytes[column]) {
+            return std::string_view();
+        }
+        const char* strings = reinterpret_cast<const char*>(base + (info.dictionaryCount + 1) * sizeof(uint64_t));
+        return std::string_view(strings + begin, end - begin);
+    }
+
+    /**
+     * @brief Binary search a sorted dictionary
+     */
+    bool FindCode(uint32_t column, std::string_view value, uint32_t& code) const {
+        uint64_t low = 0;
+        uint64_t high = footer.columns[column].dictionaryCount;
+        while (low < high) {
+            uint64_t middle = (low + high) / 2;
+            if (DictionaryValue(column, static_cast<uint32_t>(middle)) < value) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        if (low < footer.columns[column].dictionaryCount &&
+            DictionaryValue(column, static_cast<uint32_t>(low)) == value) {
+            code = static_cast<uint32_t>(low);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Decode the timestamp chunk of a group
+     */
+    bool DecodeTimestamps(uint32_t group) {
+        if (decodedGroup == group) {
+            return true;
+        }
+        const GroupInfo& info = groups[group];
+        const ChunkInfo& chunk = info.chunks[static_cast<uint32_t>(FleetFileColumn::RegisteredAt)];
+        const uint8_t* data = file.Data() + chunk.offset;
+        const uint8_t* end = data + chunk.size;
+
+        timestamps.resize(info.rows);
+        int64_t value = 0;
+        for (uint32_t r = 0; r < info.rows; r++) {
+            if (r == 0) {
+                if (end - data < static_cast<ptrdiff_t>(sizeof(value))) {
+                    return false;
+                }
+                memcpy(&value, data, sizeof(value));
+                data += sizeof(value);
+            } else {
+                uint64_t encoded = 0;
+                int shift = 0;
+                uint8_t byte;
+                do {
+                    if (data == end || shift > 63) {
+                        return false;
+                    }
+                    byte = *data++;
+                    encoded |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    shift += 7;
+                } while (byte & 0x80);
+                value += UnZigZag(encoded);
+            }
+            timestamps[r] = value;
+        }
+        decodedGroup = group;
+        return true;
+    }
+};
+
+/**
+ * @brief Constructor
+ */
+FleetFileReader::FleetFileReader()
+    : m_state(nullptr) {
+}
+
+/**
+ * @brief Destructor
+ */
+FleetFileReader::~FleetFileReader() {
+    Close();
+}
+
+/**
+ * @brief Map and validate a fleet file
+ */
+bool FleetFileReader::Open(const std::string& path, std::string& error) {
+    Close();
+    State* state = new State();
+    if (!state->file.Map(path)) {
+        delete state;
+        error = "Cannot map " + path;
+        return false;
+    }
+
+    const uint8_t* data = state->file.Data();
+    size_t size = state->file.Size();
+    FileHeader header;
+    Trailer trailer;
+    bool valid = size >= sizeof(header) + sizeof(trailer);
+    if (valid) {
+        memcpy(&header, data, sizeof(header));
+        memcpy(&trailer, data + size - sizeof(trailer), sizeof(trailer));
+        valid = memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) == 0 &&
+                memcmp(trailer.magic, kTrailerMagic, sizeof(kTrailerMagic)) == 0 &&
+                header.version == kFileVersion && header.columnCount == kColumnCount &&
+                trailer.footerSize >= sizeof(FooterHeader) &&
+                state->InRange(trailer.footerOffset, trailer.footerSize);
+    }
+    if (valid) {
+        memcpy(&state->footer, data + trailer.footerOffset, sizeof(FooterHeader));
+        const FooterHeader& footer = state->footer;
+        valid = trailer.footerSize == sizeof(FooterHeader) + footer.groupCount * sizeof(GroupInfo) &&
+                footer.rowsPerGroup == kFleetFileRowsPerGroup &&
+                footer.groupCount == (footer.rowCount + kFleetFileRowsPerGroup - 1) / kFleetFileRowsPerGroup;
+        for (uint32_t c = 0; c < kColumnCount && valid; c++) {
+            valid = footer.columns[c].encoding == static_cast<uint32_t>(ExpectedEncoding(c)) ||
+                    (c == static_cast<uint32_t>(FleetFileColumn::Fingerprint) &&
+                     footer.columns[c].encoding == static_cast<uint32_t>(FleetFileEncoding::FixedWidth));
+        }
+    }
+    if (valid) {
+        state->groups.resize(state->footer.groupCount);
+        memcpy(state->groups.data(), data + trailer.footerOffset + sizeof(FooterHeader),
+               state->groups.size() * sizeof(GroupInfo));
+
+        // Groups are full except the last, so ReadRow() can locate a row by division
+        uint64_t rows = 0;
+        for (const GroupInfo& group : state->groups) {
+            valid = valid && group.firstRow == rows &&
+                    group.rows == std::min<uint64_t>(kFleetFileRowsPerGroup, state->footer.rowCount - rows);
+            rows += group.rows;
+            for (uint32_t c = 0; c < kColumnCount && valid; c++) {
+                const ChunkInfo& chunk = group.chunks[c];
+                FleetFileEncoding encoding = static_cast<FleetFileEncoding>(state->footer.columns[c].encoding);
+                uint64_t width = encoding == FleetFileEncoding::Dictionary ? sizeof(uint32_t) :
+                                 encoding == FleetFileEncoding::FixedWidth ? sizeof(uint64_t) : 0;
+                valid = state->InRange(chunk.offset, chunk.size) && chunk.offset % 8 == 0 &&
+                        chunk.size >= width * group.rows &&
+                        (chunk.bloomOffset == 0 || state->InRange(chunk.bloomOffset, kBloomBytes));
+            }
+        }
+        valid = valid && rows == state->footer.rowCount;
+    }
+    for (uint32_t c = 0; c < kColumnCount && valid; c++) {
+        const ColumnInfo& column = state->footer.columns[c];
+        if (column.encoding == static_cast<uint32_t>(FleetFileEncoding::Dictionary)) {
+            uint64_t tableSize = (column.dictionaryCount + 1) * sizeof(uint64_t);
+            valid = column.dictionaryCount < UINT32_MAX && state->InRange(column.dictionaryOffset, tableSize);
+            if (valid) {
+                uint64_t stringBytes;
+                memcpy(&stringBytes, data + column.dictionaryOffset + column.dictionaryCount * sizeof(uint64_t),
+                       sizeof(stringBytes));
+                valid = state->InRange(column.dictionaryOffset + tableSize, stringBytes);
+                state->dictionaryBytes[c] = stringBytes;
+            }
+            // Offsets start at 0 and never decrease, so every entry lies inside the string bytes
+            uint64_t previous = 0;
+            for (uint64_t i = 0; i <= column.dictionaryCount && valid; i++) {
+                uint64_t offset;
+                memcpy(&offset, data + column.dictionaryOffset + i * sizeof(uint64_t), sizeof(offset));
+                valid = i == 0 ? offset == 0 : offset >= previous;
+                previous = offset;
+            }
+        }
+    }
+
+    if (!valid) {
+        delete state;
+        error = path + " is not a valid fleet file";
+        return false;
+    }
+    m_state = state;
+    return true;
+}
+
+/**
+ * @brief Unmap the file
+ */
+void FleetFileReader::Close() {
+    delete m_state;
+    m_state = nullptr;
+}
+
+uint64_t FleetFileReader::RowCount() const {
+    return m_state ? m_state->footer.rowCount : 0;
+}
+
+uint32_t FleetFileReader::RowGroupCount() const {
+    return m_state ? m_state->footer.groupCount : 0;
+}
+
+FleetFileEncoding FleetFileReader::ColumnEncoding(FleetFileColumn column) const {
+    return static_cast<FleetFileEncoding>(m_state->footer.columns[static_cast<uint32_t>(column)].encoding);
+}
+
+/**
+ * @brief Find the rows matching a query
+ */
+std::vector<uint64_t> FleetFileReader::Filter(const FleetFileQuery& query, FleetFileScanStats* stats) {
+    std::vector<uint64_t> matches;
+    FleetFileScanStats scan = {};
+    if (!m_state) {
+        if (stats) {
+            *stats = scan;
+        }
+        return matches;
+    }
+    scan.rowGroups = m_state->footer.groupCount;
+
+    // Resolve string conditions to codes or digests; an unknown value matches nothing
+    struct Condition {
+        uint32_t column;
+        uint64_t value;
+    };
+    std::vector<Condition> conditions;
+    bool satisfiable = true;
+    for (const auto& equal : query.equals) {
+        uint32_t column = static_cast<uint32_t>(equal.first);
+        if (!IsStringColumn(column)) {
+            continue;
+        }
+        Condition condition = { column, 0 };
+        if (m_state->footer.columns[column].encoding == static_cast<uint32_t>(FleetFileEncoding::FixedWidth)) {
+            satisfiable = satisfiable && ParseDigest(equal.second, condition.value);
+        } else {
+            uint32_t code = 0;
+            satisfiable = satisfiable && m_state->FindCode(column, equal.second, code);
+            condition.value = code;
+        }
+        conditions.push_back(condition);
+    }
+    if (!satisfiable) {
+        scan.skippedRowGroups = scan.rowGroups;
+        if (stats) {
+            *stats = scan;
+        }
+        return matches;
+    }
+
+    const uint32_t macColumn = static_cast<uint32_t>(FleetFileColumn::PrimaryMac);
+    const uint32_t timeColumn = static_cast<uint32_t>(FleetFileColumn::RegisteredAt);
+    // Requiring the presence bit keeps rows without a MAC out of every prefix, "00" included
+    uint64_t macMask = (query.macMask & kMacBits) | kMacPresent;
+    uint64_t macLow = (query.macValue & macMask) | kMacPresent;
+    uint64_t macHigh = macLow | (~macMask & kMacBits);
+    bool exactMac = macMask == (kMacBits | kMacPresent);
+    const uint8_t* data = m_state->file.Data();
+
+    for (uint32_t g = 0; g < m_state->footer.groupCount; g++) {
+        const GroupInfo& group = m_state->groups[g];
+
+        // Predicate pushdown on footer metadata
+        bool skip = false;
+        for (const Condition& condition : conditions) {
+            const ChunkInfo& chunk = group.chunks[condition.column];
+            skip = skip || condition.value < chunk.minValue || condition.value > chunk.maxValue ||
+                   (chunk.bloomOffset && !BloomMayContain(data + chunk.bloomOffset, condition.value));
+        }
+        if (query.hasMacPrefix) {
+            const ChunkInfo& chunk = group.chunks[macColumn];
+            skip = skip || macHigh < chunk.minValue || macLow > chunk.maxValue ||
+                   (exactMac && chunk.bloomOffset && !BloomMayContain(data + chunk.bloomOffset, macLow));
+        }
+        const ChunkInfo& timeChunk = group.chunks[timeColumn];
+        skip = skip || (query.hasRegisteredAfter && static_cast<int64_t>(timeChunk.maxValue) < query.registeredAfterMs);
+        skip = skip || (query.hasRegisteredBefore && static_cast<int64_t>(timeChunk.minValue) >= query.registeredBeforeMs);
+        if (skip) {
+            scan.skippedRowGroups++;
+            continue;
+        }
+
+        // Row-level evaluation over the chunks the query touches
+        std::vector<uint8_t> selected(group.rows, 1);
+        for (const Condition& condition : conditions) {
+            const ChunkInfo& chunk = group.chunks[condition.column];
+            scan.bytesScanned += chunk.size;
+            if (m_state->footer.columns[condition.column].encoding == static_cast<uint32_t>(FleetFileEncoding::FixedWidth)) {
+                const uint64_t* values = reinterpret_cast<const uint64_t*>(data + chunk.offset);
+                for (uint32_t r = 0; r < group.rows; r++) {
+                    selected[r] &= static_cast<uint8_t>(values[r] == condition.value);
+                }
+            } else {
+                const uint32_t* values = reinterpret_cast<const uint32_t*>(data + chunk.offset);
+                uint32_t code = static_cast<uint32_t>(condition.value);
+                for (uint32_t r = 0; r < group.rows; r++) {
+                    selected[r] &= static_cast<uint8_t>(values[r] == code);
+                }
+            }
+        }
+        if (query.hasMacPrefix) {
+            const ChunkInfo& chunk = group.chunks[macColumn];
+            scan.bytesScanned += chunk.size;
+            const uint64_t* values = reinterpret_cast<const uint64_t*>(data + chunk.offset);
+            for (uint32_t r = 0; r < group.rows; r++) {
+                selected[r] &= static_cast<uint8_t>((values[r] & macMask) == macLow);
+            }
+        }
+        if (query.hasRegisteredAfter || query.hasRegisteredBefore) {
+            scan.bytesScanned += timeChunk.size;
+            if (!m_state->DecodeTimestamps(g)) {
+                continue;
+            }
+            for (uint32_t r = 0; r < group.rows; r++) {
+                int64_t time = m_state->timestamps[r];
+                bool inRange = (!query.hasRegisteredAfter || time >= query.registeredAfterMs) &&
+                               (!query.hasRegisteredBefore || time < query.registeredBeforeMs);
+                selected[r] &= static_cast<uint8_t>(inRange);
+            }
+        }
+
+        for (uint32_t r = 0; r < group.rows; r++) {
+            if (selected[r]) {
+                matches.push_back(group.firstRow + r);
+            }
+        }
+    }
+
+    if (stats) {
+        *stats = scan;
+    }
+    return matches;
+}
+
+/**
+ * @brief Read one row
+ */
+bool FleetFileReader::ReadRow(uint64_t row, FleetScalarRow& values) {
+    if (!m_state || row >= m_state->footer.rowCount) {
+        return false;
+    }
+    uint32_t g = static_cast<uint32_t>(row / m_state->footer.rowsPerGroup);
+    if (g >= m_state->groups.size()) {
+        return false;
+    }
+    const GroupInfo& group = m_state->groups[g];
+    uint32_t r = static_cast<uint32_t>(row - group.firstRow);
+    if (r >= group.rows) {
+        return false;
+    }
+
+    const uint8_t* data = m_state->file.Data();
+    std::string_view strings[5];
+    for (uint32_t c = 0; c < kColumnCount; c++) {
+        if (!IsStringColumn(c)) {
+            continue;
+        }
+        const ChunkInfo& chunk = group.chunks[c];
+        if (m_state->footer.columns[c].encoding == static_cast<uint32_t>(FleetFileEncoding::FixedWidth)) {
+            uint64_t digest;
+            memcpy(&digest, data + chunk.offset + r * sizeof(uint64_t), sizeof(digest));
+            int length = snprintf(m_state->fingerprint, sizeof(m_state->fingerprint), "%llx",
+                                  static_cast<unsigned long long>(digest));
+            strings[c] = std::string_view(m_state->fingerprint, static_cast<size_t>(length));
+        } else {
+            uint32_t code;
+            memcpy(&code, data + chunk.offset + r * sizeof(uint32_t), sizeof(code));
+            strings[c] = m_state->DictionaryValue(c, code);
+        }
+    }
+    values.cpuId = strings[static_cast<uint32_t>(FleetFileColumn::CpuId)];
+    values.motherboardSerial = strings[static_cast<uint32_t>(FleetFileColumn::MotherboardSerial)];
+    values.biosSerial = strings[static_cast<uint32_t>(FleetFileColumn::BiosSerial)];
+    values.fingerprint = strings[static_cast<uint32_t>(FleetFileColumn::Fingerprint)];
+    values.firstDiskSerial = strings[static_cast<uint32_t>(FleetFileColumn::FirstDiskSerial)];
+
+    const ChunkInfo& macChunk = group.chunks[static_cast<uint32_t>(FleetFileColumn::PrimaryMac)];
+    uint64_t mac;
+    memcpy(&mac, data + macChunk.offset + r * sizeof(uint64_t), sizeof(mac));
+    values.primaryMac = mac & kMacBits;
+    values.hasPrimaryMac = (mac & kMacPresent) != 0;
+
+    if (!m_state->DecodeTimestamps(g)) {
+        return false;
+    }
+    values.registeredAtMs = m_state->timestamps[r];
+    return true;
+}
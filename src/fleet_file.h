@@ -0,0 +1,172 @@
+#ifndef FLEET_FILE_H
+#define FLEET_FILE_H
+
+#include "fleet_registry.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Columns of a fleet file
+ */
+enum class FleetFileColumn : uint32_t {
+    CpuId = 0,
+    MotherboardSerial,
+    BiosSerial,
+    Fingerprint,
+    FirstDiskSerial,
+    PrimaryMac,
+    RegisteredAt,
+    Count
+};
+
+/**
+ * @brief Column chunk encodings
+ */
+enum class FleetFileEncoding : uint32_t {
+    Dictionary = 1,     // Sorted column dictionary plus 32-bit codes per row
+    FixedWidth = 2,     // 64-bit little-endian values (digests, MAC addresses)
+    Delta = 3           // First value, then zigzag varint deltas (timestamps)
+};
+
+/**
+ * @brief Rows per row group
+ */
+constexpr uint32_t kFleetFileRowsPerGroup = 65536;
+
+/**
+ * @brief Supplies row values to the writer
+ * @param index Row index below the row count
+ * @param row Receives the row values
+ * @return false to abort writing
+ */
+using FleetFileRowSource = std::function<bool(uint64_t index, FleetScalarRow& row)>;
+
+/**
+ * @brief Write a columnar fleet file
+ *
+ * Layout: header, column dictionaries, row groups of column chunks, then a
+ * footer with per-chunk offsets, min/max values and Bloom filters, and a
+ * fixed-size trailer locating the footer. Hex fingerprints of up to 16
+ * digits are stored as fixed-width digests, other fingerprints through a
+ * dictionary. The primary MAC column sets bit 48 when the row has a MAC,
+ * so MAC prefix queries skip rows without one, as in FleetTable.
+ *
+ * @param path Output file
+ * @param rowCount Number of rows
+ * @param source Row values, read twice (dictionaries, then chunks)
+ * @param error Receives a description on failure
+ * @return true on success
+ */
+bool WriteFleetFile(const std::string& path, uint64_t rowCount, const FleetFileRowSource& source, std::string& error);
+
+/**
+ * @brief Fleet file query; all set conditions must match
+ */
+struct FleetFileQuery {
+    /**
+     * @brief Exact matches on string columns (CpuId through FirstDiskSerial)
+     */
+    std::vector<std::pair<FleetFileColumn, std::string>> equals;
+
+    bool hasMacPrefix = false;
+    uint64_t macValue = 0;
+    uint64_t macMask = 0;
+    bool hasRegisteredAfter = false;
+    int64_t registeredAfterMs = 0;      // Inclusive
+    bool hasRegisteredBefore = false;
+    int64_t registeredBeforeMs = 0;     // Exclusive
+};
+
+/**
+ * @brief Work done by a fleet file scan
+ */
+struct FleetFileScanStats {
+    uint32_t rowGroups;
+    uint32_t skippedRowGroups;      // Pruned by dictionary, min/max or Bloom metadata
+    uint64_t bytesScanned;          // Column chunk bytes touched
+};
+
+/**
+ * @brief Memory-mapped fleet file reader
+ *
+ * Opening maps the file and validates the trailer, footer and dictionary
+ * offset tables, so its cost does not grow with the row count. Column chunks are decoded lazily when a
+ * query or row read needs them; dictionary values are string views into
+ * the mapping. Queries are pushed down to row groups: a group is skipped
+ * when a value is absent from the dictionary, outside the chunk min/max, or
+ * rejected by the chunk Bloom filter.
+ */
+class FleetFileReader {
+public:
+    FleetFileReader();
+    ~FleetFileReader();
+
+    FleetFileReader(const FleetFileReader&) = delete;
+    FleetFileReader& operator=(const FleetFileReader&) = delete;
+
+    /**
+     * @brief Map and validate a fleet file
+     *
+     * Rejects files whose footer does not describe the writer's layout:
+     * other row group sizes, unknown column encodings, chunks or
+     * dictionaries outside the file, and offset tables that decrease.
+     *
+     * @param path File to open
+     * @param error Receives a description on failure
+     * @return true on success
+     */
+    bool Open(const std::string& path, std::string& error);
+
+    /**
+     * @brief Unmap the file
+     */
+    void Close();
+
+    /**
+     * @brief Get the number of rows
+     */
+    uint64_t RowCount() const;
+
+    /**
+     * @brief Get the number of row groups
+     */
+    uint32_t RowGroupCount() const;
+
+    /**
+     * @brief Get the encoding of a column
+     */
+    FleetFileEncoding ColumnEncoding(FleetFileColumn column) const;
+
+    /**
+     * @brief Find the rows matching a query
+     * @param query Conditions
+     * @param stats Receives scan statistics (optional)
+     * @return Matching row numbers in ascending order
+     */
+    std::vector<uint64_t> Filter(const FleetFileQuery& query, FleetFileScanStats* stats = nullptr);
+
+    /**
+     * @brief Read one row
+     * @param row Row number
+     * @param values Receives views into the mapping (a fixed-width
+     *               fingerprint is formatted into reader storage that is
+     *               reused by the next call)
+     * @return false if the row is out of range or corrupt
+     */
+    bool ReadRow(uint64_t row, FleetScalarRow& values);
+
+    /**
+     * @brief Opaque footer and mapping state (defined in fleet_file.cpp)
+     */
+    struct State;
+
+private:
+    State* m_state;
+};
+
+#endif // FLEET_FILE_H
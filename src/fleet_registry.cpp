@@ -0,0 +1,271 @@
+#include "fleet_registry.h"
+#include "mac_address.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+/**
+ * @brief Constructor
+ */
+FleetRegistry::FleetRegistry()
+    : m_logicalBytes(0) {
+}
+
+/**
+ * @brief Register a snapshot
+ */
+uint32_t FleetRegistry::Register(const ArenaSnapshot& snapshot, int64_t registeredAtMs) {
+    // Intern before taking the registry lock; the interner is concurrent
+    std::shared_lock<std::shared_mutex> clearLock(m_clearMutex);
+    FleetPlatform platform;
+    platform.cpuId = m_interner.Intern(snapshot.CpuId());
+    platform.motherboardSerial = m_interner.Intern(snapshot.MotherboardSerial());
+    platform.biosSerial = m_interner.Intern(snapshot.BiosSerial());
+    InternId fingerprint = m_interner.Intern(snapshot.Fingerprint());
+    if (registeredAtMs == kRegisteredNow) {
+        registeredAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    uint64_t logicalBytes = snapshot.CpuId().size() + snapshot.MotherboardSerial().size() +
+                            snapshot.BiosSerial().size() + snapshot.Fingerprint().size();
+
+    std::vector<InternId> listIds;
+    listIds.reserve(snapshot.DiskSerialCount() + snapshot.MacAddressCount());
+    for (size_t i = 0; i < snapshot.DiskSerialCount(); i++) {
+        listIds.push_back(m_interner.Intern(snapshot.DiskSerial(i)));
+        logicalBytes += snapshot.DiskSerial(i).size();
+    }
+    uint32_t diskSerialCount = static_cast<uint32_t>(listIds.size());
+    for (size_t i = 0; i < snapshot.MacAddressCount(); i++) {
+        listIds.push_back(m_interner.Intern(snapshot.MacAddress(i)));
+        logicalBytes += snapshot.MacAddress(i).size();
+    }
+    uint32_t macAddressCount = static_cast<uint32_t>(listIds.size()) - diskSerialCount;
+
+    InternId columns[5] = {
+        platform.cpuId, platform.motherboardSerial, platform.biosSerial, fingerprint,
+        diskSerialCount ? listIds[0] : kEmptyInternId
+    };
+    MacAddress primaryMac;
+    bool hasPrimaryMac = snapshot.MacAddressCount() != 0 && ParseMacAddress(snapshot.MacAddress(0), primaryMac);
+    if (!hasPrimaryMac) {
+        primaryMac.value = 0;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    FleetSnapshotTuple tuple;
+    tuple.platform = ConsPlatform(platform);
+    tuple.diskSerials = ConsList(listIds.data(), diskSerialCount);
+    tuple.macAddresses = ConsList(listIds.data() + diskSerialCount, macAddressCount);
+    tuple.fingerprint = fingerprint;
+    tuple.timedOutComponents = snapshot.TimedOutComponents();
+
+    FleetRecord record = {};
+    record.snapshot = ConsSnapshot(tuple);
+    record.registeredAtMs = registeredAtMs;
+    m_records.push_back(record);
+    m_table.Append(columns, primaryMac.value, hasPrimaryMac);
+    m_logicalBytes += logicalBytes;
+    return static_cast<uint32_t>(m_records.size() - 1);
+}
+
+/**
+ * @brief Find or add a platform tuple
+ */
+uint32_t FleetRegistry::ConsPlatform(const FleetPlatform& platform) {
+    auto inserted = m_platformIds.emplace(platform, static_cast<uint32_t>(m_platforms.size()));
+    if (inserted.second) {
+        m_platforms.push_back(platform);
+    }
+    return inserted.first->second;
+}
+
+/**
+ * @brief Find or add an identifier list
+ */
+uint32_t FleetRegistry::ConsList(const InternId* ids, uint32_t count) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ count;
+    for (uint32_t i = 0; i < count; i++) {
+        hash = (hash ^ ids[i]) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+
+    auto range = m_listIdsByHash.equal_range(static_cast<size_t>(hash));
+    for (auto it = range.first; it != range.second; ++it) {
+        const FleetList& list = m_lists[it->second];
+        if (list.count == count && std::equal(ids, ids + count, m_listIds.begin() + list.first)) {
+            return it->second;
+        }
+    }
+
+    FleetList list;
+    list.first = static_cast<uint32_t>(m_listIds.size());
+    list.count = count;
+    m_listIds.insert(m_listIds.end(), ids, ids + count);
+    uint32_t listId = static_cast<uint32_t>(m_lists.size());
+    m_lists.push_back(list);
+    m_listIdsByHash.emplace(static_cast<size_t>(hash), listId);
+    return listId;
+}
+
+/**
+ * @brief Find or add a snapshot tuple
+ */
+uint32_t FleetRegistry::ConsSnapshot(const FleetSnapshotTuple& snapshot) {
+    auto inserted = m_snapshotIds.emplace(snapshot, static_cast<uint32_t>(m_snapshots.size()));
+    if (inserted.second) {
+        m_snapshots.push_back(snapshot);
+    }
+    return inserted.first->second;
+}
+
+/**
+ * @brief Register collected identifiers
+ */
+uint32_t FleetRegistry::Register(const HardwareInfo& info, int64_t registeredAtMs) {
+    return Register(ArenaSnapshot(info), registeredAtMs);
+}
+
+size_t FleetRegistry::Size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_records.size();
+}
+
+/**
+ * @brief Expand a registered record
+ */
+bool FleetRegistry::GetRecord(uint32_t index, HardwareInfo& info) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (index >= m_records.size()) {
+        return false;
+    }
+
+    const FleetSnapshotTuple& snapshot = m_snapshots[m_records[index].snapshot];
+    const FleetPlatform& platform = m_platforms[snapshot.platform];
+    info.cpuId = std::string(m_interner.Lookup(platform.cpuId));
+    info.motherboardSerial = std::string(m_interner.Lookup(platform.motherboardSerial));
+    info.biosSerial = std::string(m_interner.Lookup(platform.biosSerial));
+    info.fingerprint = std::string(m_interner.Lookup(snapshot.fingerprint));
+    info.timedOutComponents = snapshot.timedOutComponents;
+    const FleetList& disks = m_lists[snapshot.diskSerials];
+    info.diskSerials.clear();
+    for (uint32_t i = 0; i < disks.count; i++) {
+        info.diskSerials.emplace_back(m_interner.Lookup(m_listIds[disks.first + i]));
+    }
+    const FleetList& macs = m_lists[snapshot.macAddresses];
+    info.macAddresses.clear();
+    for (uint32_t i = 0; i < macs.count; i++) {
+        info.macAddresses.emplace_back(m_interner.Lookup(m_listIds[macs.first + i]));
+    }
+    return true;
+}
+
+/**
+ * @brief Get the hash-consed snapshot ID of a record
+ */
+bool FleetRegistry::GetSnapshotId(uint32_t index, uint32_t& snapshotId) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (index >= m_records.size()) {
+        return false;
+    }
+    snapshotId = m_records[index].snapshot;
+    return true;
+}
+
+/**
+ * @brief Get the registration time of a record
+ */
+int64_t FleetRegistry::GetRegisteredAt(uint32_t index) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return index < m_records.size() ? m_records[index].registeredAtMs : 0;
+}
+
+/**
+ * @brief Get the scalar fields of a record
+ */
+bool FleetRegistry::GetScalarRow(uint32_t index, FleetScalarRow& row) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (index >= m_records.size()) {
+        return false;
+    }
+
+    const FleetRecord& record = m_records[index];
+    const FleetSnapshotTuple& snapshot = m_snapshots[record.snapshot];
+    const FleetPlatform& platform = m_platforms[snapshot.platform];
+    const FleetList& disks = m_lists[snapshot.diskSerials];
+    row.cpuId = m_interner.Lookup(platform.cpuId);
+    row.motherboardSerial = m_interner.Lookup(platform.motherboardSerial);
+    row.biosSerial = m_interner.Lookup(platform.biosSerial);
+    row.fingerprint = m_interner.Lookup(snapshot.fingerprint);
+    row.firstDiskSerial = disks.count ? m_interner.Lookup(m_listIds[disks.first]) : std::string_view();
+    row.primaryMac = m_table.PrimaryMac(index);
+    row.hasPrimaryMac = m_table.HasPrimaryMac(index);
+    row.registeredAtMs = record.registeredAtMs;
+    return true;
+}
+
+/**
+ * @brief Find every record with a fingerprint
+ */
+std::vector<uint32_t> FleetRegistry::FindByFingerprint(std::string_view fingerprint) const {
+    InternId id;
+    if (!m_interner.Find(fingerprint, id)) {
+        return std::vector<uint32_t>();
+    }
+    return Filter({ FleetPredicate{ FleetColumn::Fingerprint, id, 0 } }, 1);
+}
+
+/**
+ * @brief Resolve a string value to its interned identifier
+ */
+bool FleetRegistry::Resolve(std::string_view value, InternId& id) const {
+    return m_interner.Find(value, id);
+}
+
+/**
+ * @brief Scan the columnar table for records matching every predicate
+ */
+std::vector<uint32_t> FleetRegistry::Filter(const std::vector<FleetPredicate>& predicates, unsigned threads) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_table.Filter(predicates, threads);
+}
+
+/**
+ * @brief Get memory statistics
+ */
+FleetRegistryStats FleetRegistry::GetStats() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    FleetRegistryStats stats;
+    stats.records = m_records.size();
+    stats.uniqueStrings = m_interner.Size();
+    stats.internedBytes = m_interner.StoredBytes();
+    stats.logicalBytes = m_logicalBytes;
+    stats.recordBytes = m_records.size() * sizeof(FleetRecord) + m_platforms.size() * sizeof(FleetPlatform) +
+                        m_lists.size() * sizeof(FleetList) + m_snapshots.size() * sizeof(FleetSnapshotTuple) +
+                        m_listIds.size() * sizeof(InternId);
+    stats.columnBytes = m_table.ColumnBytes();
+    stats.uniquePlatforms = m_platforms.size();
+    stats.uniqueLists = m_lists.size();
+    stats.uniqueSnapshots = m_snapshots.size();
+    return stats;
+}
+
+/**
+ * @brief Remove every record and interned value
+ */
+void FleetRegistry::Clear() {
+    std::unique_lock<std::shared_mutex> clearLock(m_clearMutex);
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_records.clear();
+    m_platforms.clear();
+    m_platformIds.clear();
+    m_lists.clear();
+    m_listIdsByHash.clear();
+    m_listIds.clear();
+    m_snapshots.clear();
+    m_snapshotIds.clear();
+    m_table.Clear();
+    m_logicalBytes = 0;
+    m_interner.Clear();
+}
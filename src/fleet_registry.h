@@ -0,0 +1,263 @@
+#ifndef FLEET_REGISTRY_H
+#define FLEET_REGISTRY_H
+
+#include "hardware_info.h"
+#include "arena_snapshot.h"
+#include "string_interner.h"
+#include "fleet_table.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Hash-consed platform tuple (processor, board and firmware)
+ */
+struct FleetPlatform {
+    InternId cpuId;
+    InternId motherboardSerial;
+    InternId biosSerial;
+};
+
+/**
+ * @brief Hash-consed identifier list (a range in the registry's list storage)
+ */
+struct FleetList {
+    uint32_t first;
+    uint32_t count;
+};
+
+/**
+ * @brief Hash-consed snapshot: platform, identifier lists and fingerprint
+ *
+ * Identical snapshots share one entry, so comparing two registered
+ * snapshots is comparing their snapshot IDs.
+ */
+struct FleetSnapshotTuple {
+    uint32_t platform;
+    uint32_t diskSerials;
+    uint32_t macAddresses;
+    InternId fingerprint;
+    uint32_t timedOutComponents;
+};
+
+/**
+ * @brief Registered hardware record
+ */
+struct FleetRecord {
+    uint32_t snapshot;              // Hash-consed snapshot ID
+    uint32_t reserved;
+    int64_t registeredAtMs;         // Registration time, milliseconds since the Unix epoch
+};
+
+/**
+ * @brief Hash of a tuple of 32-bit identifiers
+ */
+struct FleetTupleHash {
+    template <typename Tuple>
+    size_t operator()(const Tuple& tuple) const {
+        static_assert(sizeof(Tuple) % sizeof(uint32_t) == 0, "Tuple must consist of 32-bit fields");
+        uint32_t words[sizeof(Tuple) / sizeof(uint32_t)];
+        memcpy(words, &tuple, sizeof(Tuple));
+        uint64_t hash = 0x9E3779B97F4A7C15ULL;
+        for (uint32_t word : words) {
+            hash = (hash ^ word) * 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 32;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+/**
+ * @brief Byte-wise equality of identifier tuples
+ */
+struct FleetTupleEqual {
+    template <typename Tuple>
+    bool operator()(const Tuple& a, const Tuple& b) const {
+        return memcmp(&a, &b, sizeof(Tuple)) == 0;
+    }
+};
+
+/**
+ * @brief Scalar fields of a registered record
+ *
+ * Views point into registry (or file) storage and stay valid until the
+ * registry is cleared (or the file closed).
+ */
+struct FleetScalarRow {
+    std::string_view cpuId;
+    std::string_view motherboardSerial;
+    std::string_view biosSerial;
+    std::string_view fingerprint;
+    std::string_view firstDiskSerial;
+    uint64_t primaryMac;            // 48-bit MAC address of the first adapter, 0 if none
+    bool hasPrimaryMac;             // False when the record has no parseable MAC address
+    int64_t registeredAtMs;
+};
+
+/**
+ * @brief Fleet registry memory statistics
+ */
+struct FleetRegistryStats {
+    uint64_t records;
+    uint64_t uniqueStrings;
+    uint64_t internedBytes;    // Bytes of distinct string values
+    uint64_t logicalBytes;     // Bytes the registered values would take without interning
+    uint64_t recordBytes;      // Bytes of records, hash-consed tuples and list identifiers
+    uint64_t columnBytes;      // Bytes of the columnar scan table
+    uint64_t uniquePlatforms;  // Distinct processor, board and firmware tuples
+    uint64_t uniqueLists;      // Distinct disk serial and MAC address lists
+    uint64_t uniqueSnapshots;  // Distinct snapshots
+};
+
+/**
+ * @brief In-memory registry of fleet hardware records
+ *
+ * Values that repeat across a fleet (CPU IDs of one processor model, BIOS
+ * placeholder serials, virtual NIC prefixes) are stored once in a
+ * StringInterner; records only hold 32-bit identifiers, and equality
+ * checks between records are integer compares. Identifier tuples are
+ * hash-consed on top of that: platform tuples, disk and MAC lists, and
+ * whole snapshots are each stored once, so cloned images and machines of
+ * one model share storage and snapshot equality is an ID compare.
+ * Registration interns outside the registry lock, so batch workers can
+ * register concurrently. Scalar fields are also kept in a FleetTable for
+ * columnar SIMD scans.
+ */
+class FleetRegistry {
+public:
+    FleetRegistry();
+
+    FleetRegistry(const FleetRegistry&) = delete;
+    FleetRegistry& operator=(const FleetRegistry&) = delete;
+
+    /**
+     * @brief Registration time that stands for the time of the Register() call
+     *
+     * Every real time, including 0 (the epoch), can be registered as is.
+     */
+    static constexpr int64_t kRegisteredNow = INT64_MIN;
+
+    /**
+     * @brief Register a snapshot
+     * @param snapshot Collected identifiers
+     * @param registeredAtMs Registration time in milliseconds since the epoch, kRegisteredNow for now
+     * @return Record index
+     */
+    uint32_t Register(const ArenaSnapshot& snapshot, int64_t registeredAtMs = kRegisteredNow);
+
+    /**
+     * @brief Register collected identifiers
+     * @param info Collected identifiers
+     * @param registeredAtMs Registration time in milliseconds since the epoch, kRegisteredNow for now
+     * @return Record index
+     */
+    uint32_t Register(const HardwareInfo& info, int64_t registeredAtMs = kRegisteredNow);
+
+    /**
+     * @brief Get the number of registered records
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Expand a registered record
+     * @param index Record index
+     * @param info Receives the record values
+     * @return false if the index is out of range
+     */
+    bool GetRecord(uint32_t index, HardwareInfo& info) const;
+
+    /**
+     * @brief Get the hash-consed snapshot ID of a record
+     *
+     * Records with identical collected values share a snapshot ID.
+     *
+     * @param index Record index
+     * @param snapshotId Receives the snapshot ID
+     * @return false if the index is out of range
+     */
+    bool GetSnapshotId(uint32_t index, uint32_t& snapshotId) const;
+
+    /**
+     * @brief Get the registration time of a record
+     * @param index Record index
+     * @return Milliseconds since the epoch, 0 for an unknown index
+     */
+    int64_t GetRegisteredAt(uint32_t index) const;
+
+    /**
+     * @brief Get the scalar fields of a record
+     * @param index Record index
+     * @param row Receives views of the record values
+     * @return false if the index is out of range
+     */
+    bool GetScalarRow(uint32_t index, FleetScalarRow& row) const;
+
+    /**
+     * @brief Find every record with a fingerprint
+     * @param fingerprint Fingerprint to match
+     * @return Indices of matching records
+     */
+    std::vector<uint32_t> FindByFingerprint(std::string_view fingerprint) const;
+
+    /**
+     * @brief Resolve a string value to its interned identifier
+     * @param value Value to look up
+     * @param id Receives the identifier
+     * @return false if no registered record contains the value
+     */
+    bool Resolve(std::string_view value, InternId& id) const;
+
+    /**
+     * @brief Scan the columnar table for records matching every predicate
+     * @param predicates Conditions on interned identifiers and the primary MAC
+     * @param threads Scan threads, 0 for the CPU count
+     * @return Matching record indices in ascending order
+     */
+    std::vector<uint32_t> Filter(const std::vector<FleetPredicate>& predicates, unsigned threads) const;
+
+    /**
+     * @brief Get memory statistics
+     */
+    FleetRegistryStats GetStats() const;
+
+    /**
+     * @brief Remove every record and interned value
+     */
+    void Clear();
+
+private:
+    /**
+     * @brief Find or add a platform tuple; caller holds m_mutex exclusively
+     */
+    uint32_t ConsPlatform(const FleetPlatform& platform);
+
+    /**
+     * @brief Find or add an identifier list; caller holds m_mutex exclusively
+     */
+    uint32_t ConsList(const InternId* ids, uint32_t count);
+
+    /**
+     * @brief Find or add a snapshot tuple; caller holds m_mutex exclusively
+     */
+    uint32_t ConsSnapshot(const FleetSnapshotTuple& snapshot);
+
+    StringInterner m_interner;
+    std::shared_mutex m_clearMutex;        // Shared by registrations, exclusive for Clear()
+    mutable std::shared_mutex m_mutex;     // Guards records and hash-consed tuples
+    std::vector<FleetRecord> m_records;
+    std::vector<FleetPlatform> m_platforms;
+    std::unordered_map<FleetPlatform, uint32_t, FleetTupleHash, FleetTupleEqual> m_platformIds;
+    std::vector<FleetList> m_lists;
+    std::unordered_multimap<size_t, uint32_t> m_listIdsByHash;
+    std::vector<InternId> m_listIds;       // Storage of the hash-consed lists
+    std::vector<FleetSnapshotTuple> m_snapshots;
+    std::unordered_map<FleetSnapshotTuple, uint32_t, FleetTupleHash, FleetTupleEqual> m_snapshotIds;
+    FleetTable m_table;                    // Columnar copy of the scalar record fields
+    uint64_t m_logicalBytes;
+};
+
+#endif // FLEET_REGISTRY_H
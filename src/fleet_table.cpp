@@ -0,0 +1,340 @@
+#include "fleet_table.h"
+#include "cpu_features.h"
+#include <algorithm>
+#include <bitset>
+#include <thread>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(HWID_ARCH_X86)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLEET_TABLE_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define FLEET_TABLE_NEON 1
+#endif
+
+/**
+ * @brief Rows per bitmap word
+ */
+static constexpr size_t kRowsPerWord = 64;
+
+/**
+ * @brief Rows per scan thread below which a scan stays single-threaded
+ */
+static constexpr size_t kMinRowsPerThread = 1 << 20;
+
+/**
+ * @brief Get the index of the lowest set bit of a non-zero word
+ */
+static inline unsigned LowestSetBit(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, static_cast<unsigned long>(word))) {
+        return index;
+    }
+    _BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+    return index + 32;
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+/**
+ * @brief Compare up to 64 32-bit values with a constant
+ * @return Bit i set if values[i] == value
+ */
+using MatchEqual32Fn = uint64_t (*)(const uint32_t* values, size_t count, uint32_t value);
+
+/**
+ * @brief Compare up to 64 masked 64-bit values with a constant
+ * @return Bit i set if (values[i] & mask) == value
+ */
+using MatchMaskedEqual64Fn = uint64_t (*)(const uint64_t* values, size_t count, uint64_t value, uint64_t mask);
+
+static uint64_t MatchEqual32Scalar(const uint32_t* values, size_t count, uint32_t value) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < count; i++) {
+        bits |= static_cast<uint64_t>(values[i] == value) << i;
+    }
+    return bits;
+}
+
+static uint64_t MatchMaskedEqual64Scalar(const uint64_t* values, size_t count, uint64_t value, uint64_t mask) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < count; i++) {
+        bits |= static_cast<uint64_t>((values[i] & mask) == value) << i;
+    }
+    return bits;
+}
+
+#if defined(HWID_ARCH_X86)
+HWID_TARGET("avx2")
+static uint64_t MatchEqual32Avx2(const uint32_t* values, size_t count, uint32_t value) {
+    uint64_t bits = 0;
+    size_t i = 0;
+    __m256i needle = _mm256_set1_epi32(static_cast<int>(value));
+    for (; i + 8 <= count; i += 8) {
+        __m256i row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(row, needle))));
+        bits |= static_cast<uint64_t>(mask) << i;
+    }
+    return bits | (MatchEqual32Scalar(values + i, count - i, value) << (i & 63));
+}
+
+HWID_TARGET("avx2")
+static uint64_t MatchMaskedEqual64Avx2(const uint64_t* values, size_t count, uint64_t value, uint64_t mask) {
+    uint64_t bits = 0;
+    size_t i = 0;
+    __m256i needle = _mm256_set1_epi64x(static_cast<long long>(value));
+    __m256i maskVector = _mm256_set1_epi64x(static_cast<long long>(mask));
+    for (; i + 4 <= count; i += 4) {
+        __m256i row = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)), maskVector);
+        uint32_t lanes = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(row, needle))));
+        bits |= static_cast<uint64_t>(lanes) << i;
+    }
+    return bits | (MatchMaskedEqual64Scalar(values + i, count - i, value, mask) << (i & 63));
+}
+#endif
+
+#if defined(FLEET_TABLE_SSE2)
+static uint64_t MatchEqual32Sse2(const uint32_t* values, size_t count, uint32_t value) {
+    uint64_t bits = 0;
+    size_t i = 0;
+    __m128i needle = _mm_set1_epi32(static_cast<int>(value));
+    for (; i + 4 <= count; i += 4) {
+        __m128i row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(row, needle))));
+        bits |= static_cast<uint64_t>(mask) << i;
+    }
+    return bits | (MatchEqual32Scalar(values + i, count - i, value) << (i & 63));
+}
+
+static uint64_t MatchMaskedEqual64Sse2(const uint64_t* values, size_t count, uint64_t value, uint64_t mask) {
+    uint64_t bits = 0;
+    size_t i = 0;
+    __m128i needle = _mm_set1_epi64x(static_cast<long long>(value));
+    __m128i maskVector = _mm_set1_epi64x(static_cast<long long>(mask));
+    for (; i + 2 <= count; i += 2) {
+        __m128i row = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), maskVector);
+        // SSE2 has no 64-bit compare: both 32-bit halves must match
+        __m128i equal32 = _mm_cmpeq_epi32(row, needle);
+        __m128i equal64 = _mm_and_si128(equal32, _mm_shuffle_epi32(equal32, _MM_SHUFFLE(2, 3, 0, 1)));
+        uint32_t lanes = static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(equal64)));
+        bits |= static_cast<uint64_t>(lanes) << i;
+    }
+    return bits | (MatchMaskedEqual64Scalar(values + i, count - i, value, mask) << (i & 63));
+}
+#elif defined(FLEET_TABLE_NEON)
+static uint64_t MatchEqual32Neon(const uint32_t* values, size_t count, uint32_t value) {
+    static const uint32_t kWeights[4] = {1, 2, 4, 8};
+    uint64_t bits = 0;
+    size_t i = 0;
+    uint32x4_t weights = vld1q_u32(kWeights);
+    uint32x4_t needle = vdupq_n_u32(value);
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t equal = vceqq_u32(vld1q_u32(values + i), needle);
+        uint32_t mask = vaddvq_u32(vandq_u32(equal, weights));
+        bits |= static_cast<uint64_t>(mask) << i;
+    }
+    return bits | (MatchEqual32Scalar(values + i, count - i, value) << (i & 63));
+}
+
+static uint64_t MatchMaskedEqual64Neon(const uint64_t* values, size_t count, uint64_t value, uint64_t mask) {
+    uint64_t bits = 0;
+    size_t i = 0;
+    uint64x2_t needle = vdupq_n_u64(value);
+    uint64x2_t maskVector = vdupq_n_u64(mask);
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t equal = vceqq_u64(vandq_u64(vld1q_u64(values + i), maskVector), needle);
+        uint64_t lanes = (vgetq_lane_u64(equal, 0) & 1) | (vgetq_lane_u64(equal, 1) & 2);
+        bits |= lanes << i;
+    }
+    return bits | (MatchMaskedEqual64Scalar(values + i, count - i, value, mask) << (i & 63));
+}
+#endif
+
+/**
+ * @brief Select the best 32-bit compare kernel for the running CPU
+ */
+static MatchEqual32Fn SelectMatchEqual32() {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    (void)cpu;
+#if defined(HWID_ARCH_X86)
+    if (cpu.avx2) {
+        RecordKernelVariant("fleetTable.matchEqual32", "avx2");
+        return MatchEqual32Avx2;
+    }
+#endif
+#if defined(FLEET_TABLE_SSE2)
+    if (cpu.sse2) {
+        RecordKernelVariant("fleetTable.matchEqual32", "sse2");
+        return MatchEqual32Sse2;
+    }
+#elif defined(FLEET_TABLE_NEON)
+    if (cpu.neon) {
+        RecordKernelVariant("fleetTable.matchEqual32", "neon");
+        return MatchEqual32Neon;
+    }
+#endif
+    RecordKernelVariant("fleetTable.matchEqual32", "scalar");
+    return MatchEqual32Scalar;
+}
+
+/**
+ * @brief Select the best masked 64-bit compare kernel for the running CPU
+ */
+static MatchMaskedEqual64Fn SelectMatchMaskedEqual64() {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    (void)cpu;
+#if defined(HWID_ARCH_X86)
+    if (cpu.avx2) {
+        RecordKernelVariant("fleetTable.matchMaskedEqual64", "avx2");
+        return MatchMaskedEqual64Avx2;
+    }
+#endif
+#if defined(FLEET_TABLE_SSE2)
+    if (cpu.sse2) {
+        RecordKernelVariant("fleetTable.matchMaskedEqual64", "sse2");
+        return MatchMaskedEqual64Sse2;
+    }
+#elif defined(FLEET_TABLE_NEON)
+    if (cpu.neon) {
+        RecordKernelVariant("fleetTable.matchMaskedEqual64", "neon");
+        return MatchMaskedEqual64Neon;
+    }
+#endif
+    RecordKernelVariant("fleetTable.matchMaskedEqual64", "scalar");
+    return MatchMaskedEqual64Scalar;
+}
+
+// Resolved while the module loads, before any scan
+static const MatchEqual32Fn MatchEqual32 = SelectMatchEqual32();
+static const MatchMaskedEqual64Fn MatchMaskedEqual64 = SelectMatchMaskedEqual64();
+
+/**
+ * @brief Append a row
+ */
+uint32_t FleetTable::Append(const InternId (&ids)[5], uint64_t primaryMac, bool hasPrimaryMac) {
+    for (uint32_t c = 0; c < kIdColumnCount; c++) {
+        m_ids[c].push_back(ids[c]);
+    }
+    size_t row = m_primaryMac.size();
+    m_primaryMac.push_back(hasPrimaryMac ? primaryMac : 0);
+    if (row % kRowsPerWord == 0) {
+        m_hasPrimaryMac.push_back(0);
+    }
+    if (hasPrimaryMac) {
+        m_hasPrimaryMac[row / kRowsPerWord] |= 1ULL << (row % kRowsPerWord);
+    }
+    return static_cast<uint32_t>(row);
+}
+
+size_t FleetTable::Size() const {
+    return m_primaryMac.size();
+}
+
+uint64_t FleetTable::PrimaryMac(uint32_t row) const {
+    return m_primaryMac[row];
+}
+
+bool FleetTable::HasPrimaryMac(uint32_t row) const {
+    return (m_hasPrimaryMac[row / kRowsPerWord] >> (row % kRowsPerWord)) & 1;
+}
+
+/**
+ * @brief Evaluate all predicates over a word-aligned row range into a bitmap
+ */
+void FleetTable::ScanRange(const std::vector<FleetPredicate>& predicates, size_t begin, size_t end,
+                           uint64_t* bits) const {
+    for (size_t row = begin; row < end; row += kRowsPerWord) {
+        size_t count = std::min(kRowsPerWord, end - row);
+        uint64_t word = count == kRowsPerWord ? ~0ULL : ((1ULL << count) - 1);
+
+        // Predicates short-circuit per word once no row is left
+        for (const FleetPredicate& predicate : predicates) {
+            if (!word) {
+                break;
+            }
+            if (predicate.column == FleetColumn::PrimaryMac) {
+                // A missing MAC is stored as 0, which an all-zero prefix would match
+                word &= m_hasPrimaryMac[row / kRowsPerWord];
+                word &= MatchMaskedEqual64(m_primaryMac.data() + row, count, predicate.value, predicate.mask);
+            } else {
+                const std::vector<InternId>& column = m_ids[static_cast<uint32_t>(predicate.column)];
+                word &= MatchEqual32(column.data() + row, count, static_cast<uint32_t>(predicate.value));
+            }
+        }
+        bits[row / kRowsPerWord] = word;
+    }
+}
+
+/**
+ * @brief Find the rows matching every predicate
+ */
+std::vector<uint32_t> FleetTable::Filter(const std::vector<FleetPredicate>& predicates, unsigned threads) const {
+    size_t rows = Size();
+    for (const FleetPredicate& predicate : predicates) {
+        if (predicate.column >= FleetColumn::Count) {
+            return std::vector<uint32_t>();
+        }
+    }
+
+    std::vector<uint64_t> bits((rows + kRowsPerWord - 1) / kRowsPerWord);
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, rows / kMinRowsPerThread)));
+
+    // Split on word boundaries so threads never share a bitmap word
+    size_t words = bits.size();
+    size_t wordsPerThread = (words + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        size_t begin = t * wordsPerThread * kRowsPerWord;
+        size_t end = std::min(rows, (t + 1) * wordsPerThread * kRowsPerWord);
+        if (begin < end) {
+            workers.emplace_back(&FleetTable::ScanRange, this, std::cref(predicates), begin, end, bits.data());
+        }
+    }
+    ScanRange(predicates, 0, std::min(rows, wordsPerThread * kRowsPerWord), bits.data());
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    size_t matches = 0;
+    for (uint64_t word : bits) {
+        matches += std::bitset<64>(word).count();
+    }
+    std::vector<uint32_t> indices;
+    indices.reserve(matches);
+    for (size_t w = 0; w < words; w++) {
+        uint64_t word = bits[w];
+        while (word) {
+            indices.push_back(static_cast<uint32_t>(w * kRowsPerWord + LowestSetBit(word)));
+            word &= word - 1;
+        }
+    }
+    return indices;
+}
+
+/**
+ * @brief Remove every row
+ */
+void FleetTable::Clear() {
+    for (std::vector<InternId>& column : m_ids) {
+        column.clear();
+    }
+    m_primaryMac.clear();
+    m_hasPrimaryMac.clear();
+}
+
+size_t FleetTable::ColumnBytes() const {
+    return Size() * (kIdColumnCount * sizeof(InternId) + sizeof(uint64_t)) +
+           m_hasPrimaryMac.size() * sizeof(uint64_t);
+}
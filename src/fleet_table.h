@@ -0,0 +1,100 @@
+#ifndef FLEET_TABLE_H
+#define FLEET_TABLE_H
+
+#include "string_interner.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Columns of a FleetTable
+ */
+enum class FleetColumn : uint32_t {
+    CpuId = 0,          // InternId
+    MotherboardSerial,  // InternId
+    BiosSerial,         // InternId
+    Fingerprint,        // InternId
+    FirstDiskSerial,    // InternId, kEmptyInternId if no disk
+    PrimaryMac,         // 48-bit MAC address of the first adapter, 0 and absent if none
+    Count
+};
+
+/**
+ * @brief One filter condition of a fleet scan
+ *
+ * Interned columns match when the row equals value. The MAC column matches
+ * when (row & mask) == value, which expresses both exact addresses and
+ * OUI/vendor prefixes; rows without a MAC address never match it.
+ */
+struct FleetPredicate {
+    FleetColumn column;
+    uint64_t value;
+    uint64_t mask;
+};
+
+/**
+ * @brief Struct-of-arrays table of fleet records
+ *
+ * Every column is a contiguous fixed-width array, so a filter touches only
+ * the columns it tests. Predicates are evaluated by SIMD kernels into
+ * per-row bitmaps, 64 rows per word, and large scans are split across
+ * threads on word boundaries.
+ */
+class FleetTable {
+public:
+    /**
+     * @brief Append a row
+     * @param ids Interned values of the CpuId through FirstDiskSerial columns
+     * @param primaryMac 48-bit MAC address, 0 if none
+     * @param hasPrimaryMac false if the row has no MAC address
+     * @return Row index
+     */
+    uint32_t Append(const InternId (&ids)[5], uint64_t primaryMac, bool hasPrimaryMac);
+
+    /**
+     * @brief Get the number of rows
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Get the primary MAC column value of a row
+     */
+    uint64_t PrimaryMac(uint32_t row) const;
+
+    /**
+     * @brief Check whether a row has a primary MAC address
+     */
+    bool HasPrimaryMac(uint32_t row) const;
+
+    /**
+     * @brief Find the rows matching every predicate
+     * @param predicates Conditions combined with AND; empty matches every row
+     * @param threads Scan threads, 0 for the CPU count
+     * @return Matching row indices in ascending order
+     */
+    std::vector<uint32_t> Filter(const std::vector<FleetPredicate>& predicates, unsigned threads) const;
+
+    /**
+     * @brief Remove every row
+     */
+    void Clear();
+
+    /**
+     * @brief Get the bytes used by the columns
+     */
+    size_t ColumnBytes() const;
+
+private:
+    /**
+     * @brief Evaluate all predicates over a word-aligned row range into a bitmap
+     */
+    void ScanRange(const std::vector<FleetPredicate>& predicates, size_t begin, size_t end, uint64_t* bits) const;
+
+    static constexpr uint32_t kIdColumnCount = 5;
+
+    std::vector<InternId> m_ids[kIdColumnCount];
+    std::vector<uint64_t> m_primaryMac;
+    std::vector<uint64_t> m_hasPrimaryMac;  // Presence bitmap, 64 rows per word
+};
+
+#endif // FLEET_TABLE_H
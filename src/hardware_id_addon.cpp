@@ -1,17 +1,326 @@
 #include <napi.h>
 #include "hardware_identifier.h"
+#include "collection_scheduler.h"
+#include "change_monitor.h"
+#include "cpu_features.h"
+#include "digest_encoding.h"
+#include "sysfs_collector.h"
+#include "arena_snapshot.h"
+#include "fleet_file.h"
+#include "fleet_registry.h"
+#include "json_reader.h"
+#include "json_writer.h"
+#include "mac_address.h"
+#include "snapshot_codec.h"
+#include "snapshot_refresher.h"
+#include "component_watchdog.h"
+#include "hedged_request.h"
+#include "attestation_token.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <list>
 #include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 /**
  * @brief Global hardware identifier instance
- * Using smart pointer for automatic memory management
+ * Shared with the collection scheduler, which may still hold it while
+ * asynchronous requests are in flight
  */
-static std::unique_ptr<HardwareIdentifier> g_hardwareIdentifier;
+static std::shared_ptr<HardwareIdentifier> g_hardwareIdentifier;
+
+/**
+ * @brief Global collection scheduler, created on first asynchronous request
+ */
+static std::unique_ptr<CollectionScheduler> g_collectionScheduler;
+
+/**
+ * @brief Global change monitor and the JavaScript listener it reports to
+ */
+static ChangeMonitor g_changeMonitor;
+static Napi::FunctionReference g_changeListener;
+
+/**
+ * @brief Global fleet registry of interned hardware records
+ */
+static FleetRegistry g_fleetRegistry;
+
+/**
+ * @brief Steady-state refresh snapshot of the global hardware identifier
+ */
+static SnapshotRefresher g_snapshotRefresher;
+
+/**
+ * @brief Telemetry stream encoder for this machine's snapshots
+ */
+static SnapshotStreamEncoder g_telemetryEncoder;
+
+/**
+ * @brief Devices whose telemetry state is kept; the least recently decoded is dropped beyond this
+ */
+static constexpr size_t kMaxTelemetryDevices = 16384;
+
+/**
+ * @brief Telemetry stream decoder of one device
+ */
+struct TelemetryDevice {
+    SnapshotStreamDecoder decoder;
+    std::list<std::string>::iterator recency;   // Position in g_telemetryRecency
+};
+
+/**
+ * @brief Telemetry stream decoders by device identifier
+ */
+static std::unordered_map<std::string, TelemetryDevice> g_telemetryDevices;
+
+/**
+ * @brief Device identifiers of g_telemetryDevices, most recently decoded first
+ */
+static std::list<std::string> g_telemetryRecency;
+
+/**
+ * @brief Create a JavaScript string from a string view
+ * @param env N-API environment
+ * @param value UTF-8 bytes
+ * @return JavaScript string
+ */
+static Napi::String StringViewToString(Napi::Env env, std::string_view value) {
+    return Napi::String::New(env, value.data(), value.size());
+}
+
+/**
+ * @brief Convert a timed-out component mask to an array of component names
+ * @param env N-API environment
+ * @param timedOutComponents ComponentBit mask
+ * @return Array of component names
+ */
+static Napi::Array TimedOutToArray(Napi::Env env, uint32_t timedOutComponents) {
+    Napi::Array timedOutArray = Napi::Array::New(env);
+    uint32_t timedOutCount = 0;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        if (timedOutComponents & ComponentBit(component)) {
+            timedOutArray[timedOutCount++] = Napi::String::New(env, ComponentName(component));
+        }
+    }
+    return timedOutArray;
+}
+
+/**
+ * @brief Convert a component value to a JavaScript string
+ */
+static Napi::Value ComponentToValue(Napi::Env env, const ComponentScalar& value) {
+    return Napi::String::New(env, value);
+}
+
+/**
+ * @brief Convert a component value to a JavaScript array of strings
+ */
+static Napi::Value ComponentToValue(Napi::Env env, const ComponentList& values) {
+    Napi::Array array = Napi::Array::New(env, values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        array[i] = Napi::String::New(env, values[i]);
+    }
+    return array;
+}
+
+/**
+ * @brief Convert a collected snapshot to a JavaScript object
+ * @param env N-API environment
+ * @param hardwareInfo Collected snapshot
+ * @return Object in the getAllHardwareInfo() shape
+ */
+static Napi::Object HardwareInfoToObject(Napi::Env env, const HardwareInfo& hardwareInfo) {
+    Napi::Object result = Napi::Object::New(env);
+    
+    // Set component properties in table order
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        VisitComponent(component, hardwareInfo, [&](const auto& value) {
+            result.Set(ComponentName(component), ComponentToValue(env, value));
+        });
+    }
+    result.Set("fingerprint", Napi::String::New(env, hardwareInfo.fingerprint));
+    
+    // Components abandoned by the watchdog
+    result.Set("timedOut", TimedOutToArray(env, hardwareInfo.timedOutComponents));
+    
+    return result;
+}
+
+/**
+ * @brief Convert an arena snapshot to a JavaScript object
+ * Strings are created straight from the arena views, without intermediate
+ * std::string copies
+ * @param env N-API environment
+ * @param snapshot Arena-backed snapshot
+ * @return Object in the getAllHardwareInfo() shape
+ */
+static Napi::Object ArenaSnapshotToObject(Napi::Env env, const ArenaSnapshot& snapshot) {
+    Napi::Object result = Napi::Object::New(env);
+    
+    result.Set("cpuId", StringViewToString(env, snapshot.CpuId()));
+    result.Set("motherboardSerial", StringViewToString(env, snapshot.MotherboardSerial()));
+    result.Set("biosSerial", StringViewToString(env, snapshot.BiosSerial()));
+    result.Set("fingerprint", StringViewToString(env, snapshot.Fingerprint()));
+    
+    Napi::Array diskArray = Napi::Array::New(env, snapshot.DiskSerialCount());
+    for (size_t i = 0; i < snapshot.DiskSerialCount(); i++) {
+        diskArray[i] = StringViewToString(env, snapshot.DiskSerial(i));
+    }
+    result.Set("diskSerials", diskArray);
+    
+    Napi::Array macArray = Napi::Array::New(env, snapshot.MacAddressCount());
+    for (size_t i = 0; i < snapshot.MacAddressCount(); i++) {
+        macArray[i] = StringViewToString(env, snapshot.MacAddress(i));
+    }
+    result.Set("macAddresses", macArray);
+    
+    result.Set("timedOut", TimedOutToArray(env, snapshot.TimedOutComponents()));
+    
+    return result;
+}
+
+/**
+ * @brief Parse collection options from a JavaScript object
+ *
+ * Recognized properties: componentTimeoutMs (number) and
+ * requiredComponents (array of component names, the fingerprint profile).
+ * Throws a TypeError on invalid input.
+ *
+ * @param env N-API environment
+ * @param value Options object or undefined
+ * @param options Receives the parsed options
+ * @return true if parsed, false if an exception is pending
+ */
+static bool ParseCollectionOptions(Napi::Env env, Napi::Value value, CollectionOptions& options) {
+    if (value.IsUndefined() || value.IsNull()) {
+        return true;
+    }
+    if (!value.IsObject()) {
+        Napi::TypeError::New(env, "Options must be an object").ThrowAsJavaScriptException();
+        return false;
+    }
+    
+    Napi::Object object = value.As<Napi::Object>();
+    Napi::Value timeout = object.Get("componentTimeoutMs");
+    if (!timeout.IsUndefined()) {
+        if (!timeout.IsNumber()) {
+            Napi::TypeError::New(env, "componentTimeoutMs must be a number").ThrowAsJavaScriptException();
+            return false;
+        }
+        // Uint32Value() would wrap negative and fractional values into huge deadlines
+        double timeoutMs = timeout.As<Napi::Number>().DoubleValue();
+        if (!(timeoutMs >= 0 && timeoutMs <= UINT32_MAX) || std::floor(timeoutMs) != timeoutMs) {
+            Napi::RangeError::New(env, "componentTimeoutMs must be an integer between 0 and 4294967295")
+                .ThrowAsJavaScriptException();
+            return false;
+        }
+        options.componentTimeoutMs = static_cast<uint32_t>(timeoutMs);
+    }
+    
+    Napi::Value required = object.Get("requiredComponents");
+    if (!required.IsUndefined()) {
+        if (!required.IsArray()) {
+            Napi::TypeError::New(env, "requiredComponents must be an array of component names").ThrowAsJavaScriptException();
+            return false;
+        }
+        Napi::Array names = required.As<Napi::Array>();
+        options.requiredComponents = 0;
+        for (uint32_t i = 0; i < names.Length(); i++) {
+            Napi::Value name = names[i];
+            bool known = false;
+            HardwareComponent component;
+            if (name.IsString() && FindComponent(name.As<Napi::String>().Utf8Value(), component)) {
+                options.requiredComponents |= ComponentBit(component);
+                known = true;
+            }
+            if (!known) {
+                Napi::TypeError::New(env, "Unknown component in requiredComponents").ThrowAsJavaScriptException();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Read a string property, empty if absent
+ */
+static std::string GetStringProperty(Napi::Object object, const char* name) {
+    Napi::Value value = object.Get(name);
+    return value.IsString() ? value.As<Napi::String>().Utf8Value() : std::string();
+}
+
+/**
+ * @brief Read a string array property, empty if absent
+ */
+static std::vector<std::string> GetStringArrayProperty(Napi::Object object, const char* name) {
+    std::vector<std::string> values;
+    Napi::Value value = object.Get(name);
+    if (value.IsArray()) {
+        Napi::Array array = value.As<Napi::Array>();
+        for (uint32_t i = 0; i < array.Length(); i++) {
+            Napi::Value element = array[i];
+            if (element.IsString()) {
+                values.push_back(element.As<Napi::String>().Utf8Value());
+            }
+        }
+    }
+    return values;
+}
+
+/**
+ * @brief Convert a JavaScript object in the getAllHardwareInfo() shape to a snapshot
+ *
+ * Missing properties are treated as empty values; timed-out component
+ * flags are not read back.
+ *
+ * @param object Hardware information object
+ * @return Collected identifiers
+ */
+static HardwareInfo ObjectToHardwareInfo(Napi::Object object) {
+    HardwareInfo hardwareInfo;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        VisitComponent(component, hardwareInfo, [&](auto& value) {
+            if constexpr (std::is_same<std::decay_t<decltype(value)>, ComponentList>::value) {
+                value = GetStringArrayProperty(object, ComponentName(component));
+            } else {
+                value = GetStringProperty(object, ComponentName(component));
+            }
+        });
+    }
+    hardwareInfo.fingerprint = GetStringProperty(object, "fingerprint");
+    return hardwareInfo;
+}
+
+/**
+ * @brief Read the timedOut component names of a JavaScript object
+ * @param object Hardware information object
+ * @return ComponentBit mask of the listed components
+ */
+static uint32_t TimedOutFromObject(Napi::Object object) {
+    uint32_t timedOutComponents = 0;
+    for (const std::string& name : GetStringArrayProperty(object, "timedOut")) {
+        HardwareComponent component;
+        if (FindComponent(name, component)) {
+            timedOutComponents |= ComponentBit(component);
+        }
+    }
+    return timedOutComponents;
+}
 
 /**
  * @brief Initialize the hardware identifier
  * @param env N-API environment
- * @param info Function call info
+ * @param info Function call info (optional alternate root path)
  * @return Boolean indicating success
  */
 Napi::Value Initialize(const Napi::CallbackInfo& info) {
@@ -19,8 +328,15 @@ Napi::Value Initialize(const Napi::CallbackInfo& info) {
     
     try {
         if (!g_hardwareIdentifier) {
-            g_hardwareIdentifier = std::make_unique<HardwareIdentifier>();
+            g_hardwareIdentifier = std::make_shared<HardwareIdentifier>();
+        }
+        
+        // Without a root, go back to the live system rather than keep a previous root
+        std::string rootPath;
+        if (info.Length() > 0 && info[0].IsString()) {
+            rootPath = info[0].As<Napi::String>().Utf8Value();
         }
+        g_hardwareIdentifier->SetRootPath(rootPath);
         
         bool success = g_hardwareIdentifier->Initialize();
         return Napi::Boolean::New(env, success);
@@ -41,10 +357,17 @@ Napi::Value Cleanup(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
+        // Stop the scheduler first so no worker is querying during cleanup
+        if (g_collectionScheduler) {
+            g_collectionScheduler->Shutdown();
+            g_collectionScheduler.reset();
+        }
+        
         if (g_hardwareIdentifier) {
             g_hardwareIdentifier->Cleanup();
             g_hardwareIdentifier.reset();
         }
+        g_snapshotRefresher.Reset();
         return env.Undefined();
     }
     catch (const std::exception& e) {
@@ -54,12 +377,17 @@ Napi::Value Cleanup(const Napi::CallbackInfo& info) {
 }
 
 /**
- * @brief Get CPU ID
+ * @brief Collect one hardware component
+ *
+ * Instantiated for every row of HWID_COMPONENT_TABLE and exported under
+ * the row's getter name (getCpuId, getDiskSerials, ...).
+ *
  * @param env N-API environment
  * @param info Function call info
- * @return String containing CPU ID
+ * @return String or array of strings with the component value
  */
-Napi::Value GetCpuId(const Napi::CallbackInfo& info) {
+template <HardwareComponent Component>
+Napi::Value GetComponent(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -68,22 +396,28 @@ Napi::Value GetCpuId(const Napi::CallbackInfo& info) {
             return env.Null();
         }
         
-        std::string cpuId = g_hardwareIdentifier->GetCpuId();
-        return Napi::String::New(env, cpuId);
+        HardwareInfo hardwareInfo;
+        g_hardwareIdentifier->CollectComponent(Component, hardwareInfo);
+        Napi::Value result;
+        VisitComponent(Component, hardwareInfo, [&](const auto& value) {
+            result = ComponentToValue(env, value);
+        });
+        return result;
     }
     catch (const std::exception& e) {
-        Napi::TypeError::New(env, "Failed to get CPU ID").ThrowAsJavaScriptException();
+        std::string message = std::string("Failed to get ") + kComponentTraits[static_cast<uint32_t>(Component)].label;
+        Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
 /**
- * @brief Get motherboard serial number
+ * @brief Collect one hardware component by name
  * @param env N-API environment
- * @param info Function call info
- * @return String containing motherboard serial
+ * @param info Function call info (component name)
+ * @return String or array of strings with the component value
  */
-Napi::Value GetMotherboardSerial(const Napi::CallbackInfo& info) {
+Napi::Value GetComponentByName(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -92,22 +426,110 @@ Napi::Value GetMotherboardSerial(const Napi::CallbackInfo& info) {
             return env.Null();
         }
         
-        std::string serial = g_hardwareIdentifier->GetMotherboardSerial();
-        return Napi::String::New(env, serial);
+        HardwareComponent component;
+        if (info.Length() < 1 || !info[0].IsString() ||
+            !FindComponent(info[0].As<Napi::String>().Utf8Value(), component)) {
+            Napi::TypeError::New(env, "Unknown component").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        HardwareInfo hardwareInfo;
+        g_hardwareIdentifier->CollectComponent(component, hardwareInfo);
+        Napi::Value result;
+        VisitComponent(component, hardwareInfo, [&](const auto& value) {
+            result = ComponentToValue(env, value);
+        });
+        return result;
     }
     catch (const std::exception& e) {
-        Napi::TypeError::New(env, "Failed to get motherboard serial").ThrowAsJavaScriptException();
+        Napi::TypeError::New(env, "Failed to get component").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
 /**
- * @brief Get BIOS serial number
+ * @brief Describe the hardware components of the identifier table
  * @param env N-API environment
  * @param info Function call info
- * @return String containing BIOS serial
+ * @return Array of { name, getter, type, sources, cost, volatility } objects
+ */
+Napi::Value GetComponentTable(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        static const char* const kCostNames[] = { "attribute", "hedged", "enumeration" };
+        static const char* const kVolatilityNames[] = { "fixed", "hotplug" };
+        static const std::pair<uint32_t, const char*> kSourceNames[] = {
+            {kSourceWmi, "wmi"},
+            {kSourceSmbios, "smbios"},
+            {kSourceProcfs, "procfs"},
+            {kSourceSysfs, "sysfs"}
+        };
+        
+        Napi::Array result = Napi::Array::New(env, kHardwareComponentCount);
+        for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+            const ComponentTraits& traits = kComponentTraits[i];
+            std::string getter = traits.getter;
+            getter[0] = 'g';
+            Napi::Array sources = Napi::Array::New(env);
+            uint32_t sourceCount = 0;
+            for (const auto& source : kSourceNames) {
+                if (traits.sources & source.first) {
+                    sources[sourceCount++] = Napi::String::New(env, source.second);
+                }
+            }
+            
+            Napi::Object component = Napi::Object::New(env);
+            component.Set("name", Napi::String::New(env, traits.name));
+            component.Set("getter", Napi::String::New(env, getter));
+            component.Set("type", Napi::String::New(env, traits.isList ? "list" : "string"));
+            component.Set("sources", sources);
+            component.Set("cost", Napi::String::New(env, kCostNames[static_cast<uint32_t>(traits.cost)]));
+            component.Set("volatility", Napi::String::New(env, kVolatilityNames[static_cast<uint32_t>(traits.volatility)]));
+            result[i] = component;
+        }
+        return result;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to get component table").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Read a digest encoding name
+ * @param env N-API environment
+ * @param value 'hex', 'base32' or 'base64url'
+ * @param encoding Receives the encoding
+ * @return false (with a JavaScript exception pending) if the name is unknown
+ */
+static bool ParseDigestEncoding(Napi::Env env, Napi::Value value, DigestEncoding& encoding) {
+    std::string name = value.IsString() ? value.As<Napi::String>().Utf8Value() : std::string();
+    if (name == "hex") {
+        encoding = DigestEncoding::Hex;
+    } else if (name == "base32") {
+        encoding = DigestEncoding::Base32;
+    } else if (name == "base64url") {
+        encoding = DigestEncoding::Base64Url;
+    } else {
+        Napi::TypeError::New(env, "Encoding must be 'hex', 'base32' or 'base64url'").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get hardware fingerprint (combined hash)
+ *
+ * Without an encoding option this is the legacy variable-length hex hash.
+ * With one, the SHA-256 fingerprint digest is returned as a Buffer
+ * ('raw') or as fixed-width text.
+ *
+ * @param env N-API environment
+ * @param info Function call info (optional collection options)
+ * @return String containing hardware fingerprint, or a Buffer for 'raw'
  */
-Napi::Value GetBiosSerial(const Napi::CallbackInfo& info) {
+Napi::Value GetHardwareFingerprint(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -116,52 +538,120 @@ Napi::Value GetBiosSerial(const Napi::CallbackInfo& info) {
             return env.Null();
         }
         
-        std::string serial = g_hardwareIdentifier->GetBiosSerial();
-        return Napi::String::New(env, serial);
+        CollectionOptions options;
+        if (!ParseCollectionOptions(env, info[0], options)) {
+            return env.Null();
+        }
+        
+        Napi::Value encodingName = info[0].IsObject() ? info[0].As<Napi::Object>().Get("encoding") : env.Undefined();
+        if (encodingName.IsUndefined() ||
+            (encodingName.IsString() && encodingName.As<Napi::String>().Utf8Value() == "legacy")) {
+            std::string fingerprint = g_hardwareIdentifier->GetHardwareFingerprint(options);
+            return Napi::String::New(env, fingerprint);
+        }
+        
+        bool raw = encodingName.IsString() && encodingName.As<Napi::String>().Utf8Value() == "raw";
+        DigestEncoding encoding = DigestEncoding::Hex;
+        if (!raw && !ParseDigestEncoding(env, encodingName, encoding)) {
+            return env.Null();
+        }
+        
+        // An empty legacy fingerprint means a required component timed out
+        HardwareInfo hardwareInfo = g_hardwareIdentifier->GetAllHardwareInfo(options);
+        uint8_t digest[kFingerprintDigestSize];
+        size_t digestSize = 0;
+        if (!hardwareInfo.fingerprint.empty()) {
+            ComputeFingerprintDigest(hardwareInfo, digest);
+            digestSize = sizeof(digest);
+        }
+        if (raw) {
+            return Napi::Buffer<uint8_t>::Copy(env, digest, digestSize);
+        }
+        char text[2 * kFingerprintDigestSize];
+        size_t length = EncodedDigestLength(encoding, digestSize);
+        EncodeDigest(encoding, digest, digestSize, text);
+        return Napi::String::New(env, text, length);
     }
     catch (const std::exception& e) {
-        Napi::TypeError::New(env, "Failed to get BIOS serial").ThrowAsJavaScriptException();
+        Napi::TypeError::New(env, "Failed to get hardware fingerprint").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
 /**
- * @brief Get disk drive serial numbers
+ * @brief Encode a binary fingerprint digest as text
  * @param env N-API environment
- * @param info Function call info
- * @return Array of strings containing disk serials
+ * @param info Function call info (digest Buffer, encoding name)
+ * @return Encoded string
  */
-Napi::Value GetDiskSerials(const Napi::CallbackInfo& info) {
+Napi::Value FingerprintEncode(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        if (!g_hardwareIdentifier) {
-            Napi::TypeError::New(env, "Hardware identifier not initialized. Call initialize() first.").ThrowAsJavaScriptException();
+        if (info.Length() < 1 || !info[0].IsTypedArray() ||
+            info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+            Napi::TypeError::New(env, "Digest must be a Buffer").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        DigestEncoding encoding;
+        if (!ParseDigestEncoding(env, info[1], encoding)) {
             return env.Null();
         }
         
-        std::vector<std::string> serials = g_hardwareIdentifier->GetDiskSerials();
-        Napi::Array result = Napi::Array::New(env, serials.size());
-        
-        for (size_t i = 0; i < serials.size(); i++) {
-            result[i] = Napi::String::New(env, serials[i]);
+        Napi::Uint8Array digest = info[0].As<Napi::Uint8Array>();
+        std::string text(EncodedDigestLength(encoding, digest.ByteLength()), '\0');
+        EncodeDigest(encoding, digest.Data(), digest.ByteLength(), &text[0]);
+        return Napi::String::New(env, text);
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to encode fingerprint").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Decode a fingerprint digest from text
+ * @param env N-API environment
+ * @param info Function call info (text, encoding name)
+ * @return Buffer with the digest, or null if the text is not valid
+ */
+Napi::Value FingerprintDecode(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsString()) {
+            Napi::TypeError::New(env, "Fingerprint must be a string").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        DigestEncoding encoding;
+        if (!ParseDigestEncoding(env, info[1], encoding)) {
+            return env.Null();
         }
         
-        return result;
+        std::string text = info[0].As<Napi::String>().Utf8Value();
+        size_t size;
+        if (!DecodedDigestLength(encoding, text.size(), size)) {
+            return env.Null();
+        }
+        Napi::Buffer<uint8_t> digest = Napi::Buffer<uint8_t>::New(env, size);
+        if (!DecodeDigest(encoding, text.data(), text.size(), digest.Data())) {
+            return env.Null();
+        }
+        return digest;
     }
     catch (const std::exception& e) {
-        Napi::TypeError::New(env, "Failed to get disk serials").ThrowAsJavaScriptException();
+        Napi::TypeError::New(env, "Failed to decode fingerprint").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
 /**
- * @brief Get network adapter MAC addresses
+ * @brief Get all hardware information at once
  * @param env N-API environment
- * @param info Function call info
- * @return Array of strings containing MAC addresses
+ * @param info Function call info (optional collection options)
+ * @return Object containing all hardware information
  */
-Napi::Value GetMacAddresses(const Napi::CallbackInfo& info) {
+Napi::Value GetAllHardwareInfo(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -170,28 +660,32 @@ Napi::Value GetMacAddresses(const Napi::CallbackInfo& info) {
             return env.Null();
         }
         
-        std::vector<std::string> addresses = g_hardwareIdentifier->GetMacAddresses();
-        Napi::Array result = Napi::Array::New(env, addresses.size());
-        
-        for (size_t i = 0; i < addresses.size(); i++) {
-            result[i] = Napi::String::New(env, addresses[i]);
+        CollectionOptions options;
+        if (!ParseCollectionOptions(env, info[0], options)) {
+            return env.Null();
         }
         
-        return result;
+        HardwareInfo hardwareInfo = g_hardwareIdentifier->GetAllHardwareInfo(options);
+        return HardwareInfoToObject(env, hardwareInfo);
     }
     catch (const std::exception& e) {
-        Napi::TypeError::New(env, "Failed to get MAC addresses").ThrowAsJavaScriptException();
+        Napi::TypeError::New(env, "Failed to get all hardware info").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
 /**
- * @brief Get hardware fingerprint (combined hash)
+ * @brief Refresh the steady-state snapshot
+ *
+ * Re-collects every component and compares it with the previous refresh
+ * in place; the snapshot is only rewritten when something changed.
+ *
  * @param env N-API environment
- * @param info Function call info
- * @return String containing hardware fingerprint
+ * @param info Function call info (optional collection options)
+ * @return Object with changed component names, fingerprintChanged,
+ *         allocations and the current values (null if nothing changed)
  */
-Napi::Value GetHardwareFingerprint(const Napi::CallbackInfo& info) {
+Napi::Value RefreshHardwareInfo(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -200,22 +694,85 @@ Napi::Value GetHardwareFingerprint(const Napi::CallbackInfo& info) {
             return env.Null();
         }
         
-        std::string fingerprint = g_hardwareIdentifier->GetHardwareFingerprint();
-        return Napi::String::New(env, fingerprint);
+        CollectionOptions options;
+        if (!ParseCollectionOptions(env, info[0], options)) {
+            return env.Null();
+        }
+        
+        HardwareIdentifier* identifier = g_hardwareIdentifier.get();
+        uint32_t timeoutMs = options.componentTimeoutMs;
+        RefreshResult refresh = g_snapshotRefresher.Refresh(
+            [identifier, timeoutMs](HardwareComponent component, HardwareInfo& hardwareInfo) {
+                return identifier->CollectComponent(component, hardwareInfo, timeoutMs);
+            }, options.requiredComponents);
+        
+        Napi::Object result = Napi::Object::New(env);
+        Napi::Array changed = Napi::Array::New(env);
+        uint32_t changedCount = 0;
+        for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+            HardwareComponent component = static_cast<HardwareComponent>(i);
+            if (refresh.changedComponents & ComponentBit(component)) {
+                changed[changedCount++] = Napi::String::New(env, ComponentName(component));
+            }
+        }
+        result.Set("changed", changed);
+        result.Set("fingerprintChanged", Napi::Boolean::New(env, refresh.fingerprintChanged));
+        result.Set("allocations", Napi::Number::New(env, refresh.allocations));
+        
+        if (refresh.changedComponents || refresh.fingerprintChanged) {
+            result.Set("current", HardwareInfoToObject(env, g_snapshotRefresher.Current()));
+        } else {
+            result.Set("current", env.Null());
+        }
+        return result;
     }
     catch (const std::exception& e) {
-        Napi::TypeError::New(env, "Failed to get hardware fingerprint").ThrowAsJavaScriptException();
+        Napi::TypeError::New(env, "Failed to refresh hardware info").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
 /**
- * @brief Get all hardware information at once
+ * @brief Pending asynchronous collection, owned by the completion callback
+ */
+struct PendingCollection {
+    Napi::Promise::Deferred deferred;
+    Napi::ThreadSafeFunction tsfn;
+    HardwareInfo hardwareInfo;
+    bool success;
+
+    explicit PendingCollection(Napi::Env env)
+        : deferred(Napi::Promise::Deferred::New(env))
+        , success(false) {
+    }
+};
+
+/**
+ * @brief Parse a collection priority name
+ * @param name "interactive", "normal" or "background"
+ * @param priority Receives the parsed priority
+ * @return true if the name is a known priority
+ */
+static bool ParseCollectionPriority(const std::string& name, CollectionPriority& priority) {
+    if (name == "interactive") {
+        priority = CollectionPriority::Interactive;
+    } else if (name == "normal") {
+        priority = CollectionPriority::Normal;
+    } else if (name == "background") {
+        priority = CollectionPriority::Background;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get all hardware information through the prioritized scheduler
  * @param env N-API environment
- * @param info Function call info
- * @return Object containing all hardware information
+ * @param info Function call info (optional priority name, optional collection options)
+ * @return Promise resolving to an object containing all hardware information
  */
-Napi::Value GetAllHardwareInfo(const Napi::CallbackInfo& info) {
+Napi::Value GetAllHardwareInfoAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
@@ -224,71 +781,1749 @@ Napi::Value GetAllHardwareInfo(const Napi::CallbackInfo& info) {
             return env.Null();
         }
         
-        // Create result object
+        CollectionPriority priority = CollectionPriority::Normal;
+        if (info.Length() > 0 && !info[0].IsUndefined()) {
+            if (!info[0].IsString() || !ParseCollectionPriority(info[0].As<Napi::String>().Utf8Value(), priority)) {
+                Napi::TypeError::New(env, "Priority must be 'interactive', 'normal' or 'background'").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+        }
+        
+        CollectionOptions options;
+        if (!ParseCollectionOptions(env, info[1], options)) {
+            return env.Null();
+        }
+        
+        if (!g_collectionScheduler) {
+            g_collectionScheduler = std::make_unique<CollectionScheduler>(g_hardwareIdentifier);
+        }
+        
+        PendingCollection* pending = new PendingCollection(env);
+        Napi::Promise promise = pending->deferred.Promise();
+        pending->tsfn = Napi::ThreadSafeFunction::New(
+            env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "hardwareIdCollect", 0, 1);
+        
+        bool queued = g_collectionScheduler->Submit(priority, options, [pending](HardwareInfo&& hardwareInfo, bool success) {
+            pending->hardwareInfo = std::move(hardwareInfo);
+            pending->success = success;
+            
+            Napi::ThreadSafeFunction tsfn = pending->tsfn;
+            napi_status status = tsfn.BlockingCall(pending, [](Napi::Env env, Napi::Function, PendingCollection* done) {
+                if (done->success) {
+                    done->deferred.Resolve(HardwareInfoToObject(env, done->hardwareInfo));
+                } else {
+                    done->deferred.Reject(Napi::Error::New(env, "Hardware collection cancelled").Value());
+                }
+                delete done;
+            });
+            // The callback never runs once the environment is tearing down
+            if (status != napi_ok) {
+                delete pending;
+            }
+            tsfn.Release();
+        });
+        
+        if (!queued) {
+            pending->tsfn.Release();
+            pending->deferred.Reject(Napi::Error::New(env, "Hardware collection scheduler is shutting down").Value());
+            delete pending;
+        }
+        
+        return promise;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to schedule hardware collection").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Get collection statistics
+ * @param env N-API environment
+ * @param info Function call info
+ * @return Object with scheduler, watchdog, hedging and CPU dispatch details
+ */
+Napi::Value GetCollectionStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
         Napi::Object result = Napi::Object::New(env);
+        Napi::Object scheduler = Napi::Object::New(env);
+        
+        CollectionSchedulerStats stats;
+        if (g_collectionScheduler) {
+            stats = g_collectionScheduler->GetStats();
+        }
         
-        // Get all hardware information
-        std::string cpuId = g_hardwareIdentifier->GetCpuId();
-        std::string motherboardSerial = g_hardwareIdentifier->GetMotherboardSerial();
-        std::string biosSerial = g_hardwareIdentifier->GetBiosSerial();
-        std::vector<std::string> diskSerials = g_hardwareIdentifier->GetDiskSerials();
-        std::vector<std::string> macAddresses = g_hardwareIdentifier->GetMacAddresses();
-        std::string fingerprint = g_hardwareIdentifier->GetHardwareFingerprint();
+        static const char* const kPriorityNames[kCollectionPriorityCount] = {
+            "interactive", "normal", "background"
+        };
+        for (uint32_t i = 0; i < kCollectionPriorityCount; i++) {
+            const CollectionPriorityStats& priorityStats = stats.priorities[i];
+            Napi::Object entry = Napi::Object::New(env);
+            entry.Set("submitted", Napi::Number::New(env, static_cast<double>(priorityStats.submitted)));
+            entry.Set("completed", Napi::Number::New(env, static_cast<double>(priorityStats.completed)));
+            entry.Set("avgWaitMs", Napi::Number::New(env, priorityStats.completed
+                ? priorityStats.totalWaitMicros / 1000.0 / priorityStats.completed : 0.0));
+            entry.Set("maxWaitMs", Napi::Number::New(env, priorityStats.maxWaitMicros / 1000.0));
+            entry.Set("avgRunMs", Napi::Number::New(env, priorityStats.completed
+                ? priorityStats.totalRunMicros / 1000.0 / priorityStats.completed : 0.0));
+            entry.Set("maxRunMs", Napi::Number::New(env, priorityStats.maxRunMicros / 1000.0));
+            scheduler.Set(kPriorityNames[i], entry);
+        }
+        scheduler.Set("preemptions", Napi::Number::New(env, static_cast<double>(stats.preemptions)));
+        scheduler.Set("queued", Napi::Number::New(env, stats.queued));
+        result.Set("scheduler", scheduler);
         
-        // Set properties
-        result.Set("cpuId", Napi::String::New(env, cpuId));
-        result.Set("motherboardSerial", Napi::String::New(env, motherboardSerial));
-        result.Set("biosSerial", Napi::String::New(env, biosSerial));
-        result.Set("fingerprint", Napi::String::New(env, fingerprint));
+        ComponentWatchdogStats watchdogStats = ComponentWatchdog::Instance().GetStats();
+        Napi::Object watchdog = Napi::Object::New(env);
+        watchdog.Set("completed", Napi::Number::New(env, static_cast<double>(watchdogStats.completed)));
+        watchdog.Set("timedOut", Napi::Number::New(env, static_cast<double>(watchdogStats.timedOut)));
+        watchdog.Set("failed", Napi::Number::New(env, static_cast<double>(watchdogStats.failed)));
+        watchdog.Set("rejected", Napi::Number::New(env, static_cast<double>(watchdogStats.rejected)));
+        watchdog.Set("threads", Napi::Number::New(env, watchdogStats.threads));
+        watchdog.Set("stuckThreads", Napi::Number::New(env, watchdogStats.stuckThreads));
+        result.Set("watchdog", watchdog);
         
-        // Convert disk serials to array
-        Napi::Array diskArray = Napi::Array::New(env, diskSerials.size());
-        for (size_t i = 0; i < diskSerials.size(); i++) {
-            diskArray[i] = Napi::String::New(env, diskSerials[i]);
+        Napi::Object hedging = Napi::Object::New(env);
+        for (const HedgeStats& hedgeStats : HedgedSource::GetAllStats()) {
+            Napi::Object entry = Napi::Object::New(env);
+            entry.Set("requests", Napi::Number::New(env, static_cast<double>(hedgeStats.requests)));
+            entry.Set("hedged", Napi::Number::New(env, static_cast<double>(hedgeStats.hedged)));
+            entry.Set("primaryWins", Napi::Number::New(env, static_cast<double>(hedgeStats.primaryWins)));
+            entry.Set("secondaryWins", Napi::Number::New(env, static_cast<double>(hedgeStats.secondaryWins)));
+            entry.Set("empty", Napi::Number::New(env, static_cast<double>(hedgeStats.empty)));
+            entry.Set("hedgeDelayMs", Napi::Number::New(env, hedgeStats.hedgeDelayMs));
+            entry.Set("lastLatencyMs", Napi::Number::New(env, hedgeStats.lastLatencyMs));
+            entry.Set("lastWinner", Napi::String::New(env, hedgeStats.lastWinner));
+            hedging.Set(hedgeStats.name, entry);
         }
-        result.Set("diskSerials", diskArray);
+        result.Set("hedging", hedging);
         
-        // Convert MAC addresses to array
-        Napi::Array macArray = Napi::Array::New(env, macAddresses.size());
-        for (size_t i = 0; i < macAddresses.size(); i++) {
-            macArray[i] = Napi::String::New(env, macAddresses[i]);
+        std::vector<std::string> featureNames = CpuFeatureNames(GetCpuFeatures());
+        Napi::Array features = Napi::Array::New(env, featureNames.size());
+        for (size_t i = 0; i < featureNames.size(); i++) {
+            features[i] = Napi::String::New(env, featureNames[i]);
         }
-        result.Set("macAddresses", macArray);
+        Napi::Object kernels = Napi::Object::New(env);
+        for (const auto& kernel : GetKernelVariants()) {
+            kernels.Set(kernel.first, Napi::String::New(env, kernel.second));
+        }
+        Napi::Object cpu = Napi::Object::New(env);
+        cpu.Set("features", features);
+        cpu.Set("kernels", kernels);
+        result.Set("cpu", cpu);
         
         return result;
     }
     catch (const std::exception& e) {
-        Napi::TypeError::New(env, "Failed to get all hardware info").ThrowAsJavaScriptException();
+        Napi::TypeError::New(env, "Failed to get collection stats").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
 /**
- * @brief Initialize the addon module
- * @param env N-API environment
- * @param exports Module exports object
- * @return Module exports
+ * @brief Background worker collecting a batch of alternate roots
  */
-Napi::Object Init(Napi::Env env, Napi::Object exports) {
-    // Export individual functions
-    exports.Set(Napi::String::New(env, "initialize"), 
-                Napi::Function::New(env, Initialize));
-    exports.Set(Napi::String::New(env, "cleanup"), 
-                Napi::Function::New(env, Cleanup));
-    exports.Set(Napi::String::New(env, "getCpuId"), 
-                Napi::Function::New(env, GetCpuId));
-    exports.Set(Napi::String::New(env, "getMotherboardSerial"), 
-                Napi::Function::New(env, GetMotherboardSerial));
-    exports.Set(Napi::String::New(env, "getBiosSerial"), 
-                Napi::Function::New(env, GetBiosSerial));
-    exports.Set(Napi::String::New(env, "getDiskSerials"), 
-                Napi::Function::New(env, GetDiskSerials));
-    exports.Set(Napi::String::New(env, "getMacAddresses"), 
-                Napi::Function::New(env, GetMacAddresses));
+class CollectRootsWorker : public Napi::AsyncWorker {
+public:
+    CollectRootsWorker(Napi::Env env, std::vector<std::string> roots, unsigned concurrency, bool registerResults)
+        : Napi::AsyncWorker(env)
+        , m_deferred(Napi::Promise::Deferred::New(env))
+        , m_roots(std::move(roots))
+        , m_concurrency(concurrency)
+        , m_registerResults(registerResults) {
+    }
+
+    Napi::Promise Promise() {
+        return m_deferred.Promise();
+    }
+
+protected:
+    void Execute() override {
+        m_results = SysfsCollector::CollectBatch(m_roots, m_concurrency);
+        if (m_registerResults) {
+            m_registryIndices.resize(m_results.size());
+            for (size_t i = 0; i < m_results.size(); i++) {
+                if (m_results[i].success) {
+                    m_registryIndices[i] = g_fleetRegistry.Register(m_results[i].snapshot);
+                }
+            }
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        Napi::Array results = Napi::Array::New(env, m_results.size());
+        for (size_t i = 0; i < m_results.size(); i++) {
+            Napi::Object entry = ArenaSnapshotToObject(env, m_results[i].snapshot);
+            entry.Set("root", Napi::String::New(env, m_results[i].root));
+            entry.Set("success", Napi::Boolean::New(env, m_results[i].success));
+            if (m_registerResults && m_results[i].success) {
+                entry.Set("registryIndex", Napi::Number::New(env, m_registryIndices[i]));
+            }
+            results[i] = entry;
+        }
+        m_deferred.Resolve(results);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        m_deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred m_deferred;
+    std::vector<std::string> m_roots;
+    unsigned m_concurrency;
+    bool m_registerResults;
+    std::vector<RootCollectionResult> m_results;
+    std::vector<uint32_t> m_registryIndices;
+};
+
+/**
+ * @brief Collect and fingerprint many alternate roots concurrently
+ * @param env N-API environment
+ * @param info Function call info (array of root paths, optional concurrency, optional register flag)
+ * @return Promise resolving to one hardware information object per root
+ */
+Napi::Value CollectRoots(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsArray()) {
+            Napi::TypeError::New(env, "Roots must be an array of paths").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        Napi::Array rootArray = info[0].As<Napi::Array>();
+        std::vector<std::string> roots;
+        roots.reserve(rootArray.Length());
+        for (uint32_t i = 0; i < rootArray.Length(); i++) {
+            Napi::Value root = rootArray[i];
+            if (!root.IsString()) {
+                Napi::TypeError::New(env, "Roots must be an array of paths").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            roots.push_back(root.As<Napi::String>().Utf8Value());
+        }
+        
+        unsigned concurrency = 0;
+        if (info.Length() > 1 && info[1].IsNumber()) {
+            concurrency = info[1].As<Napi::Number>().Uint32Value();
+        }
+        bool registerResults = info.Length() > 2 && info[2].ToBoolean().Value();
+        
+        CollectRootsWorker* worker = new CollectRootsWorker(env, std::move(roots), concurrency, registerResults);
+        Napi::Promise promise = worker->Promise();
+        worker->Queue();
+        return promise;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to collect roots").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Add hardware records to the fleet registry
+ * @param env N-API environment
+ * @param info Function call info (array of hardware information objects)
+ * @return Array of record indices
+ */
+Napi::Value RegistryAdd(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsArray()) {
+            Napi::TypeError::New(env, "Records must be an array of objects").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        Napi::Array records = info[0].As<Napi::Array>();
+        Napi::Array indices = Napi::Array::New(env, records.Length());
+        for (uint32_t i = 0; i < records.Length(); i++) {
+            Napi::Value record = records[i];
+            if (!record.IsObject()) {
+                Napi::TypeError::New(env, "Records must be an array of objects").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            uint32_t index = g_fleetRegistry.Register(ObjectToHardwareInfo(record.As<Napi::Object>()));
+            indices[i] = Napi::Number::New(env, index);
+        }
+        return indices;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to register records").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Register hardware records read from JSON text
+ *
+ * Registration files, NDJSON streams and arrays of records are parsed
+ * natively, in parallel chunks for large inputs, and registered without
+ * creating JavaScript objects.
+ *
+ * @param env N-API environment
+ * @param info Function call info (UTF-8 JSON Buffer, optional parse thread count)
+ * @return Uint32Array of registry indices in input order
+ */
+Napi::Value RegistryLoadJson(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsTypedArray() ||
+            info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+            Napi::TypeError::New(env, "Registration JSON must be a Buffer").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        unsigned threads = 0;
+        if (info.Length() > 1 && info[1].IsNumber()) {
+            threads = info[1].As<Napi::Number>().Uint32Value();
+        }
+        
+        Napi::Uint8Array bytes = info[0].As<Napi::Uint8Array>();
+        std::vector<JsonRegistration> records;
+        size_t errorOffset = 0;
+        if (!ReadJsonRegistrations(reinterpret_cast<const char*>(bytes.Data()), bytes.ByteLength(),
+                                   threads, records, errorOffset)) {
+            Napi::Error::New(env, "Malformed registration JSON at offset " + std::to_string(errorOffset))
+                .ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        Napi::Uint32Array indices = Napi::Uint32Array::New(env, records.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            indices[i] = g_fleetRegistry.Register(records[i].info, records[i].hasRegisteredAt
+                                                  ? records[i].registeredAtMs
+                                                  : FleetRegistry::kRegisteredNow);
+        }
+        return indices;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to load registration JSON").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Get a record from the fleet registry
+ * @param env N-API environment
+ * @param info Function call info (record index)
+ * @return Hardware information object, or null for an unknown index
+ */
+Napi::Value RegistryGet(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsNumber()) {
+            Napi::TypeError::New(env, "Record index must be a number").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        HardwareInfo hardwareInfo;
+        if (!g_fleetRegistry.GetRecord(info[0].As<Napi::Number>().Uint32Value(), hardwareInfo)) {
+            return env.Null();
+        }
+        return HardwareInfoToObject(env, hardwareInfo);
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to get record").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Get the hash-consed snapshot ID of a fleet registry record
+ * @param env N-API environment
+ * @param info Function call info (record index)
+ * @return Snapshot ID shared by records with identical values, or null
+ */
+Napi::Value RegistrySnapshotId(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsNumber()) {
+            Napi::TypeError::New(env, "Record index must be a number").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        uint32_t snapshotId;
+        if (!g_fleetRegistry.GetSnapshotId(info[0].As<Napi::Number>().Uint32Value(), snapshotId)) {
+            return env.Null();
+        }
+        return Napi::Number::New(env, snapshotId);
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to get snapshot ID").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Find fleet registry records by fingerprint
+ * @param env N-API environment
+ * @param info Function call info (fingerprint)
+ * @return Array of record indices
+ */
+Napi::Value RegistryFind(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsString()) {
+            Napi::TypeError::New(env, "Fingerprint must be a string").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        std::vector<uint32_t> matches = g_fleetRegistry.FindByFingerprint(info[0].As<Napi::String>().Utf8Value());
+        Napi::Array indices = Napi::Array::New(env, matches.size());
+        for (size_t i = 0; i < matches.size(); i++) {
+            indices[i] = Napi::Number::New(env, matches[i]);
+        }
+        return indices;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to find records").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Scan the fleet registry's columnar table
+ *
+ * Recognized filter properties: cpuId, motherboardSerial, biosSerial,
+ * fingerprint and diskSerial (first disk) match exactly; macPrefix matches
+ * the first MAC address by prefix (for example an OUI). All given filters
+ * must match.
+ *
+ * @param env N-API environment
+ * @param info Function call info (filter object, optional thread count)
+ * @return Uint32Array of matching record indices
+ */
+Napi::Value RegistryQuery(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsObject()) {
+            Napi::TypeError::New(env, "Filter must be an object").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        static const struct {
+            const char* name;
+            FleetColumn column;
+        } kStringFilters[] = {
+            { "cpuId", FleetColumn::CpuId },
+            { "motherboardSerial", FleetColumn::MotherboardSerial },
+            { "biosSerial", FleetColumn::BiosSerial },
+            { "fingerprint", FleetColumn::Fingerprint },
+            { "diskSerial", FleetColumn::FirstDiskSerial }
+        };
+        
+        Napi::Object filter = info[0].As<Napi::Object>();
+        std::vector<FleetPredicate> predicates;
+        bool unmatchable = false;
+        for (const auto& stringFilter : kStringFilters) {
+            Napi::Value value = filter.Get(stringFilter.name);
+            if (value.IsUndefined()) {
+                continue;
+            }
+            if (!value.IsString()) {
+                Napi::TypeError::New(env, std::string(stringFilter.name) + " filter must be a string").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            // A value no record contains cannot match
+            InternId id = kEmptyInternId;
+            if (!g_fleetRegistry.Resolve(value.As<Napi::String>().Utf8Value(), id)) {
+                unmatchable = true;
+            }
+            predicates.push_back(FleetPredicate{ stringFilter.column, id, 0 });
+        }
+        
+        Napi::Value macPrefix = filter.Get("macPrefix");
+        if (!macPrefix.IsUndefined()) {
+            uint64_t value;
+            uint64_t mask;
+            if (!macPrefix.IsString() || !ParseMacPrefix(macPrefix.As<Napi::String>().Utf8Value(), value, mask)) {
+                Napi::TypeError::New(env, "macPrefix filter must be a MAC address prefix").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            predicates.push_back(FleetPredicate{ FleetColumn::PrimaryMac, value, mask });
+        }
+        
+        unsigned threads = 0;
+        if (info.Length() > 1 && info[1].IsNumber()) {
+            threads = info[1].As<Napi::Number>().Uint32Value();
+        }
+        
+        std::vector<uint32_t> matches;
+        if (!unmatchable) {
+            matches = g_fleetRegistry.Filter(predicates, threads);
+        }
+        Napi::Uint32Array result = Napi::Uint32Array::New(env, matches.size());
+        if (!matches.empty()) {
+            memcpy(result.Data(), matches.data(), matches.size() * sizeof(uint32_t));
+        }
+        return result;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to query registry").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Get fleet registry memory statistics
+ * @param env N-API environment
+ * @param info Function call info
+ * @return Object with record, string and byte counts
+ */
+Napi::Value RegistryStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        FleetRegistryStats stats = g_fleetRegistry.GetStats();
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("records", Napi::Number::New(env, static_cast<double>(stats.records)));
+        result.Set("uniqueStrings", Napi::Number::New(env, static_cast<double>(stats.uniqueStrings)));
+        result.Set("internedBytes", Napi::Number::New(env, static_cast<double>(stats.internedBytes)));
+        result.Set("logicalBytes", Napi::Number::New(env, static_cast<double>(stats.logicalBytes)));
+        result.Set("recordBytes", Napi::Number::New(env, static_cast<double>(stats.recordBytes)));
+        result.Set("columnBytes", Napi::Number::New(env, static_cast<double>(stats.columnBytes)));
+        result.Set("uniquePlatforms", Napi::Number::New(env, static_cast<double>(stats.uniquePlatforms)));
+        result.Set("uniqueLists", Napi::Number::New(env, static_cast<double>(stats.uniqueLists)));
+        result.Set("uniqueSnapshots", Napi::Number::New(env, static_cast<double>(stats.uniqueSnapshots)));
+        return result;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to get registry stats").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Remove every record from the fleet registry
+ * @param env N-API environment
+ * @param info Function call info
+ * @return Undefined
+ */
+Napi::Value RegistryClear(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        g_fleetRegistry.Clear();
+        return env.Undefined();
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to clear registry").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Write the fleet registry to a columnar fleet file
+ * @param env N-API environment
+ * @param info Function call info (file path)
+ * @return Object with the row and row group counts
+ */
+Napi::Value RegistryExport(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsString()) {
+            Napi::TypeError::New(env, "Path must be a string").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        std::string path = info[0].As<Napi::String>().Utf8Value();
+        uint64_t rowCount = g_fleetRegistry.Size();
+        std::string error;
+        bool written = WriteFleetFile(path, rowCount, [](uint64_t index, FleetScalarRow& row) {
+            return g_fleetRegistry.GetScalarRow(static_cast<uint32_t>(index), row);
+        }, error);
+        if (!written) {
+            Napi::Error::New(env, error).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("rows", Napi::Number::New(env, static_cast<double>(rowCount)));
+        result.Set("rowGroups", Napi::Number::New(env, static_cast<double>(
+            (rowCount + kFleetFileRowsPerGroup - 1) / kFleetFileRowsPerGroup)));
+        return result;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to export registry").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Query a columnar fleet file without loading it
+ *
+ * Accepts the registryQuery filters plus registeredAfter (inclusive) and
+ * registeredBefore (exclusive) in milliseconds since the epoch. Row groups
+ * whose footer statistics rule out a match are never read.
+ *
+ * @param env N-API environment
+ * @param info Function call info (file path, filter object)
+ * @return Object with matching rows and scan statistics
+ */
+Napi::Value FleetFileQueryRows(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject()) {
+            Napi::TypeError::New(env, "Expected a path and a filter object").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        static const struct {
+            const char* name;
+            FleetFileColumn column;
+        } kStringFilters[] = {
+            { "cpuId", FleetFileColumn::CpuId },
+            { "motherboardSerial", FleetFileColumn::MotherboardSerial },
+            { "biosSerial", FleetFileColumn::BiosSerial },
+            { "fingerprint", FleetFileColumn::Fingerprint },
+            { "diskSerial", FleetFileColumn::FirstDiskSerial }
+        };
+        
+        Napi::Object filter = info[1].As<Napi::Object>();
+        FleetFileQuery query;
+        for (const auto& stringFilter : kStringFilters) {
+            Napi::Value value = filter.Get(stringFilter.name);
+            if (value.IsUndefined()) {
+                continue;
+            }
+            if (!value.IsString()) {
+                Napi::TypeError::New(env, std::string(stringFilter.name) + " filter must be a string").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            query.equals.emplace_back(stringFilter.column, value.As<Napi::String>().Utf8Value());
+        }
+        
+        Napi::Value macPrefix = filter.Get("macPrefix");
+        if (!macPrefix.IsUndefined()) {
+            if (!macPrefix.IsString() ||
+                !ParseMacPrefix(macPrefix.As<Napi::String>().Utf8Value(), query.macValue, query.macMask)) {
+                Napi::TypeError::New(env, "macPrefix filter must be a MAC address prefix").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            query.hasMacPrefix = true;
+        }
+        
+        Napi::Value registeredAfter = filter.Get("registeredAfter");
+        Napi::Value registeredBefore = filter.Get("registeredBefore");
+        if ((!registeredAfter.IsUndefined() && !registeredAfter.IsNumber()) ||
+            (!registeredBefore.IsUndefined() && !registeredBefore.IsNumber())) {
+            Napi::TypeError::New(env, "Registration time filters must be numbers").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        if (registeredAfter.IsNumber()) {
+            query.hasRegisteredAfter = true;
+            query.registeredAfterMs = registeredAfter.As<Napi::Number>().Int64Value();
+        }
+        if (registeredBefore.IsNumber()) {
+            query.hasRegisteredBefore = true;
+            query.registeredBeforeMs = registeredBefore.As<Napi::Number>().Int64Value();
+        }
+        
+        FleetFileReader reader;
+        std::string error;
+        if (!reader.Open(info[0].As<Napi::String>().Utf8Value(), error)) {
+            Napi::Error::New(env, error).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        FleetFileScanStats stats;
+        std::vector<uint64_t> matches = reader.Filter(query, &stats);
+        Napi::Array rows = Napi::Array::New(env, matches.size());
+        for (size_t i = 0; i < matches.size(); i++) {
+            FleetScalarRow row;
+            if (!reader.ReadRow(matches[i], row)) {
+                Napi::Error::New(env, "Fleet file row is corrupt").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            char mac[kMaxMacAddressLength];
+            size_t macLength = 0;
+            if (row.hasPrimaryMac) {
+                macLength = FormatMacAddress(MacAddress{ row.primaryMac }, MacFormat::Colon, true, mac);
+            }
+            
+            Napi::Object entry = Napi::Object::New(env);
+            entry.Set("row", Napi::Number::New(env, static_cast<double>(matches[i])));
+            entry.Set("cpuId", StringViewToString(env, row.cpuId));
+            entry.Set("motherboardSerial", StringViewToString(env, row.motherboardSerial));
+            entry.Set("biosSerial", StringViewToString(env, row.biosSerial));
+            entry.Set("fingerprint", StringViewToString(env, row.fingerprint));
+            entry.Set("diskSerial", StringViewToString(env, row.firstDiskSerial));
+            entry.Set("macAddress", Napi::String::New(env, mac, macLength));
+            entry.Set("registeredAt", Napi::Number::New(env, static_cast<double>(row.registeredAtMs)));
+            rows[i] = entry;
+        }
+        
+        Napi::Object scan = Napi::Object::New(env);
+        scan.Set("rowGroups", Napi::Number::New(env, stats.rowGroups));
+        scan.Set("skippedRowGroups", Napi::Number::New(env, stats.skippedRowGroups));
+        scan.Set("bytesScanned", Napi::Number::New(env, static_cast<double>(stats.bytesScanned)));
+        
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("rows", rows);
+        result.Set("stats", scan);
+        return result;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to query fleet file").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Encode a snapshot natively into a Buffer
+ *
+ * Without a snapshot object the current hardware is collected and encoded
+ * directly from the native values, so no JavaScript object graph is built.
+ *
+ * @param env N-API environment
+ * @param info Function call info (object in the getAllHardwareInfo() shape
+ *             or undefined for this machine, optional format: 'binary',
+ *             'msgpack' or 'cbor')
+ * @return Buffer holding the encoding
+ */
+Napi::Value EncodeSnapshotBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        SnapshotFormat format = SnapshotFormat::Binary;
+        if (info.Length() > 1 && !info[1].IsUndefined()) {
+            std::string name = info[1].IsString() ? info[1].As<Napi::String>().Utf8Value() : std::string();
+            if (name == "msgpack") {
+                format = SnapshotFormat::MessagePack;
+            } else if (name == "cbor") {
+                format = SnapshotFormat::Cbor;
+            } else if (name != "binary") {
+                Napi::TypeError::New(env, "Format must be 'binary', 'msgpack' or 'cbor'").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+        }
+        
+        HardwareInfo hardwareInfo;
+        if (info.Length() > 0 && info[0].IsObject()) {
+            Napi::Object object = info[0].As<Napi::Object>();
+            hardwareInfo = ObjectToHardwareInfo(object);
+            hardwareInfo.timedOutComponents = TimedOutFromObject(object);
+        } else if (info.Length() == 0 || info[0].IsUndefined() || info[0].IsNull()) {
+            if (!g_hardwareIdentifier) {
+                Napi::TypeError::New(env, "Hardware identifier not initialized. Call initialize() first.").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            hardwareInfo = g_hardwareIdentifier->GetAllHardwareInfo(CollectionOptions());
+        } else {
+            Napi::TypeError::New(env, "Snapshot must be an object").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        // The Buffer takes over the encoded string instead of copying it; the
+        // finalizer frees it once the Buffer is collected, or straight away
+        // where the runtime does not allow external buffers and copies
+        std::unique_ptr<std::string> encoded(new std::string());
+        EncodeSnapshotAs(hardwareInfo, format, *encoded);
+        uint8_t* data = reinterpret_cast<uint8_t*>(&(*encoded)[0]);
+        size_t size = encoded->size();
+        return Napi::Buffer<uint8_t>::NewOrCopy(env, data, size,
+                                                [](Napi::Env, uint8_t*, std::string* storage) { delete storage; },
+                                                encoded.release());
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to encode snapshot").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Decode every snapshot frame in a buffer
+ * @param env N-API environment
+ * @param info Function call info (Buffer or Uint8Array of concatenated frames)
+ * @return Array of objects in the getAllHardwareInfo() shape
+ */
+Napi::Value DecodeSnapshotBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsTypedArray() ||
+            info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+            Napi::TypeError::New(env, "Encoded snapshots must be a Buffer").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        Napi::Uint8Array bytes = info[0].As<Napi::Uint8Array>();
+        const uint8_t* data = bytes.Data();
+        size_t size = bytes.ByteLength();
+        
+        // One HardwareInfo is reused so string capacity carries across frames
+        HardwareInfo hardwareInfo;
+        Napi::Array snapshots = Napi::Array::New(env);
+        uint32_t count = 0;
+        size_t position = 0;
+        while (position < size) {
+            size_t consumed = 0;
+            SnapshotDecodeStatus status = DecodeSnapshot(data + position, size - position, hardwareInfo, &consumed);
+            if (status != SnapshotDecodeStatus::Ok) {
+                Napi::Error::New(env, "Snapshot at offset " + std::to_string(position) + " is " +
+                                 SnapshotDecodeStatusName(status)).ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            snapshots[count++] = HardwareInfoToObject(env, hardwareInfo);
+            position += consumed;
+        }
+        return snapshots;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to decode snapshots").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Get the names of the fields in a snapshot field bitmap
+ * @param env N-API environment
+ * @param fields kSnapshot* field bitmap
+ * @return Array of getAllHardwareInfo() property names
+ */
+static Napi::Array SnapshotFieldNames(Napi::Env env, uint32_t fields) {
+    // Component presence bits are ComponentBit() values (see snapshot_codec.cpp)
+    Napi::Array names = Napi::Array::New(env);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        if (fields & ComponentBit(component)) {
+            names[count++] = Napi::String::New(env, ComponentName(component));
+        }
+    }
+    if (fields & kSnapshotFingerprint) {
+        names[count++] = Napi::String::New(env, "fingerprint");
+    }
+    if (fields & kSnapshotTimedOutComponents) {
+        names[count++] = Napi::String::New(env, "timedOut");
+    }
+    return names;
+}
+
+/**
+ * @brief Encode the next frame of this machine's telemetry stream
+ * @param env N-API environment
+ * @param info Function call info (snapshot object or undefined to collect,
+ *             force a keyframe, optional keyframe interval)
+ * @return Buffer with one keyframe or delta frame
+ */
+Napi::Value TelemetryEncode(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        HardwareInfo hardwareInfo;
+        if (info.Length() > 0 && info[0].IsObject()) {
+            Napi::Object object = info[0].As<Napi::Object>();
+            hardwareInfo = ObjectToHardwareInfo(object);
+            hardwareInfo.timedOutComponents = TimedOutFromObject(object);
+        } else if (info.Length() == 0 || info[0].IsUndefined() || info[0].IsNull()) {
+            if (!g_hardwareIdentifier) {
+                Napi::TypeError::New(env, "Hardware identifier not initialized. Call initialize() first.").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            hardwareInfo = g_hardwareIdentifier->GetAllHardwareInfo(CollectionOptions());
+        } else {
+            Napi::TypeError::New(env, "Snapshot must be an object").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        if (info.Length() > 1 && info[1].ToBoolean().Value()) {
+            g_telemetryEncoder.RequestKeyframe();
+        }
+        if (info.Length() > 2 && info[2].IsNumber()) {
+            g_telemetryEncoder.SetKeyframeInterval(info[2].As<Napi::Number>().Uint32Value());
+        }
+        
+        std::string frame;
+        g_telemetryEncoder.Encode(hardwareInfo, frame);
+        return Napi::Buffer<uint8_t>::Copy(env, reinterpret_cast<const uint8_t*>(frame.data()), frame.size());
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to encode telemetry").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Keep the decoder of a device seen for the first time
+ *
+ * Evicts the least recently decoded device once kMaxTelemetryDevices are
+ * kept; its next delta then asks for a keyframe like any lost frame.
+ *
+ * @param deviceId Device identifier
+ * @param decoder Decoder that has applied at least one keyframe
+ */
+static void KeepTelemetryDevice(const std::string& deviceId, SnapshotStreamDecoder&& decoder) {
+    if (g_telemetryDevices.size() >= kMaxTelemetryDevices) {
+        g_telemetryDevices.erase(g_telemetryRecency.back());
+        g_telemetryRecency.pop_back();
+    }
+    g_telemetryRecency.push_front(deviceId);
+    TelemetryDevice& device = g_telemetryDevices[deviceId];
+    device.decoder = std::move(decoder);
+    device.recency = g_telemetryRecency.begin();
+}
+
+/**
+ * @brief Apply telemetry frames received from one device
+ *
+ * Each device keeps its own decoder state, so deltas reconstruct that
+ * device's latest snapshot. State is kept only once a keyframe of the
+ * device has been applied, so deltas and malformed frames from unknown
+ * devices leave nothing behind.
+ *
+ * @param env N-API environment
+ * @param info Function call info (device identifier, Buffer of concatenated frames)
+ * @return Array with one result object per frame
+ */
+Napi::Value TelemetryDecode(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 2 || !info[0].IsString() || !info[1].IsTypedArray() ||
+            info[1].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+            Napi::TypeError::New(env, "Expected a device identifier and a Buffer").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        std::string deviceId = info[0].As<Napi::String>().Utf8Value();
+        auto known = g_telemetryDevices.find(deviceId);
+        SnapshotStreamDecoder newDecoder;
+        SnapshotStreamDecoder& decoder = known != g_telemetryDevices.end() ? known->second.decoder : newDecoder;
+        if (known != g_telemetryDevices.end()) {
+            g_telemetryRecency.splice(g_telemetryRecency.begin(), g_telemetryRecency, known->second.recency);
+        }
+        auto keepNewDevice = [&]() {
+            if (known == g_telemetryDevices.end() && newDecoder.HasState()) {
+                KeepTelemetryDevice(deviceId, std::move(newDecoder));
+            }
+        };
+        Napi::Uint8Array bytes = info[1].As<Napi::Uint8Array>();
+        const uint8_t* data = bytes.Data();
+        size_t size = bytes.ByteLength();
+        
+        Napi::Array results = Napi::Array::New(env);
+        uint32_t count = 0;
+        size_t position = 0;
+        while (position < size) {
+            size_t consumed = 0;
+            SnapshotDecodeStatus status = decoder.Decode(data + position, size - position, &consumed);
+            if (status != SnapshotDecodeStatus::Ok && status != SnapshotDecodeStatus::OutOfSequence) {
+                Napi::Error::New(env, "Telemetry frame at offset " + std::to_string(position) + " is " +
+                                 SnapshotDecodeStatusName(status)).ThrowAsJavaScriptException();
+                keepNewDevice();
+                return env.Null();
+            }
+            
+            bool applied = status == SnapshotDecodeStatus::Ok;
+            uint32_t fields = applied ? decoder.LastFields() : 0;
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("sequence", Napi::Number::New(env, decoder.Sequence()));
+            result.Set("keyframe", Napi::Boolean::New(env, (fields & kSnapshotStreamKeyframe) != 0));
+            result.Set("needKeyframe", Napi::Boolean::New(env, !applied));
+            result.Set("changed", SnapshotFieldNames(env, (fields & kSnapshotStreamKeyframe) ? 0 : fields));
+            result.Set("snapshot", decoder.HasState() ? Napi::Value(HardwareInfoToObject(env, decoder.State())) : env.Null());
+            results[count++] = result;
+            position += consumed;
+        }
+        keepNewDevice();
+        return results;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to decode telemetry").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Forget the telemetry state of one device, or of every device
+ * @param env N-API environment
+ * @param info Function call info (optional device identifier)
+ * @return Undefined
+ */
+Napi::Value TelemetryReset(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() > 0 && info[0].IsString()) {
+            auto device = g_telemetryDevices.find(info[0].As<Napi::String>().Utf8Value());
+            if (device != g_telemetryDevices.end()) {
+                g_telemetryRecency.erase(device->second.recency);
+                g_telemetryDevices.erase(device);
+            }
+        } else {
+            g_telemetryDevices.clear();
+            g_telemetryRecency.clear();
+        }
+        return env.Undefined();
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to reset telemetry").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Read an HMAC key given as a Buffer or a string
+ * @param value JavaScript value
+ * @param key Receives the key bytes
+ * @return false if the value is neither
+ */
+static bool GetKeyBytes(Napi::Value value, std::string& key) {
+    if (value.IsString()) {
+        key = value.As<Napi::String>().Utf8Value();
+        return true;
+    }
+    if (value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() == napi_uint8_array) {
+        Napi::Uint8Array bytes = value.As<Napi::Uint8Array>();
+        key.assign(reinterpret_cast<const char*>(bytes.Data()), bytes.ByteLength());
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Get the current time in milliseconds since the epoch
+ */
+static int64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Create a signed attestation token
+ * @param env N-API environment
+ * @param info Function call info (key, key identifier, optional 16-byte
+ *             nonce, optional issue time, optional snapshot object)
+ * @return Buffer with the token
+ */
+Napi::Value AttestationCreate(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::string keyBytes;
+        if (info.Length() < 1 || !GetKeyBytes(info[0], keyBytes)) {
+            Napi::TypeError::New(env, "Key must be a Buffer or string").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        AttestationClaims claims;
+        claims.keyId = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Uint32Value() : 0;
+        if (info.Length() > 2 && info[2].IsTypedArray()) {
+            Napi::Uint8Array nonce = info[2].As<Napi::Uint8Array>();
+            if (nonce.ByteLength() != kAttestationNonceSize) {
+                Napi::TypeError::New(env, "Nonce must be 16 bytes").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            memcpy(claims.nonce, nonce.Data(), kAttestationNonceSize);
+        } else {
+            std::random_device random;
+            for (size_t i = 0; i < kAttestationNonceSize; i += 4) {
+                uint32_t word = random();
+                memcpy(claims.nonce + i, &word, 4);
+            }
+        }
+        claims.issuedAtMs = info.Length() > 3 && info[3].IsNumber()
+            ? info[3].As<Napi::Number>().Int64Value() : NowMs();
+        
+        HardwareInfo hardwareInfo;
+        if (info.Length() > 4 && info[4].IsObject()) {
+            hardwareInfo = ObjectToHardwareInfo(info[4].As<Napi::Object>());
+        } else {
+            if (!g_hardwareIdentifier) {
+                Napi::TypeError::New(env, "Hardware identifier not initialized. Call initialize() first.").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            hardwareInfo = g_hardwareIdentifier->GetAllHardwareInfo(CollectionOptions());
+        }
+        SetAttestationHardware(hardwareInfo, claims);
+        
+        HmacSha256Key key(keyBytes.data(), keyBytes.size());
+        uint8_t token[kAttestationTokenSize];
+        if (!EncodeAttestationToken(claims, key, token)) {
+            Napi::TypeError::New(env, "Fingerprint is too long for a token").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        return Napi::Buffer<uint8_t>::Copy(env, token, sizeof(token));
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to create attestation token").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Verify many attestation tokens with multi-buffer HMAC
+ * @param env N-API environment
+ * @param info Function call info (key, Buffer of concatenated tokens or
+ *             array of token Buffers, optional maximum age in ms, optional
+ *             current time in ms)
+ * @return Uint8Array with 1 for each valid token and 0 otherwise
+ */
+Napi::Value AttestationVerify(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::string keyBytes;
+        if (info.Length() < 2 || !GetKeyBytes(info[0], keyBytes)) {
+            Napi::TypeError::New(env, "Key must be a Buffer or string").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        // Tokens of the wrong size are collected as null and reported invalid
+        std::vector<const uint8_t*> tokens;
+        if (info[1].IsTypedArray() && info[1].As<Napi::TypedArray>().TypedArrayType() == napi_uint8_array) {
+            Napi::Uint8Array bytes = info[1].As<Napi::Uint8Array>();
+            if (bytes.ByteLength() % kAttestationTokenSize != 0) {
+                Napi::TypeError::New(env, "Token buffer length must be a multiple of " +
+                                          std::to_string(kAttestationTokenSize)).ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            for (size_t offset = 0; offset < bytes.ByteLength(); offset += kAttestationTokenSize) {
+                tokens.push_back(bytes.Data() + offset);
+            }
+        } else if (info[1].IsArray()) {
+            Napi::Array array = info[1].As<Napi::Array>();
+            tokens.reserve(array.Length());
+            for (uint32_t i = 0; i < array.Length(); i++) {
+                Napi::Value token = array.Get(i);
+                bool sized = token.IsTypedArray() &&
+                             token.As<Napi::TypedArray>().TypedArrayType() == napi_uint8_array &&
+                             token.As<Napi::Uint8Array>().ByteLength() == kAttestationTokenSize;
+                tokens.push_back(sized ? token.As<Napi::Uint8Array>().Data() : nullptr);
+            }
+        } else {
+            Napi::TypeError::New(env, "Tokens must be a Buffer or an array of Buffers").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        // Verify the correctly sized tokens as one contiguous batch
+        std::vector<const uint8_t*> sized;
+        sized.reserve(tokens.size());
+        for (const uint8_t* token : tokens) {
+            if (token) {
+                sized.push_back(token);
+            }
+        }
+        std::vector<uint8_t> sizedValid(sized.size());
+        HmacSha256Key key(keyBytes.data(), keyBytes.size());
+        VerifyAttestationTokens(key, sized.data(), sized.size(), sizedValid.data());
+        
+        bool checkAge = info.Length() > 2 && info[2].IsNumber();
+        int64_t maxAgeMs = checkAge ? info[2].As<Napi::Number>().Int64Value() : 0;
+        int64_t nowMs = info.Length() > 3 && info[3].IsNumber() ? info[3].As<Napi::Number>().Int64Value() : NowMs();
+        
+        Napi::Uint8Array valid = Napi::Uint8Array::New(env, tokens.size());
+        size_t next = 0;
+        for (size_t i = 0; i < tokens.size(); i++) {
+            uint8_t ok = 0;
+            if (tokens[i]) {
+                ok = sizedValid[next++];
+                if (ok && checkAge) {
+                    AttestationClaims claims;
+                    DecodeAttestationToken(tokens[i], kAttestationTokenSize, claims);
+                    ok = claims.issuedAtMs <= nowMs && nowMs - claims.issuedAtMs <= maxAgeMs ? 1 : 0;
+                }
+            }
+            valid[i] = ok;
+        }
+        return valid;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to verify attestation tokens").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Read the claims of an attestation token without verifying it
+ * @param env N-API environment
+ * @param info Function call info (token Buffer)
+ * @return Claims object, or null if the token is malformed
+ */
+Napi::Value AttestationDecode(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsTypedArray() ||
+            info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+            Napi::TypeError::New(env, "Token must be a Buffer").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        Napi::Uint8Array bytes = info[0].As<Napi::Uint8Array>();
+        AttestationClaims claims;
+        if (!DecodeAttestationToken(bytes.Data(), bytes.ByteLength(), claims)) {
+            return env.Null();
+        }
+        
+        static const char kHex[] = "0123456789abcdef";
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("keyId", Napi::Number::New(env, claims.keyId));
+        result.Set("issuedAt", Napi::Number::New(env, static_cast<double>(claims.issuedAtMs)));
+        result.Set("nonce", Napi::Buffer<uint8_t>::Copy(env, claims.nonce, kAttestationNonceSize));
+        result.Set("fingerprint", Napi::String::New(env, claims.fingerprint));
+        Napi::Object digests = Napi::Object::New(env);
+        for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+            HardwareComponent component = static_cast<HardwareComponent>(i);
+            if (claims.components & ComponentBit(component)) {
+                std::string hex;
+                for (uint8_t byte : claims.componentDigests[i]) {
+                    hex.push_back(kHex[byte >> 4]);
+                    hex.push_back(kHex[byte & 0x0F]);
+                }
+                digests.Set(ComponentName(component), Napi::String::New(env, hex));
+            }
+        }
+        result.Set("componentDigests", digests);
+        return result;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to decode attestation token").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Nesting depth beyond which an entry is rejected
+ */
+static constexpr size_t kMaxJsonDepth = 64;
+
+/**
+ * @brief Check whether a value is skipped as an object property, as by JSON.stringify
+ */
+static bool IsJsonOmitted(const Napi::Value& value) {
+    return value.IsUndefined() || value.IsFunction() || value.Type() == napi_symbol;
+}
+
+/**
+ * @brief Write an arbitrary JavaScript value as JSON
+ *
+ * Follows JSON.stringify: toJSON() is honoured, non-finite numbers become
+ * null, and undefined, functions and symbols are skipped in objects and
+ * written as null in arrays.
+ *
+ * @param env N-API environment
+ * @param writer JSON writer positioned where a value is expected
+ * @param value Value to write
+ * @param ancestors Objects and arrays enclosing the value, outermost first
+ * @return false with a TypeError pending for BigInts and circular structures,
+ *         or a RangeError for nesting deeper than kMaxJsonDepth
+ */
+static bool WriteJsonValue(Napi::Env env, JsonWriter& writer, Napi::Value value,
+                           std::vector<Napi::Value>& ancestors) {
+    if (value.IsObject() && !value.IsFunction()) {
+        Napi::Value toJson = value.As<Napi::Object>().Get("toJSON");
+        if (toJson.IsFunction()) {
+            value = toJson.As<Napi::Function>().Call(value, {});
+            if (env.IsExceptionPending()) {
+                return false;
+            }
+        }
+    }
+
+    if (value.IsString()) {
+        writer.String(value.As<Napi::String>().Utf8Value());
+    } else if (value.IsNumber()) {
+        writer.Number(value.As<Napi::Number>().DoubleValue());
+    } else if (value.IsBoolean()) {
+        writer.Bool(value.As<Napi::Boolean>().Value());
+    } else if (value.Type() == napi_bigint) {
+        Napi::TypeError::New(env, "Do not know how to serialize a BigInt").ThrowAsJavaScriptException();
+        return false;
+    } else if (value.IsNull() || IsJsonOmitted(value)) {
+        writer.Null();
+    } else {
+        for (const Napi::Value& ancestor : ancestors) {
+            if (ancestor.StrictEquals(value)) {
+                Napi::TypeError::New(env, "Converting circular structure to JSON").ThrowAsJavaScriptException();
+                return false;
+            }
+        }
+        if (ancestors.size() >= kMaxJsonDepth) {
+            Napi::RangeError::New(env, "Entry is nested more than " + std::to_string(kMaxJsonDepth) +
+                                       " levels deep").ThrowAsJavaScriptException();
+            return false;
+        }
+        ancestors.push_back(value);
+        if (value.IsArray()) {
+            Napi::Array array = value.As<Napi::Array>();
+            writer.BeginArray();
+            for (uint32_t i = 0; i < array.Length(); i++) {
+                if (!WriteJsonValue(env, writer, array.Get(i), ancestors)) {
+                    return false;
+                }
+            }
+            writer.EndArray();
+        } else {
+            Napi::Object object = value.As<Napi::Object>();
+            Napi::Array names = object.GetPropertyNames();
+            writer.BeginObject();
+            for (uint32_t i = 0; i < names.Length(); i++) {
+                std::string name = names.Get(i).ToString().Utf8Value();
+                Napi::Value property = object.Get(name);
+                if (IsJsonOmitted(property)) {
+                    continue;
+                }
+                writer.Key(name);
+                if (!WriteJsonValue(env, writer, property, ancestors)) {
+                    return false;
+                }
+            }
+            writer.EndObject();
+        }
+        ancestors.pop_back();
+    }
+    return !env.IsExceptionPending();
+}
+
+/**
+ * @brief Write one JSON report entry from a JavaScript object
+ *
+ * Objects with before and after (or previous and current, as in watch()
+ * events) properties are written as snapshot diffs; other objects as
+ * snapshots, keeping properties outside the getAllHardwareInfo() shape
+ * (such as root, success and registryIndex of batch results) as
+ * JSON.stringify would write them.
+ *
+ * @param env N-API environment
+ * @param writer JSON writer positioned where a value is expected
+ * @param entry Entry object
+ * @return false with a JavaScript exception pending if a property cannot be serialized
+ */
+static bool WriteJsonEntry(Napi::Env env, JsonWriter& writer, Napi::Object entry) {
+    Napi::Value before = entry.Get("before");
+    Napi::Value after = entry.Get("after");
+    if (!before.IsObject() || !after.IsObject()) {
+        // watch() events name the two snapshots previous and current
+        before = entry.Get("previous");
+        after = entry.Get("current");
+    }
+    if (before.IsObject() && after.IsObject()) {
+        WriteSnapshotDiff(writer, ObjectToHardwareInfo(before.As<Napi::Object>()),
+                          ObjectToHardwareInfo(after.As<Napi::Object>()));
+        return true;
+    }
+    
+    HardwareInfo hardwareInfo = ObjectToHardwareInfo(entry);
+    hardwareInfo.timedOutComponents = TimedOutFromObject(entry);
+    writer.BeginObject();
+    WriteHardwareInfoFields(writer, hardwareInfo);
+    
+    std::vector<Napi::Value> ancestors = {entry};
+    Napi::Array names = entry.GetPropertyNames();
+    for (uint32_t i = 0; i < names.Length(); i++) {
+        std::string name = names.Get(i).ToString().Utf8Value();
+        bool known = name == "fingerprint" || name == "timedOut";
+        for (uint32_t c = 0; c < kHardwareComponentCount && !known; c++) {
+            known = name == ComponentName(static_cast<HardwareComponent>(c));
+        }
+        if (known) {
+            continue;
+        }
+        Napi::Value value = entry.Get(name);
+        if (IsJsonOmitted(value)) {
+            continue;
+        }
+        writer.Key(name);
+        if (!WriteJsonValue(env, writer, value, ancestors)) {
+            return false;
+        }
+    }
+    writer.EndObject();
+    return true;
+}
+
+/**
+ * @brief Serialize report entries to JSON natively
+ *
+ * Entries are written as JSON array elements (comma-separated) or as
+ * newline-delimited JSON; the caller adds the enclosing brackets.
+ *
+ * @param env N-API environment
+ * @param info Function call info (entries array, ndjson flag, whether the
+ *             first entry starts the output)
+ * @return Buffer with the serialized entries
+ */
+Napi::Value JsonEncodeEntries(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsArray()) {
+            Napi::TypeError::New(env, "Entries must be an array").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        bool ndjson = info.Length() > 1 && info[1].ToBoolean().Value();
+        bool first = info.Length() < 3 || info[2].ToBoolean().Value();
+        
+        Napi::Array entries = info[0].As<Napi::Array>();
+        std::string out;
+        for (uint32_t i = 0; i < entries.Length(); i++) {
+            Napi::Value entry = entries.Get(i);
+            if (!entry.IsObject()) {
+                Napi::TypeError::New(env, "Entries must be objects").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            if (!ndjson && !first) {
+                out.push_back(',');
+            }
+            JsonWriter writer(out);
+            if (!WriteJsonEntry(env, writer, entry.As<Napi::Object>())) {
+                return env.Null();
+            }
+            if (ndjson) {
+                out.push_back('\n');
+            }
+            first = false;
+        }
+        return Napi::Buffer<char>::Copy(env, out.data(), out.size());
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to encode JSON").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Serialize fleet registry records to JSON in chunks
+ *
+ * Records are read straight from the registry, so no JavaScript objects
+ * are created. Each record carries its index, registeredAt and the
+ * getAllHardwareInfo() fields.
+ *
+ * @param env N-API environment
+ * @param info Function call info (first record index, chunk size in
+ *             bytes, ndjson flag, whether the first record starts the output)
+ * @return Object with the chunk Buffer and the next record index
+ */
+Napi::Value JsonEncodeRegistry(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+            Napi::TypeError::New(env, "Expected a record index and a chunk size").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        uint32_t index = info[0].As<Napi::Number>().Uint32Value();
+        size_t chunkSize = info[1].As<Napi::Number>().Uint32Value();
+        bool ndjson = info.Length() > 2 && info[2].ToBoolean().Value();
+        bool first = info.Length() < 4 || info[3].ToBoolean().Value();
+        
+        // The chunk ends after the record that crosses chunkSize
+        std::string out;
+        out.reserve(chunkSize + 1024);
+        HardwareInfo hardwareInfo;
+        while (out.size() < chunkSize && g_fleetRegistry.GetRecord(index, hardwareInfo)) {
+            if (!ndjson && !first) {
+                out.push_back(',');
+            }
+            JsonWriter writer(out);
+            writer.BeginObject();
+            writer.Key("index");
+            writer.Integer(index);
+            writer.Key("registeredAt");
+            writer.Integer(g_fleetRegistry.GetRegisteredAt(index));
+            WriteHardwareInfoFields(writer, hardwareInfo);
+            writer.EndObject();
+            if (ndjson) {
+                out.push_back('\n');
+            }
+            first = false;
+            index++;
+        }
+        
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("chunk", Napi::Buffer<char>::Copy(env, out.data(), out.size()));
+        result.Set("next", Napi::Number::New(env, index));
+        return result;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to encode registry JSON").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Parse, filter and reformat a list of MAC addresses
+ *
+ * Addresses are handled as 48-bit integers: flag filters are mask tests
+ * and sorting/deduplication are integer operations. Entries that are not
+ * MAC addresses are skipped.
+ *
+ * @param env N-API environment
+ * @param info Function call info (array of addresses, optional options object
+ *             with format, lowercase, unique, excludeMulticast and
+ *             excludeLocallyAdministered)
+ * @return Array of formatted addresses
+ */
+Napi::Value NormalizeMacAddresses(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsArray()) {
+            Napi::TypeError::New(env, "MAC addresses must be an array of strings").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        MacFormat format = MacFormat::Colon;
+        bool lowercase = false;
+        bool unique = false;
+        bool excludeMulticast = false;
+        bool excludeLocal = false;
+        if (info.Length() > 1 && info[1].IsObject()) {
+            Napi::Object options = info[1].As<Napi::Object>();
+            std::string formatName = GetStringProperty(options, "format");
+            if (formatName == "dash") {
+                format = MacFormat::Dash;
+            } else if (formatName == "dot") {
+                format = MacFormat::Dot;
+            } else if (formatName == "bare") {
+                format = MacFormat::Bare;
+            } else if (!formatName.empty() && formatName != "colon") {
+                Napi::TypeError::New(env, "Unknown MAC address format").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            lowercase = options.Get("lowercase").ToBoolean().Value();
+            unique = options.Get("unique").ToBoolean().Value();
+            excludeMulticast = options.Get("excludeMulticast").ToBoolean().Value();
+            excludeLocal = options.Get("excludeLocallyAdministered").ToBoolean().Value();
+        }
+        
+        Napi::Array input = info[0].As<Napi::Array>();
+        std::vector<MacAddress> macs;
+        macs.reserve(input.Length());
+        for (uint32_t i = 0; i < input.Length(); i++) {
+            Napi::Value value = input[i];
+            MacAddress mac;
+            if (!value.IsString() || !ParseMacAddress(value.As<Napi::String>().Utf8Value(), mac)) {
+                continue;
+            }
+            if ((excludeMulticast && mac.IsMulticast()) || (excludeLocal && mac.IsLocallyAdministered())) {
+                continue;
+            }
+            macs.push_back(mac);
+        }
+        if (unique) {
+            SortUniqueMacAddresses(macs);
+        }
+        
+        Napi::Array result = Napi::Array::New(env, macs.size());
+        char buffer[kMaxMacAddressLength];
+        for (size_t i = 0; i < macs.size(); i++) {
+            size_t length = FormatMacAddress(macs[i], format, !lowercase, buffer);
+            result[i] = Napi::String::New(env, buffer, length);
+        }
+        return result;
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to normalize MAC addresses").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Deliver coalesced change sources to the JavaScript listener
+ * @param env N-API environment
+ * @param sources Mask of ChangeSource bits
+ */
+static void DispatchHardwareChange(Napi::Env env, uint32_t sources) {
+    if (g_changeListener.IsEmpty()) {
+        return;
+    }
+    
+    // Called straight from the libuv loop, outside of any JavaScript frame
+    Napi::HandleScope scope(env);
+    Napi::Array names = Napi::Array::New(env);
+    uint32_t count = 0;
+    if (sources & kChangeSourceNetwork) {
+        names[count++] = Napi::String::New(env, "network");
+    }
+    if (sources & kChangeSourceDevice) {
+        names[count++] = Napi::String::New(env, "device");
+    }
+    
+    g_changeListener.Value().MakeCallback(env.Global(), { names });
+    if (env.IsExceptionPending()) {
+        Napi::Error error = env.GetAndClearPendingException();
+        napi_fatal_exception(env, error.Value());
+    }
+}
+
+/**
+ * @brief Start the event-loop change monitor
+ * @param env N-API environment
+ * @param info Function call info (listener, optional debounce in milliseconds)
+ * @return Boolean indicating whether any change source could be registered
+ */
+Napi::Value StartChangeMonitor(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        if (info.Length() < 1 || !info[0].IsFunction()) {
+            Napi::TypeError::New(env, "Listener must be a function").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        uint32_t debounceMs = 500;
+        if (info.Length() > 1 && !info[1].IsUndefined()) {
+            double value = info[1].IsNumber() ? info[1].As<Napi::Number>().DoubleValue() : -1;
+            if (!(value >= 0 && value <= 0xFFFFFFFF)) {
+                Napi::TypeError::New(env, "debounceMs must be a non-negative number").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            debounceMs = static_cast<uint32_t>(value);
+        }
+        
+        // A running monitor keeps its pending notifications and takes the new debounce
+        g_changeListener = Napi::Persistent(info[0].As<Napi::Function>());
+        if (g_changeMonitor.IsRunning()) {
+            g_changeMonitor.SetDebounce(debounceMs);
+            return Napi::Boolean::New(env, true);
+        }
+        
+        uv_loop_t* loop = nullptr;
+        if (napi_get_uv_event_loop(env, &loop) != napi_ok || !loop) {
+            g_changeListener.Reset();
+            return Napi::Boolean::New(env, false);
+        }
+        
+        bool started = g_changeMonitor.Start(loop, debounceMs, [env](uint32_t sources) {
+            DispatchHardwareChange(env, sources);
+        });
+        if (!started) {
+            g_changeListener.Reset();
+        }
+        return Napi::Boolean::New(env, started);
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to start change monitor").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Stop the event-loop change monitor
+ * @param env N-API environment
+ * @param info Function call info
+ * @return Undefined
+ */
+Napi::Value StopChangeMonitor(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        g_changeMonitor.Stop();
+        g_changeListener.Reset();
+        return env.Undefined();
+    }
+    catch (const std::exception& e) {
+        Napi::TypeError::New(env, "Failed to stop change monitor").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Initialize the addon module
+ * @param env N-API environment
+ * @param exports Module exports object
+ * @return Module exports
+ */
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    // Release loop handles and references before the environment goes away
+    napi_add_env_cleanup_hook(env, [](void*) {
+        g_changeMonitor.Stop();
+        g_changeListener.Reset();
+    }, nullptr);
+    
+    // Export individual functions
+    exports.Set(Napi::String::New(env, "initialize"), 
+                Napi::Function::New(env, Initialize));
+    exports.Set(Napi::String::New(env, "cleanup"), 
+                Napi::Function::New(env, Cleanup));
+    
+    // One getter per row of the identifier table, named after its collector method
+#define HWID_COMPONENT_EXPORT(Id, member, Type, Getter, ...) \
+    exports.Set(Napi::String::New(env, std::string(1, 'g') + (#Getter + 1)), \
+                Napi::Function::New(env, GetComponent<HardwareComponent::Id>));
+    HWID_COMPONENT_TABLE(HWID_COMPONENT_EXPORT)
+#undef HWID_COMPONENT_EXPORT
+    exports.Set(Napi::String::New(env, "getComponent"), 
+                Napi::Function::New(env, GetComponentByName));
+    exports.Set(Napi::String::New(env, "getComponentTable"), 
+                Napi::Function::New(env, GetComponentTable));
+    
     exports.Set(Napi::String::New(env, "getHardwareFingerprint"), 
                 Napi::Function::New(env, GetHardwareFingerprint));
+    exports.Set(Napi::String::New(env, "fingerprintEncode"), 
+                Napi::Function::New(env, FingerprintEncode));
+    exports.Set(Napi::String::New(env, "fingerprintDecode"), 
+                Napi::Function::New(env, FingerprintDecode));
     exports.Set(Napi::String::New(env, "getAllHardwareInfo"), 
                 Napi::Function::New(env, GetAllHardwareInfo));
+    exports.Set(Napi::String::New(env, "refreshHardwareInfo"), 
+                Napi::Function::New(env, RefreshHardwareInfo));
+    exports.Set(Napi::String::New(env, "getAllHardwareInfoAsync"), 
+                Napi::Function::New(env, GetAllHardwareInfoAsync));
+    exports.Set(Napi::String::New(env, "getCollectionStats"), 
+                Napi::Function::New(env, GetCollectionStats));
+    exports.Set(Napi::String::New(env, "collectRoots"), 
+                Napi::Function::New(env, CollectRoots));
+    exports.Set(Napi::String::New(env, "registryAdd"), 
+                Napi::Function::New(env, RegistryAdd));
+    exports.Set(Napi::String::New(env, "registryLoadJson"), 
+                Napi::Function::New(env, RegistryLoadJson));
+    exports.Set(Napi::String::New(env, "registryGet"), 
+                Napi::Function::New(env, RegistryGet));
+    exports.Set(Napi::String::New(env, "registrySnapshotId"), 
+                Napi::Function::New(env, RegistrySnapshotId));
+    exports.Set(Napi::String::New(env, "registryFind"), 
+                Napi::Function::New(env, RegistryFind));
+    exports.Set(Napi::String::New(env, "registryQuery"), 
+                Napi::Function::New(env, RegistryQuery));
+    exports.Set(Napi::String::New(env, "registryStats"), 
+                Napi::Function::New(env, RegistryStats));
+    exports.Set(Napi::String::New(env, "registryClear"), 
+                Napi::Function::New(env, RegistryClear));
+    exports.Set(Napi::String::New(env, "registryExport"), 
+                Napi::Function::New(env, RegistryExport));
+    exports.Set(Napi::String::New(env, "fleetFileQuery"), 
+                Napi::Function::New(env, FleetFileQueryRows));
+    exports.Set(Napi::String::New(env, "normalizeMacAddresses"), 
+                Napi::Function::New(env, NormalizeMacAddresses));
+    exports.Set(Napi::String::New(env, "encodeSnapshot"), 
+                Napi::Function::New(env, EncodeSnapshotBuffer));
+    exports.Set(Napi::String::New(env, "decodeSnapshots"), 
+                Napi::Function::New(env, DecodeSnapshotBuffer));
+    exports.Set(Napi::String::New(env, "telemetryEncode"), 
+                Napi::Function::New(env, TelemetryEncode));
+    exports.Set(Napi::String::New(env, "telemetryDecode"), 
+                Napi::Function::New(env, TelemetryDecode));
+    exports.Set(Napi::String::New(env, "telemetryReset"), 
+                Napi::Function::New(env, TelemetryReset));
+    exports.Set(Napi::String::New(env, "attestationCreate"), 
+                Napi::Function::New(env, AttestationCreate));
+    exports.Set(Napi::String::New(env, "attestationVerify"), 
+                Napi::Function::New(env, AttestationVerify));
+    exports.Set(Napi::String::New(env, "attestationDecode"), 
+                Napi::Function::New(env, AttestationDecode));
+    exports.Set(Napi::String::New(env, "jsonEncode"), 
+                Napi::Function::New(env, JsonEncodeEntries));
+    exports.Set(Napi::String::New(env, "jsonEncodeRegistry"), 
+                Napi::Function::New(env, JsonEncodeRegistry));
+    exports.Set(Napi::String::New(env, "startChangeMonitor"), 
+                Napi::Function::New(env, StartChangeMonitor));
+    exports.Set(Napi::String::New(env, "stopChangeMonitor"), 
+                Napi::Function::New(env, StopChangeMonitor));
     
     return exports;
 }
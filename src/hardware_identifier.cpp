@@ -1,15 +1,23 @@
 #include "hardware_identifier.h"
-#include <windows.h>
-#include <comdef.h>
-#include <wbemidl.h>
+#include "sysfs_collector.h"
+#include "component_watchdog.h"
+#include "hedged_request.h"
+#include "smbios_table.h"
+#include "utf16_transcoder.h"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 
+#ifdef _WIN32
+#include <windows.h>
+#include <comdef.h>
+#include <wbemidl.h>
+
 // Link with COM libraries
 #pragma comment(lib, "wbemuuid.lib")
 #pragma comment(lib, "ole32.lib")
 #pragma comment(lib, "oleaut32.lib")
+#endif
 
 /**
  * @brief Constructor - Initialize member variables
@@ -32,6 +40,15 @@ HardwareIdentifier::~HardwareIdentifier() {
  * @return true if successful, false otherwise
  */
 bool HardwareIdentifier::Initialize() {
+    if (std::shared_ptr<SysfsCollector> collector = OfflineCollector()) {
+        return collector->IsValidRoot();
+    }
+
+#ifndef _WIN32
+    // Without WMI the live system is read like any other root
+    SetRootPath("");
+    return OfflineCollector()->IsValidRoot();
+#else
     if (m_isInitialized) {
         return true;
     }
@@ -115,19 +132,27 @@ bool HardwareIdentifier::Initialize() {
 
     // Store the pointers
     m_pWbemLocator = pLoc;
-    m_pWbemServices = pSvc;
+    {
+        std::lock_guard<std::mutex> lock(m_servicesMutex);
+        m_pWbemServices = pSvc;
+    }
     m_isInitialized = true;
 
     return true;
+#endif
 }
 
 /**
  * @brief Clean up COM resources
  */
 void HardwareIdentifier::Cleanup() {
-    if (m_pWbemServices) {
-        static_cast<IWbemServices*>(m_pWbemServices)->Release();
-        m_pWbemServices = nullptr;
+#ifdef _WIN32
+    {
+        std::lock_guard<std::mutex> lock(m_servicesMutex);
+        if (m_pWbemServices) {
+            static_cast<IWbemServices*>(m_pWbemServices)->Release();
+            m_pWbemServices = nullptr;
+        }
     }
 
     if (m_pWbemLocator) {
@@ -139,6 +164,68 @@ void HardwareIdentifier::Cleanup() {
         CoUninitialize();
         m_isInitialized = false;
     }
+#endif
+}
+
+/**
+ * @brief Read identifiers from an alternate root instead of the live system
+ */
+void HardwareIdentifier::SetRootPath(const std::string& rootPath) {
+    std::shared_ptr<SysfsCollector> collector;
+#ifdef _WIN32
+    if (!rootPath.empty()) {
+        collector = std::make_shared<SysfsCollector>(rootPath);
+    }
+#else
+    collector = std::make_shared<SysfsCollector>(rootPath.empty() ? "/" : rootPath);
+#endif
+    // Collections in flight keep their own reference to the previous collector
+    std::lock_guard<std::mutex> lock(m_collectorMutex);
+    m_offlineCollector.swap(collector);
+}
+
+/**
+ * @brief Take a reference to the alternate-root collector
+ */
+std::shared_ptr<SysfsCollector> HardwareIdentifier::OfflineCollector() const {
+    std::lock_guard<std::mutex> lock(m_collectorMutex);
+    return m_offlineCollector;
+}
+
+/**
+ * @brief Prepare the calling worker thread for hardware queries
+ */
+bool HardwareIdentifier::InitializeWorkerThread() {
+#ifdef _WIN32
+    // Join the process-wide multithreaded apartment created by Initialize()
+    HRESULT hres = CoInitializeEx(0, COINIT_MULTITHREADED);
+    return SUCCEEDED(hres);
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Release per-thread state acquired by InitializeWorkerThread()
+ */
+void HardwareIdentifier::UninitializeWorkerThread() {
+#ifdef _WIN32
+    CoUninitialize();
+#endif
+}
+
+#ifdef _WIN32
+/**
+ * @brief Take a reference to the WMI services proxy
+ */
+void* HardwareIdentifier::AcquireServices() {
+    std::lock_guard<std::mutex> lock(m_servicesMutex);
+    if (!m_pWbemServices) {
+        return nullptr;
+    }
+    IWbemServices* pSvc = static_cast<IWbemServices*>(m_pWbemServices);
+    pSvc->AddRef();
+    return pSvc;
 }
 
 /**
@@ -147,11 +234,10 @@ void HardwareIdentifier::Cleanup() {
 std::string HardwareIdentifier::ExecuteWmiQuery(const std::string& wmiClass, 
                                                const std::string& property, 
                                                int index) {
-    if (!m_isInitialized) {
+    IWbemServices* pSvc = static_cast<IWbemServices*>(AcquireServices());
+    if (!pSvc) {
         return "";
     }
-
-    IWbemServices* pSvc = static_cast<IWbemServices*>(m_pWbemServices);
     
     // Build WQL query
     std::string query = "SELECT " + property + " FROM " + wmiClass;
@@ -167,6 +253,7 @@ std::string HardwareIdentifier::ExecuteWmiQuery(const std::string& wmiClass,
     );
 
     if (FAILED(hres)) {
+        pSvc->Release();
         return "";
     }
 
@@ -195,7 +282,7 @@ std::string HardwareIdentifier::ExecuteWmiQuery(const std::string& wmiClass,
         // Get the value of the property
         hres = pclsObj->Get(_bstr_t(property.c_str()), 0, &vtProp, 0, 0);
         if (SUCCEEDED(hres) && vtProp.vt == VT_BSTR && vtProp.bstrVal) {
-            result = WideStringToString(std::wstring(vtProp.bstrVal));
+            result = WideStringToString(vtProp.bstrVal, SysStringLen(vtProp.bstrVal));
         }
 
         VariantClear(&vtProp);
@@ -203,6 +290,7 @@ std::string HardwareIdentifier::ExecuteWmiQuery(const std::string& wmiClass,
     }
 
     pEnumerator->Release();
+    pSvc->Release();
     return result;
 }
 
@@ -213,11 +301,10 @@ std::vector<std::string> HardwareIdentifier::ExecuteWmiQueryMultiple(const std::
                                                                     const std::string& property) {
     std::vector<std::string> results;
     
-    if (!m_isInitialized) {
+    IWbemServices* pSvc = static_cast<IWbemServices*>(AcquireServices());
+    if (!pSvc) {
         return results;
     }
-
-    IWbemServices* pSvc = static_cast<IWbemServices*>(m_pWbemServices);
     
     // Build WQL query
     std::string query = "SELECT " + property + " FROM " + wmiClass;
@@ -233,6 +320,7 @@ std::vector<std::string> HardwareIdentifier::ExecuteWmiQueryMultiple(const std::
     );
 
     if (FAILED(hres)) {
+        pSvc->Release();
         return results;
     }
 
@@ -252,7 +340,7 @@ std::vector<std::string> HardwareIdentifier::ExecuteWmiQueryMultiple(const std::
         // Get the value of the property
         hres = pclsObj->Get(_bstr_t(property.c_str()), 0, &vtProp, 0, 0);
         if (SUCCEEDED(hres) && vtProp.vt == VT_BSTR && vtProp.bstrVal) {
-            std::string value = WideStringToString(std::wstring(vtProp.bstrVal));
+            std::string value = WideStringToString(vtProp.bstrVal, SysStringLen(vtProp.bstrVal));
             if (!value.empty()) {
                 results.push_back(value);
             }
@@ -263,48 +351,114 @@ std::vector<std::string> HardwareIdentifier::ExecuteWmiQueryMultiple(const std::
     }
 
     pEnumerator->Release();
+    pSvc->Release();
     return results;
 }
 
 /**
  * @brief Convert wide string to UTF-8 string
  */
-std::string HardwareIdentifier::WideStringToString(const std::wstring& wstr) {
-    if (wstr.empty()) {
+std::string HardwareIdentifier::WideStringToString(const wchar_t* data, size_t length) {
+    // BSTRs are UTF-16 on Windows; transcode in one pass instead of sizing
+    // with WideCharToMultiByte first
+    static_assert(sizeof(wchar_t) == sizeof(char16_t), "WMI strings are UTF-16");
+    return Utf16ToUtf8(reinterpret_cast<const char16_t*>(data), length);
+}
+
+/**
+ * @brief Read a string from the raw SMBIOS firmware table
+ */
+std::string HardwareIdentifier::ReadFirmwareTableString(uint8_t structureType, uint8_t fieldOffset) {
+    const DWORD provider = 'RSMB';
+    UINT size = GetSystemFirmwareTable(provider, 0, NULL, 0);
+    if (size < 8) {
+        return "";
+    }
+
+    std::vector<BYTE> buffer(size);
+    if (GetSystemFirmwareTable(provider, 0, buffer.data(), size) != size) {
         return "";
     }
 
-    int size_needed = WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), NULL, 0, NULL, NULL);
-    std::string strTo(size_needed, 0);
-    WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), &strTo[0], size_needed, NULL, NULL);
-    return strTo;
+    // RawSMBIOSData: four version bytes, DWORD table length, then the table
+    DWORD length = 0;
+    memcpy(&length, &buffer[4], sizeof(length));
+    length = std::min<DWORD>(length, size - 8);
+    return FindSmbiosString(&buffer[8], length, structureType, fieldOffset);
 }
+#else
+/**
+ * @brief WMI is Windows-only; other systems are read through SysfsCollector
+ */
+std::string HardwareIdentifier::ExecuteWmiQuery(const std::string&, const std::string&, int) {
+    return "";
+}
+
+std::vector<std::string> HardwareIdentifier::ExecuteWmiQueryMultiple(const std::string&, const std::string&) {
+    return std::vector<std::string>();
+}
+
+std::string HardwareIdentifier::ReadFirmwareTableString(uint8_t, uint8_t) {
+    return "";
+}
+#endif
 
 /**
  * @brief Get CPU identifier (processor ID)
  */
 std::string HardwareIdentifier::GetCpuId() {
+    if (std::shared_ptr<SysfsCollector> collector = OfflineCollector()) {
+        return collector->GetCpuId();
+    }
     return ExecuteWmiQuery("Win32_Processor", "ProcessorId", 0);
 }
 
 /**
  * @brief Get motherboard serial number
+ *
+ * Hedged between WMI and the raw SMBIOS table WMI reads it from.
  */
 std::string HardwareIdentifier::GetMotherboardSerial() {
-    return ExecuteWmiQuery("Win32_BaseBoard", "SerialNumber", 0);
+    if (std::shared_ptr<SysfsCollector> collector = OfflineCollector()) {
+        return collector->GetMotherboardSerial();
+    }
+
+    // Hedging needs shared ownership, the losing query may outlive this call
+    std::shared_ptr<HardwareIdentifier> self = weak_from_this().lock();
+    if (!self) {
+        return NormalizeIdentifier(ExecuteWmiQuery("Win32_BaseBoard", "SerialNumber", 0));
+    }
+    return HedgedSource::Get("wmi.motherboardSerial").Run(
+        [self]() { return self->ExecuteWmiQuery("Win32_BaseBoard", "SerialNumber", 0); },
+        []() { return ReadFirmwareTableString(kSmbiosBaseboardInformation, kSmbiosSerialNumberOffset); });
 }
 
 /**
  * @brief Get BIOS serial number
+ *
+ * Hedged between WMI and the raw SMBIOS table WMI reads it from.
  */
 std::string HardwareIdentifier::GetBiosSerial() {
-    return ExecuteWmiQuery("Win32_BIOS", "SerialNumber", 0);
+    if (std::shared_ptr<SysfsCollector> collector = OfflineCollector()) {
+        return collector->GetBiosSerial();
+    }
+
+    std::shared_ptr<HardwareIdentifier> self = weak_from_this().lock();
+    if (!self) {
+        return NormalizeIdentifier(ExecuteWmiQuery("Win32_BIOS", "SerialNumber", 0));
+    }
+    return HedgedSource::Get("wmi.biosSerial").Run(
+        [self]() { return self->ExecuteWmiQuery("Win32_BIOS", "SerialNumber", 0); },
+        []() { return ReadFirmwareTableString(kSmbiosSystemInformation, kSmbiosSerialNumberOffset); });
 }
 
 /**
  * @brief Get disk drive serial numbers
  */
 std::vector<std::string> HardwareIdentifier::GetDiskSerials() {
+    if (std::shared_ptr<SysfsCollector> collector = OfflineCollector()) {
+        return collector->GetDiskSerials();
+    }
     return ExecuteWmiQueryMultiple("Win32_PhysicalMedia", "SerialNumber");
 }
 
@@ -312,46 +466,74 @@ std::vector<std::string> HardwareIdentifier::GetDiskSerials() {
  * @brief Get network adapter MAC addresses
  */
 std::vector<std::string> HardwareIdentifier::GetMacAddresses() {
+    if (std::shared_ptr<SysfsCollector> collector = OfflineCollector()) {
+        return collector->GetMacAddresses();
+    }
     return ExecuteWmiQueryMultiple("Win32_NetworkAdapter", "MACAddress");
 }
 
 /**
- * @brief Generate a simple hash from input string
+ * @brief Collect a single hardware component into a snapshot
  */
-std::string HardwareIdentifier::GenerateHash(const std::string& input) {
-    // Simple hash algorithm for demonstration
-    // In production, consider using a cryptographic hash like SHA-256
-    std::hash<std::string> hasher;
-    size_t hashValue = hasher(input);
-    
-    std::stringstream ss;
-    ss << std::hex << hashValue;
-    return ss.str();
+void HardwareIdentifier::CollectComponent(HardwareComponent component, HardwareInfo& info) {
+    CollectComponentWith(*this, component, info);
 }
 
 /**
- * @brief Generate a combined hardware fingerprint
+ * @brief Collect a single hardware component under a watchdog deadline
  */
-std::string HardwareIdentifier::GetHardwareFingerprint() {
-    std::stringstream fingerprint;
-    
-    // Combine multiple hardware identifiers
-    fingerprint << GetCpuId();
-    fingerprint << "|" << GetMotherboardSerial();
-    fingerprint << "|" << GetBiosSerial();
-    
-    // Add first disk serial if available
-    auto diskSerials = GetDiskSerials();
-    if (!diskSerials.empty()) {
-        fingerprint << "|" << diskSerials[0];
+bool HardwareIdentifier::CollectComponent(HardwareComponent component, HardwareInfo& info, uint32_t timeoutMs) {
+    if (timeoutMs == 0) {
+        CollectComponent(component, info);
+        return true;
     }
-    
-    // Add first MAC address if available
-    auto macAddresses = GetMacAddresses();
-    if (!macAddresses.empty()) {
-        fingerprint << "|" << macAddresses[0];
+
+    // The task owns everything it touches, so it can safely outlive this call
+    std::shared_ptr<HardwareIdentifier> self = shared_from_this();
+    std::shared_ptr<HardwareInfo> result = std::make_shared<HardwareInfo>();
+    bool finished = ComponentWatchdog::Instance().RunWithDeadline([self, component, result]() {
+        self->CollectComponent(component, *result);
+    }, std::chrono::milliseconds(timeoutMs));
+
+    if (!finished) {
+        info.timedOutComponents |= ComponentBit(component);
+        return false;
     }
-    
-    // Generate hash of the combined string
-    return GenerateHash(fingerprint.str());
+
+    // Copied rather than moved so the caller's buffers are reused
+    CopyComponent(component, *result, info);
+    return true;
+}
+
+/**
+ * @brief Collect every hardware component and the fingerprint
+ */
+HardwareInfo HardwareIdentifier::GetAllHardwareInfo() {
+    return GetAllHardwareInfo(CollectionOptions());
+}
+
+/**
+ * @brief Collect every hardware component with per-component deadlines
+ */
+HardwareInfo HardwareIdentifier::GetAllHardwareInfo(const CollectionOptions& options) {
+    HardwareInfo info;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        CollectComponent(static_cast<HardwareComponent>(i), info, options.componentTimeoutMs);
+    }
+    ApplyFingerprintProfile(info, options.requiredComponents);
+    return info;
+}
+
+/**
+ * @brief Generate a combined hardware fingerprint
+ */
+std::string HardwareIdentifier::GetHardwareFingerprint() {
+    return GetAllHardwareInfo().fingerprint;
+}
+
+/**
+ * @brief Generate a hardware fingerprint with per-component deadlines
+ */
+std::string HardwareIdentifier::GetHardwareFingerprint(const CollectionOptions& options) {
+    return GetAllHardwareInfo(options).fingerprint;
 }
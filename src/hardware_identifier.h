@@ -1,14 +1,20 @@
 #ifndef HARDWARE_IDENTIFIER_H
 #define HARDWARE_IDENTIFIER_H
 
+#include "hardware_info.h"
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+class SysfsCollector;
+
 /**
  * @brief Hardware Identifier class for Windows platform
  * 
  * This class provides methods to retrieve various hardware identifiers
  * from a Windows system using WMI (Windows Management Instrumentation).
+ * On other systems the live identifiers are read through procfs and sysfs.
  * 
  * Features:
  * - CPU ID retrieval
@@ -16,8 +22,11 @@
  * - BIOS serial number
  * - Disk drive serial numbers
  * - Network adapter MAC addresses
+ *
+ * With an alternate root set, identifiers are read from a captured Linux
+ * sysfs/procfs tree or mounted system image instead of the live system.
  */
-class HardwareIdentifier {
+class HardwareIdentifier : public std::enable_shared_from_this<HardwareIdentifier> {
 public:
     /**
      * @brief Construct a new Hardware Identifier object
@@ -31,6 +40,10 @@ public:
 
     /**
      * @brief Initialize COM and WMI services
+     *
+     * Outside Windows no services are needed; the live system is read
+     * through a SysfsCollector rooted at "/".
+     *
      * @return true if initialization successful, false otherwise
      */
     bool Initialize();
@@ -40,6 +53,35 @@ public:
      */
     void Cleanup();
 
+    /**
+     * @brief Read identifiers from an alternate root instead of the live system
+     *
+     * Must be called before Initialize(). With a root set, Initialize() only
+     * checks that the root exists and no WMI connection is made. Re-rooting
+     * is safe while collections run on other threads: they finish against
+     * the collector they started with.
+     *
+     * @param rootPath Root of a captured sysfs tree or mounted image, empty for
+     *        the live system (WMI on Windows, "/" elsewhere)
+     */
+    void SetRootPath(const std::string& rootPath);
+
+    /**
+     * @brief Prepare the calling worker thread for hardware queries
+     *
+     * Must be called on every thread other than the one that called
+     * Initialize() before it collects components.
+     *
+     * @return true if the thread was initialized and UninitializeWorkerThread()
+     *         must be called before it exits, false otherwise
+     */
+    static bool InitializeWorkerThread();
+
+    /**
+     * @brief Release per-thread state acquired by InitializeWorkerThread()
+     */
+    static void UninitializeWorkerThread();
+
     /**
      * @brief Get CPU identifier (processor ID)
      * @return CPU ID as string, empty if failed
@@ -76,6 +118,58 @@ public:
      */
     std::string GetHardwareFingerprint();
 
+    /**
+     * @brief Collect a single hardware component into a snapshot
+     * @param component Component to collect
+     * @param info Snapshot receiving the component value
+     */
+    void CollectComponent(HardwareComponent component, HardwareInfo& info);
+
+    /**
+     * @brief Collect a single hardware component under a watchdog deadline
+     *
+     * On timeout the collection is abandoned on its watchdog thread, the
+     * component is flagged in info.timedOutComponents and its value is left
+     * untouched. A collection that throws is flagged the same way, so the
+     * fingerprint profile treats it as unavailable. The identifier must be owned by a std::shared_ptr, since an
+     * abandoned collection keeps it alive until the query returns.
+     *
+     * @param component Component to collect
+     * @param info Snapshot receiving the component value
+     * @param timeoutMs Deadline in milliseconds, 0 collects without a watchdog
+     * @return true if the component was collected, false if it timed out or failed
+     */
+    bool CollectComponent(HardwareComponent component, HardwareInfo& info, uint32_t timeoutMs);
+
+    /**
+     * @brief Collect every hardware component and the fingerprint
+     *
+     * Each component is queried once; the fingerprint is derived from the
+     * collected values rather than by querying the hardware again.
+     *
+     * @return Snapshot of all hardware identifiers
+     */
+    HardwareInfo GetAllHardwareInfo();
+
+    /**
+     * @brief Collect every hardware component with per-component deadlines
+     *
+     * Components that miss their deadline are flagged in
+     * timedOutComponents; the fingerprint is set according to the
+     * fingerprint profile in options.
+     *
+     * @param options Watchdog deadline and fingerprint profile
+     * @return Snapshot of all hardware identifiers, possibly partial
+     */
+    HardwareInfo GetAllHardwareInfo(const CollectionOptions& options);
+
+    /**
+     * @brief Generate a hardware fingerprint with per-component deadlines
+     * @param options Watchdog deadline and fingerprint profile
+     * @return Hardware fingerprint, empty if a required component timed out
+     */
+    std::string GetHardwareFingerprint(const CollectionOptions& options);
+
 private:
     /**
      * @brief Execute WMI query and return string result
@@ -99,22 +193,46 @@ private:
 
     /**
      * @brief Convert wide string to UTF-8 string
-     * @param wstr Wide string input
+     * @param data UTF-16 wide string input
+     * @param length Number of wide characters
      * @return UTF-8 string output
      */
-    std::string WideStringToString(const std::wstring& wstr);
+    std::string WideStringToString(const wchar_t* data, size_t length);
+
+    /**
+     * @brief Take a reference to the WMI services proxy
+     *
+     * Queries hold their own reference, so Cleanup() on another thread
+     * cannot free the proxy under a query abandoned by the watchdog.
+     *
+     * @return IWbemServices pointer to Release() after use, nullptr if not initialized
+     */
+    void* AcquireServices();
+
+    /**
+     * @brief Read a string from the raw SMBIOS firmware table
+     *
+     * Redundant source for WMI properties that WMI itself reads from SMBIOS.
+     *
+     * @param structureType SMBIOS structure type
+     * @param fieldOffset Offset of the string index byte in the structure
+     * @return String value, empty if not available
+     */
+    static std::string ReadFirmwareTableString(uint8_t structureType, uint8_t fieldOffset);
 
     /**
-     * @brief Generate hash from input string (simple hash for fingerprint)
-     * @param input Input string to hash
-     * @return Hashed string
+     * @brief Take a reference to the alternate-root collector
+     * @return Collector, nullptr when reading the live system through WMI
      */
-    std::string GenerateHash(const std::string& input);
+    std::shared_ptr<SysfsCollector> OfflineCollector() const;
 
 private:
     bool m_isInitialized;
+    std::shared_ptr<SysfsCollector> m_offlineCollector;  // Alternate root; "/" for the live system outside Windows
+    mutable std::mutex m_collectorMutex;                 // Guards m_offlineCollector against re-rooting
     void* m_pWbemLocator;    // IWbemLocator pointer (void* to avoid COM headers in header file)
     void* m_pWbemServices;   // IWbemServices pointer
+    std::mutex m_servicesMutex;  // Guards m_pWbemServices against concurrent Cleanup()
 };
 
 #endif // HARDWARE_IDENTIFIER_H
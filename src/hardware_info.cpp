@@ -0,0 +1,163 @@
+#include "hardware_info.h"
+#include "digest_encoding.h"
+#include "sha256.h"
+#include <cstring>
+#include <functional>
+#include <utility>
+
+/**
+ * @brief Get the JavaScript property name of a hardware component
+ */
+const char* ComponentName(HardwareComponent component) {
+    uint32_t index = static_cast<uint32_t>(component);
+    return index < kHardwareComponentCount ? kComponentTraits[index].name : "unknown";
+}
+
+/**
+ * @brief Find a hardware component by its JavaScript property name
+ */
+bool FindComponent(std::string_view name, HardwareComponent& component) {
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        if (name == kComponentTraits[i].name) {
+            component = static_cast<HardwareComponent>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Move one component value between snapshots
+ */
+void MoveComponent(HardwareComponent component, HardwareInfo& from, HardwareInfo& to) {
+    switch (component) {
+#define HWID_COMPONENT_MOVE(Id, member, ...) case HardwareComponent::Id: to.member = std::move(from.member); break;
+        HWID_COMPONENT_TABLE(HWID_COMPONENT_MOVE)
+#undef HWID_COMPONENT_MOVE
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Copy a scalar value into existing storage
+ */
+void AssignComponentValue(ComponentScalar& to, const ComponentScalar& from) {
+    to.assign(from);
+}
+
+/**
+ * @brief Copy a list value into existing storage
+ */
+void AssignComponentValue(ComponentList& to, const ComponentList& from) {
+    // Shrinking keeps the vector's capacity; only new entries allocate
+    to.resize(from.size());
+    for (size_t i = 0; i < from.size(); i++) {
+        to[i].assign(from[i]);
+    }
+}
+
+/**
+ * @brief Copy one component value between snapshots into existing storage
+ */
+void CopyComponent(HardwareComponent component, const HardwareInfo& from, HardwareInfo& to) {
+    switch (component) {
+#define HWID_COMPONENT_COPY(Id, member, ...) case HardwareComponent::Id: AssignComponentValue(to.member, from.member); break;
+        HWID_COMPONENT_TABLE(HWID_COMPONENT_COPY)
+#undef HWID_COMPONENT_COPY
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Compare one component value of two snapshots
+ */
+bool ComponentEquals(HardwareComponent component, const HardwareInfo& a, const HardwareInfo& b) {
+    switch (component) {
+#define HWID_COMPONENT_EQUALS(Id, member, ...) case HardwareComponent::Id: return a.member == b.member;
+        HWID_COMPONENT_TABLE(HWID_COMPONENT_EQUALS)
+#undef HWID_COMPONENT_EQUALS
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Join the identifiers that make up the fingerprint
+ */
+void BuildFingerprintInput(const HardwareInfo& info, std::string& input) {
+    // Combine multiple hardware identifiers
+    input.clear();
+    input += info.cpuId;
+    input += '|';
+    input += info.motherboardSerial;
+    input += '|';
+    input += info.biosSerial;
+    
+    // Add first disk serial if available
+    if (!info.diskSerials.empty()) {
+        input += '|';
+        input += info.diskSerials[0];
+    }
+    
+    // Add first MAC address if available
+    if (!info.macAddresses.empty()) {
+        input += '|';
+        input += info.macAddresses[0];
+    }
+}
+
+/**
+ * @brief Hash a fingerprint input into its text form
+ */
+size_t FormatFingerprint(std::string_view input, char* text) {
+    // Simple hash algorithm for demonstration
+    // In production, consider using a cryptographic hash like SHA-256
+    size_t hashValue = std::hash<std::string_view>()(input);
+    
+    // Variable-length lowercase hex, as fingerprints have always been formatted
+    uint8_t bytes[sizeof(size_t)];
+    for (size_t i = 0; i < sizeof(size_t); i++) {
+        bytes[i] = static_cast<uint8_t>(hashValue >> (8 * (sizeof(size_t) - 1 - i)));
+    }
+    char digits[kMaxFingerprintLength];
+    EncodeDigest(DigestEncoding::Hex, bytes, sizeof(bytes), digits);
+    size_t start = 0;
+    while (start + 1 < sizeof(digits) && digits[start] == '0') {
+        start++;
+    }
+    size_t length = sizeof(digits) - start;
+    memcpy(text, digits + start, length);
+    return length;
+}
+
+/**
+ * @brief Compute the hardware fingerprint of collected identifiers
+ */
+std::string ComputeFingerprint(const HardwareInfo& info) {
+    std::string input;
+    BuildFingerprintInput(info, input);
+    char text[kMaxFingerprintLength];
+    return std::string(text, FormatFingerprint(input, text));
+}
+
+/**
+ * @brief Compute the SHA-256 fingerprint digest of collected identifiers
+ */
+void ComputeFingerprintDigest(const HardwareInfo& info, uint8_t* digest) {
+    std::string input;
+    BuildFingerprintInput(info, input);
+    Sha256Digest(input.data(), input.size(), digest);
+}
+
+/**
+ * @brief Set the snapshot fingerprint according to a fingerprint profile
+ */
+void ApplyFingerprintProfile(HardwareInfo& info, uint32_t requiredComponents) {
+    if (info.timedOutComponents & requiredComponents) {
+        info.fingerprint.clear();
+        return;
+    }
+    info.fingerprint = ComputeFingerprint(info);
+}
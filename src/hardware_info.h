@@ -0,0 +1,313 @@
+#ifndef HARDWARE_INFO_H
+#define HARDWARE_INFO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Value types of hardware components
+ */
+using ComponentScalar = std::string;                // One identifier
+using ComponentList = std::vector<std::string>;     // One identifier per matching device
+
+/**
+ * @brief Sources a component can be read from (bit mask)
+ */
+enum ComponentSource : uint32_t {
+    kSourceWmi = 1u << 0,       // WMI on Windows
+    kSourceSmbios = 1u << 1,    // Raw SMBIOS/DMI firmware table
+    kSourceProcfs = 1u << 2,    // procfs on Linux
+    kSourceSysfs = 1u << 3      // sysfs on Linux
+};
+
+/**
+ * @brief Relative cost class of collecting a component
+ */
+enum class ComponentCost : uint8_t {
+    Attribute,      // One query or attribute read
+    Hedged,         // Redundant sources raced against each other
+    Enumeration     // One read per device of a class
+};
+
+/**
+ * @brief How a component value changes while the system runs
+ */
+enum class ComponentVolatility : uint8_t {
+    Fixed,          // Only when the hardware is replaced
+    Hotplug         // When devices are attached or removed
+};
+
+/**
+ * @brief Identifier table, one row per hardware component
+ *
+ *   X(Id, member, Type, Getter, label, sources, cost, volatility)
+ *
+ * Id names the HardwareComponent enumerator and member the HardwareInfo
+ * field, which is also the JavaScript property name. Type is Scalar or
+ * List (ComponentScalar, ComponentList). Getter is the collector method of
+ * HardwareIdentifier and SysfsCollector, exported to JavaScript with a
+ * lowercase first letter; label names the component in error messages.
+ *
+ * The enumerator, HardwareInfo fields, traits, collector dispatch and the
+ * addon's per-component exports and conversions are generated from this
+ * table, so dispatch is a switch on the enumerator. A row's position is
+ * its bit in component masks: only append rows. Versioned layouts
+ * (HardwareSnapshot, snapshot_codec.h, fleet files) still list their
+ * fields explicitly.
+ */
+#define HWID_COMPONENT_TABLE(X) \
+    X(CpuId,             cpuId,             Scalar, GetCpuId,             "CPU ID",             kSourceWmi | kSourceProcfs,                Attribute,   Fixed)   \
+    X(MotherboardSerial, motherboardSerial, Scalar, GetMotherboardSerial, "motherboard serial", kSourceWmi | kSourceSmbios | kSourceSysfs, Hedged,      Fixed)   \
+    X(BiosSerial,        biosSerial,        Scalar, GetBiosSerial,        "BIOS serial",        kSourceWmi | kSourceSmbios | kSourceSysfs, Hedged,      Fixed)   \
+    X(DiskSerials,       diskSerials,       List,   GetDiskSerials,       "disk serials",       kSourceWmi | kSourceSysfs,                 Enumeration, Hotplug) \
+    X(MacAddresses,      macAddresses,      List,   GetMacAddresses,      "MAC addresses",      kSourceWmi | kSourceSysfs,                 Enumeration, Hotplug)
+
+/**
+ * @brief Hardware components that make up a hardware snapshot
+ *
+ * Components are collected independently, so collection can be scheduled,
+ * interrupted or timed out at component granularity.
+ */
+enum class HardwareComponent : uint32_t {
+#define HWID_COMPONENT_ENUMERATOR(Id, ...) Id,
+    HWID_COMPONENT_TABLE(HWID_COMPONENT_ENUMERATOR)
+#undef HWID_COMPONENT_ENUMERATOR
+    Count
+};
+
+/**
+ * @brief Number of collectable hardware components
+ */
+constexpr uint32_t kHardwareComponentCount = static_cast<uint32_t>(HardwareComponent::Count);
+
+/**
+ * @brief Bit mask with every hardware component set
+ */
+constexpr uint32_t kAllHardwareComponents = (1u << kHardwareComponentCount) - 1;
+
+/**
+ * @brief Get the mask bit of a hardware component
+ * @param component Hardware component
+ * @return Bit identifying the component in a component mask
+ */
+constexpr uint32_t ComponentBit(HardwareComponent component) {
+    return 1u << static_cast<uint32_t>(component);
+}
+
+/**
+ * @brief Static description of a hardware component
+ */
+struct ComponentTraits {
+    const char* name;           // JavaScript property name
+    const char* getter;         // Collector method name
+    const char* label;          // Name in error messages
+    bool isList;                // ComponentList rather than ComponentScalar
+    uint32_t sources;           // ComponentSource mask
+    ComponentCost cost;
+    ComponentVolatility volatility;
+};
+
+/**
+ * @brief Traits of every component, indexed by HardwareComponent
+ */
+constexpr ComponentTraits kComponentTraits[kHardwareComponentCount] = {
+#define HWID_COMPONENT_TRAITS(Id, member, Type, Getter, label, sources, cost, volatility) \
+    { #member, #Getter, label, std::is_same<Component##Type, ComponentList>::value, \
+      sources, ComponentCost::cost, ComponentVolatility::volatility },
+    HWID_COMPONENT_TABLE(HWID_COMPONENT_TRAITS)
+#undef HWID_COMPONENT_TRAITS
+};
+
+/**
+ * @brief Get the JavaScript property name of a hardware component
+ * @param component Hardware component
+ * @return Property name as used by getAllHardwareInfo()
+ */
+const char* ComponentName(HardwareComponent component);
+
+/**
+ * @brief Find a hardware component by its JavaScript property name
+ * @param name Property name such as "cpuId"
+ * @param component Receives the component
+ * @return false if no component has that name
+ */
+bool FindComponent(std::string_view name, HardwareComponent& component);
+
+/**
+ * @brief Complete set of hardware identifiers collected from one system
+ */
+struct HardwareInfo {
+#define HWID_COMPONENT_FIELD(Id, member, Type, ...) Component##Type member;
+    HWID_COMPONENT_TABLE(HWID_COMPONENT_FIELD)
+#undef HWID_COMPONENT_FIELD
+    std::string fingerprint;
+    uint32_t timedOutComponents = 0;  // Components abandoned by the watchdog (ComponentBit mask)
+};
+
+/**
+ * @brief Call a function with the value of one component
+ *
+ * The function receives the field as a ComponentScalar or ComponentList
+ * reference, so a generic lambda is instantiated per value type.
+ *
+ * @param component Component to visit
+ * @param info Snapshot, const or not
+ * @param visit Function taking the field
+ */
+template <typename Info, typename Visit>
+inline void VisitComponent(HardwareComponent component, Info& info, Visit&& visit) {
+    switch (component) {
+#define HWID_COMPONENT_VISIT(Id, member, ...) case HardwareComponent::Id: visit(info.member); break;
+        HWID_COMPONENT_TABLE(HWID_COMPONENT_VISIT)
+#undef HWID_COMPONENT_VISIT
+        default: break;
+    }
+}
+
+/**
+ * @brief Copy a component value into existing storage
+ *
+ * Unlike plain assignment from a collector's return value, the destination
+ * keeps its buffers: strings are overwritten in place and list entries are
+ * reused, so an unchanged value that fits allocates nothing.
+ *
+ * @param to Destination value
+ * @param from Source value
+ */
+void AssignComponentValue(ComponentScalar& to, const ComponentScalar& from);
+void AssignComponentValue(ComponentList& to, const ComponentList& from);
+
+/**
+ * @brief Collect one component through the collector method named in the table
+ *
+ * The value is copied into the existing field with AssignComponentValue().
+ *
+ * @param collector HardwareIdentifier, SysfsCollector or any type with the table's getters
+ * @param component Component to collect
+ * @param info Snapshot receiving the component value
+ */
+template <typename Collector>
+inline void CollectComponentWith(Collector& collector, HardwareComponent component, HardwareInfo& info) {
+    switch (component) {
+#define HWID_COMPONENT_COLLECT(Id, member, Type, Getter, ...) case HardwareComponent::Id: AssignComponentValue(info.member, collector.Getter()); break;
+        HWID_COMPONENT_TABLE(HWID_COMPONENT_COLLECT)
+#undef HWID_COMPONENT_COLLECT
+        default: break;
+    }
+}
+
+/**
+ * @brief Options controlling how a snapshot is collected
+ */
+struct CollectionOptions {
+    /**
+     * @brief Deadline for each component collection, 0 disables the watchdog
+     */
+    uint32_t componentTimeoutMs = 0;
+
+    /**
+     * @brief Fingerprint profile: components that must be present for a fingerprint
+     *
+     * If any required component timed out the snapshot carries no
+     * fingerprint. Timed-out components outside this mask are tolerated and
+     * the fingerprint is computed from the values that were collected.
+     */
+    uint32_t requiredComponents = kAllHardwareComponents;
+};
+
+/**
+ * @brief Move one component value between snapshots
+ * @param component Component to move
+ * @param from Source snapshot
+ * @param to Destination snapshot
+ */
+void MoveComponent(HardwareComponent component, HardwareInfo& from, HardwareInfo& to);
+
+/**
+ * @brief Copy one component value between snapshots into existing storage
+ * @param component Component to copy
+ * @param from Source snapshot
+ * @param to Destination snapshot
+ */
+void CopyComponent(HardwareComponent component, const HardwareInfo& from, HardwareInfo& to);
+
+/**
+ * @brief Compare one component value of two snapshots
+ * @param component Component to compare
+ * @param a First snapshot
+ * @param b Second snapshot
+ * @return true if both hold the same value
+ */
+bool ComponentEquals(HardwareComponent component, const HardwareInfo& a, const HardwareInfo& b);
+
+/**
+ * @brief Longest fingerprint ComputeFingerprint() returns
+ */
+constexpr size_t kMaxFingerprintLength = 2 * sizeof(size_t);
+
+/**
+ * @brief Join the identifiers that make up the fingerprint
+ *
+ * Uses CPU ID, motherboard serial, BIOS serial, the first disk serial and
+ * the first MAC address. The input is cleared first; callers on a hot
+ * path keep it between calls so its capacity is reused.
+ *
+ * @param info Collected hardware identifiers (fingerprint field is ignored)
+ * @param input Receives the fingerprint input
+ */
+void BuildFingerprintInput(const HardwareInfo& info, std::string& input);
+
+/**
+ * @brief Hash a fingerprint input into its text form
+ *
+ * Lowercase hex without leading zeros, and without a terminating NUL.
+ *
+ * @param input Fingerprint input from BuildFingerprintInput()
+ * @param text Receives up to kMaxFingerprintLength characters
+ * @return Number of characters written
+ */
+size_t FormatFingerprint(std::string_view input, char* text);
+
+/**
+ * @brief Compute the hardware fingerprint of collected identifiers
+ *
+ * Combines CPU ID, motherboard serial, BIOS serial, the first disk serial
+ * and the first MAC address, then hashes the result.
+ *
+ * @param info Collected hardware identifiers (fingerprint field is ignored)
+ * @return Hardware fingerprint string
+ */
+std::string ComputeFingerprint(const HardwareInfo& info);
+
+/**
+ * @brief Size of a fingerprint digest in bytes
+ */
+constexpr size_t kFingerprintDigestSize = 32;
+
+/**
+ * @brief Compute the SHA-256 fingerprint digest of collected identifiers
+ *
+ * Hashes the same identifiers as ComputeFingerprint, for callers that
+ * store or compare fixed-size binary keys; see digest_encoding.h for its
+ * text forms.
+ *
+ * @param info Collected hardware identifiers (fingerprint field is ignored)
+ * @param digest Receives kFingerprintDigestSize bytes
+ */
+void ComputeFingerprintDigest(const HardwareInfo& info, uint8_t* digest);
+
+/**
+ * @brief Set the snapshot fingerprint according to a fingerprint profile
+ *
+ * Leaves the fingerprint empty when a required component timed out.
+ *
+ * @param info Snapshot to fingerprint
+ * @param requiredComponents Components that must not have timed out
+ */
+void ApplyFingerprintProfile(HardwareInfo& info, uint32_t requiredComponents);
+
+#endif // HARDWARE_INFO_H
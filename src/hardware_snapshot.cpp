@@ -0,0 +1,132 @@
+#include "hardware_snapshot.h"
+#include <cstring>
+
+/**
+ * @brief Copy a value into the arena
+ */
+uint32_t SnapshotArena::Append(std::string_view value) {
+    uint32_t offset = static_cast<uint32_t>(m_bytes.size());
+    m_bytes.insert(m_bytes.end(), value.begin(), value.end());
+    return offset;
+}
+
+/**
+ * @brief View a value stored in the arena
+ */
+std::string_view SnapshotArena::View(uint32_t offset, uint32_t length) const {
+    if (static_cast<size_t>(offset) + length > m_bytes.size()) {
+        return std::string_view();
+    }
+    return std::string_view(m_bytes.data() + offset, length);
+}
+
+/**
+ * @brief Drop all values, keeping the capacity for reuse
+ */
+void SnapshotArena::Clear() {
+    m_bytes.clear();
+}
+
+size_t SnapshotArena::Size() const {
+    return m_bytes.size();
+}
+
+size_t SnapshotArena::Capacity() const {
+    return m_bytes.capacity();
+}
+
+const char* SnapshotArena::Data() const {
+    return m_bytes.data();
+}
+
+/**
+ * @brief Reset a snapshot to all-zero bytes
+ */
+void ClearSnapshot(HardwareSnapshot& snapshot) {
+    memset(&snapshot, 0, sizeof(snapshot));
+}
+
+/**
+ * @brief Store a value in a snapshot field
+ */
+void SetSnapshotField(SnapshotField& field, std::string_view value, SnapshotArena& arena) {
+    memset(&field, 0, sizeof(field));
+    field.length = static_cast<uint32_t>(value.size());
+    if (value.size() <= SnapshotField::kInlineCapacity) {
+        memcpy(field.inlineData, value.data(), value.size());
+    } else {
+        field.overflowOffset = arena.Append(value);
+    }
+}
+
+/**
+ * @brief Read a snapshot field
+ */
+std::string_view GetSnapshotField(const SnapshotField& field, const SnapshotArena& arena) {
+    if (field.IsOverflow()) {
+        return arena.View(field.overflowOffset, field.length);
+    }
+    return std::string_view(field.inlineData, field.length);
+}
+
+// HardwareSnapshot has one member per component; conversions list them all
+static_assert(kHardwareComponentCount == 5, "HardwareSnapshot stores 5 hardware components");
+
+/**
+ * @brief Convert collected identifiers to a fixed-layout snapshot
+ */
+void SnapshotFromHardwareInfo(const HardwareInfo& info, HardwareSnapshot& snapshot, SnapshotArena& arena) {
+    ClearSnapshot(snapshot);
+    SetSnapshotField(snapshot.cpuId, info.cpuId, arena);
+    SetSnapshotField(snapshot.motherboardSerial, info.motherboardSerial, arena);
+    SetSnapshotField(snapshot.biosSerial, info.biosSerial, arena);
+    SetSnapshotField(snapshot.fingerprint, info.fingerprint, arena);
+    snapshot.timedOutComponents = info.timedOutComponents;
+
+    for (const std::string& serial : info.diskSerials) {
+        if (snapshot.diskSerialCount == HardwareSnapshot::kMaxDiskSerials) {
+            snapshot.droppedEntries++;
+            continue;
+        }
+        SetSnapshotField(snapshot.diskSerials[snapshot.diskSerialCount++], serial, arena);
+    }
+    for (const std::string& address : info.macAddresses) {
+        if (snapshot.macAddressCount == HardwareSnapshot::kMaxMacAddresses) {
+            snapshot.droppedEntries++;
+            continue;
+        }
+        SetSnapshotField(snapshot.macAddresses[snapshot.macAddressCount++], address, arena);
+    }
+}
+
+/**
+ * @brief Expand a fixed-layout snapshot into separately allocated strings
+ */
+HardwareInfo SnapshotToHardwareInfo(const HardwareSnapshot& snapshot, const SnapshotArena& arena) {
+    HardwareInfo info;
+    info.cpuId = std::string(GetSnapshotField(snapshot.cpuId, arena));
+    info.motherboardSerial = std::string(GetSnapshotField(snapshot.motherboardSerial, arena));
+    info.biosSerial = std::string(GetSnapshotField(snapshot.biosSerial, arena));
+    info.fingerprint = std::string(GetSnapshotField(snapshot.fingerprint, arena));
+    info.timedOutComponents = snapshot.timedOutComponents;
+    for (uint32_t i = 0; i < snapshot.diskSerialCount && i < HardwareSnapshot::kMaxDiskSerials; i++) {
+        info.diskSerials.emplace_back(GetSnapshotField(snapshot.diskSerials[i], arena));
+    }
+    for (uint32_t i = 0; i < snapshot.macAddressCount && i < HardwareSnapshot::kMaxMacAddresses; i++) {
+        info.macAddresses.emplace_back(GetSnapshotField(snapshot.macAddresses[i], arena));
+    }
+    return info;
+}
+
+/**
+ * @brief Hash the raw bytes of a snapshot (FNV-1a, 64-bit)
+ */
+uint64_t HashSnapshotBytes(const HardwareSnapshot& snapshot) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&snapshot);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < sizeof(snapshot); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,159 @@
+#ifndef HARDWARE_SNAPSHOT_H
+#define HARDWARE_SNAPSHOT_H
+
+#include "hardware_info.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Fixed-size string field of a HardwareSnapshot
+ *
+ * Values up to kInlineCapacity bytes are stored inline and NUL-terminated;
+ * longer values live in the SnapshotArena passed alongside the snapshot and
+ * are referenced by offset, never by pointer, so the field stays valid when
+ * copied to another thread or mapped into another process. Unused inline
+ * bytes are always zero, which makes equal values byte-identical.
+ */
+struct SnapshotField {
+    static constexpr size_t kInlineCapacity = 55;
+
+    uint32_t length;                          // Full value length in bytes
+    uint32_t overflowOffset;                  // Arena offset when length > kInlineCapacity
+    char inlineData[kInlineCapacity + 1];
+
+    /**
+     * @brief Check whether the value is stored in the overflow arena
+     */
+    bool IsOverflow() const {
+        return length > kInlineCapacity;
+    }
+};
+
+static_assert(sizeof(SnapshotField) == 64, "SnapshotField must fill one cache line");
+
+/**
+ * @brief Append-only storage for snapshot values that do not fit inline
+ */
+class SnapshotArena {
+public:
+    /**
+     * @brief Copy a value into the arena
+     * @param value Value bytes
+     * @return Offset of the copied value
+     */
+    uint32_t Append(std::string_view value);
+
+    /**
+     * @brief View a value stored in the arena
+     * @param offset Offset returned by Append()
+     * @param length Value length
+     * @return View into the arena, valid until the next Append() or Clear()
+     */
+    std::string_view View(uint32_t offset, uint32_t length) const;
+
+    /**
+     * @brief Drop all values, keeping the capacity for reuse
+     */
+    void Clear();
+
+    /**
+     * @brief Get the number of bytes in use
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Get the number of bytes reserved
+     */
+    size_t Capacity() const;
+
+    /**
+     * @brief Get the raw arena bytes
+     */
+    const char* Data() const;
+
+private:
+    std::vector<char> m_bytes;
+};
+
+/**
+ * @brief Trivially copyable hardware snapshot with inline storage
+ *
+ * Counterpart of HardwareInfo without heap strings or vectors: every value
+ * is a SnapshotField and the disk and MAC lists are bounded inline arrays.
+ * Entries beyond the array capacity are counted but not stored; they never
+ * affect the fingerprint, which only uses the first disk and MAC. A
+ * snapshot can be memcpy'd, hashed as raw bytes and shared between threads
+ * or processes; overflow values additionally need the SnapshotArena.
+ */
+struct HardwareSnapshot {
+    static constexpr size_t kMaxDiskSerials = 8;
+    static constexpr size_t kMaxMacAddresses = 8;
+
+    SnapshotField cpuId;
+    SnapshotField motherboardSerial;
+    SnapshotField biosSerial;
+    SnapshotField fingerprint;
+    SnapshotField diskSerials[kMaxDiskSerials];
+    SnapshotField macAddresses[kMaxMacAddresses];
+    uint32_t diskSerialCount;       // Stored entries in diskSerials
+    uint32_t macAddressCount;       // Stored entries in macAddresses
+    uint32_t droppedEntries;        // Disk and MAC entries beyond the inline capacity
+    uint32_t timedOutComponents;    // Components abandoned by the watchdog (ComponentBit mask)
+};
+
+static_assert(std::is_trivially_copyable<HardwareSnapshot>::value, "HardwareSnapshot must be memcpy-able");
+static_assert(std::is_standard_layout<HardwareSnapshot>::value, "HardwareSnapshot must have a fixed layout");
+
+/**
+ * @brief Reset a snapshot to all-zero bytes
+ * @param snapshot Snapshot to clear
+ */
+void ClearSnapshot(HardwareSnapshot& snapshot);
+
+/**
+ * @brief Store a value in a snapshot field
+ * @param field Destination field
+ * @param value Value bytes
+ * @param arena Overflow storage for values longer than the inline capacity
+ */
+void SetSnapshotField(SnapshotField& field, std::string_view value, SnapshotArena& arena);
+
+/**
+ * @brief Read a snapshot field
+ * @param field Source field
+ * @param arena Overflow storage the field was written with
+ * @return View of the value
+ */
+std::string_view GetSnapshotField(const SnapshotField& field, const SnapshotArena& arena);
+
+/**
+ * @brief Convert collected identifiers to a fixed-layout snapshot
+ * @param info Collected identifiers
+ * @param snapshot Destination snapshot, fully overwritten
+ * @param arena Overflow storage for long values
+ */
+void SnapshotFromHardwareInfo(const HardwareInfo& info, HardwareSnapshot& snapshot, SnapshotArena& arena);
+
+/**
+ * @brief Expand a fixed-layout snapshot into separately allocated strings
+ * @param snapshot Source snapshot
+ * @param arena Overflow storage the snapshot was written with
+ * @return Equivalent HardwareInfo (entries dropped for capacity are absent)
+ */
+HardwareInfo SnapshotToHardwareInfo(const HardwareSnapshot& snapshot, const SnapshotArena& arena);
+
+/**
+ * @brief Hash the raw bytes of a snapshot (FNV-1a, 64-bit)
+ *
+ * Snapshots whose values are all inline hash equal exactly when their
+ * values are equal.
+ *
+ * @param snapshot Snapshot to hash
+ * @return 64-bit hash
+ */
+uint64_t HashSnapshotBytes(const HardwareSnapshot& snapshot);
+
+#endif // HARDWARE_SNAPSHOT_H
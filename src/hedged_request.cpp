@@ -0,0 +1,239 @@
+#include "hedged_request.h"
+#include "component_watchdog.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+
+// Hedge delay used until enough primary latencies have been observed
+static const uint64_t kInitialHedgeDelayMicros = 50000;
+
+// Samples needed before the percentile replaces the initial delay
+static const size_t kMinLatencySamples = 8;
+
+// Lower bound so a very fast primary is not hedged on scheduling noise
+static const uint64_t kMinHedgeDelayMicros = 1000;
+
+/**
+ * @brief Outcome of one race between the two sources
+ */
+struct HedgeRace {
+    std::mutex mutex;
+    std::condition_variable settled;
+    std::string value;
+    int winner = -1;       // 0 primary, 1 secondary
+    int started = 1;
+    int finished = 0;
+    bool sourceFinished[2] = {false, false};
+};
+
+/**
+ * @brief Normalize an identifier value read from any source
+ */
+std::string NormalizeIdentifier(const std::string& value) {
+    auto isPadding = [](char c) { return std::isspace(static_cast<unsigned char>(c)) || c == '\0'; };
+    size_t begin = 0;
+    size_t end = value.size();
+    while (begin < end && isPadding(value[begin])) {
+        begin++;
+    }
+    while (end > begin && isPadding(value[end - 1])) {
+        end--;
+    }
+    return value.substr(begin, end - begin);
+}
+
+/**
+ * @brief Registry of hedged sources by name
+ */
+static std::mutex& RegistryMutex() {
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+static std::map<std::string, HedgedSource*>& Registry() {
+    static std::map<std::string, HedgedSource*>* registry = new std::map<std::string, HedgedSource*>();
+    return *registry;
+}
+
+/**
+ * @brief Get the hedged source registered under a name
+ */
+HedgedSource& HedgedSource::Get(const char* name) {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    HedgedSource*& source = Registry()[name];
+    if (!source) {
+        source = new HedgedSource(name);
+    }
+    return *source;
+}
+
+/**
+ * @brief Get the counters of every hedged source
+ */
+std::vector<HedgeStats> HedgedSource::GetAllStats() {
+    std::vector<HedgeStats> all;
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    for (auto& entry : Registry()) {
+        HedgedSource* source = entry.second;
+        std::lock_guard<std::mutex> sourceLock(source->m_mutex);
+        HedgeStats stats = source->m_stats;
+        stats.hedgeDelayMs = source->HedgeDelayMicros() / 1000.0;
+        all.push_back(stats);
+    }
+    return all;
+}
+
+/**
+ * @brief Constructor - Initialize counters
+ */
+HedgedSource::HedgedSource(const char* name)
+    : m_latencyCount(0)
+    , m_latencyNext(0) {
+    m_stats.name = name;
+    m_stats.lastWinner = "none";
+    std::fill(m_latencies, m_latencies + kLatencySamples, 0);
+}
+
+/**
+ * @brief Record a primary source latency sample
+ */
+void HedgedSource::RecordPrimaryLatency(uint64_t micros) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_latencies[m_latencyNext] = micros;
+    m_latencyNext = (m_latencyNext + 1) % kLatencySamples;
+    m_latencyCount = std::min(m_latencyCount + 1, kLatencySamples);
+}
+
+/**
+ * @brief Current hedge delay in microseconds
+ */
+uint64_t HedgedSource::HedgeDelayMicros() const {
+    if (m_latencyCount < kMinLatencySamples) {
+        return kInitialHedgeDelayMicros;
+    }
+
+    uint64_t sorted[kLatencySamples];
+    std::copy(m_latencies, m_latencies + m_latencyCount, sorted);
+    size_t rank = (m_latencyCount * 95 + 99) / 100 - 1;
+    std::nth_element(sorted, sorted + rank, sorted + m_latencyCount);
+    return std::max(sorted[rank], kMinHedgeDelayMicros);
+}
+
+/**
+ * @brief Collect the identifier, hedging the primary with the secondary
+ */
+std::string HedgedSource::Run(Source primary, Source secondary) {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    std::shared_ptr<HedgeRace> race = std::make_shared<HedgeRace>();
+
+    uint64_t delayMicros;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        delayMicros = HedgeDelayMicros();
+    }
+
+    // Both sources go through the same normalization, so the value does not
+    // depend on which one wins
+    auto finish = [race](int source, const std::string& raw) {
+        std::string value = NormalizeIdentifier(raw);
+        std::lock_guard<std::mutex> lock(race->mutex);
+        race->finished++;
+        race->sourceFinished[source] = true;
+        if (race->winner < 0 && !value.empty()) {
+            race->winner = source;
+            race->value = std::move(value);
+        }
+        race->settled.notify_all();
+    };
+
+    // Instances are never destroyed, so tasks may keep a raw pointer
+    HedgedSource* self = this;
+    // A source that throws still settles the race, with an empty value
+    std::function<void()> runPrimary = [self, primary, finish, start]() {
+        std::string value;
+        try {
+            value = primary();
+        } catch (...) {
+            // Treated like a source with no value
+        }
+        self->RecordPrimaryLatency(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count()));
+        finish(0, value);
+    };
+    std::function<void()> runSecondary = [secondary, finish]() {
+        std::string value;
+        try {
+            value = secondary();
+        } catch (...) {
+            // Treated like a source with no value
+        }
+        finish(1, value);
+    };
+
+    ComponentWatchdog& watchdog = ComponentWatchdog::Instance();
+    ComponentWatchdog::Ticket primaryTicket;
+    ComponentWatchdog::Ticket secondaryTicket;
+    bool hedged = false;
+
+    std::unique_lock<std::mutex> lock(race->mutex);
+    if (watchdog.Post(runPrimary, &primaryTicket)) {
+        race->settled.wait_for(lock, std::chrono::microseconds(delayMicros), [&race] {
+            return race->winner >= 0 || race->finished == race->started;
+        });
+    } else {
+        // Too many threads stuck already, likely in this very primary: use
+        // only the secondary rather than block on the primary here
+        race->started = 0;
+    }
+
+    if (race->winner < 0) {
+        hedged = true;
+        race->started++;
+        lock.unlock();
+        if (!watchdog.Post(runSecondary, &secondaryTicket)) {
+            runSecondary();
+        }
+        lock.lock();
+    }
+
+    race->settled.wait(lock, [&race] {
+        return race->winner >= 0 || race->finished == race->started;
+    });
+    std::string value = race->value;
+    int winner = race->winner;
+    bool primaryRunning = !race->sourceFinished[0];
+    bool secondaryRunning = !race->sourceFinished[1];
+    lock.unlock();
+
+    // A loser still running counts against the watchdog's stuck thread bound
+    if (primaryRunning) {
+        watchdog.Abandon(primaryTicket);
+    }
+    if (secondaryRunning) {
+        watchdog.Abandon(secondaryTicket);
+    }
+
+    double latencyMs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+
+    std::lock_guard<std::mutex> statsLock(m_mutex);
+    m_stats.requests++;
+    if (hedged) {
+        m_stats.hedged++;
+    }
+    if (winner == 0) {
+        m_stats.primaryWins++;
+        m_stats.lastWinner = "primary";
+    } else if (winner == 1) {
+        m_stats.secondaryWins++;
+        m_stats.lastWinner = "secondary";
+    } else {
+        m_stats.empty++;
+        m_stats.lastWinner = "none";
+    }
+    m_stats.lastLatencyMs = latencyMs;
+    return value;
+}
@@ -0,0 +1,102 @@
+#ifndef HEDGED_REQUEST_H
+#define HEDGED_REQUEST_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Counters for one hedged identifier
+ */
+struct HedgeStats {
+    std::string name;
+    uint64_t requests = 0;
+    uint64_t hedged = 0;           // Requests where the secondary source was started
+    uint64_t primaryWins = 0;
+    uint64_t secondaryWins = 0;
+    uint64_t empty = 0;            // Neither source produced a value
+    double hedgeDelayMs = 0;       // Current delay before the secondary is started
+    double lastLatencyMs = 0;      // Latency of the most recent request
+    std::string lastWinner;        // "primary", "secondary" or "none"
+};
+
+/**
+ * @brief Normalize an identifier value read from any source
+ *
+ * Strips the surrounding whitespace and NUL padding that WMI, sysfs and
+ * raw SMBIOS strings variously carry.
+ *
+ * @param value Raw value
+ * @return Normalized value, empty if only padding
+ */
+std::string NormalizeIdentifier(const std::string& value);
+
+/**
+ * @brief Hedged collection of one identifier from two redundant sources
+ *
+ * The primary source is started first. If it has not produced a value
+ * within the hedge delay - the 95th percentile of its recent latencies -
+ * the secondary source is started too, and whichever returns a non-empty
+ * value first wins. A primary that finishes early with an empty value
+ * starts the secondary immediately, so hedging also covers plain fallback.
+ *
+ * Both sources must return the same value for the same hardware; their
+ * values pass through NormalizeIdentifier() before the race is decided. The
+ * loser keeps running on its watchdog thread, counted against the
+ * watchdog's stuck thread bound, and its result is discarded. Once that
+ * bound is reached only the secondary source is used.
+ */
+class HedgedSource {
+public:
+    using Source = std::function<std::string()>;
+
+    /**
+     * @brief Get the hedged source registered under a name
+     *
+     * Instances are created on first use and never destroyed, because a
+     * losing source may still be running when the process exits.
+     *
+     * @param name Identifier name reported in stats (e.g. "wmi.biosSerial")
+     * @return Hedged source for that identifier
+     */
+    static HedgedSource& Get(const char* name);
+
+    /**
+     * @brief Get the counters of every hedged source
+     * @return One entry per registered source
+     */
+    static std::vector<HedgeStats> GetAllStats();
+
+    /**
+     * @brief Collect the identifier, hedging the primary with the secondary
+     * @param primary Preferred source; must only touch state it owns
+     * @param secondary Redundant source; must only touch state it owns
+     * @return Value from the winning source, empty if neither produced one
+     */
+    std::string Run(Source primary, Source secondary);
+
+private:
+    explicit HedgedSource(const char* name);
+
+    /**
+     * @brief Record a primary source latency sample
+     */
+    void RecordPrimaryLatency(uint64_t micros);
+
+    /**
+     * @brief Current hedge delay in microseconds (caller holds m_mutex)
+     */
+    uint64_t HedgeDelayMicros() const;
+
+    static constexpr size_t kLatencySamples = 64;
+
+    std::mutex m_mutex;
+    HedgeStats m_stats;
+    uint64_t m_latencies[kLatencySamples];
+    size_t m_latencyCount;
+    size_t m_latencyNext;
+};
+
+#endif // HEDGED_REQUEST_H
@@ -0,0 +1,274 @@
+#include "hwid.h"
+#include "hardware_identifier.h"
+#include "hardware_info.h"
+#include "digest_encoding.h"
+#include "json_writer.h"
+#include "snapshot_codec.h"
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Collector behind an opaque handle
+ */
+struct hwid_handle {
+    std::shared_ptr<HardwareIdentifier> identifier;  // Shared, watchdog tasks may outlive a call
+    HardwareInfo info;
+    bool collected = false;
+};
+
+/**
+ * @brief Copy output into a caller buffer, or report the size it needs
+ */
+static hwid_status CopyOut(const void* data, size_t length, bool terminate, void* buffer, size_t* size) {
+    size_t required = length + (terminate ? 1 : 0);
+    size_t capacity = *size;
+    *size = required;
+    if (capacity < required || (required > 0 && !buffer)) {
+        return HWID_ERROR_BUFFER_TOO_SMALL;
+    }
+    if (length > 0) {
+        memcpy(buffer, data, length);
+    }
+    if (terminate) {
+        static_cast<char*>(buffer)[length] = '\0';
+    }
+    return HWID_OK;
+}
+
+/**
+ * @brief Run a call body, mapping escaping exceptions to status codes
+ */
+template <typename Body>
+static hwid_status Guarded(Body&& body) {
+    try {
+        return body();
+    } catch (const std::exception&) {
+        return HWID_ERROR_INTERNAL;
+    } catch (...) {
+        return HWID_ERROR_INTERNAL;
+    }
+}
+
+/**
+ * @brief Get the version of the loaded library
+ */
+uint32_t hwid_version(void) {
+    return HWID_VERSION;
+}
+
+/**
+ * @brief Get a static description of a status code
+ */
+const char* hwid_status_string(hwid_status status) {
+    switch (status) {
+        case HWID_OK: return "ok";
+        case HWID_ERROR_INVALID_ARGUMENT: return "invalid argument";
+        case HWID_ERROR_BUFFER_TOO_SMALL: return "buffer too small";
+        case HWID_ERROR_UNAVAILABLE: return "hardware source unavailable";
+        case HWID_ERROR_NOT_FOUND: return "unknown component";
+        case HWID_ERROR_NOT_COLLECTED: return "no snapshot collected";
+        case HWID_ERROR_INTERNAL: return "internal error";
+    }
+    return "unknown status";
+}
+
+/**
+ * @brief Open a collector
+ */
+hwid_status hwid_open(const char* root, hwid_handle** handle) {
+    if (!handle) {
+        return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    *handle = nullptr;
+    return Guarded([&]() {
+        std::unique_ptr<hwid_handle> opened(new hwid_handle());
+        opened->identifier = std::make_shared<HardwareIdentifier>();
+        opened->identifier->SetRootPath(root ? root : "");
+        if (!opened->identifier->Initialize()) {
+            return HWID_ERROR_UNAVAILABLE;
+        }
+        *handle = opened.release();
+        return HWID_OK;
+    });
+}
+
+/**
+ * @brief Release a collector
+ */
+void hwid_close(hwid_handle* handle) {
+    delete handle;
+}
+
+/**
+ * @brief Collect every component and the fingerprint into the handle
+ */
+hwid_status hwid_collect(hwid_handle* handle, uint32_t timeout_ms) {
+    if (!handle) {
+        return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    return Guarded([&]() {
+        CollectionOptions options;
+        options.componentTimeoutMs = timeout_ms;
+        handle->collected = false;
+        handle->info = handle->identifier->GetAllHardwareInfo(options);
+        handle->collected = true;
+        return HWID_OK;
+    });
+}
+
+/**
+ * @brief Get the number of hardware components
+ */
+size_t hwid_component_count(void) {
+    return kHardwareComponentCount;
+}
+
+/**
+ * @brief Get the name of a hardware component
+ */
+const char* hwid_component_name(size_t index) {
+    if (index >= kHardwareComponentCount) {
+        return nullptr;
+    }
+    return ComponentName(static_cast<HardwareComponent>(index));
+}
+
+/**
+ * @brief Check the handle and look up a component for the getters
+ */
+static hwid_status FindCollectedComponent(const hwid_handle* handle, const char* name, HardwareComponent& component) {
+    if (!handle || !name) {
+        return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    if (!FindComponent(name, component)) {
+        return HWID_ERROR_NOT_FOUND;
+    }
+    return handle->collected ? HWID_OK : HWID_ERROR_NOT_COLLECTED;
+}
+
+/**
+ * @brief Check whether a component timed out in the last collection
+ */
+hwid_status hwid_component_timed_out(const hwid_handle* handle, const char* name, int* timed_out) {
+    if (!timed_out) {
+        return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    HardwareComponent component;
+    hwid_status status = FindCollectedComponent(handle, name, component);
+    if (status != HWID_OK) {
+        return status;
+    }
+    *timed_out = (handle->info.timedOutComponents & ComponentBit(component)) ? 1 : 0;
+    return HWID_OK;
+}
+
+/**
+ * @brief Copy one component value from the collected snapshot
+ */
+hwid_status hwid_get_component(const hwid_handle* handle, const char* name, char* buffer, size_t* size) {
+    if (!size) {
+        return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    HardwareComponent component;
+    hwid_status status = FindCollectedComponent(handle, name, component);
+    if (status != HWID_OK) {
+        return status;
+    }
+    return Guarded([&]() {
+        hwid_status result = HWID_OK;
+        VisitComponent(component, handle->info, [&](const auto& value) {
+            if constexpr (std::is_same<std::decay_t<decltype(value)>, ComponentList>::value) {
+                std::string joined;
+                for (const std::string& entry : value) {
+                    if (!joined.empty()) {
+                        joined += '\n';
+                    }
+                    joined += entry;
+                }
+                result = CopyOut(joined.data(), joined.size(), true, buffer, size);
+            } else {
+                result = CopyOut(value.data(), value.size(), true, buffer, size);
+            }
+        });
+        return result;
+    });
+}
+
+/**
+ * @brief Copy the fingerprint of the collected snapshot
+ */
+hwid_status hwid_get_fingerprint(const hwid_handle* handle, hwid_fingerprint_encoding encoding,
+                                 void* buffer, size_t* size) {
+    if (!handle || !size) {
+        return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    if (!handle->collected) {
+        return HWID_ERROR_NOT_COLLECTED;
+    }
+
+    const HardwareInfo& info = handle->info;
+    if (encoding == HWID_FINGERPRINT_LEGACY) {
+        return CopyOut(info.fingerprint.data(), info.fingerprint.size(), true, buffer, size);
+    }
+
+    DigestEncoding textEncoding = DigestEncoding::Hex;
+    switch (encoding) {
+        case HWID_FINGERPRINT_RAW: break;
+        case HWID_FINGERPRINT_HEX: break;
+        case HWID_FINGERPRINT_BASE32: textEncoding = DigestEncoding::Base32; break;
+        case HWID_FINGERPRINT_BASE64URL: textEncoding = DigestEncoding::Base64Url; break;
+        default: return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    bool raw = encoding == HWID_FINGERPRINT_RAW;
+
+    // No fingerprint means a required component timed out; there is no digest either
+    if (info.fingerprint.empty()) {
+        return CopyOut(nullptr, 0, !raw, buffer, size);
+    }
+
+    return Guarded([&]() {
+        uint8_t digest[kFingerprintDigestSize];
+        ComputeFingerprintDigest(info, digest);
+        if (raw) {
+            return CopyOut(digest, sizeof(digest), false, buffer, size);
+        }
+        // Hex is the longest of the text encodings
+        char text[2 * kFingerprintDigestSize];
+        EncodeDigest(textEncoding, digest, sizeof(digest), text);
+        return CopyOut(text, EncodedDigestLength(textEncoding, sizeof(digest)), true, buffer, size);
+    });
+}
+
+/**
+ * @brief Serialize the collected snapshot
+ */
+hwid_status hwid_get_snapshot(const hwid_handle* handle, hwid_snapshot_format format, void* buffer, size_t* size) {
+    if (!handle || !size) {
+        return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    if (format < HWID_SNAPSHOT_JSON || format > HWID_SNAPSHOT_CBOR) {
+        return HWID_ERROR_INVALID_ARGUMENT;
+    }
+    if (!handle->collected) {
+        return HWID_ERROR_NOT_COLLECTED;
+    }
+    return Guarded([&]() {
+        std::string out;
+        switch (format) {
+            case HWID_SNAPSHOT_JSON: {
+                JsonWriter writer(out);
+                writer.BeginObject();
+                WriteHardwareInfoFields(writer, handle->info);
+                writer.EndObject();
+                return CopyOut(out.data(), out.size(), true, buffer, size);
+            }
+            case HWID_SNAPSHOT_BINARY: EncodeSnapshot(handle->info, out); break;
+            case HWID_SNAPSHOT_MSGPACK: EncodeSnapshotAs(handle->info, SnapshotFormat::MessagePack, out); break;
+            case HWID_SNAPSHOT_CBOR: EncodeSnapshotAs(handle->info, SnapshotFormat::Cbor, out); break;
+        }
+        return CopyOut(out.data(), out.size(), false, buffer, size);
+    });
+}
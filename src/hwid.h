@@ -0,0 +1,202 @@
+#ifndef HWID_H
+#define HWID_H
+
+/**
+ * @file hwid.h
+ * @brief C interface of the hardware identification library (libhwid)
+ *
+ * The interface is plain C so it can be called from any language with a C
+ * FFI. Its rules do not change within a major version:
+ * - Objects are opaque handles created and destroyed by the library.
+ * - Output goes to caller-provided buffers; nothing the library allocates
+ *   is handed to the caller.
+ * - Every fallible call returns an hwid_status; no C++ exception crosses
+ *   the interface.
+ *
+ * Buffers are passed as a pointer and a size_t in/out parameter. On input
+ * the size is the buffer capacity; on return it is the number of bytes the
+ * output needs. When the buffer is too small nothing is written and
+ * HWID_ERROR_BUFFER_TOO_SMALL is returned, so a caller may pass a null
+ * buffer with capacity 0 to ask for the size. Text output is UTF-8 and
+ * NUL-terminated, and the size counts the terminator.
+ *
+ * A handle is not thread-safe, but separate handles may be used from
+ * separate threads at the same time.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#  if defined(HWID_BUILDING_LIBRARY)
+#    define HWID_API __declspec(dllexport)
+#  elif defined(HWID_SHARED)
+#    define HWID_API __declspec(dllimport)
+#  else
+#    define HWID_API
+#  endif
+#elif defined(__GNUC__)
+#  define HWID_API __attribute__((visibility("default")))
+#else
+#  define HWID_API
+#endif
+
+/**
+ * @brief Version of this header; hwid_version() reports the library's
+ */
+#define HWID_VERSION_MAJOR 1
+#define HWID_VERSION_MINOR 0
+#define HWID_VERSION_PATCH 0
+#define HWID_VERSION ((HWID_VERSION_MAJOR << 16) | (HWID_VERSION_MINOR << 8) | HWID_VERSION_PATCH)
+
+/**
+ * @brief Result of a library call
+ */
+typedef enum hwid_status {
+    HWID_OK = 0,
+    HWID_ERROR_INVALID_ARGUMENT = 1,    /* Null handle or pointer, or unknown enum value */
+    HWID_ERROR_BUFFER_TOO_SMALL = 2,    /* The size parameter holds the required size */
+    HWID_ERROR_UNAVAILABLE = 3,         /* Root missing or system services not reachable */
+    HWID_ERROR_NOT_FOUND = 4,           /* No component has that name */
+    HWID_ERROR_NOT_COLLECTED = 5,       /* hwid_collect() has not succeeded on the handle */
+    HWID_ERROR_INTERNAL = 6             /* Unexpected failure, including out of memory */
+} hwid_status;
+
+/**
+ * @brief Text encodings of the fingerprint
+ */
+typedef enum hwid_fingerprint_encoding {
+    HWID_FINGERPRINT_LEGACY = 0,        /* Lowercase hex of a size_t hash without leading zeros, as
+                                           getHardwareFingerprint(); 1 to 2 * sizeof(size_t) digits */
+    HWID_FINGERPRINT_RAW = 1,           /* 32-byte SHA-256 digest, not terminated */
+    HWID_FINGERPRINT_HEX = 2,
+    HWID_FINGERPRINT_BASE32 = 3,        /* Crockford base32 */
+    HWID_FINGERPRINT_BASE64URL = 4      /* Unpadded base64url */
+} hwid_fingerprint_encoding;
+
+/**
+ * @brief Serialization formats of a whole snapshot
+ */
+typedef enum hwid_snapshot_format {
+    HWID_SNAPSHOT_JSON = 0,             /* Object in the getAllHardwareInfo() shape, terminated */
+    HWID_SNAPSHOT_BINARY = 1,           /* Compact wire format of encodeSnapshot(), not terminated */
+    HWID_SNAPSHOT_MSGPACK = 2,          /* Not terminated */
+    HWID_SNAPSHOT_CBOR = 3              /* Not terminated */
+} hwid_snapshot_format;
+
+/**
+ * @brief Collector for one system or root directory
+ */
+typedef struct hwid_handle hwid_handle;
+
+/**
+ * @brief Get the version of the loaded library
+ * @return Version encoded like HWID_VERSION
+ */
+HWID_API uint32_t hwid_version(void);
+
+/**
+ * @brief Get a static description of a status code
+ * @param status Status code
+ * @return Description, never null
+ */
+HWID_API const char* hwid_status_string(hwid_status status);
+
+/**
+ * @brief Open a collector
+ * @param root Root of a captured sysfs tree or mounted image, null or "" for the live system
+ * @param handle Receives the handle, to be released with hwid_close()
+ * @return HWID_OK, or HWID_ERROR_UNAVAILABLE if the root or the system
+ *         services cannot be used
+ */
+HWID_API hwid_status hwid_open(const char* root, hwid_handle** handle);
+
+/**
+ * @brief Release a collector
+ * @param handle Handle from hwid_open(), may be null
+ */
+HWID_API void hwid_close(hwid_handle* handle);
+
+/**
+ * @brief Collect every component and the fingerprint into the handle
+ *
+ * The getters below read this snapshot, so one collection serves any
+ * number of them. Calling it again replaces the snapshot.
+ *
+ * @param handle Collector
+ * @param timeout_ms Deadline for each component, 0 waits without a watchdog
+ * @return HWID_OK, also when some components timed out
+ */
+HWID_API hwid_status hwid_collect(hwid_handle* handle, uint32_t timeout_ms);
+
+/**
+ * @brief Get the number of hardware components
+ * @return Number of components, fixed for the library version
+ */
+HWID_API size_t hwid_component_count(void);
+
+/**
+ * @brief Get the name of a hardware component
+ * @param index Component index, below hwid_component_count()
+ * @return Name as used by getAllHardwareInfo(), such as "cpuId"; null if out of range
+ */
+HWID_API const char* hwid_component_name(size_t index);
+
+/**
+ * @brief Check whether a component timed out in the last collection
+ * @param handle Collector
+ * @param name Component name
+ * @param timed_out Receives 1 if the component timed out, else 0
+ * @return HWID_OK, HWID_ERROR_NOT_FOUND or HWID_ERROR_NOT_COLLECTED
+ */
+HWID_API hwid_status hwid_component_timed_out(const hwid_handle* handle, const char* name, int* timed_out);
+
+/**
+ * @brief Copy one component value from the collected snapshot
+ *
+ * List components (disk serials, MAC addresses) are written one entry per
+ * line, separated by '\n' without a trailing newline.
+ *
+ * @param handle Collector
+ * @param name Component name, such as "cpuId" or "macAddresses"
+ * @param buffer Receives the value as terminated text
+ * @param size Buffer capacity in, required size out
+ * @return HWID_OK, HWID_ERROR_NOT_FOUND, HWID_ERROR_NOT_COLLECTED or HWID_ERROR_BUFFER_TOO_SMALL
+ */
+HWID_API hwid_status hwid_get_component(const hwid_handle* handle, const char* name, char* buffer, size_t* size);
+
+/**
+ * @brief Copy the fingerprint of the collected snapshot
+ *
+ * An empty fingerprint is returned as empty text (or zero bytes for
+ * HWID_FINGERPRINT_RAW) when a component timed out.
+ *
+ * @param handle Collector
+ * @param encoding Fingerprint encoding
+ * @param buffer Receives the fingerprint
+ * @param size Buffer capacity in, required size out
+ * @return HWID_OK, HWID_ERROR_NOT_COLLECTED or HWID_ERROR_BUFFER_TOO_SMALL
+ */
+HWID_API hwid_status hwid_get_fingerprint(const hwid_handle* handle, hwid_fingerprint_encoding encoding,
+                                          void* buffer, size_t* size);
+
+/**
+ * @brief Serialize the collected snapshot
+ * @param handle Collector
+ * @param format Output format
+ * @param buffer Receives the encoding
+ * @param size Buffer capacity in, required size out
+ * @return HWID_OK, HWID_ERROR_NOT_COLLECTED or HWID_ERROR_BUFFER_TOO_SMALL
+ */
+HWID_API hwid_status hwid_get_snapshot(const hwid_handle* handle, hwid_snapshot_format format,
+                                       void* buffer, size_t* size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HWID_H */
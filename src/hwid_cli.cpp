@@ -0,0 +1,597 @@
+/**
+ * @file hwid_cli.cpp
+ * @brief hwid command-line tool
+ *
+ * Prints hardware snapshots and fingerprints without starting Node, for
+ * config-management runs and fleet collection agents:
+ *
+ *   hwid                                  # JSON snapshot of the live system
+ *   hwid --fields fingerprint --format value
+ *   hwid --root /mnt/image --format shell
+ *   hwid --batch /srv/captures/host1 /srv/captures/host2 > fleet.ndjson
+ *   find /srv/captures -mindepth 1 -maxdepth 1 | hwid --batch --format binary
+ *
+ * Exit status: 0 on success, 1 if a root could not be read, 2 on a usage error.
+ */
+
+#include "hwid.h"
+#include "hardware_identifier.h"
+#include "hardware_info.h"
+#include "digest_encoding.h"
+#include "json_writer.h"
+#include "snapshot_codec.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+/**
+ * @brief Output formats
+ */
+enum class OutputFormat {
+    Json,           // One object per record, one record per line
+    Shell,          // HWID_NAME='value' assignments for eval
+    Value,          // Bare values, one per line
+    Binary,         // Snapshot wire frames, as encodeSnapshot()
+    MessagePack,
+    Cbor
+};
+
+/**
+ * @brief Selectable fields: the components, then the fingerprint and timeout list
+ */
+static constexpr uint32_t kFieldFingerprint = 1u << kHardwareComponentCount;
+static constexpr uint32_t kFieldTimedOut = kFieldFingerprint << 1;
+static constexpr uint32_t kAllFields = kAllHardwareComponents | kFieldFingerprint | kFieldTimedOut;
+
+/**
+ * @brief Parsed command line
+ */
+struct CliOptions {
+    OutputFormat format = OutputFormat::Json;
+    bool legacyFingerprint = true;              // false: SHA-256 digest in encoding
+    DigestEncoding encoding = DigestEncoding::Hex;
+    uint32_t fields = kAllFields;
+    std::string root;                           // Empty for the live system
+    bool batch = false;
+    std::vector<std::string> roots;             // Batch roots, in output order
+    unsigned jobs = 0;                          // Batch threads, 0 for hardware concurrency
+    CollectionOptions collection;
+};
+
+static const char kUsage[] =
+    "Usage: hwid [options]\n"
+    "       hwid --batch [options] [root...]\n"
+    "\n"
+    "Print the hardware identifiers and fingerprint of this system, of a\n"
+    "captured sysfs tree or mounted image, or of many such roots.\n"
+    "\n"
+    "Options:\n"
+    "  -f, --format FORMAT   json (default), shell, value, binary, msgpack or cbor\n"
+    "  -F, --fields LIST     comma-separated fields to print (default: all; see --list-fields)\n"
+    "  -e, --encoding ENC    fingerprint as legacy (default), hex, base32 or base64url\n"
+    "  -r, --root DIR        read DIR instead of the live system\n"
+    "  -b, --batch           read every root given as an argument, or listed one per line\n"
+    "                        on stdin when none (or '-') is given; one record per root\n"
+    "  -j, --jobs N          batch worker threads (default: one per CPU)\n"
+    "  -t, --timeout MS      deadline for each component (default: none)\n"
+    "      --list-fields     print the field names and exit\n"
+    "  -h, --help            print this help and exit\n"
+    "  -V, --version         print the version and exit\n";
+
+/**
+ * @brief Report a usage error
+ * @return Exit status for usage errors
+ */
+static int UsageError(const std::string& message) {
+    fprintf(stderr, "hwid: %s\nTry 'hwid --help'.\n", message.c_str());
+    return 2;
+}
+
+/**
+ * @brief Parse a non-negative decimal number
+ */
+static bool ParseNumber(const std::string& text, uint32_t& value) {
+    if (text.empty() || text.size() > 9 ||
+        !std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return false;
+    }
+    value = static_cast<uint32_t>(std::strtoul(text.c_str(), nullptr, 10));
+    return true;
+}
+
+/**
+ * @brief Parse a comma-separated field list into a field mask
+ */
+static bool ParseFields(const std::string& list, uint32_t& fields, std::string& unknown) {
+    fields = 0;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string name = list.substr(start, end - start);
+        HardwareComponent component;
+        if (name == "fingerprint") {
+            fields |= kFieldFingerprint;
+        } else if (name == "timedOut") {
+            fields |= kFieldTimedOut;
+        } else if (FindComponent(name, component)) {
+            fields |= ComponentBit(component);
+        } else {
+            unknown = name;
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Read batch roots from stdin, one per line, skipping blank lines
+ */
+static void ReadRoots(std::vector<std::string>& roots) {
+    std::string line;
+    char chunk[4096];
+    while (fgets(chunk, sizeof(chunk), stdin)) {
+        line += chunk;
+        if (line.back() != '\n' && !feof(stdin)) {
+            continue;
+        }
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            roots.push_back(line);
+        }
+        line.clear();
+    }
+}
+
+/**
+ * @brief Parse the command line
+ * @return -1 to continue, otherwise the exit status
+ */
+static int ParseArguments(int argc, char** argv, CliOptions& options) {
+    bool readStdin = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value;
+        bool hasValue = false;
+
+        // --name=value
+        size_t equals = arg.find('=');
+        if (arg.compare(0, 2, "--") == 0 && equals != std::string::npos) {
+            value = arg.substr(equals + 1);
+            arg.resize(equals);
+            hasValue = true;
+        }
+        auto takeValue = [&]() {
+            if (hasValue) {
+                return true;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            value = argv[++i];
+            return true;
+        };
+        auto needsValue = [&]() {
+            return arg == "-f" || arg == "--format" || arg == "-F" || arg == "--fields" ||
+                   arg == "-e" || arg == "--encoding" || arg == "-r" || arg == "--root" ||
+                   arg == "-j" || arg == "--jobs" || arg == "-t" || arg == "--timeout";
+        };
+
+        if (needsValue() && !takeValue()) {
+            return UsageError("option '" + arg + "' requires a value");
+        }
+        if (hasValue && !needsValue()) {
+            return UsageError("option '" + arg + "' does not take a value");
+        }
+
+        if (arg == "-h" || arg == "--help") {
+            fputs(kUsage, stdout);
+            return 0;
+        } else if (arg == "-V" || arg == "--version") {
+            printf("hwid %d.%d.%d\n", HWID_VERSION_MAJOR, HWID_VERSION_MINOR, HWID_VERSION_PATCH);
+            return 0;
+        } else if (arg == "--list-fields") {
+            for (uint32_t c = 0; c < kHardwareComponentCount; c++) {
+                printf("%s\n", ComponentName(static_cast<HardwareComponent>(c)));
+            }
+            printf("fingerprint\ntimedOut\n");
+            return 0;
+        } else if (arg == "-f" || arg == "--format") {
+            if (value == "json") {
+                options.format = OutputFormat::Json;
+            } else if (value == "shell") {
+                options.format = OutputFormat::Shell;
+            } else if (value == "value") {
+                options.format = OutputFormat::Value;
+            } else if (value == "binary") {
+                options.format = OutputFormat::Binary;
+            } else if (value == "msgpack") {
+                options.format = OutputFormat::MessagePack;
+            } else if (value == "cbor") {
+                options.format = OutputFormat::Cbor;
+            } else {
+                return UsageError("unknown format '" + value + "'");
+            }
+        } else if (arg == "-F" || arg == "--fields") {
+            std::string unknown;
+            if (!ParseFields(value, options.fields, unknown)) {
+                return UsageError("unknown field '" + unknown + "'");
+            }
+        } else if (arg == "-e" || arg == "--encoding") {
+            options.legacyFingerprint = value == "legacy";
+            if (value == "hex") {
+                options.encoding = DigestEncoding::Hex;
+            } else if (value == "base32") {
+                options.encoding = DigestEncoding::Base32;
+            } else if (value == "base64url") {
+                options.encoding = DigestEncoding::Base64Url;
+            } else if (!options.legacyFingerprint) {
+                return UsageError("unknown encoding '" + value + "'");
+            }
+        } else if (arg == "-r" || arg == "--root") {
+            if (value.empty()) {
+                return UsageError("root must not be empty");
+            }
+            options.root = value;
+        } else if (arg == "-j" || arg == "--jobs") {
+            uint32_t jobs;
+            if (!ParseNumber(value, jobs) || jobs == 0) {
+                return UsageError("jobs must be a positive number");
+            }
+            options.jobs = jobs;
+        } else if (arg == "-t" || arg == "--timeout") {
+            if (!ParseNumber(value, options.collection.componentTimeoutMs)) {
+                return UsageError("timeout must be a number of milliseconds");
+            }
+        } else if (arg == "-b" || arg == "--batch") {
+            options.batch = true;
+        } else if (arg == "-") {
+            readStdin = true;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            return UsageError("unknown option '" + arg + "'");
+        } else {
+            options.roots.push_back(arg);
+        }
+    }
+
+    if (!options.batch) {
+        if (readStdin || !options.roots.empty()) {
+            return UsageError("roots as arguments need --batch; use --root for one root");
+        }
+        return -1;
+    }
+    if (!options.root.empty()) {
+        return UsageError("--root cannot be combined with --batch");
+    }
+    if (readStdin || options.roots.empty()) {
+        ReadRoots(options.roots);
+    }
+    return -1;
+}
+
+/**
+ * @brief Collect the selected fields of one root
+ *
+ * Only the selected components are queried, unless the fingerprint is
+ * selected, which needs every component.
+ *
+ * @param root Root directory, empty for the live system
+ * @param options Command line
+ * @param info Receives the selected fields; others are left empty
+ * @return false if the root or the system services cannot be used
+ */
+static bool CollectRoot(const std::string& root, const CliOptions& options, HardwareInfo& info) {
+    // Shared ownership lets the watchdog abandon a hung query
+    std::shared_ptr<HardwareIdentifier> identifier = std::make_shared<HardwareIdentifier>();
+    identifier->SetRootPath(root);
+    if (!identifier->Initialize()) {
+        return false;
+    }
+
+    if (options.fields & kFieldFingerprint) {
+        info = identifier->GetAllHardwareInfo(options.collection);
+        if (!options.legacyFingerprint && !info.fingerprint.empty()) {
+            uint8_t digest[kFingerprintDigestSize];
+            ComputeFingerprintDigest(info, digest);
+            info.fingerprint.resize(EncodedDigestLength(options.encoding, sizeof(digest)));
+            EncodeDigest(options.encoding, digest, sizeof(digest), &info.fingerprint[0]);
+        }
+    } else {
+        for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+            HardwareComponent component = static_cast<HardwareComponent>(i);
+            if (options.fields & ComponentBit(component)) {
+                identifier->CollectComponent(component, info, options.collection.componentTimeoutMs);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        if (!(options.fields & ComponentBit(component))) {
+            VisitComponent(component, info, [](auto& value) { value.clear(); });
+        }
+    }
+    if (!(options.fields & kFieldTimedOut)) {
+        info.timedOutComponents = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Append a string quoted for POSIX sh
+ */
+static void AppendShellQuoted(std::string& out, const std::string& value) {
+    out += '\'';
+    for (char c : value) {
+        if (c == '\'') {
+            out += "'\\''";
+        } else {
+            out += c;
+        }
+    }
+    out += '\'';
+}
+
+/**
+ * @brief Append a shell variable name: HWID_ and the field name in upper snake case
+ */
+static void AppendShellName(std::string& out, const char* name) {
+    out += "HWID_";
+    for (const char* p = name; *p; p++) {
+        if (std::isupper(static_cast<unsigned char>(*p))) {
+            out += '_';
+        }
+        out += static_cast<char>(std::toupper(static_cast<unsigned char>(*p)));
+    }
+}
+
+/**
+ * @brief Get the names of the components in a ComponentBit mask
+ */
+static std::vector<std::string> ComponentNames(uint32_t components) {
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        if (components & ComponentBit(component)) {
+            names.push_back(ComponentName(component));
+        }
+    }
+    return names;
+}
+
+/**
+ * @brief Call a function with the name and value of every selected field
+ *
+ * Values are passed as a std::string or a std::vector<std::string>.
+ */
+template <typename Visit>
+static void VisitFields(const HardwareInfo& info, uint32_t fields, Visit&& visit) {
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        if (fields & ComponentBit(component)) {
+            VisitComponent(component, info, [&](const auto& value) { visit(ComponentName(component), value); });
+        }
+    }
+    if (fields & kFieldFingerprint) {
+        visit("fingerprint", info.fingerprint);
+    }
+    if (fields & kFieldTimedOut) {
+        visit("timedOut", ComponentNames(info.timedOutComponents));
+    }
+}
+
+/**
+ * @brief Format the record of one root
+ * @param root Root directory, or nullptr outside batch mode
+ * @param collected false if the root could not be read
+ * @param info Collected fields
+ * @param options Command line
+ * @param out Receives the record
+ */
+static void FormatRecord(const std::string* root, bool collected, const HardwareInfo& info,
+                         const CliOptions& options, std::string& out) {
+    switch (options.format) {
+        case OutputFormat::Json: {
+            JsonWriter writer(out);
+            writer.BeginObject();
+            if (root) {
+                writer.Key("root");
+                writer.String(*root);
+            }
+            if (!collected) {
+                writer.Key("error");
+                writer.String("root not readable");
+            } else {
+                VisitFields(info, options.fields, [&writer](const char* name, const auto& value) {
+                    writer.Key(name);
+                    if constexpr (std::is_same<std::decay_t<decltype(value)>, std::string>::value) {
+                        writer.String(value);
+                    } else {
+                        writer.StringArray(value);
+                    }
+                });
+            }
+            writer.EndObject();
+            out += '\n';
+            break;
+        }
+        case OutputFormat::Shell: {
+            if (root) {
+                out += "HWID_ROOT=";
+                AppendShellQuoted(out, *root);
+                out += '\n';
+            }
+            if (!collected) {
+                out += "HWID_ERROR='root not readable'\n";
+            } else {
+                // List entries are one per line inside the quotes
+                VisitFields(info, options.fields, [&out](const char* name, const auto& value) {
+                    AppendShellName(out, name);
+                    out += '=';
+                    if constexpr (std::is_same<std::decay_t<decltype(value)>, std::string>::value) {
+                        AppendShellQuoted(out, value);
+                    } else {
+                        std::string joined;
+                        for (const std::string& entry : value) {
+                            joined += joined.empty() ? "" : "\n";
+                            joined += entry;
+                        }
+                        AppendShellQuoted(out, joined);
+                    }
+                    out += '\n';
+                });
+            }
+            if (root) {
+                out += '\n';
+            }
+            break;
+        }
+        case OutputFormat::Value: {
+            // One line per scalar or list entry; in batch mode prefixed with the root and a tab
+            if (!collected) {
+                break;
+            }
+            auto line = [&](const std::string& value) {
+                if (root) {
+                    out += *root;
+                    out += '\t';
+                }
+                out += value;
+                out += '\n';
+            };
+            VisitFields(info, options.fields, [&line](const char*, const auto& value) {
+                if constexpr (std::is_same<std::decay_t<decltype(value)>, std::string>::value) {
+                    line(value);
+                } else {
+                    for (const std::string& entry : value) {
+                        line(entry);
+                    }
+                }
+            });
+            break;
+        }
+        case OutputFormat::Binary:
+            // An unreadable root yields an empty frame, keeping frames in input order
+            EncodeSnapshot(info, out);
+            break;
+        case OutputFormat::MessagePack:
+            EncodeSnapshotAs(info, SnapshotFormat::MessagePack, out);
+            break;
+        case OutputFormat::Cbor:
+            EncodeSnapshotAs(info, SnapshotFormat::Cbor, out);
+            break;
+    }
+}
+
+/**
+ * @brief Collect and print many roots, in input order
+ *
+ * Workers pull the next root from a shared counter, as in
+ * SysfsCollector::CollectBatch; the main thread writes each record as soon
+ * as it and every record before it are ready.
+ *
+ * @return Exit status
+ */
+static int RunBatch(const CliOptions& options) {
+    const std::vector<std::string>& roots = options.roots;
+    unsigned jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = static_cast<unsigned>(std::min<size_t>(jobs, roots.size()));
+
+    std::vector<std::string> records(roots.size());
+    std::vector<char> ready(roots.size(), 0);
+    std::mutex mutex;
+    std::condition_variable readyChanged;
+    std::atomic<size_t> nextIndex(0);
+    std::atomic<bool> failed(false);
+
+    auto worker = [&]() {
+        size_t index;
+        while ((index = nextIndex.fetch_add(1)) < roots.size()) {
+            HardwareInfo info;
+            bool collected = CollectRoot(roots[index], options, info);
+            if (!collected) {
+                fprintf(stderr, "hwid: %s: root not readable\n", roots[index].c_str());
+                failed = true;
+            }
+            std::string record;
+            FormatRecord(&roots[index], collected, info, options, record);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            records[index] = std::move(record);
+            ready[index] = 1;
+            readyChanged.notify_one();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < jobs; i++) {
+        threads.emplace_back(worker);
+    }
+    for (size_t i = 0; i < roots.size(); i++) {
+        std::string record;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            readyChanged.wait(lock, [&]() { return ready[i] != 0; });
+            record.swap(records[i]);
+        }
+        fwrite(record.data(), 1, record.size(), stdout);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    CliOptions options;
+    int status = ParseArguments(argc, argv, options);
+    if (status >= 0) {
+        return status;
+    }
+
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    if (options.batch) {
+        status = RunBatch(options);
+    } else {
+        HardwareInfo info;
+        bool collected = CollectRoot(options.root, options, info);
+        if (!collected) {
+            fprintf(stderr, "hwid: %s: %s\n", options.root.empty() ? "live system" : options.root.c_str(),
+                    options.root.empty() ? "hardware sources unavailable" : "root not readable");
+            return 1;
+        }
+        std::string record;
+        FormatRecord(nullptr, true, info, options, record);
+        fwrite(record.data(), 1, record.size(), stdout);
+        status = 0;
+    }
+
+    if (fflush(stdout) != 0 || ferror(stdout)) {
+        fprintf(stderr, "hwid: write error\n");
+        return 1;
+    }
+    return status;
+}
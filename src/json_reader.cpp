@@ -0,0 +1,690 @@
+#include "json_reader.h"
+#include "json_writer.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Smallest input split off to its own parse thread
+ */
+constexpr size_t kMinBytesPerThread = 4u << 20;
+
+/**
+ * @brief Deepest nesting skipped inside a record
+ */
+constexpr int kMaxDepth = 64;
+
+/**
+ * @brief Check whether a byte is JSON whitespace
+ */
+inline bool IsJsonWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+/**
+ * @brief Get the value of a hexadecimal digit, -1 for other bytes
+ */
+inline int HexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Append a code point as UTF-8
+ */
+void AppendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+/**
+ * @brief Get the number of days from 1970-01-01 to a civil date
+ */
+int64_t DaysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+/**
+ * @brief Values a record gives only as the first disk and network adapter
+ */
+struct FirstIdentifiers {
+    std::string diskSerial;
+    std::string macAddress;
+};
+
+/**
+ * @brief Single-pass parser from JSON text to registration records
+ *
+ * Property names are decoded into one reused buffer and compared against
+ * the known field names; values of other properties are validated and
+ * skipped without being decoded.
+ */
+class RegistrationParser {
+public:
+    RegistrationParser(const char* data, size_t size)
+        : m_begin(data), m_cur(data), m_end(data + size) {
+    }
+
+    /**
+     * @brief Parse every top-level value
+     * @param out Receives the records
+     * @return false on malformed input; Offset() is then the error position
+     */
+    bool ParseAll(std::vector<JsonRegistration>& out) {
+        if (m_end - m_cur >= 3 && std::memcmp(m_cur, "\xEF\xBB\xBF", 3) == 0) {
+            m_cur += 3;
+        }
+        for (;;) {
+            SkipWhitespace();
+            if (m_cur == m_end) {
+                return true;
+            }
+            if (*m_cur == '{') {
+                if (!ParseRecord(out)) {
+                    return false;
+                }
+            } else if (*m_cur == '[') {
+                if (!ParseRecordArray(out)) {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the current offset from the start of the input
+     */
+    size_t Offset() const {
+        return static_cast<size_t>(m_cur - m_begin);
+    }
+
+private:
+    void SkipWhitespace() {
+        while (m_cur < m_end && IsJsonWhitespace(*m_cur)) {
+            m_cur++;
+        }
+    }
+
+    /**
+     * @brief Skip whitespace and consume an expected byte
+     */
+    bool Consume(char c) {
+        SkipWhitespace();
+        if (m_cur == m_end || *m_cur != c) {
+            return false;
+        }
+        m_cur++;
+        return true;
+    }
+
+    /**
+     * @brief Skip whitespace and check the first byte of the next value
+     */
+    bool PeekValue(char c) {
+        SkipWhitespace();
+        return m_cur < m_end && *m_cur == c;
+    }
+
+    /**
+     * @brief Consume a literal such as true, false or null
+     */
+    bool ConsumeLiteral(const char* literal) {
+        size_t length = std::strlen(literal);
+        if (static_cast<size_t>(m_end - m_cur) < length || std::memcmp(m_cur, literal, length) != 0) {
+            return false;
+        }
+        m_cur += length;
+        return true;
+    }
+
+    /**
+     * @brief Read the four hex digits of a \\u escape
+     */
+    bool ReadHex4(uint32_t& value) {
+        if (m_end - m_cur < 4) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < 4; i++) {
+            int digit = HexValue(m_cur[i]);
+            if (digit < 0) {
+                return false;
+            }
+            value = (value << 4) | static_cast<uint32_t>(digit);
+        }
+        m_cur += 4;
+        return true;
+    }
+
+    /**
+     * @brief Parse a string; the cursor is on the opening quote
+     * @param out Receives the decoded value, or nullptr to only validate
+     */
+    bool ParseString(std::string* out) {
+        m_cur++;
+        if (out) {
+            out->clear();
+        }
+        for (;;) {
+            // Copy the run up to the next quote, backslash or control byte
+            size_t run = FindJsonEscape(m_cur, static_cast<size_t>(m_end - m_cur));
+            if (out) {
+                out->append(m_cur, run);
+            }
+            m_cur += run;
+            if (m_cur == m_end) {
+                return false;
+            }
+            char c = *m_cur;
+            if (c == '"') {
+                m_cur++;
+                return true;
+            }
+            if (c != '\\' || ++m_cur == m_end) {
+                return false;
+            }
+            char decoded;
+            switch (*m_cur++) {
+                case '"':  decoded = '"'; break;
+                case '\\': decoded = '\\'; break;
+                case '/':  decoded = '/'; break;
+                case 'b':  decoded = '\b'; break;
+                case 'f':  decoded = '\f'; break;
+                case 'n':  decoded = '\n'; break;
+                case 'r':  decoded = '\r'; break;
+                case 't':  decoded = '\t'; break;
+                case 'u': {
+                    uint32_t codePoint;
+                    if (!ReadHex4(codePoint)) {
+                        return false;
+                    }
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && m_end - m_cur >= 6 &&
+                        m_cur[0] == '\\' && m_cur[1] == 'u') {
+                        const char* mark = m_cur;
+                        uint32_t low;
+                        m_cur += 2;
+                        if (ReadHex4(low) && low >= 0xDC00 && low < 0xE000) {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        } else {
+                            m_cur = mark;
+                        }
+                    }
+                    if (codePoint >= 0xD800 && codePoint < 0xE000) {
+                        codePoint = 0xFFFD;  // Unpaired surrogate
+                    }
+                    if (out) {
+                        AppendUtf8(*out, codePoint);
+                    }
+                    continue;
+                }
+                default:
+                    return false;
+            }
+            if (out) {
+                out->push_back(decoded);
+            }
+        }
+    }
+
+    /**
+     * @brief Parse a number; the cursor is on its first byte
+     */
+    bool ParseNumber(double& value) {
+        bool negative = m_cur < m_end && *m_cur == '-';
+        if (negative) {
+            m_cur++;
+        }
+        if (m_cur == m_end || *m_cur < '0' || *m_cur > '9') {
+            return false;
+        }
+        double mantissa = 0;
+        int exponent = 0;
+        if (*m_cur == '0') {
+            m_cur++;
+        } else {
+            while (m_cur < m_end && *m_cur >= '0' && *m_cur <= '9') {
+                mantissa = mantissa * 10 + (*m_cur++ - '0');
+            }
+        }
+        if (m_cur < m_end && *m_cur == '.') {
+            m_cur++;
+            if (m_cur == m_end || *m_cur < '0' || *m_cur > '9') {
+                return false;
+            }
+            while (m_cur < m_end && *m_cur >= '0' && *m_cur <= '9') {
+                mantissa = mantissa * 10 + (*m_cur++ - '0');
+                exponent--;
+            }
+        }
+        if (m_cur < m_end && (*m_cur == 'e' || *m_cur == 'E')) {
+            m_cur++;
+            bool negativeExponent = m_cur < m_end && *m_cur == '-';
+            if (m_cur < m_end && (*m_cur == '+' || *m_cur == '-')) {
+                m_cur++;
+            }
+            if (m_cur == m_end || *m_cur < '0' || *m_cur > '9') {
+                return false;
+            }
+            int written = 0;
+            while (m_cur < m_end && *m_cur >= '0' && *m_cur <= '9') {
+                written = std::min(written * 10 + (*m_cur++ - '0'), 1000);
+            }
+            exponent += negativeExponent ? -written : written;
+        }
+        for (; exponent > 0; exponent--) {
+            mantissa *= 10;
+        }
+        for (; exponent < 0; exponent++) {
+            mantissa /= 10;
+        }
+        value = negative ? -mantissa : mantissa;
+        return true;
+    }
+
+    /**
+     * @brief Validate and skip any value
+     */
+    bool SkipValue(int depth) {
+        SkipWhitespace();
+        if (m_cur == m_end) {
+            return false;
+        }
+        switch (*m_cur) {
+            case '"':
+                return ParseString(nullptr);
+            case 't':
+                return ConsumeLiteral("true");
+            case 'f':
+                return ConsumeLiteral("false");
+            case 'n':
+                return ConsumeLiteral("null");
+            case '{':
+            case '[': {
+                bool object = *m_cur++ == '{';
+                if (depth >= kMaxDepth) {
+                    return false;
+                }
+                if (Consume(object ? '}' : ']')) {
+                    return true;
+                }
+                do {
+                    if (object) {
+                        SkipWhitespace();
+                        if (m_cur == m_end || *m_cur != '"' || !ParseString(nullptr) || !Consume(':')) {
+                            return false;
+                        }
+                    }
+                    if (!SkipValue(depth + 1)) {
+                        return false;
+                    }
+                } while (Consume(','));
+                return Consume(object ? '}' : ']');
+            }
+            default: {
+                double ignored;
+                return ParseNumber(ignored);
+            }
+        }
+    }
+
+    /**
+     * @brief Parse a string value; values of other types are skipped
+     */
+    bool ParseStringValue(std::string& out, int depth) {
+        if (PeekValue('"')) {
+            return ParseString(&out);
+        }
+        return SkipValue(depth);
+    }
+
+    /**
+     * @brief Parse an array of strings; other elements and values are skipped
+     */
+    bool ParseStringArray(std::vector<std::string>& out, int depth) {
+        SkipWhitespace();
+        if (m_cur == m_end || *m_cur != '[') {
+            return SkipValue(depth);
+        }
+        m_cur++;
+        out.clear();
+        if (Consume(']')) {
+            return true;
+        }
+        do {
+            SkipWhitespace();
+            if (m_cur < m_end && *m_cur == '"') {
+                out.emplace_back();
+                if (!ParseString(&out.back())) {
+                    return false;
+                }
+            } else if (!SkipValue(depth + 1)) {
+                return false;
+            }
+        } while (Consume(','));
+        return Consume(']');
+    }
+
+    /**
+     * @brief Parse a registration time given as ISO 8601 text or epoch milliseconds
+     *
+     * A string that is not a timestamp, or a number outside the range of a
+     * JavaScript Date, is an error reported at the start of the value. A
+     * null or other value leaves the record without a registration time.
+     */
+    bool ParseRegisteredAt(JsonRegistration& record, int depth) {
+        SkipWhitespace();
+        const char* start = m_cur;
+        if (m_cur < m_end && *m_cur == '"') {
+            int64_t ms;
+            if (!ParseString(&m_value)) {
+                return false;
+            }
+            if (!ParseIsoTimestamp(m_value, ms)) {
+                m_cur = start;
+                return false;
+            }
+            record.registeredAtMs = ms;
+            record.hasRegisteredAt = true;
+            return true;
+        }
+        if (m_cur < m_end && (*m_cur == '-' || (*m_cur >= '0' && *m_cur <= '9'))) {
+            double ms;
+            if (!ParseNumber(ms)) {
+                return false;
+            }
+            if (!(ms >= -8.64e15 && ms <= 8.64e15)) {
+                m_cur = start;
+                return false;
+            }
+            record.registeredAtMs = static_cast<int64_t>(ms);
+            record.hasRegisteredAt = true;
+            return true;
+        }
+        return SkipValue(depth);
+    }
+
+    /**
+     * @brief Parse the properties of a record object or its hardware object
+     */
+    bool ParseRecordFields(JsonRegistration& record, FirstIdentifiers& first, int depth) {
+        if (!Consume('{')) {
+            return false;
+        }
+        if (Consume('}')) {
+            return true;
+        }
+        HardwareInfo& info = record.info;
+        do {
+            SkipWhitespace();
+            if (m_cur == m_end || *m_cur != '"' || !ParseString(&m_key) || !Consume(':')) {
+                return false;
+            }
+            bool parsed;
+            if (m_key == "cpuId") {
+                parsed = ParseStringValue(info.cpuId, depth + 1);
+            } else if (m_key == "motherboardSerial") {
+                parsed = ParseStringValue(info.motherboardSerial, depth + 1);
+            } else if (m_key == "biosSerial") {
+                parsed = ParseStringValue(info.biosSerial, depth + 1);
+            } else if (m_key == "fingerprint") {
+                parsed = ParseStringValue(info.fingerprint, depth + 1);
+            } else if (m_key == "diskSerials") {
+                parsed = ParseStringArray(info.diskSerials, depth + 1);
+            } else if (m_key == "macAddresses") {
+                parsed = ParseStringArray(info.macAddresses, depth + 1);
+            } else if (m_key == "firstDiskSerial") {
+                parsed = ParseStringValue(first.diskSerial, depth + 1);
+            } else if (m_key == "firstMacAddress") {
+                parsed = ParseStringValue(first.macAddress, depth + 1);
+            } else if (m_key == "registeredAt") {
+                parsed = ParseRegisteredAt(record, depth + 1);
+            } else if (m_key == "hardware" && depth + 1 < kMaxDepth && PeekValue('{')) {
+                parsed = ParseRecordFields(record, first, depth + 1);
+            } else {
+                parsed = SkipValue(depth + 1);
+            }
+            if (!parsed) {
+                return false;
+            }
+        } while (Consume(','));
+        return Consume('}');
+    }
+
+    /**
+     * @brief Parse one record object
+     */
+    bool ParseRecord(std::vector<JsonRegistration>& out) {
+        JsonRegistration record;
+        FirstIdentifiers first;
+        if (!ParseRecordFields(record, first, 0)) {
+            return false;
+        }
+        // Registration files only keep the first disk and adapter
+        if (record.info.diskSerials.empty() && !first.diskSerial.empty()) {
+            record.info.diskSerials.push_back(std::move(first.diskSerial));
+        }
+        if (record.info.macAddresses.empty() && !first.macAddress.empty()) {
+            record.info.macAddresses.push_back(std::move(first.macAddress));
+        }
+        out.push_back(std::move(record));
+        return true;
+    }
+
+    /**
+     * @brief Parse a top-level array of record objects
+     */
+    bool ParseRecordArray(std::vector<JsonRegistration>& out) {
+        m_cur++;
+        if (Consume(']')) {
+            return true;
+        }
+        do {
+            SkipWhitespace();
+            if (m_cur == m_end || *m_cur != '{' || !ParseRecord(out)) {
+                return false;
+            }
+        } while (Consume(','));
+        return Consume(']');
+    }
+
+    const char* m_begin;
+    const char* m_cur;
+    const char* m_end;
+    std::string m_key;      // Reused property name buffer
+    std::string m_value;    // Reused scratch value buffer
+};
+
+/**
+ * @brief Find the first line at or after an offset that starts a top-level value
+ * @return Offset of the line, or size if there is none
+ */
+size_t FindValueLine(const char* data, size_t size, size_t offset) {
+    while (offset < size) {
+        const void* newline = std::memchr(data + offset, '\n', size - offset);
+        if (!newline) {
+            return size;
+        }
+        offset = static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+        if (offset < size && (data[offset] == '{' || data[offset] == '[')) {
+            return offset;
+        }
+    }
+    return size;
+}
+
+} // namespace
+
+/**
+ * @brief Parse an ISO 8601 timestamp
+ */
+bool ParseIsoTimestamp(const std::string& text, int64_t& ms) {
+    const char* p = text.c_str();
+    size_t length = text.size();
+    auto digits = [&](size_t offset, size_t count, int& value) {
+        if (offset + count > length) {
+            return false;
+        }
+        value = 0;
+        for (size_t i = 0; i < count; i++) {
+            char c = p[offset + i];
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        return true;
+    };
+
+    int year, month, day;
+    if (!digits(0, 4, year) || length < 10 || p[4] != '-' || !digits(5, 2, month) ||
+        p[7] != '-' || !digits(8, 2, day)) {
+        return false;
+    }
+    static const int kDaysInMonth[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (month < 1 || month > 12 || day < 1 || day > kDaysInMonth[month - 1] ||
+        (month == 2 && day == 29 && !leap)) {
+        return false;
+    }
+    int64_t result = DaysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400000;
+    if (length == 10) {
+        ms = result;
+        return true;
+    }
+
+    int hour, minute, second = 0;
+    if (p[10] != 'T' || !digits(11, 2, hour) || length < 16 || p[13] != ':' || !digits(14, 2, minute) ||
+        hour > 23 || minute > 59) {
+        return false;
+    }
+    size_t offset = 16;
+    int millis = 0;
+    if (offset < length && p[offset] == ':') {
+        if (!digits(offset + 1, 2, second) || second > 59) {
+            return false;
+        }
+        offset += 3;
+        if (offset < length && p[offset] == '.') {
+            size_t fractionDigits = 0;
+            for (offset++; offset < length && p[offset] >= '0' && p[offset] <= '9'; offset++, fractionDigits++) {
+                if (fractionDigits < 3) {
+                    millis = millis * 10 + (p[offset] - '0');
+                }
+            }
+            if (fractionDigits == 0) {
+                return false;
+            }
+            for (; fractionDigits < 3; fractionDigits++) {
+                millis *= 10;
+            }
+        }
+    }
+    result += ((hour * 60 + minute) * 60 + second) * 1000LL + millis;
+
+    if (offset + 1 == length && p[offset] == 'Z') {
+        ms = result;
+        return true;
+    }
+    int offsetHours, offsetMinutes;
+    if (offset + 6 == length && (p[offset] == '+' || p[offset] == '-') &&
+        digits(offset + 1, 2, offsetHours) && p[offset + 3] == ':' && digits(offset + 4, 2, offsetMinutes) &&
+        offsetHours <= 23 && offsetMinutes <= 59) {
+        int64_t shift = (offsetHours * 60 + offsetMinutes) * 60000LL;
+        ms = p[offset] == '+' ? result - shift : result + shift;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Read hardware registrations from JSON text
+ */
+bool ReadJsonRegistrations(const char* data, size_t size, unsigned threads,
+                           std::vector<JsonRegistration>& out, size_t& errorOffset) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, size / kMinBytesPerThread)));
+
+    // Split at lines that start with '{' or '['; strings cannot contain raw
+    // newlines, so every candidate is outside a string
+    std::vector<size_t> bounds(1, 0);
+    for (unsigned t = 1; t < threads; t++) {
+        size_t bound = FindValueLine(data, size, std::max(bounds.back(), size / threads * t));
+        if (bound >= size) {
+            break;
+        }
+        bounds.push_back(bound);
+    }
+    bounds.push_back(size);
+
+    if (bounds.size() > 2) {
+        size_t chunks = bounds.size() - 1;
+        std::vector<std::vector<JsonRegistration>> parts(chunks);
+        std::vector<char> parsed(chunks);
+        auto parseChunk = [&](size_t chunk) {
+            RegistrationParser parser(data + bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+            parsed[chunk] = parser.ParseAll(parts[chunk]);
+        };
+        std::vector<std::thread> workers;
+        for (size_t chunk = 1; chunk < chunks; chunk++) {
+            workers.emplace_back(parseChunk, chunk);
+        }
+        parseChunk(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        // The first chunk starts on a value boundary; each chunk that parses
+        // to its end without error proves the next one does too
+        bool complete = true;
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            complete = complete && parsed[chunk];
+        }
+        if (complete) {
+            size_t records = 0;
+            for (const std::vector<JsonRegistration>& part : parts) {
+                records += part.size();
+            }
+            out.reserve(out.size() + records);
+            for (std::vector<JsonRegistration>& part : parts) {
+                std::move(part.begin(), part.end(), std::back_inserter(out));
+            }
+            return true;
+        }
+    }
+
+    size_t firstRecord = out.size();
+    RegistrationParser parser(data, size);
+    if (!parser.ParseAll(out)) {
+        errorOffset = parser.Offset();
+        out.resize(firstRecord);
+        return false;
+    }
+    return true;
+}
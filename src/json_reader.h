@@ -0,0 +1,59 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include "hardware_info.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One hardware registration read from JSON
+ */
+struct JsonRegistration {
+    HardwareInfo info;
+    int64_t registeredAtMs = 0;  // Valid only if hasRegisteredAt; 0 is the epoch itself
+    bool hasRegisteredAt = false;
+};
+
+/**
+ * @brief Parse an ISO 8601 UTC or offset timestamp
+ *
+ * Accepts the Date.prototype.toISOString() form and its variants with
+ * fewer fraction digits, no fraction, or a +hh:mm/-hh:mm offset.
+ *
+ * @param text Timestamp text
+ * @param ms Receives milliseconds since the epoch
+ * @return false if the text is not such a timestamp
+ */
+bool ParseIsoTimestamp(const std::string& text, int64_t& ms);
+
+/**
+ * @brief Read hardware registrations from JSON text
+ *
+ * The input is a sequence of top-level values separated by whitespace:
+ * newline-delimited records, concatenated (pretty-printed) registration
+ * files, or arrays of records. A record is an object in the
+ * registration-file shape (registeredAt, fingerprint and a hardware
+ * object with firstDiskSerial/firstMacAddress), the getAllHardwareInfo()
+ * shape, or a registry export entry; other properties are skipped.
+ *
+ * Records are parsed straight into native values without building a
+ * document tree. String bodies are scanned with the SIMD escape finder of
+ * the JSON writer. Inputs above a few megabytes are split at lines that
+ * start a top-level value and parsed on several threads; each chunk only
+ * counts if the chunk before it ended on a value boundary, otherwise the
+ * whole input is parsed again on one thread.
+ *
+ * @param data UTF-8 JSON text
+ * @param size Number of bytes
+ * @param threads Parse threads, 0 for the CPU count
+ * @param out Receives the records in input order
+ * @param errorOffset Receives the byte offset of the first error
+ * @return false if the input is not valid JSON of that shape, or a
+ *         registeredAt value is neither a timestamp nor epoch milliseconds
+ */
+bool ReadJsonRegistrations(const char* data, size_t size, unsigned threads,
+                           std::vector<JsonRegistration>& out, size_t& errorOffset);
+
+#endif // JSON_READER_H
@@ -0,0 +1,405 @@
+#include "json_writer.h"
+#include "cpu_features.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(HWID_ARCH_X86)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSON_WRITER_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define JSON_WRITER_NEON 1
+#endif
+
+/**
+ * @brief Get the index of the lowest set bit of a non-zero mask
+ */
+static inline unsigned LowestSetBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * @brief Check whether a byte needs escaping in a JSON string
+ */
+static inline bool NeedsEscape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+using FindJsonEscapeFn = size_t (*)(const char* data, size_t size);
+
+static size_t FindJsonEscapeScalar(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size && !NeedsEscape(static_cast<unsigned char>(data[i]))) {
+        i++;
+    }
+    return i;
+}
+
+#if defined(JSON_WRITER_SSE2)
+static size_t FindJsonEscapeSse2(const char* data, size_t size) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        // Unsigned bytes <= 0x1F are exactly those whose max with 0x1F is 0x1F
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+                                       _mm_cmpeq_epi8(_mm_max_epu8(bytes, control), control));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+        if (mask) {
+            return i + LowestSetBit(mask);
+        }
+    }
+    return i + FindJsonEscapeScalar(data + i, size - i);
+}
+#elif defined(JSON_WRITER_NEON)
+static size_t FindJsonEscapeNeon(const char* data, size_t size) {
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(bytes, quote), vceqq_u8(bytes, backslash)),
+                                      vcltq_u8(bytes, space));
+        if (vmaxvq_u8(special)) {
+            break;
+        }
+    }
+    return i + FindJsonEscapeScalar(data + i, size - i);
+}
+#endif
+
+#if defined(HWID_ARCH_X86)
+HWID_TARGET("avx2")
+static size_t FindJsonEscapeAvx2(const char* data, size_t size) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote), _mm256_cmpeq_epi8(bytes, backslash)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, control), control));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+        if (mask) {
+            return i + LowestSetBit(mask);
+        }
+    }
+    return i + FindJsonEscapeScalar(data + i, size - i);
+}
+#endif
+
+/**
+ * @brief Select the best escape scan kernel for the running CPU
+ */
+static FindJsonEscapeFn SelectFindJsonEscape() {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    (void)cpu;
+#if defined(HWID_ARCH_X86)
+    if (cpu.avx2) {
+        RecordKernelVariant("json.findEscape", "avx2");
+        return FindJsonEscapeAvx2;
+    }
+#endif
+#if defined(JSON_WRITER_SSE2)
+    if (cpu.sse2) {
+        RecordKernelVariant("json.findEscape", "sse2");
+        return FindJsonEscapeSse2;
+    }
+#elif defined(JSON_WRITER_NEON)
+    if (cpu.neon) {
+        RecordKernelVariant("json.findEscape", "neon");
+        return FindJsonEscapeNeon;
+    }
+#endif
+    RecordKernelVariant("json.findEscape", "scalar");
+    return FindJsonEscapeScalar;
+}
+
+// Resolved while the module loads, before any string is written
+static const FindJsonEscapeFn FindJsonEscapeKernel = SelectFindJsonEscape();
+
+/**
+ * @brief Find the first byte that JSON requires to be escaped
+ */
+size_t FindJsonEscape(const char* data, size_t size) {
+    return FindJsonEscapeKernel(data, size);
+}
+
+/**
+ * @brief Constructor
+ */
+JsonWriter::JsonWriter(std::string& out)
+    : m_out(out)
+    , m_afterKey(false) {
+}
+
+void JsonWriter::BeforeValue() {
+    if (m_afterKey) {
+        m_afterKey = false;
+        return;
+    }
+    if (!m_hasElements.empty()) {
+        if (m_hasElements.back()) {
+            m_out.push_back(',');
+        }
+        m_hasElements.back() = true;
+    }
+}
+
+void JsonWriter::BeginObject() {
+    BeforeValue();
+    m_out.push_back('{');
+    m_hasElements.push_back(false);
+}
+
+void JsonWriter::EndObject() {
+    m_hasElements.pop_back();
+    m_out.push_back('}');
+}
+
+void JsonWriter::BeginArray() {
+    BeforeValue();
+    m_out.push_back('[');
+    m_hasElements.push_back(false);
+}
+
+void JsonWriter::EndArray() {
+    m_hasElements.pop_back();
+    m_out.push_back(']');
+}
+
+void JsonWriter::Key(std::string_view key) {
+    String(key);
+    m_out.push_back(':');
+    m_afterKey = true;
+}
+
+/**
+ * @brief Write an escaped string
+ */
+void JsonWriter::String(std::string_view value) {
+    BeforeValue();
+    m_out.push_back('"');
+    const char* data = value.data();
+    size_t size = value.size();
+    while (size > 0) {
+        size_t run = FindJsonEscape(data, size);
+        m_out.append(data, run);
+        if (run == size) {
+            break;
+        }
+
+        unsigned char c = static_cast<unsigned char>(data[run]);
+        switch (c) {
+            case '"':  m_out.append("\\\"", 2); break;
+            case '\\': m_out.append("\\\\", 2); break;
+            case '\n': m_out.append("\\n", 2); break;
+            case '\r': m_out.append("\\r", 2); break;
+            case '\t': m_out.append("\\t", 2); break;
+            case '\b': m_out.append("\\b", 2); break;
+            case '\f': m_out.append("\\f", 2); break;
+            default: {
+                static const char kHex[] = "0123456789abcdef";
+                char escape[6] = { '\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF] };
+                m_out.append(escape, sizeof(escape));
+                break;
+            }
+        }
+        data += run + 1;
+        size -= run + 1;
+    }
+    m_out.push_back('"');
+}
+
+void JsonWriter::Integer(int64_t value) {
+    BeforeValue();
+    char digits[24];
+    int length = snprintf(digits, sizeof(digits), "%lld", static_cast<long long>(value));
+    m_out.append(digits, static_cast<size_t>(length));
+}
+
+void JsonWriter::Number(double value) {
+    if (!std::isfinite(value)) {
+        Null();
+        return;
+    }
+    // Integers up to 2^53 are exact; this also writes -0 as 0, as JavaScript does
+    if (std::fabs(value) <= 9007199254740992.0 && value == std::trunc(value)) {
+        Integer(static_cast<int64_t>(value));
+        return;
+    }
+    BeforeValue();
+    // 17 significant digits always round-trip; fewer usually do. Any decimal
+    // of up to 15 digits survives a trip through a normal double, so the
+    // 15-digit rounding carries the shortest digits padded with zeros when
+    // they fit. Subnormals hold fewer digits and are searched from one.
+    bool subnormal = std::fabs(value) < std::numeric_limits<double>::min();
+    char scientific[32];
+    for (int precision = subnormal ? 0 : 14; precision <= 16; precision++) {
+        snprintf(scientific, sizeof(scientific), "%.*e", precision, value);
+        if (strtod(scientific, nullptr) == value) {
+            break;
+        }
+    }
+
+    // Split "-d.ddde+XX" into significant digits and a point position, so
+    // that value = 0.digits * 10^point
+    const char* cursor = scientific;
+    if (*cursor == '-') {
+        m_out.push_back('-');
+        cursor++;
+    }
+    char digits[20];
+    int count = 0;
+    for (; *cursor != 'e'; cursor++) {
+        if (*cursor >= '0' && *cursor <= '9') {
+            digits[count++] = *cursor;
+        }
+    }
+    int point = static_cast<int>(strtol(cursor + 1, nullptr, 10)) + 1;
+    while (count > 1 && digits[count - 1] == '0') {
+        count--;
+    }
+
+    // Lay the digits out as Number.prototype.toString does
+    if (count <= point && point <= 21) {
+        m_out.append(digits, static_cast<size_t>(count));
+        m_out.append(static_cast<size_t>(point - count), '0');
+    } else if (point > 0 && point <= 21) {
+        m_out.append(digits, static_cast<size_t>(point));
+        m_out.push_back('.');
+        m_out.append(digits + point, static_cast<size_t>(count - point));
+    } else if (point > -6 && point <= 0) {
+        m_out.append("0.", 2);
+        m_out.append(static_cast<size_t>(-point), '0');
+        m_out.append(digits, static_cast<size_t>(count));
+    } else {
+        m_out.push_back(digits[0]);
+        if (count > 1) {
+            m_out.push_back('.');
+            m_out.append(digits + 1, static_cast<size_t>(count - 1));
+        }
+        char exponent[8];
+        int length = snprintf(exponent, sizeof(exponent), "e%+d", point - 1);
+        m_out.append(exponent, static_cast<size_t>(length));
+    }
+}
+
+void JsonWriter::Bool(bool value) {
+    BeforeValue();
+    m_out.append(value ? "true" : "false");
+}
+
+void JsonWriter::Null() {
+    BeforeValue();
+    m_out.append("null", 4);
+}
+
+void JsonWriter::StringArray(const std::vector<std::string>& values) {
+    BeginArray();
+    for (const std::string& value : values) {
+        String(value);
+    }
+    EndArray();
+}
+
+size_t JsonWriter::Depth() const {
+    return m_hasElements.size();
+}
+
+/**
+ * @brief Write the names of the components in a ComponentBit mask
+ */
+static void WriteComponentNames(JsonWriter& writer, uint32_t components) {
+    writer.BeginArray();
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        if (components & ComponentBit(component)) {
+            writer.String(ComponentName(component));
+        }
+    }
+    writer.EndArray();
+}
+
+/**
+ * @brief Write one component value of a snapshot
+ */
+static void WriteComponent(JsonWriter& writer, const HardwareInfo& info, HardwareComponent component) {
+    VisitComponent(component, info, [&writer](const auto& value) {
+        if constexpr (std::is_same<std::decay_t<decltype(value)>, ComponentList>::value) {
+            writer.StringArray(value);
+        } else {
+            writer.String(value);
+        }
+    });
+}
+
+/**
+ * @brief Write the fields of a snapshot in the getAllHardwareInfo() shape
+ */
+void WriteHardwareInfoFields(JsonWriter& writer, const HardwareInfo& info) {
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        writer.Key(ComponentName(component));
+        WriteComponent(writer, info, component);
+    }
+    writer.Key("fingerprint");
+    writer.String(info.fingerprint);
+    writer.Key("timedOut");
+    WriteComponentNames(writer, info.timedOutComponents);
+}
+
+/**
+ * @brief Write the difference between two snapshots as an object
+ */
+void WriteSnapshotDiff(JsonWriter& writer, const HardwareInfo& before, const HardwareInfo& after) {
+    uint32_t changed = 0;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        if (!ComponentEquals(component, before, after)) {
+            changed |= ComponentBit(component);
+        }
+    }
+
+    writer.BeginObject();
+    writer.Key("changed");
+    WriteComponentNames(writer, changed);
+    writer.Key("fingerprintChanged");
+    writer.Bool(before.fingerprint != after.fingerprint);
+    for (int side = 0; side < 2; side++) {
+        const HardwareInfo& info = side == 0 ? before : after;
+        writer.Key(side == 0 ? "before" : "after");
+        writer.BeginObject();
+        for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+            HardwareComponent component = static_cast<HardwareComponent>(i);
+            if (changed & ComponentBit(component)) {
+                writer.Key(ComponentName(component));
+                WriteComponent(writer, info, component);
+            }
+        }
+        writer.Key("fingerprint");
+        writer.String(info.fingerprint);
+        writer.EndObject();
+    }
+    writer.EndObject();
+}
@@ -0,0 +1,109 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include "hardware_info.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Find the first byte of a string that JSON requires to be escaped
+ *
+ * Control characters, '"' and '\\' need escaping; the scan runs 16 or 32
+ * bytes at a time with the best kernel for the running CPU.
+ *
+ * @param data String bytes
+ * @param size Number of bytes
+ * @return Offset of the first such byte, or size if there is none
+ */
+size_t FindJsonEscape(const char* data, size_t size);
+
+/**
+ * @brief Streaming JSON writer appending to a caller-owned buffer
+ *
+ * Commas and nesting are tracked internally; values are written as they
+ * arrive, so a caller can hand off and clear the buffer between values to
+ * produce output in chunks. Strings are expected to be UTF-8 and are
+ * copied in runs between the bytes that need escaping.
+ */
+class JsonWriter {
+public:
+    /**
+     * @brief Constructor
+     * @param out Buffer that receives the output
+     */
+    explicit JsonWriter(std::string& out);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    /**
+     * @brief Write an object key; the next call writes its value
+     */
+    void Key(std::string_view key);
+
+    void String(std::string_view value);
+    void Integer(int64_t value);
+
+    /**
+     * @brief Write a number as JSON.stringify does
+     *
+     * Uses the shortest digits that parse back to the same double, laid out
+     * as Number.prototype.toString lays them out: plain notation from 1e-6
+     * up to but excluding 1e21 ("1152921504606847000"), exponent form
+     * outside that range ("1e-7", "1.5e+21"). NaN and infinities are
+     * written as null.
+     */
+    void Number(double value);
+    void Bool(bool value);
+    void Null();
+
+    /**
+     * @brief Write an array of strings
+     */
+    void StringArray(const std::vector<std::string>& values);
+
+    /**
+     * @brief Get the nesting depth (0 at top level)
+     */
+    size_t Depth() const;
+
+private:
+    /**
+     * @brief Emit the separator before a value or key
+     */
+    void BeforeValue();
+
+    std::string& m_out;
+    std::vector<bool> m_hasElements;       // Per open container: a value was written
+    bool m_afterKey;
+};
+
+/**
+ * @brief Write the fields of a snapshot in the getAllHardwareInfo() shape
+ *
+ * Writes keys and values only, so callers can add fields inside the same
+ * object before closing it.
+ *
+ * @param writer Writer positioned inside an open object
+ * @param info Snapshot to write
+ */
+void WriteHardwareInfoFields(JsonWriter& writer, const HardwareInfo& info);
+
+/**
+ * @brief Write the difference between two snapshots as an object
+ *
+ * The object lists the changed component names, whether the fingerprint
+ * changed, and the before and after values of the changed components.
+ *
+ * @param writer Writer positioned where a value is expected
+ * @param before Earlier snapshot
+ * @param after Later snapshot
+ */
+void WriteSnapshotDiff(JsonWriter& writer, const HardwareInfo& before, const HardwareInfo& after);
+
+#endif // JSON_WRITER_H
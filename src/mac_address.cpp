@@ -0,0 +1,275 @@
+#include "mac_address.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAC_ADDRESS_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MAC_ADDRESS_NEON 1
+#endif
+
+/**
+ * @brief Decode one hex digit, -1 if invalid
+ */
+static int HexValue(unsigned char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Decode hex digits at fixed positions, scalar path
+ * @param text Address text
+ * @param positions Offsets of the 12 hex digits
+ * @param mac Receives the address
+ * @return false on a non-hex digit
+ */
+static bool DecodeDigits(const char* text, const uint8_t* positions, MacAddress& mac) {
+    uint64_t value = 0;
+    for (int i = 0; i < 12; i++) {
+        int nibble = HexValue(static_cast<unsigned char>(text[positions[i]]));
+        if (nibble < 0) {
+            return false;
+        }
+        value = (value << 4) | static_cast<uint64_t>(nibble);
+    }
+    mac.value = value;
+    return true;
+}
+
+/**
+ * @brief Parse the 17-character separated form ("xx:xx:xx:xx:xx:xx")
+ *
+ * The vector kernel validates the five separators in bytes 0-15 and
+ * converts all sixteen bytes to nibble values in one pass; the last digit
+ * is handled separately.
+ */
+static bool ParseSeparated(const char* text, char separator, MacAddress& mac) {
+    static const uint8_t kPositions[12] = {0, 1, 3, 4, 6, 7, 9, 10, 12, 13, 15, 16};
+
+#if defined(MAC_ADDRESS_SSE2) || defined(MAC_ADDRESS_NEON)
+    alignas(16) static const uint8_t kSeparatorLanes[16] = {
+        0, 0, 0xFF, 0, 0, 0xFF, 0, 0, 0xFF, 0, 0, 0xFF, 0, 0, 0xFF, 0
+    };
+    alignas(16) uint8_t nibbles[16];
+
+#if defined(MAC_ADDRESS_SSE2)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+    __m128i separatorLanes = _mm_load_si128(reinterpret_cast<const __m128i*>(kSeparatorLanes));
+
+    // Digits: c - '0' in [0, 9]; letters: (c | 0x20) - 'a' in [0, 5]
+    __m128i digit = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    __m128i isSeparator = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(separator));
+
+    __m128i valid = _mm_or_si128(_mm_and_si128(separatorLanes, isSeparator),
+                                 _mm_andnot_si128(separatorLanes, _mm_or_si128(isDigit, isLetter)));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+        return false;
+    }
+
+    __m128i values = _mm_or_si128(_mm_and_si128(isDigit, digit),
+                                  _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    _mm_store_si128(reinterpret_cast<__m128i*>(nibbles), values);
+#else
+    uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(text));
+    uint8x16_t separatorLanes = vld1q_u8(kSeparatorLanes);
+
+    uint8x16_t digit = vsubq_u8(bytes, vdupq_n_u8('0'));
+    uint8x16_t letter = vsubq_u8(vorrq_u8(bytes, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+    uint8x16_t isLetter = vcleq_u8(letter, vdupq_n_u8(5));
+    uint8x16_t isSeparator = vceqq_u8(bytes, vdupq_n_u8(static_cast<uint8_t>(separator)));
+
+    uint8x16_t valid = vbslq_u8(separatorLanes, isSeparator, vorrq_u8(isDigit, isLetter));
+    if (vminvq_u8(valid) != 0xFF) {
+        return false;
+    }
+
+    uint8x16_t values = vorrq_u8(vandq_u8(isDigit, digit),
+                                 vandq_u8(isLetter, vaddq_u8(letter, vdupq_n_u8(10))));
+    vst1q_u8(nibbles, values);
+#endif
+
+    int last = HexValue(static_cast<unsigned char>(text[16]));
+    if (last < 0) {
+        return false;
+    }
+
+    uint64_t value = 0;
+    for (int i = 0; i < 11; i++) {
+        value = (value << 4) | nibbles[kPositions[i]];
+    }
+    mac.value = (value << 4) | static_cast<uint64_t>(last);
+    return true;
+#else
+    for (int i = 2; i < 17; i += 3) {
+        if (text[i] != separator) {
+            return false;
+        }
+    }
+    return DecodeDigits(text, kPositions, mac);
+#endif
+}
+
+/**
+ * @brief Parse a MAC address in colon, dash, dot or bare form
+ */
+bool ParseMacAddress(std::string_view text, MacAddress& mac) {
+    switch (text.size()) {
+        case 17:
+            if (text[2] != ':' && text[2] != '-') {
+                return false;
+            }
+            return ParseSeparated(text.data(), text[2], mac);
+        case 14: {
+            static const uint8_t kPositions[12] = {0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13};
+            if (text[4] != '.' || text[9] != '.') {
+                return false;
+            }
+            return DecodeDigits(text.data(), kPositions, mac);
+        }
+        case 12: {
+            static const uint8_t kPositions[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+            return DecodeDigits(text.data(), kPositions, mac);
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Parse a MAC address prefix such as an OUI ("00:1A:2B")
+ */
+bool ParseMacPrefix(std::string_view text, uint64_t& value, uint64_t& mask) {
+    uint64_t prefix = 0;
+    int digits = 0;
+    for (char c : text) {
+        if (c == ':' || c == '-' || c == '.') {
+            continue;
+        }
+        int nibble = HexValue(static_cast<unsigned char>(c));
+        if (nibble < 0 || digits == 12) {
+            return false;
+        }
+        prefix = (prefix << 4) | static_cast<uint64_t>(nibble);
+        digits++;
+    }
+    if (digits == 0 || digits % 2 != 0) {
+        return false;
+    }
+
+    int shift = 48 - 4 * digits;
+    value = prefix << shift;
+    mask = (MacAddress::kMask >> shift) << shift;
+    return true;
+}
+
+/**
+ * @brief Format a MAC address into a caller-provided buffer
+ *
+ * The twelve nibbles are spread to their output lanes, then converted to
+ * hex and merged with the separators in one vector step.
+ */
+size_t FormatMacAddress(MacAddress mac, MacFormat format, bool uppercase, char* out) {
+    static const uint8_t kColonLayout[12] = {0, 1, 3, 4, 6, 7, 9, 10, 12, 13, 15, 16};
+    static const uint8_t kDotLayout[12] = {0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13};
+    static const uint8_t kBareLayout[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+    const uint8_t* layout;
+    size_t length;
+    char separator;
+    switch (format) {
+        case MacFormat::Dash:
+            layout = kColonLayout;
+            length = 17;
+            separator = '-';
+            break;
+        case MacFormat::Dot:
+            layout = kDotLayout;
+            length = 14;
+            separator = '.';
+            break;
+        case MacFormat::Bare:
+            layout = kBareLayout;
+            length = 12;
+            separator = 0;
+            break;
+        case MacFormat::Colon:
+        default:
+            layout = kColonLayout;
+            length = 17;
+            separator = ':';
+            break;
+    }
+
+    // Separator lanes hold 0xFF, digit lanes their nibble
+    alignas(16) uint8_t lanes[32];
+    memset(lanes, 0xFF, sizeof(lanes));
+    for (int i = 0; i < 12; i++) {
+        lanes[layout[i]] = static_cast<uint8_t>((mac.value >> (44 - 4 * i)) & 0xF);
+    }
+    char letterBase = uppercase ? 'A' : 'a';
+
+#if defined(MAC_ADDRESS_SSE2)
+    for (size_t offset = 0; offset < length; offset += 16) {
+        __m128i nibbles = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes + offset));
+        __m128i isSeparator = _mm_cmpeq_epi8(nibbles, _mm_set1_epi8(static_cast<char>(0xFF)));
+        __m128i isLetter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+        __m128i ascii = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+        ascii = _mm_add_epi8(ascii, _mm_and_si128(isLetter, _mm_set1_epi8(static_cast<char>(letterBase - '0' - 10))));
+        ascii = _mm_or_si128(_mm_andnot_si128(isSeparator, ascii), _mm_and_si128(isSeparator, _mm_set1_epi8(separator)));
+        alignas(16) char chunk[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(chunk), ascii);
+        memcpy(out + offset, chunk, std::min<size_t>(16, length - offset));
+    }
+#elif defined(MAC_ADDRESS_NEON)
+    for (size_t offset = 0; offset < length; offset += 16) {
+        uint8x16_t nibbles = vld1q_u8(lanes + offset);
+        uint8x16_t isSeparator = vceqq_u8(nibbles, vdupq_n_u8(0xFF));
+        uint8x16_t isLetter = vcgtq_u8(nibbles, vdupq_n_u8(9));
+        uint8x16_t ascii = vaddq_u8(nibbles, vdupq_n_u8('0'));
+        ascii = vaddq_u8(ascii, vandq_u8(isLetter, vdupq_n_u8(static_cast<uint8_t>(letterBase - '0' - 10))));
+        ascii = vbslq_u8(isSeparator, vdupq_n_u8(static_cast<uint8_t>(separator)), ascii);
+        uint8_t chunk[16];
+        vst1q_u8(chunk, ascii);
+        memcpy(out + offset, chunk, std::min<size_t>(16, length - offset));
+    }
+#else
+    for (size_t i = 0; i < length; i++) {
+        uint8_t nibble = lanes[i];
+        if (nibble == 0xFF) {
+            out[i] = separator;
+        } else {
+            out[i] = static_cast<char>(nibble < 10 ? '0' + nibble : letterBase + nibble - 10);
+        }
+    }
+#endif
+    return length;
+}
+
+/**
+ * @brief Format a MAC address as a string
+ */
+std::string FormatMacAddress(MacAddress mac, MacFormat format, bool uppercase) {
+    char buffer[kMaxMacAddressLength];
+    size_t length = FormatMacAddress(mac, format, uppercase, buffer);
+    return std::string(buffer, length);
+}
+
+/**
+ * @brief Sort addresses and remove duplicates
+ */
+void SortUniqueMacAddresses(std::vector<MacAddress>& macs) {
+    std::sort(macs.begin(), macs.end());
+    macs.erase(std::unique(macs.begin(), macs.end()), macs.end());
+}
@@ -0,0 +1,103 @@
+#ifndef MAC_ADDRESS_H
+#define MAC_ADDRESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Textual MAC address styles
+ */
+enum class MacFormat {
+    Colon,      // 00:1A:2B:3C:4D:5E
+    Dash,       // 00-1A-2B-3C-4D-5E
+    Dot,        // 001A.2B3C.4D5E
+    Bare        // 001A2B3C4D5E
+};
+
+/**
+ * @brief Longest formatted MAC address, without terminator
+ */
+constexpr size_t kMaxMacAddressLength = 17;
+
+/**
+ * @brief 48-bit MAC address held in an integer
+ *
+ * The first transmitted octet is the most significant byte, so integer
+ * order equals the order of the canonical text. Flag checks are single
+ * mask tests on the first octet.
+ */
+struct MacAddress {
+    static constexpr uint64_t kMask = 0xFFFFFFFFFFFFULL;
+    static constexpr uint64_t kMulticastBit = 1ULL << 40;             // I/G bit of octet 0
+    static constexpr uint64_t kLocallyAdministeredBit = 1ULL << 41;   // U/L bit of octet 0
+
+    uint64_t value = 0;
+
+    bool IsZero() const { return value == 0; }
+    bool IsBroadcast() const { return value == kMask; }
+    bool IsMulticast() const { return (value & kMulticastBit) != 0; }
+    bool IsLocallyAdministered() const { return (value & kLocallyAdministeredBit) != 0; }
+
+    /**
+     * @brief Get the organizationally unique identifier (first three octets)
+     */
+    uint32_t Oui() const { return static_cast<uint32_t>(value >> 24); }
+
+    bool operator==(const MacAddress& other) const { return value == other.value; }
+    bool operator!=(const MacAddress& other) const { return value != other.value; }
+    bool operator<(const MacAddress& other) const { return value < other.value; }
+};
+
+/**
+ * @brief Parse a MAC address in colon, dash, dot or bare form
+ *
+ * Hex digits may be either case. The 17-character colon and dash forms
+ * are decoded with a vector kernel where SSE2 or NEON is available.
+ *
+ * @param text Address text
+ * @param mac Receives the address
+ * @return false if the text is not a MAC address
+ */
+bool ParseMacAddress(std::string_view text, MacAddress& mac);
+
+/**
+ * @brief Parse a MAC address prefix such as an OUI ("00:1A:2B")
+ *
+ * Accepts 1 to 6 octets, optionally separated by ':', '-' or '.'.
+ *
+ * @param text Prefix text
+ * @param value Receives the prefix in MacAddress::value layout
+ * @param mask Receives the mask covering the given octets
+ * @return false if the text is not a MAC address prefix
+ */
+bool ParseMacPrefix(std::string_view text, uint64_t& value, uint64_t& mask);
+
+/**
+ * @brief Format a MAC address into a caller-provided buffer
+ * @param mac Address to format
+ * @param format Output style
+ * @param uppercase Use upper-case hex digits
+ * @param out Buffer of at least kMaxMacAddressLength bytes (not terminated)
+ * @return Number of characters written
+ */
+size_t FormatMacAddress(MacAddress mac, MacFormat format, bool uppercase, char* out);
+
+/**
+ * @brief Format a MAC address as a string
+ * @param mac Address to format
+ * @param format Output style
+ * @param uppercase Use upper-case hex digits
+ * @return Formatted address
+ */
+std::string FormatMacAddress(MacAddress mac, MacFormat format = MacFormat::Colon, bool uppercase = true);
+
+/**
+ * @brief Sort addresses and remove duplicates
+ * @param macs Addresses, sorted and deduplicated in place
+ */
+void SortUniqueMacAddresses(std::vector<MacAddress>& macs);
+
+#endif // MAC_ADDRESS_H
@@ -0,0 +1,382 @@
+#include "sha256.h"
+#include "cpu_features.h"
+#include <cstring>
+
+#if defined(HWID_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+static const uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const Sha256State kInitialState = {{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+}};
+
+static inline uint32_t LoadBigEndian32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static inline uint32_t RotateRight(uint32_t value, unsigned bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+/**
+ * @brief Compress consecutive blocks into a state
+ */
+using Sha256CompressFn = void (*)(uint32_t* state, const uint8_t* data, size_t blocks);
+
+/**
+ * @brief Compress one block into each of several states
+ */
+using Sha256CompressBatchFn = void (*)(Sha256State* states, const uint8_t* const* blocks, size_t count);
+
+static void Sha256CompressScalar(uint32_t* state, const uint8_t* data, size_t blocks) {
+    uint32_t w[64];
+    for (; blocks > 0; blocks--, data += kSha256BlockSize) {
+        for (int t = 0; t < 16; t++) {
+            w[t] = LoadBigEndian32(data + 4 * t);
+        }
+        for (int t = 16; t < 64; t++) {
+            uint32_t s0 = RotateRight(w[t - 15], 7) ^ RotateRight(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = RotateRight(w[t - 2], 17) ^ RotateRight(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int t = 0; t < 64; t++) {
+            uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + ch + kRoundConstants[t] + w[t];
+            uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + s0 + maj;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+static void Sha256CompressBatchScalar(Sha256State* states, const uint8_t* const* blocks, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        Sha256CompressScalar(states[i].h, blocks[i], 1);
+    }
+}
+
+#if defined(HWID_ARCH_X86)
+/**
+ * @brief SHA-NI state of one stream: ABEF and CDGH word pairs
+ */
+struct ShaNiLane {
+    __m128i abef;
+    __m128i cdgh;
+};
+
+HWID_TARGET("sha,sse4.1")
+static inline ShaNiLane ShaNiLoad(const uint32_t* state) {
+    __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+    __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+    __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+    __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+    return ShaNiLane{_mm_alignr_epi8(cdab, efgh, 8), _mm_blend_epi16(efgh, cdab, 0xF0)};
+}
+
+HWID_TARGET("sha,sse4.1")
+static inline void ShaNiStore(const ShaNiLane& lane, uint32_t* state) {
+    __m128i feba = _mm_shuffle_epi32(lane.abef, 0x1B);
+    __m128i dchg = _mm_shuffle_epi32(lane.cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+/**
+ * @brief Run the 64 rounds of one block on one or two streams
+ *
+ * Each group of four rounds is two dependent SHA256RNDS2 instructions;
+ * interleaving a second independent stream fills the latency gaps.
+ */
+template <int Lanes>
+HWID_TARGET("sha,sse4.1")
+static inline void ShaNiRounds(ShaNiLane* lanes, const uint8_t* const* blocks) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i msg[Lanes][4];
+    ShaNiLane saved[Lanes];
+    for (int l = 0; l < Lanes; l++) {
+        saved[l] = lanes[l];
+        for (int i = 0; i < 4; i++) {
+            msg[l][i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[l] + 16 * i)), byteSwap);
+        }
+    }
+    for (int group = 0; group < 16; group++) {
+        __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kRoundConstants + 4 * group));
+        for (int l = 0; l < Lanes; l++) {
+            if (group >= 4) {
+                // W[4g..4g+3] from the four previous message groups
+                __m128i& w = msg[l][group & 3];
+                __m128i w7 = _mm_alignr_epi8(msg[l][(group - 1) & 3], msg[l][(group - 2) & 3], 4);
+                w = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w, msg[l][(group - 3) & 3]), w7),
+                                         msg[l][(group - 1) & 3]);
+            }
+            __m128i wk = _mm_add_epi32(msg[l][group & 3], k);
+            lanes[l].cdgh = _mm_sha256rnds2_epu32(lanes[l].cdgh, lanes[l].abef, wk);
+            lanes[l].abef = _mm_sha256rnds2_epu32(lanes[l].abef, lanes[l].cdgh, _mm_shuffle_epi32(wk, 0x0E));
+        }
+    }
+    for (int l = 0; l < Lanes; l++) {
+        lanes[l].abef = _mm_add_epi32(lanes[l].abef, saved[l].abef);
+        lanes[l].cdgh = _mm_add_epi32(lanes[l].cdgh, saved[l].cdgh);
+    }
+}
+
+HWID_TARGET("sha,sse4.1")
+static void Sha256CompressShaNi(uint32_t* state, const uint8_t* data, size_t blocks) {
+    ShaNiLane lane = ShaNiLoad(state);
+    for (; blocks > 0; blocks--, data += kSha256BlockSize) {
+        ShaNiRounds<1>(&lane, &data);
+    }
+    ShaNiStore(lane, state);
+}
+
+HWID_TARGET("sha,sse4.1")
+static void Sha256CompressBatchShaNi(Sha256State* states, const uint8_t* const* blocks, size_t count) {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        ShaNiLane lanes[2] = {ShaNiLoad(states[i].h), ShaNiLoad(states[i + 1].h)};
+        ShaNiRounds<2>(lanes, blocks + i);
+        ShaNiStore(lanes[0], states[i].h);
+        ShaNiStore(lanes[1], states[i + 1].h);
+    }
+    if (i < count) {
+        Sha256CompressShaNi(states[i].h, blocks[i], 1);
+    }
+}
+
+HWID_TARGET("avx2")
+static inline __m256i Rotr8x32(__m256i value, int bits) {
+    return _mm256_or_si256(_mm256_srli_epi32(value, bits), _mm256_slli_epi32(value, 32 - bits));
+}
+
+/**
+ * @brief Compress one block in each of eight lanes, one lane per 32-bit element
+ */
+HWID_TARGET("avx2")
+static void Sha256Compress8Avx2(Sha256State* states, const uint8_t* const* blocks) {
+    __m256i v[8];
+    for (int j = 0; j < 8; j++) {
+        v[j] = _mm256_setr_epi32(static_cast<int>(states[0].h[j]), static_cast<int>(states[1].h[j]),
+                                 static_cast<int>(states[2].h[j]), static_cast<int>(states[3].h[j]),
+                                 static_cast<int>(states[4].h[j]), static_cast<int>(states[5].h[j]),
+                                 static_cast<int>(states[6].h[j]), static_cast<int>(states[7].h[j]));
+    }
+    __m256i w[16];
+    for (int t = 0; t < 16; t++) {
+        w[t] = _mm256_setr_epi32(static_cast<int>(LoadBigEndian32(blocks[0] + 4 * t)),
+                                 static_cast<int>(LoadBigEndian32(blocks[1] + 4 * t)),
+                                 static_cast<int>(LoadBigEndian32(blocks[2] + 4 * t)),
+                                 static_cast<int>(LoadBigEndian32(blocks[3] + 4 * t)),
+                                 static_cast<int>(LoadBigEndian32(blocks[4] + 4 * t)),
+                                 static_cast<int>(LoadBigEndian32(blocks[5] + 4 * t)),
+                                 static_cast<int>(LoadBigEndian32(blocks[6] + 4 * t)),
+                                 static_cast<int>(LoadBigEndian32(blocks[7] + 4 * t)));
+    }
+
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int t = 0; t < 64; t++) {
+        // The schedule is kept as a 16-entry ring
+        if (t >= 16) {
+            __m256i w15 = w[(t - 15) & 15];
+            __m256i w2 = w[(t - 2) & 15];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(Rotr8x32(w15, 7), Rotr8x32(w15, 18)), _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(Rotr8x32(w2, 17), Rotr8x32(w2, 19)), _mm256_srli_epi32(w2, 10));
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+        }
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(Rotr8x32(e, 6), Rotr8x32(e, 11)), Rotr8x32(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, s1),
+                                      _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(kRoundConstants[t])), w[t & 15])));
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(Rotr8x32(a, 2), Rotr8x32(a, 13)), Rotr8x32(a, 22));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(s0, maj));
+    }
+    v[0] = _mm256_add_epi32(v[0], a); v[1] = _mm256_add_epi32(v[1], b);
+    v[2] = _mm256_add_epi32(v[2], c); v[3] = _mm256_add_epi32(v[3], d);
+    v[4] = _mm256_add_epi32(v[4], e); v[5] = _mm256_add_epi32(v[5], f);
+    v[6] = _mm256_add_epi32(v[6], g); v[7] = _mm256_add_epi32(v[7], h);
+
+    alignas(32) uint32_t words[8];
+    for (int j = 0; j < 8; j++) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words), v[j]);
+        for (int l = 0; l < 8; l++) {
+            states[l].h[j] = words[l];
+        }
+    }
+}
+
+HWID_TARGET("avx2")
+static void Sha256CompressBatchAvx2(Sha256State* states, const uint8_t* const* blocks, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        Sha256Compress8Avx2(states + i, blocks + i);
+    }
+    for (; i < count; i++) {
+        Sha256CompressScalar(states[i].h, blocks[i], 1);
+    }
+}
+#endif
+
+/**
+ * @brief Select the single-stream SHA-256 kernel for the running CPU
+ */
+static Sha256CompressFn SelectSha256Compress() {
+#if defined(HWID_ARCH_X86)
+    const CpuFeatures& features = GetCpuFeatures();
+    if (features.sha && features.sse41) {
+        RecordKernelVariant("sha256.compress", "sha-ni");
+        return Sha256CompressShaNi;
+    }
+#endif
+    RecordKernelVariant("sha256.compress", "scalar");
+    return Sha256CompressScalar;
+}
+
+/**
+ * @brief Select the multi-buffer SHA-256 kernel for the running CPU
+ *
+ * Two interleaved SHA-NI streams outrun eight AVX2 lanes, so AVX2 is only
+ * used on CPUs without SHA-NI.
+ */
+static Sha256CompressBatchFn SelectSha256CompressBatch() {
+#if defined(HWID_ARCH_X86)
+    const CpuFeatures& features = GetCpuFeatures();
+    if (features.sha && features.sse41) {
+        RecordKernelVariant("sha256.compressBatch", "sha-ni-x2");
+        return Sha256CompressBatchShaNi;
+    }
+    if (features.avx2) {
+        RecordKernelVariant("sha256.compressBatch", "avx2-x8");
+        return Sha256CompressBatchAvx2;
+    }
+#endif
+    RecordKernelVariant("sha256.compressBatch", "scalar");
+    return Sha256CompressBatchScalar;
+}
+
+// Resolved while the module loads, before any hash
+static const Sha256CompressFn Sha256Compress = SelectSha256Compress();
+static const Sha256CompressBatchFn Sha256CompressBatchKernel = SelectSha256CompressBatch();
+
+/**
+ * @brief Constructor
+ */
+Sha256::Sha256() {
+    Reset();
+}
+
+/**
+ * @brief Start a new hash
+ */
+void Sha256::Reset() {
+    m_state = kInitialState;
+    m_length = 0;
+}
+
+/**
+ * @brief Hash more bytes
+ */
+void Sha256::Update(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t buffered = static_cast<size_t>(m_length % kSha256BlockSize);
+    m_length += size;
+    if (buffered > 0) {
+        size_t take = kSha256BlockSize - buffered < size ? kSha256BlockSize - buffered : size;
+        memcpy(m_buffer + buffered, bytes, take);
+        bytes += take;
+        size -= take;
+        if (buffered + take < kSha256BlockSize) {
+            return;
+        }
+        Sha256Compress(m_state.h, m_buffer, 1);
+    }
+    size_t blocks = size / kSha256BlockSize;
+    if (blocks > 0) {
+        Sha256Compress(m_state.h, bytes, blocks);
+        bytes += blocks * kSha256BlockSize;
+        size -= blocks * kSha256BlockSize;
+    }
+    memcpy(m_buffer, bytes, size);
+}
+
+/**
+ * @brief Finish the hash
+ */
+void Sha256::Final(uint8_t* digest) {
+    uint64_t bits = m_length * 8;
+    size_t buffered = static_cast<size_t>(m_length % kSha256BlockSize);
+    uint8_t padding[kSha256BlockSize * 2] = {0x80};
+    size_t padLength = (buffered < 56 ? 56 : 120) - buffered;
+    for (int i = 0; i < 8; i++) {
+        padding[padLength + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    }
+    Update(padding, padLength + 8);
+    Sha256StoreDigest(m_state, digest);
+}
+
+/**
+ * @brief Get the chaining state
+ */
+const Sha256State& Sha256::State() const {
+    return m_state;
+}
+
+/**
+ * @brief Hash a message in one call
+ */
+void Sha256Digest(const void* data, size_t size, uint8_t* digest) {
+    Sha256 hasher;
+    hasher.Update(data, size);
+    hasher.Final(digest);
+}
+
+/**
+ * @brief Compress one block into each of many independent states
+ */
+void Sha256CompressBatch(Sha256State* states, const uint8_t* const* blocks, size_t count) {
+    Sha256CompressBatchKernel(states, blocks, count);
+}
+
+/**
+ * @brief Write a chaining state as a big-endian digest
+ */
+void Sha256StoreDigest(const Sha256State& state, uint8_t* digest) {
+    for (int i = 0; i < 8; i++) {
+        digest[4 * i] = static_cast<uint8_t>(state.h[i] >> 24);
+        digest[4 * i + 1] = static_cast<uint8_t>(state.h[i] >> 16);
+        digest[4 * i + 2] = static_cast<uint8_t>(state.h[i] >> 8);
+        digest[4 * i + 3] = static_cast<uint8_t>(state.h[i]);
+    }
+}
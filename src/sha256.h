@@ -0,0 +1,83 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief SHA-256 block and digest sizes in bytes
+ */
+constexpr size_t kSha256BlockSize = 64;
+constexpr size_t kSha256DigestSize = 32;
+
+/**
+ * @brief SHA-256 chaining state
+ */
+struct Sha256State {
+    uint32_t h[8];
+};
+
+/**
+ * @brief Incremental SHA-256 hasher
+ *
+ * Blocks are compressed with SHA-NI when the running CPU has it (see
+ * cpu_features.h), otherwise with a portable implementation.
+ */
+class Sha256 {
+public:
+    Sha256();
+
+    /**
+     * @brief Hash more bytes
+     */
+    void Update(const void* data, size_t size);
+
+    /**
+     * @brief Finish the hash; the hasher must be reset before reuse
+     * @param digest Receives kSha256DigestSize bytes
+     */
+    void Final(uint8_t* digest);
+
+    /**
+     * @brief Start a new hash
+     */
+    void Reset();
+
+    /**
+     * @brief Get the chaining state; only meaningful on a block boundary
+     */
+    const Sha256State& State() const;
+
+private:
+    Sha256State m_state;
+    uint64_t m_length;                      // Bytes hashed so far
+    uint8_t m_buffer[kSha256BlockSize];     // Bytes of the incomplete block
+};
+
+/**
+ * @brief Hash a message in one call
+ * @param data Message bytes
+ * @param size Number of bytes
+ * @param digest Receives kSha256DigestSize bytes
+ */
+void Sha256Digest(const void* data, size_t size, uint8_t* digest);
+
+/**
+ * @brief Compress one block into each of many independent states
+ *
+ * Lanes are processed together: eight at a time with AVX2, or two
+ * interleaved SHA-NI streams that keep both round units busy, whichever
+ * the running CPU supports best.
+ *
+ * @param states Chaining states, updated in place
+ * @param blocks Pointer to the kSha256BlockSize-byte block of each lane
+ * @param count Number of lanes
+ */
+void Sha256CompressBatch(Sha256State* states, const uint8_t* const* blocks, size_t count);
+
+/**
+ * @brief Write a chaining state as a big-endian digest
+ */
+void Sha256StoreDigest(const Sha256State& state, uint8_t* digest);
+
+#endif // SHA256_H
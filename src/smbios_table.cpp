@@ -0,0 +1,54 @@
+#include "smbios_table.h"
+
+/**
+ * @brief Find a string field in a raw SMBIOS structure table
+ */
+std::string FindSmbiosString(const uint8_t* table, size_t size, uint8_t structureType, uint8_t fieldOffset) {
+    size_t offset = 0;
+
+    while (offset + 4 <= size) {
+        uint8_t type = table[offset];
+        uint8_t length = table[offset + 1];
+        if (length < 4 || offset + length > size) {
+            break;
+        }
+
+        // Unformatted string area follows the formatted area, ends with a double NUL
+        size_t stringsBegin = offset + length;
+        size_t stringsEnd = stringsBegin;
+        while (stringsEnd + 1 < size && !(table[stringsEnd] == 0 && table[stringsEnd + 1] == 0)) {
+            stringsEnd++;
+        }
+
+        if (type == structureType && fieldOffset < length) {
+            uint8_t index = table[offset + fieldOffset];
+            if (index == 0) {
+                return "";
+            }
+
+            // Strings are numbered from 1, each NUL terminated
+            size_t position = stringsBegin;
+            for (uint8_t i = 1; i < index && position < stringsEnd; i++) {
+                while (position < stringsEnd && table[position] != 0) {
+                    position++;
+                }
+                position++;
+            }
+            if (position >= stringsEnd) {
+                return "";
+            }
+
+            size_t end = position;
+            while (end < stringsEnd && table[end] != 0) {
+                end++;
+            }
+            return std::string(reinterpret_cast<const char*>(table + position), end - position);
+        }
+
+        if (type == 127) {
+            break;  // End-of-table structure
+        }
+        offset = stringsEnd + 2;
+    }
+    return "";
+}
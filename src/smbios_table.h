@@ -0,0 +1,36 @@
+#ifndef SMBIOS_TABLE_H
+#define SMBIOS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief SMBIOS structure types used for identifiers
+ */
+enum SmbiosStructureType : uint8_t {
+    kSmbiosSystemInformation = 1,     // Serial number at offset 0x07
+    kSmbiosBaseboardInformation = 2   // Serial number at offset 0x07
+};
+
+/**
+ * @brief Offset of the serial number string index in system and baseboard structures
+ */
+constexpr uint8_t kSmbiosSerialNumberOffset = 0x07;
+
+/**
+ * @brief Find a string field in a raw SMBIOS structure table
+ *
+ * Works on the table as exposed by /sys/firmware/dmi/tables/DMI or the
+ * SMBIOSTableData of GetSystemFirmwareTable('RSMB'). The string is returned
+ * exactly as stored, without trimming.
+ *
+ * @param table Start of the structure table
+ * @param size Table size in bytes
+ * @param structureType Type of the first structure to look in
+ * @param fieldOffset Offset of the string index byte in the structure
+ * @return String value, empty if not present
+ */
+std::string FindSmbiosString(const uint8_t* table, size_t size, uint8_t structureType, uint8_t fieldOffset);
+
+#endif // SMBIOS_TABLE_H
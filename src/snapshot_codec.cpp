@@ -0,0 +1,640 @@
+#include "snapshot_codec.h"
+#include "crc32c.h"
+#include <cstring>
+#include <utility>
+#include <string_view>
+
+// The presence bits are part of the wire format and the field readers and
+// writers below list each component, so adding one needs a new schema
+static_assert(kHardwareComponentCount == 5, "snapshot fields list 5 hardware components");
+static_assert(kSnapshotCpuId == ComponentBit(HardwareComponent::CpuId) &&
+              kSnapshotMotherboardSerial == ComponentBit(HardwareComponent::MotherboardSerial) &&
+              kSnapshotBiosSerial == ComponentBit(HardwareComponent::BiosSerial) &&
+              kSnapshotDiskSerials == ComponentBit(HardwareComponent::DiskSerials) &&
+              kSnapshotMacAddresses == ComponentBit(HardwareComponent::MacAddresses),
+              "component presence bits must match ComponentBit()");
+static_assert(kSnapshotFingerprint == 1u << kHardwareComponentCount &&
+              (kSnapshotKnownFields & kSnapshotStreamKeyframe) == 0,
+              "snapshot field bits overlap");
+
+/**
+ * @brief Maximum bytes of a 32-bit varint
+ */
+static constexpr size_t kMaxVarint32Bytes = 5;
+
+/**
+ * @brief Append an unsigned LEB128 varint
+ */
+static void AppendVarint(std::string& out, uint64_t value) {
+    char bytes[10];
+    size_t length = 0;
+    while (value >= 0x80) {
+        bytes[length++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    bytes[length++] = static_cast<char>(value);
+    out.append(bytes, length);
+}
+
+/**
+ * @brief Get the encoded size of a varint
+ */
+static size_t VarintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static void AppendString(std::string& out, const std::string& value) {
+    AppendVarint(out, value.size());
+    out.append(value);
+}
+
+static void AppendList(std::string& out, const std::vector<std::string>& values) {
+    AppendVarint(out, values.size());
+    for (const std::string& value : values) {
+        AppendString(out, value);
+    }
+}
+
+static size_t ListSize(const std::vector<std::string>& values) {
+    size_t size = VarintSize(values.size());
+    for (const std::string& value : values) {
+        size += VarintSize(value.size()) + value.size();
+    }
+    return size;
+}
+
+/**
+ * @brief Append the fields selected by a presence bitmap, in bit order
+ */
+static void AppendFields(std::string& out, const HardwareInfo& info, uint32_t fields) {
+    if (fields & kSnapshotCpuId) {
+        AppendString(out, info.cpuId);
+    }
+    if (fields & kSnapshotMotherboardSerial) {
+        AppendString(out, info.motherboardSerial);
+    }
+    if (fields & kSnapshotBiosSerial) {
+        AppendString(out, info.biosSerial);
+    }
+    if (fields & kSnapshotDiskSerials) {
+        AppendList(out, info.diskSerials);
+    }
+    if (fields & kSnapshotMacAddresses) {
+        AppendList(out, info.macAddresses);
+    }
+    if (fields & kSnapshotFingerprint) {
+        AppendString(out, info.fingerprint);
+    }
+    if (fields & kSnapshotTimedOutComponents) {
+        AppendVarint(out, info.timedOutComponents);
+    }
+}
+
+/**
+ * @brief Append the little-endian CRC-32C of the frame that starts at start
+ */
+static void AppendCrc(std::string& out, size_t start) {
+    uint32_t crc = Crc32c(out.data() + start, out.size() - start);
+    uint8_t crcBytes[4] = {
+        static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8),
+        static_cast<uint8_t>(crc >> 16), static_cast<uint8_t>(crc >> 24)
+    };
+    out.append(reinterpret_cast<const char*>(crcBytes), sizeof(crcBytes));
+}
+
+/**
+ * @brief Get the presence bitmap of a snapshot's non-empty fields
+ */
+static uint32_t PresentFields(const HardwareInfo& info) {
+    uint32_t presence = 0;
+    presence |= info.cpuId.empty() ? 0 : kSnapshotCpuId;
+    presence |= info.motherboardSerial.empty() ? 0 : kSnapshotMotherboardSerial;
+    presence |= info.biosSerial.empty() ? 0 : kSnapshotBiosSerial;
+    presence |= info.diskSerials.empty() ? 0 : kSnapshotDiskSerials;
+    presence |= info.macAddresses.empty() ? 0 : kSnapshotMacAddresses;
+    presence |= info.fingerprint.empty() ? 0 : kSnapshotFingerprint;
+    presence |= info.timedOutComponents == 0 ? 0 : kSnapshotTimedOutComponents;
+    return presence;
+}
+
+/**
+ * @brief Encode a snapshot in the compact binary wire format
+ */
+size_t EncodeSnapshot(const HardwareInfo& info, std::string& out) {
+    uint32_t presence = PresentFields(info);
+
+    // Reserve the exact frame size so encoding appends without reallocating
+    size_t size = VarintSize(kSnapshotSchemaId) + VarintSize(presence) + sizeof(uint32_t);
+    size += (presence & kSnapshotCpuId) ? VarintSize(info.cpuId.size()) + info.cpuId.size() : 0;
+    size += (presence & kSnapshotMotherboardSerial) ? VarintSize(info.motherboardSerial.size()) + info.motherboardSerial.size() : 0;
+    size += (presence & kSnapshotBiosSerial) ? VarintSize(info.biosSerial.size()) + info.biosSerial.size() : 0;
+    size += (presence & kSnapshotDiskSerials) ? ListSize(info.diskSerials) : 0;
+    size += (presence & kSnapshotMacAddresses) ? ListSize(info.macAddresses) : 0;
+    size += (presence & kSnapshotFingerprint) ? VarintSize(info.fingerprint.size()) + info.fingerprint.size() : 0;
+    size += (presence & kSnapshotTimedOutComponents) ? VarintSize(info.timedOutComponents) : 0;
+
+    size_t start = out.size();
+    out.reserve(start + size);
+    AppendVarint(out, kSnapshotSchemaId);
+    AppendVarint(out, presence);
+    AppendFields(out, info, presence);
+    AppendCrc(out, start);
+    return out.size() - start;
+}
+
+/**
+ * @brief Append a big-endian unsigned integer
+ */
+static void AppendBigEndian(std::string& out, uint64_t value, size_t bytes) {
+    for (size_t i = bytes; i-- > 0;) {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Writer for MessagePack and CBOR maps, arrays and strings
+ *
+ * Both formats encode a type and a length in a header whose size depends
+ * on the length; only the type codes differ.
+ */
+class SelfDescribingWriter {
+public:
+    SelfDescribingWriter(SnapshotFormat format, std::string& out)
+        : m_cbor(format == SnapshotFormat::Cbor)
+        , m_out(out) {
+    }
+
+    void Map(size_t count) {
+        if (m_cbor) {
+            CborHeader(5, count);
+        } else if (count < 16) {
+            m_out.push_back(static_cast<char>(0x80 | count));
+        } else {
+            MessagePackHeader(0xDE, 0xDF, count);
+        }
+    }
+
+    void Array(size_t count) {
+        if (m_cbor) {
+            CborHeader(4, count);
+        } else if (count < 16) {
+            m_out.push_back(static_cast<char>(0x90 | count));
+        } else {
+            MessagePackHeader(0xDC, 0xDD, count);
+        }
+    }
+
+    void String(std::string_view value) {
+        if (m_cbor) {
+            CborHeader(3, value.size());
+        } else if (value.size() < 32) {
+            m_out.push_back(static_cast<char>(0xA0 | value.size()));
+        } else if (value.size() <= UINT8_MAX) {
+            m_out.push_back(static_cast<char>(0xD9));
+            AppendBigEndian(m_out, value.size(), 1);
+        } else {
+            MessagePackHeader(0xDA, 0xDB, value.size());
+        }
+        m_out.append(value.data(), value.size());
+    }
+
+    void StringArray(const std::vector<std::string>& values) {
+        Array(values.size());
+        for (const std::string& value : values) {
+            String(value);
+        }
+    }
+
+private:
+    void CborHeader(uint8_t majorType, uint64_t value) {
+        uint8_t major = static_cast<uint8_t>(majorType << 5);
+        if (value < 24) {
+            m_out.push_back(static_cast<char>(major | value));
+        } else if (value <= UINT8_MAX) {
+            m_out.push_back(static_cast<char>(major | 24));
+            AppendBigEndian(m_out, value, 1);
+        } else if (value <= UINT16_MAX) {
+            m_out.push_back(static_cast<char>(major | 25));
+            AppendBigEndian(m_out, value, 2);
+        } else if (value <= UINT32_MAX) {
+            m_out.push_back(static_cast<char>(major | 26));
+            AppendBigEndian(m_out, value, 4);
+        } else {
+            m_out.push_back(static_cast<char>(major | 27));
+            AppendBigEndian(m_out, value, 8);
+        }
+    }
+
+    void MessagePackHeader(uint8_t code16, uint8_t code32, size_t count) {
+        if (count <= UINT16_MAX) {
+            m_out.push_back(static_cast<char>(code16));
+            AppendBigEndian(m_out, count, 2);
+        } else {
+            m_out.push_back(static_cast<char>(code32));
+            AppendBigEndian(m_out, count, 4);
+        }
+    }
+
+    bool m_cbor;
+    std::string& m_out;
+};
+
+/**
+ * @brief Encode a snapshot in a self-describing or wire format
+ */
+size_t EncodeSnapshotAs(const HardwareInfo& info, SnapshotFormat format, std::string& out) {
+    if (format == SnapshotFormat::Binary) {
+        return EncodeSnapshot(info, out);
+    }
+
+    size_t start = out.size();
+    SelfDescribingWriter writer(format, out);
+    writer.Map(7);
+    writer.String("cpuId");
+    writer.String(info.cpuId);
+    writer.String("motherboardSerial");
+    writer.String(info.motherboardSerial);
+    writer.String("biosSerial");
+    writer.String(info.biosSerial);
+    writer.String("diskSerials");
+    writer.StringArray(info.diskSerials);
+    writer.String("macAddresses");
+    writer.StringArray(info.macAddresses);
+    writer.String("fingerprint");
+    writer.String(info.fingerprint);
+
+    writer.String("timedOut");
+    uint32_t timedOutCount = 0;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        timedOutCount += (info.timedOutComponents & ComponentBit(static_cast<HardwareComponent>(i))) ? 1 : 0;
+    }
+    writer.Array(timedOutCount);
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        if (info.timedOutComponents & ComponentBit(component)) {
+            writer.String(ComponentName(component));
+        }
+    }
+    return out.size() - start;
+}
+
+/**
+ * @brief Bounds-checked reader over an encoded frame
+ */
+class FrameReader {
+public:
+    FrameReader(const uint8_t* data, size_t size)
+        : m_data(data)
+        , m_position(0)
+        , m_size(size)
+        , m_status(SnapshotDecodeStatus::Ok) {
+    }
+
+    /**
+     * @brief Read a varint of at most 32 bits
+     */
+    uint32_t ReadVarint32() {
+        // Single-byte fast path: lengths and counts are almost always < 128
+        if (m_position < m_size && m_data[m_position] < 0x80) {
+            return m_data[m_position++];
+        }
+        uint32_t value = 0;
+        for (size_t i = 0; i < kMaxVarint32Bytes; i++) {
+            if (m_position >= m_size) {
+                Fail(SnapshotDecodeStatus::Truncated);
+                return 0;
+            }
+            uint8_t byte = m_data[m_position++];
+            if (i == kMaxVarint32Bytes - 1 && byte > 0x0F) {
+                break;
+            }
+            value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        Fail(SnapshotDecodeStatus::Malformed);
+        return 0;
+    }
+
+    /**
+     * @brief Read a length-prefixed string, reusing the target's capacity
+     */
+    void ReadString(std::string& value) {
+        uint32_t length = ReadVarint32();
+        if (!Ok()) {
+            return;
+        }
+        if (length > m_size - m_position) {
+            Fail(SnapshotDecodeStatus::Truncated);
+            return;
+        }
+        value.assign(reinterpret_cast<const char*>(m_data + m_position), length);
+        m_position += length;
+    }
+
+    /**
+     * @brief Read a counted list of strings, reusing element capacity
+     */
+    void ReadList(std::vector<std::string>& values) {
+        uint32_t count = ReadVarint32();
+        // Every entry takes at least one byte, which bounds the count
+        if (Ok() && count > m_size - m_position) {
+            Fail(SnapshotDecodeStatus::Truncated);
+        }
+        if (!Ok()) {
+            return;
+        }
+        values.resize(count);
+        for (uint32_t i = 0; i < count && Ok(); i++) {
+            ReadString(values[i]);
+        }
+    }
+
+    bool Ok() const {
+        return m_status == SnapshotDecodeStatus::Ok;
+    }
+
+    void Fail(SnapshotDecodeStatus status) {
+        if (Ok()) {
+            m_status = status;
+        }
+    }
+
+    SnapshotDecodeStatus Status() const {
+        return m_status;
+    }
+
+    size_t Position() const {
+        return m_position;
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_position;
+    size_t m_size;
+    SnapshotDecodeStatus m_status;
+};
+
+/**
+ * @brief Read the fields selected by a presence bitmap
+ * @param reader Reader positioned at the first field
+ * @param info Receives the fields
+ * @param fields Presence bitmap
+ * @param clearAbsent Clear the fields that are not in the bitmap
+ */
+static void ReadFields(FrameReader& reader, HardwareInfo& info, uint32_t fields, bool clearAbsent) {
+    if (fields & kSnapshotCpuId) {
+        reader.ReadString(info.cpuId);
+    } else if (clearAbsent) {
+        info.cpuId.clear();
+    }
+    if (fields & kSnapshotMotherboardSerial) {
+        reader.ReadString(info.motherboardSerial);
+    } else if (clearAbsent) {
+        info.motherboardSerial.clear();
+    }
+    if (fields & kSnapshotBiosSerial) {
+        reader.ReadString(info.biosSerial);
+    } else if (clearAbsent) {
+        info.biosSerial.clear();
+    }
+    if (fields & kSnapshotDiskSerials) {
+        reader.ReadList(info.diskSerials);
+    } else if (clearAbsent) {
+        info.diskSerials.clear();
+    }
+    if (fields & kSnapshotMacAddresses) {
+        reader.ReadList(info.macAddresses);
+    } else if (clearAbsent) {
+        info.macAddresses.clear();
+    }
+    if (fields & kSnapshotFingerprint) {
+        reader.ReadString(info.fingerprint);
+    } else if (clearAbsent) {
+        info.fingerprint.clear();
+    }
+    if (fields & kSnapshotTimedOutComponents) {
+        info.timedOutComponents = reader.ReadVarint32();
+    } else if (clearAbsent) {
+        info.timedOutComponents = 0;
+    }
+}
+
+/**
+ * @brief Verify the CRC-32C that follows a frame body
+ * @param data Frame bytes
+ * @param size Number of bytes available
+ * @param body Length of the frame before its CRC
+ * @param consumed Receives the frame length on success (optional)
+ */
+static SnapshotDecodeStatus CheckCrc(const uint8_t* data, size_t size, size_t body, size_t* consumed) {
+    if (size - body < sizeof(uint32_t)) {
+        return SnapshotDecodeStatus::Truncated;
+    }
+    const uint8_t* crcBytes = data + body;
+    uint32_t expected = static_cast<uint32_t>(crcBytes[0]) | (static_cast<uint32_t>(crcBytes[1]) << 8) |
+                        (static_cast<uint32_t>(crcBytes[2]) << 16) | (static_cast<uint32_t>(crcBytes[3]) << 24);
+    if (Crc32c(data, body) != expected) {
+        return SnapshotDecodeStatus::ChecksumMismatch;
+    }
+    if (consumed) {
+        *consumed = body + sizeof(uint32_t);
+    }
+    return SnapshotDecodeStatus::Ok;
+}
+
+/**
+ * @brief Decode one snapshot frame
+ */
+SnapshotDecodeStatus DecodeSnapshot(const uint8_t* data, size_t size, HardwareInfo& info, size_t* consumed) {
+    FrameReader reader(data, size);
+    uint32_t schema = reader.ReadVarint32();
+    if (reader.Ok() && schema != kSnapshotSchemaId) {
+        return SnapshotDecodeStatus::UnknownSchema;
+    }
+    uint32_t presence = reader.ReadVarint32();
+    if (reader.Ok() && (presence & ~kSnapshotKnownFields)) {
+        reader.Fail(SnapshotDecodeStatus::Malformed);
+    }
+
+    ReadFields(reader, info, presence, true);
+
+    if (!reader.Ok()) {
+        return reader.Status();
+    }
+    return CheckCrc(data, size, reader.Position(), consumed);
+}
+
+/**
+ * @brief Get the bitmap of fields that differ between two snapshots
+ */
+static uint32_t ChangedFields(const HardwareInfo& before, const HardwareInfo& after) {
+    uint32_t changed = 0;
+    changed |= before.cpuId == after.cpuId ? 0 : kSnapshotCpuId;
+    changed |= before.motherboardSerial == after.motherboardSerial ? 0 : kSnapshotMotherboardSerial;
+    changed |= before.biosSerial == after.biosSerial ? 0 : kSnapshotBiosSerial;
+    changed |= before.diskSerials == after.diskSerials ? 0 : kSnapshotDiskSerials;
+    changed |= before.macAddresses == after.macAddresses ? 0 : kSnapshotMacAddresses;
+    changed |= before.fingerprint == after.fingerprint ? 0 : kSnapshotFingerprint;
+    changed |= before.timedOutComponents == after.timedOutComponents ? 0 : kSnapshotTimedOutComponents;
+    return changed;
+}
+
+/**
+ * @brief Constructor
+ */
+SnapshotStreamEncoder::SnapshotStreamEncoder(uint32_t keyframeInterval)
+    : m_sequence(0)
+    , m_keyframeInterval(keyframeInterval)
+    , m_framesSinceKeyframe(0)
+    , m_keyframePending(true) {
+}
+
+/**
+ * @brief Encode the next frame of the stream
+ */
+size_t SnapshotStreamEncoder::Encode(const HardwareInfo& info, std::string& out) {
+    bool keyframe = m_keyframePending ||
+                    (m_keyframeInterval != 0 && m_framesSinceKeyframe >= m_keyframeInterval);
+    uint32_t fields = keyframe ? (PresentFields(info) | kSnapshotStreamKeyframe) : ChangedFields(m_previous, info);
+
+    size_t start = out.size();
+    AppendVarint(out, kSnapshotStreamSchemaId);
+    AppendVarint(out, ++m_sequence);
+    AppendVarint(out, fields);
+    AppendFields(out, info, fields);
+    AppendCrc(out, start);
+
+    if (keyframe) {
+        m_previous = info;
+        m_framesSinceKeyframe = 1;
+        m_keyframePending = false;
+    } else {
+        if (fields != 0) {
+            m_previous = info;
+        }
+        m_framesSinceKeyframe++;
+    }
+    return out.size() - start;
+}
+
+/**
+ * @brief Make the next frame a keyframe
+ */
+void SnapshotStreamEncoder::RequestKeyframe() {
+    m_keyframePending = true;
+}
+
+/**
+ * @brief Set the number of frames between keyframes
+ */
+void SnapshotStreamEncoder::SetKeyframeInterval(uint32_t keyframeInterval) {
+    m_keyframeInterval = keyframeInterval;
+}
+
+/**
+ * @brief Get the sequence number of the last encoded frame
+ */
+uint32_t SnapshotStreamEncoder::Sequence() const {
+    return m_sequence;
+}
+
+/**
+ * @brief Constructor
+ */
+SnapshotStreamDecoder::SnapshotStreamDecoder()
+    : m_sequence(0)
+    , m_lastFields(0)
+    , m_hasState(false) {
+}
+
+/**
+ * @brief Decode one stream frame
+ */
+SnapshotDecodeStatus SnapshotStreamDecoder::Decode(const uint8_t* data, size_t size, size_t* consumed) {
+    FrameReader reader(data, size);
+    uint32_t schema = reader.ReadVarint32();
+    if (reader.Ok() && schema != kSnapshotStreamSchemaId) {
+        return SnapshotDecodeStatus::UnknownSchema;
+    }
+    uint32_t sequence = reader.ReadVarint32();
+    uint32_t fields = reader.ReadVarint32();
+    if (reader.Ok() && (fields & ~(kSnapshotKnownFields | kSnapshotStreamKeyframe))) {
+        reader.Fail(SnapshotDecodeStatus::Malformed);
+    }
+    if (!reader.Ok()) {
+        return reader.Status();
+    }
+
+    // Deltas are read over a copy of the state; assignment reuses capacity
+    bool keyframe = (fields & kSnapshotStreamKeyframe) != 0;
+    if (!keyframe) {
+        m_scratch = m_state;
+    }
+    ReadFields(reader, m_scratch, fields, keyframe);
+    if (!reader.Ok()) {
+        return reader.Status();
+    }
+    SnapshotDecodeStatus status = CheckCrc(data, size, reader.Position(), consumed);
+    if (status != SnapshotDecodeStatus::Ok) {
+        return status;
+    }
+    if (!keyframe && (!m_hasState || sequence != m_sequence + 1)) {
+        return SnapshotDecodeStatus::OutOfSequence;
+    }
+
+    std::swap(m_state, m_scratch);
+    m_sequence = sequence;
+    m_lastFields = fields;
+    m_hasState = true;
+    return SnapshotDecodeStatus::Ok;
+}
+
+/**
+ * @brief Check whether a keyframe has been decoded
+ */
+bool SnapshotStreamDecoder::HasState() const {
+    return m_hasState;
+}
+
+/**
+ * @brief Get the reconstructed snapshot
+ */
+const HardwareInfo& SnapshotStreamDecoder::State() const {
+    return m_state;
+}
+
+/**
+ * @brief Get the sequence number of the last decoded frame
+ */
+uint32_t SnapshotStreamDecoder::Sequence() const {
+    return m_sequence;
+}
+
+/**
+ * @brief Get the field bitmap of the last decoded frame
+ */
+uint32_t SnapshotStreamDecoder::LastFields() const {
+    return m_lastFields;
+}
+
+/**
+ * @brief Get a short description of a decode status
+ */
+const char* SnapshotDecodeStatusName(SnapshotDecodeStatus status) {
+    switch (status) {
+        case SnapshotDecodeStatus::Ok:               return "ok";
+        case SnapshotDecodeStatus::Truncated:        return "truncated";
+        case SnapshotDecodeStatus::UnknownSchema:    return "unknown schema";
+        case SnapshotDecodeStatus::Malformed:        return "malformed";
+        case SnapshotDecodeStatus::ChecksumMismatch: return "checksum mismatch";
+        case SnapshotDecodeStatus::OutOfSequence:    return "out of sequence";
+        default:                                     return "unknown";
+    }
+}
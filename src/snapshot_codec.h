@@ -0,0 +1,209 @@
+#ifndef SNAPSHOT_CODEC_H
+#define SNAPSHOT_CODEC_H
+
+#include "hardware_info.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Schema identifier written at the start of every encoded snapshot
+ */
+constexpr uint32_t kSnapshotSchemaId = 1;
+
+/**
+ * @brief Presence bits of the encoded snapshot fields, in encoding order
+ */
+constexpr uint32_t kSnapshotCpuId = 1u << 0;
+constexpr uint32_t kSnapshotMotherboardSerial = 1u << 1;
+constexpr uint32_t kSnapshotBiosSerial = 1u << 2;
+constexpr uint32_t kSnapshotDiskSerials = 1u << 3;
+constexpr uint32_t kSnapshotMacAddresses = 1u << 4;
+constexpr uint32_t kSnapshotFingerprint = 1u << 5;
+constexpr uint32_t kSnapshotTimedOutComponents = 1u << 6;
+constexpr uint32_t kSnapshotKnownFields = (1u << 7) - 1;
+
+/**
+ * @brief Schema identifier of snapshot stream (keyframe and delta) frames
+ */
+constexpr uint32_t kSnapshotStreamSchemaId = 2;
+
+/**
+ * @brief Field bitmap flag marking a stream keyframe
+ */
+constexpr uint32_t kSnapshotStreamKeyframe = 1u << 7;
+
+/**
+ * @brief Result of decoding an encoded snapshot
+ */
+enum class SnapshotDecodeStatus {
+    Ok,
+    Truncated,          // Input ends inside the frame
+    UnknownSchema,      // Schema identifier this build cannot decode
+    Malformed,          // Bad varint, length or unknown presence bit
+    ChecksumMismatch,   // Trailing CRC-32C does not match
+    OutOfSequence       // Stream delta that does not follow the last decoded frame
+};
+
+/**
+ * @brief Encode a snapshot in the compact binary wire format
+ *
+ * Frame layout: schema id (varint), presence bitmap (varint), then each
+ * present field in bit order as a varint length and bytes (lists as a
+ * varint count followed by entries, timed-out components as a varint),
+ * and a little-endian CRC-32C of everything before it. A field is present
+ * exactly when it is non-empty, so equal snapshots encode to identical
+ * bytes and can be compared with memcmp.
+ *
+ * @param info Snapshot to encode
+ * @param out Receives the frame, appended to existing contents
+ * @return Number of bytes appended
+ */
+size_t EncodeSnapshot(const HardwareInfo& info, std::string& out);
+
+/**
+ * @brief Output formats of EncodeSnapshotAs
+ */
+enum class SnapshotFormat {
+    Binary,         // Wire format of EncodeSnapshot
+    MessagePack,
+    Cbor
+};
+
+/**
+ * @brief Encode a snapshot in a self-describing or wire format
+ *
+ * MessagePack and CBOR output is a map in the getAllHardwareInfo() shape
+ * (cpuId, motherboardSerial, biosSerial, diskSerials, macAddresses,
+ * fingerprint and timedOut as an array of component names), written
+ * straight from the native values.
+ *
+ * @param info Snapshot to encode
+ * @param format Output format
+ * @param out Receives the encoding, appended to existing contents
+ * @return Number of bytes appended
+ */
+size_t EncodeSnapshotAs(const HardwareInfo& info, SnapshotFormat format, std::string& out);
+
+/**
+ * @brief Decode one snapshot frame
+ *
+ * Frames can be concatenated; use consumed to find the next one. String
+ * capacity in info is reused, so decoding a stream into one HardwareInfo
+ * does not allocate once the strings have grown.
+ *
+ * @param data Encoded bytes
+ * @param size Number of bytes available
+ * @param info Receives the decoded snapshot
+ * @param consumed Receives the frame length on success (optional)
+ * @return Decode status
+ */
+SnapshotDecodeStatus DecodeSnapshot(const uint8_t* data, size_t size, HardwareInfo& info, size_t* consumed = nullptr);
+
+/**
+ * @brief Encoder of a delta-compressed snapshot stream for one device
+ *
+ * Frame layout: stream schema id (varint), sequence number (varint), field
+ * bitmap (varint), the fields named by the bitmap as in EncodeSnapshot,
+ * and a CRC-32C. A keyframe sets kSnapshotStreamKeyframe and carries every
+ * non-empty field; a delta carries only the fields that changed since the
+ * previous frame, so a heartbeat with no changes is the header and CRC
+ * alone (7 bytes while the sequence number is below 128, at most 11).
+ */
+class SnapshotStreamEncoder {
+public:
+    /**
+     * @brief Constructor
+     * @param keyframeInterval Frames between keyframes, 0 for keyframes only on request
+     */
+    explicit SnapshotStreamEncoder(uint32_t keyframeInterval = 60);
+
+    /**
+     * @brief Encode the next frame of the stream
+     * @param info Current snapshot
+     * @param out Receives the frame, appended to existing contents
+     * @return Number of bytes appended
+     */
+    size_t Encode(const HardwareInfo& info, std::string& out);
+
+    /**
+     * @brief Make the next frame a keyframe, e.g. after a receiver lost frames
+     */
+    void RequestKeyframe();
+
+    /**
+     * @brief Set the number of frames between keyframes
+     */
+    void SetKeyframeInterval(uint32_t keyframeInterval);
+
+    /**
+     * @brief Get the sequence number of the last encoded frame
+     */
+    uint32_t Sequence() const;
+
+private:
+    HardwareInfo m_previous;
+    uint32_t m_sequence;
+    uint32_t m_keyframeInterval;
+    uint32_t m_framesSinceKeyframe;
+    bool m_keyframePending;
+};
+
+/**
+ * @brief Decoder reconstructing one device's snapshots from its stream
+ *
+ * A keyframe replaces the state; a delta applies only when its sequence
+ * number follows the last decoded frame. Frames that fail to decode leave
+ * the state unchanged.
+ */
+class SnapshotStreamDecoder {
+public:
+    SnapshotStreamDecoder();
+
+    /**
+     * @brief Decode one stream frame
+     * @param data Encoded bytes
+     * @param size Number of bytes available
+     * @param consumed Receives the frame length when the frame is intact,
+     *                 including OutOfSequence (optional)
+     * @return Decode status; OutOfSequence means a keyframe is needed
+     */
+    SnapshotDecodeStatus Decode(const uint8_t* data, size_t size, size_t* consumed = nullptr);
+
+    /**
+     * @brief Check whether a keyframe has been decoded
+     */
+    bool HasState() const;
+
+    /**
+     * @brief Get the reconstructed snapshot
+     */
+    const HardwareInfo& State() const;
+
+    /**
+     * @brief Get the sequence number of the last decoded frame
+     */
+    uint32_t Sequence() const;
+
+    /**
+     * @brief Get the field bitmap of the last decoded frame
+     *
+     * Includes kSnapshotStreamKeyframe for keyframes; for deltas it lists
+     * the changed fields.
+     */
+    uint32_t LastFields() const;
+
+private:
+    HardwareInfo m_state;
+    HardwareInfo m_scratch;     // Decode target, swapped in once the frame checks out
+    uint32_t m_sequence;
+    uint32_t m_lastFields;
+    bool m_hasState;
+};
+
+/**
+ * @brief Get a short description of a decode status
+ */
+const char* SnapshotDecodeStatusName(SnapshotDecodeStatus status);
+
+#endif // SNAPSHOT_CODEC_H
@@ -0,0 +1,216 @@
+#include "snapshot_refresher.h"
+#include <string_view>
+
+/**
+ * @brief Constructor
+ */
+SnapshotRefresher::SnapshotRefresher()
+    : m_diskSerialTail()
+    , m_macAddressTail()
+    , m_hasSnapshot(false)
+    , m_stats() {
+    ClearSnapshot(m_snapshot);
+    // Serials are short; size the fingerprint input once up front
+    m_fingerprintInput.reserve(256);
+}
+
+/**
+ * @brief Compare a stored field with a collected value
+ */
+static bool FieldEquals(const SnapshotField& field, const SnapshotArena& arena, const std::string& value) {
+    return GetSnapshotField(field, arena) == std::string_view(value);
+}
+
+/**
+ * @brief Compare the inline entries of a stored list with collected values
+ *
+ * Entries beyond the inline capacity are compared through their ListTail.
+ */
+static bool ListEquals(const SnapshotField* fields, uint32_t count, size_t capacity,
+                       const SnapshotArena& arena, const std::vector<std::string>& values) {
+    size_t stored = values.size() < capacity ? values.size() : capacity;
+    if (count != stored) {
+        return false;
+    }
+    for (size_t i = 0; i < stored; i++) {
+        if (!FieldEquals(fields[i], arena, values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Summarize the entries of a list that the snapshot does not store
+ */
+SnapshotRefresher::ListTail SnapshotRefresher::TailOf(const ComponentList& values, size_t capacity) {
+    ListTail tail = {};
+    tail.hash = 14695981039346656037ULL;
+    for (size_t i = capacity; i < values.size(); i++) {
+        // Length first, so entries cannot shift across boundaries
+        uint64_t length = values[i].size();
+        for (size_t b = 0; b < sizeof(length); b++) {
+            tail.hash ^= (length >> (8 * b)) & 0xFF;
+            tail.hash *= 1099511628211ULL;
+        }
+        for (unsigned char byte : values[i]) {
+            tail.hash ^= byte;
+            tail.hash *= 1099511628211ULL;
+        }
+        tail.count++;
+    }
+    return tail;
+}
+
+/**
+ * @brief Get the storage held by one collected value
+ *
+ * Collectors copy into the existing buffers, which never shrink, so a
+ * larger total after collection means a buffer was allocated or grown.
+ */
+static size_t ValueCapacity(const ComponentScalar& value) {
+    return value.capacity();
+}
+
+static size_t ValueCapacity(const ComponentList& values) {
+    size_t capacity = values.capacity();
+    for (const std::string& value : values) {
+        capacity += value.capacity();
+    }
+    return capacity;
+}
+
+/**
+ * @brief Compare a collected component with the stored snapshot
+ */
+bool SnapshotRefresher::ComponentChanged(HardwareComponent component) const {
+    static_assert(kHardwareComponentCount == 5, "every component needs a case below");
+    switch (component) {
+        case HardwareComponent::CpuId:
+            return !FieldEquals(m_snapshot.cpuId, m_arena, m_collected.cpuId);
+        case HardwareComponent::MotherboardSerial:
+            return !FieldEquals(m_snapshot.motherboardSerial, m_arena, m_collected.motherboardSerial);
+        case HardwareComponent::BiosSerial:
+            return !FieldEquals(m_snapshot.biosSerial, m_arena, m_collected.biosSerial);
+        case HardwareComponent::DiskSerials:
+            return !ListEquals(m_snapshot.diskSerials, m_snapshot.diskSerialCount,
+                               HardwareSnapshot::kMaxDiskSerials, m_arena, m_collected.diskSerials) ||
+                   !(TailOf(m_collected.diskSerials, HardwareSnapshot::kMaxDiskSerials) == m_diskSerialTail);
+        case HardwareComponent::MacAddresses:
+            return !ListEquals(m_snapshot.macAddresses, m_snapshot.macAddressCount,
+                               HardwareSnapshot::kMaxMacAddresses, m_arena, m_collected.macAddresses) ||
+                   !(TailOf(m_collected.macAddresses, HardwareSnapshot::kMaxMacAddresses) == m_macAddressTail);
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Compute the fingerprint of the collected values into m_fingerprint
+ *
+ * Shares the input layout and hash with ComputeFingerprint(), reusing
+ * m_fingerprintInput so a refresh does not allocate.
+ */
+size_t SnapshotRefresher::ComputeFingerprint(uint32_t requiredComponents) {
+    if (m_collected.timedOutComponents & requiredComponents) {
+        return 0;
+    }
+
+    BuildFingerprintInput(m_collected, m_fingerprintInput);
+    return FormatFingerprint(m_fingerprintInput, m_fingerprint);
+}
+
+/**
+ * @brief Collect every component and update the snapshot if anything changed
+ */
+RefreshResult SnapshotRefresher::Refresh(const Collector& collect, uint32_t requiredComponents) {
+    RefreshResult result = {};
+    size_t inputCapacity = m_fingerprintInput.capacity();
+    size_t arenaCapacity = m_arena.Capacity();
+    size_t fingerprintCapacity = m_collected.fingerprint.capacity();
+
+    m_collected.timedOutComponents = 0;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        HardwareComponent component = static_cast<HardwareComponent>(i);
+        size_t valueCapacity = 0;
+        VisitComponent(component, m_collected, [&](const auto& value) { valueCapacity = ValueCapacity(value); });
+        bool collected = collect(component, m_collected);
+        VisitComponent(component, m_collected, [&](const auto& value) {
+            if (ValueCapacity(value) > valueCapacity) {
+                result.allocations++;
+            }
+        });
+        if (!collected) {
+            m_collected.timedOutComponents |= ComponentBit(component);
+            continue;
+        }
+        if (!m_hasSnapshot || ComponentChanged(component)) {
+            result.changedComponents |= ComponentBit(component);
+        }
+    }
+
+    size_t fingerprintLength = ComputeFingerprint(requiredComponents);
+    std::string_view fingerprint(m_fingerprint, fingerprintLength);
+    result.fingerprintChanged = !m_hasSnapshot ||
+                                GetSnapshotField(m_snapshot.fingerprint, m_arena) != fingerprint;
+
+    if (result.changedComponents || result.fingerprintChanged ||
+        m_snapshot.timedOutComponents != m_collected.timedOutComponents) {
+        // A component that timed out was not touched by the collector, so
+        // m_collected still holds its previous value
+        m_collected.fingerprint.assign(fingerprint.data(), fingerprint.size());
+
+        // Values come from m_collected, so the arena can be rebuilt in place
+        m_arena.Clear();
+        SnapshotFromHardwareInfo(m_collected, m_snapshot, m_arena);
+        m_diskSerialTail = TailOf(m_collected.diskSerials, HardwareSnapshot::kMaxDiskSerials);
+        m_macAddressTail = TailOf(m_collected.macAddresses, HardwareSnapshot::kMaxMacAddresses);
+        m_hasSnapshot = true;
+    } else {
+        m_stats.unchangedRefreshes++;
+    }
+
+    if (m_fingerprintInput.capacity() != inputCapacity) {
+        result.allocations++;
+    }
+    if (m_arena.Capacity() != arenaCapacity) {
+        result.allocations++;
+    }
+    if (m_collected.fingerprint.capacity() != fingerprintCapacity) {
+        result.allocations++;
+    }
+    m_stats.refreshes++;
+    m_stats.allocations += result.allocations;
+    return result;
+}
+
+bool SnapshotRefresher::HasSnapshot() const {
+    return m_hasSnapshot;
+}
+
+const HardwareSnapshot& SnapshotRefresher::Snapshot() const {
+    return m_snapshot;
+}
+
+const SnapshotArena& SnapshotRefresher::Arena() const {
+    return m_arena;
+}
+
+const HardwareInfo& SnapshotRefresher::Current() const {
+    return m_collected;
+}
+
+RefreshStats SnapshotRefresher::GetStats() const {
+    return m_stats;
+}
+
+/**
+ * @brief Forget the current snapshot
+ */
+void SnapshotRefresher::Reset() {
+    ClearSnapshot(m_snapshot);
+    m_arena.Clear();
+    m_diskSerialTail = ListTail();
+    m_macAddressTail = ListTail();
+    m_hasSnapshot = false;
+}
@@ -0,0 +1,132 @@
+#ifndef SNAPSHOT_REFRESHER_H
+#define SNAPSHOT_REFRESHER_H
+
+#include "hardware_info.h"
+#include "hardware_snapshot.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Outcome of one refresh
+ */
+struct RefreshResult {
+    uint32_t changedComponents;     // ComponentBit mask of components whose value changed
+    bool fingerprintChanged;
+    uint32_t allocations;           // Buffer allocations made by the refresh path
+};
+
+/**
+ * @brief Cumulative refresh counters
+ */
+struct RefreshStats {
+    uint64_t refreshes;
+    uint64_t unchangedRefreshes;
+    uint64_t allocations;
+};
+
+/**
+ * @brief Steady-state refresh of a fixed-layout snapshot
+ *
+ * Keeps the current values in a HardwareSnapshot and compares freshly
+ * collected values against it in place. The snapshot is only rewritten
+ * when a value changed, and the fingerprint is recomputed into a reused
+ * scratch buffer, so a refresh in which nothing changed performs no
+ * allocation in the refresh path. Allocations inside the platform query
+ * layer (WMI, file reads) are outside this path and not counted.
+ */
+class SnapshotRefresher {
+public:
+    /**
+     * @brief Component collector
+     *
+     * Stores the component value in the given snapshot and returns false if
+     * the component timed out. The value should be copied into the existing
+     * field (see AssignComponentValue()) so its buffers are reused; a buffer
+     * that has to grow is counted as an allocation.
+     */
+    using Collector = std::function<bool(HardwareComponent, HardwareInfo&)>;
+
+    SnapshotRefresher();
+
+    /**
+     * @brief Collect every component and update the snapshot if anything changed
+     * @param collect Component collector
+     * @param requiredComponents Fingerprint profile (see CollectionOptions)
+     * @return Changed components and allocation count
+     */
+    RefreshResult Refresh(const Collector& collect, uint32_t requiredComponents = kAllHardwareComponents);
+
+    /**
+     * @brief Check whether a snapshot has been collected
+     */
+    bool HasSnapshot() const;
+
+    /**
+     * @brief Get the current snapshot
+     */
+    const HardwareSnapshot& Snapshot() const;
+
+    /**
+     * @brief Get the overflow storage of the current snapshot
+     */
+    const SnapshotArena& Arena() const;
+
+    /**
+     * @brief Get the current values in full
+     *
+     * Unlike Snapshot(), lists are not capped at the inline capacity.
+     */
+    const HardwareInfo& Current() const;
+
+    /**
+     * @brief Get cumulative refresh counters
+     */
+    RefreshStats GetStats() const;
+
+    /**
+     * @brief Forget the current snapshot; the next refresh reports every component as changed
+     */
+    void Reset();
+
+private:
+    /**
+     * @brief List entries beyond the inline capacity of the snapshot
+     */
+    struct ListTail {
+        size_t count;
+        uint64_t hash;      // FNV-1a over the entries and their lengths
+
+        bool operator==(const ListTail& other) const {
+            return count == other.count && hash == other.hash;
+        }
+    };
+
+    /**
+     * @brief Summarize the entries of a list that the snapshot does not store
+     */
+    static ListTail TailOf(const ComponentList& values, size_t capacity);
+
+    /**
+     * @brief Compute the fingerprint of the collected values into m_fingerprint
+     * @return Fingerprint length (0 if a required component timed out)
+     */
+    size_t ComputeFingerprint(uint32_t requiredComponents);
+
+    /**
+     * @brief Compare a collected component with the stored snapshot
+     */
+    bool ComponentChanged(HardwareComponent component) const;
+
+    HardwareSnapshot m_snapshot;
+    SnapshotArena m_arena;
+    HardwareInfo m_collected;           // Values handed over by the collector
+    ListTail m_diskSerialTail;          // Stored entries beyond kMaxDiskSerials
+    ListTail m_macAddressTail;          // Stored entries beyond kMaxMacAddresses
+    std::string m_fingerprintInput;     // Reused fingerprint input buffer
+    char m_fingerprint[kMaxFingerprintLength];
+    bool m_hasSnapshot;
+    RefreshStats m_stats;
+};
+
+#endif // SNAPSHOT_REFRESHER_H
@@ -0,0 +1,135 @@
+#include "string_interner.h"
+#include <cstring>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief Constructor - Interns the empty string as kEmptyInternId
+ */
+StringInterner::StringInterner() {
+    Clear();
+}
+
+uint32_t StringInterner::ShardOf(std::string_view value) {
+    // Mix the high bits in, std::hash may be weak in the low ones
+    size_t hash = std::hash<std::string_view>()(value);
+    return static_cast<uint32_t>((hash ^ (hash >> 17)) & (kShardCount - 1));
+}
+
+/**
+ * @brief Copy a value into stable shard storage
+ */
+std::string_view StringInterner::Store(Shard& shard, std::string_view value) {
+    if (value.empty()) {
+        return std::string_view();
+    }
+
+    char* destination;
+    if (value.size() > kBlockSize / 4) {
+        // Oversized values get a block of their own
+        shard.largeBlocks.emplace_back(new char[value.size()]);
+        destination = shard.largeBlocks.back().get();
+    } else {
+        if (shard.blocks.empty() || shard.blockUsed + value.size() > kBlockSize) {
+            shard.blocks.emplace_back(new char[kBlockSize]);
+            shard.blockUsed = 0;
+        }
+        destination = shard.blocks.back().get() + shard.blockUsed;
+        shard.blockUsed += value.size();
+    }
+
+    memcpy(destination, value.data(), value.size());
+    shard.storedBytes += value.size();
+    return std::string_view(destination, value.size());
+}
+
+/**
+ * @brief Intern a value
+ */
+InternId StringInterner::Intern(std::string_view value) {
+    uint32_t shardIndex = ShardOf(value);
+    Shard& shard = m_shards[shardIndex];
+
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.index.find(value);
+        if (it != shard.index.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(value);
+    if (it != shard.index.end()) {
+        return it->second;
+    }
+
+    std::string_view stored = Store(shard, value);
+    InternId id = static_cast<InternId>((shard.values.size() << kShardBits) | shardIndex);
+    shard.values.push_back(stored);
+    shard.index.emplace(stored, id);
+    return id;
+}
+
+/**
+ * @brief Look up a value without interning it
+ */
+bool StringInterner::Find(std::string_view value, InternId& id) const {
+    const Shard& shard = m_shards[ShardOf(value)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(value);
+    if (it == shard.index.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+/**
+ * @brief Get the value of an identifier
+ */
+std::string_view StringInterner::Lookup(InternId id) const {
+    const Shard& shard = m_shards[id & (kShardCount - 1)];
+    size_t local = id >> kShardBits;
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return local < shard.values.size() ? shard.values[local] : std::string_view();
+}
+
+size_t StringInterner::Size() const {
+    size_t size = 0;
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        size += shard.values.size();
+    }
+    return size;
+}
+
+size_t StringInterner::StoredBytes() const {
+    size_t bytes = 0;
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        bytes += shard.storedBytes;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Drop every value except the empty string
+ */
+void StringInterner::Clear() {
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.index.clear();
+        shard.values.clear();
+        shard.blocks.clear();
+        shard.largeBlocks.clear();
+        shard.blockUsed = 0;
+        shard.storedBytes = 0;
+    }
+
+    // The empty string is always identifier 0 (shard 0, slot 0), whichever
+    // shard it hashes to; shard 0 reserves slot 0 for it
+    Shard& first = m_shards[0];
+    first.values.push_back(std::string_view());
+    m_shards[ShardOf(std::string_view())].index.emplace(std::string_view(), kEmptyInternId);
+}
@@ -0,0 +1,105 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Identifier of an interned string
+ *
+ * Two interned strings are equal exactly when their identifiers are equal.
+ */
+using InternId = uint32_t;
+
+/**
+ * @brief Identifier of the empty string, interned up front
+ */
+constexpr InternId kEmptyInternId = 0;
+
+/**
+ * @brief Concurrent string interner
+ *
+ * Stores each distinct value once in append-only blocks and maps it to a
+ * compact InternId. The table is split into independently locked shards
+ * selected by hash, so batch workers interning in parallel rarely contend;
+ * lookups of existing values only take a shared lock. Views returned by
+ * Lookup() stay valid until Clear().
+ */
+class StringInterner {
+public:
+    StringInterner();
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /**
+     * @brief Intern a value
+     * @param value Value to intern
+     * @return Identifier shared by every equal value
+     */
+    InternId Intern(std::string_view value);
+
+    /**
+     * @brief Look up a value without interning it
+     * @param value Value to find
+     * @param id Receives the identifier if found
+     * @return true if the value has been interned
+     */
+    bool Find(std::string_view value, InternId& id) const;
+
+    /**
+     * @brief Get the value of an identifier
+     * @param id Identifier returned by Intern()
+     * @return Interned value, empty for unknown identifiers
+     */
+    std::string_view Lookup(InternId id) const;
+
+    /**
+     * @brief Get the number of distinct values
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Get the number of bytes used by distinct values
+     */
+    size_t StoredBytes() const;
+
+    /**
+     * @brief Drop every value except the empty string
+     *
+     * Invalidates all identifiers and views; callers must ensure no other
+     * thread is using the interner.
+     */
+    void Clear();
+
+private:
+    static constexpr uint32_t kShardBits = 4;
+    static constexpr uint32_t kShardCount = 1u << kShardBits;
+    static constexpr size_t kBlockSize = 64 * 1024;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string_view, InternId> index;
+        std::vector<std::string_view> values;
+        std::vector<std::unique_ptr<char[]>> blocks;       // Bump-allocated, blockUsed applies to the last
+        std::vector<std::unique_ptr<char[]>> largeBlocks;  // One per oversized value
+        size_t blockUsed = 0;
+        size_t storedBytes = 0;
+    };
+
+    /**
+     * @brief Copy a value into stable shard storage
+     */
+    static std::string_view Store(Shard& shard, std::string_view value);
+
+    static uint32_t ShardOf(std::string_view value);
+
+    Shard m_shards[kShardCount];
+};
+
+#endif // STRING_INTERNER_H
@@ -0,0 +1,338 @@
+#include "sysfs_collector.h"
+#include "mac_address.h"
+#include "smbios_table.h"
+#include "hedged_request.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+// CPUID leaf 1 EDX feature bits in bit order, as named in /proc/cpuinfo flags
+static const char* const kCpuidEdxFlags[32] = {
+    "fpu", "vme", "de", "pse", "tsc", "msr", "pae", "mce",
+    "cx8", "apic", nullptr, "sep", "mtrr", "pge", "mca", "cmov",
+    "pat", "pse36", "pn", "clflush", nullptr, "dts", "acpi", "mmx",
+    "fxsr", "sse", "sse2", "ss", "ht", "tm", "ia64", "pbe"
+};
+
+/**
+ * @brief Remove leading and trailing whitespace and NUL padding
+ */
+static std::string Trim(const std::string& value) {
+    size_t begin = 0;
+    size_t end = value.size();
+    while (begin < end && (std::isspace(static_cast<unsigned char>(value[begin])) || value[begin] == '\0')) {
+        begin++;
+    }
+    while (end > begin && (std::isspace(static_cast<unsigned char>(value[end - 1])) || value[end - 1] == '\0')) {
+        end--;
+    }
+    return value.substr(begin, end - begin);
+}
+
+/**
+ * @brief Read a whole file into a string
+ * @return File contents, empty if unreadable
+ */
+static std::string ReadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return "";
+    }
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Constructor - Store the root directory
+ */
+SysfsCollector::SysfsCollector(const std::string& rootPath)
+    : m_rootPath(rootPath.empty() ? "/" : rootPath) {
+}
+
+/**
+ * @brief Get the root directory this collector reads from
+ */
+const std::string& SysfsCollector::GetRootPath() const {
+    return m_rootPath;
+}
+
+/**
+ * @brief Check whether the root directory exists
+ */
+bool SysfsCollector::IsValidRoot() const {
+    std::error_code error;
+    return fs::is_directory(m_rootPath, error);
+}
+
+/**
+ * @brief Build an absolute path below the root
+ */
+std::string SysfsCollector::ResolvePath(const std::string& relativePath) const {
+    if (!m_rootPath.empty() && m_rootPath.back() == '/') {
+        return m_rootPath + relativePath;
+    }
+    return m_rootPath + "/" + relativePath;
+}
+
+/**
+ * @brief Read a sysfs attribute with surrounding whitespace removed
+ */
+std::string SysfsCollector::ReadAttribute(const std::string& relativePath) const {
+    return Trim(ReadFile(ResolvePath(relativePath)));
+}
+
+/**
+ * @brief List directory entry names, sorted
+ */
+std::vector<std::string> SysfsCollector::ListDirectory(const std::string& relativePath) const {
+    std::vector<std::string> names;
+    std::error_code error;
+    fs::directory_iterator it(ResolvePath(relativePath), error);
+    if (error) {
+        return names;
+    }
+
+    for (const fs::directory_entry& entry : it) {
+        names.push_back(entry.path().filename().string());
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+/**
+ * @brief Read a string field from the raw SMBIOS/DMI table
+ */
+std::string SysfsCollector::ReadDmiTableString(uint8_t structureType, uint8_t fieldOffset) const {
+    std::string table = ReadFile(ResolvePath("sys/firmware/dmi/tables/DMI"));
+    return Trim(FindSmbiosString(reinterpret_cast<const uint8_t*>(table.data()), table.size(),
+                                 structureType, fieldOffset));
+}
+
+/**
+ * @brief Get CPU identifier in Win32_Processor.ProcessorId format
+ *
+ * ProcessorId is CPUID leaf 1 EDX followed by EAX in hex. EAX is rebuilt
+ * from family/model/stepping and EDX from the feature flags, so the same
+ * CPU yields the same ID as WMI reports on Windows.
+ */
+std::string SysfsCollector::GetCpuId() const {
+    std::istringstream cpuinfo(ReadFile(ResolvePath("proc/cpuinfo")));
+    std::string line;
+    int family = -1;
+    int model = -1;
+    int stepping = -1;
+    std::string flags;
+
+    while (std::getline(cpuinfo, line)) {
+        if (line.empty()) {
+            break;  // Only the first processor block is needed
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string key = Trim(line.substr(0, colon));
+        std::string value = Trim(line.substr(colon + 1));
+        if (key == "cpu family") {
+            family = std::atoi(value.c_str());
+        } else if (key == "model") {
+            model = std::atoi(value.c_str());
+        } else if (key == "stepping") {
+            stepping = std::atoi(value.c_str());
+        } else if (key == "flags") {
+            flags = " " + value + " ";
+        }
+    }
+
+    if (family < 0 || model < 0 || stepping < 0 || flags.empty()) {
+        return "";
+    }
+
+    uint32_t baseFamily = family >= 0xF ? 0xF : static_cast<uint32_t>(family);
+    uint32_t extendedFamily = family >= 0xF ? static_cast<uint32_t>(family - 0xF) : 0;
+    uint32_t baseModel = static_cast<uint32_t>(model) & 0xF;
+    uint32_t extendedModel = (baseFamily == 0x6 || baseFamily == 0xF) ? (static_cast<uint32_t>(model) >> 4) & 0xF : 0;
+    uint32_t eax = (static_cast<uint32_t>(stepping) & 0xF) |
+                   (baseModel << 4) |
+                   (baseFamily << 8) |
+                   (extendedModel << 16) |
+                   ((extendedFamily & 0xFF) << 20);
+
+    uint32_t edx = 0;
+    for (uint32_t bit = 0; bit < 32; bit++) {
+        if (kCpuidEdxFlags[bit] && flags.find(std::string(" ") + kCpuidEdxFlags[bit] + " ") != std::string::npos) {
+            edx |= 1u << bit;
+        }
+    }
+
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%08X%08X", edx, eax);
+    return buffer;
+}
+
+/**
+ * @brief Read a DMI identifier from its sysfs attribute or the raw DMI table
+ *
+ * The live system is hedged between the two sources. Other roots are
+ * captured images read as plain files: they are read in turn on the calling
+ * thread, so batch collection posts nothing to the watchdog and their
+ * latencies stay out of the live system's hedge delay.
+ */
+std::string SysfsCollector::ReadDmiIdentifier(const char* hedgeName, const char* attribute,
+                                              uint8_t structureType, uint8_t fieldOffset) const {
+    if (m_rootPath != "/") {
+        std::string value = NormalizeIdentifier(ReadAttribute(attribute));
+        if (value.empty()) {
+            value = NormalizeIdentifier(ReadDmiTableString(structureType, fieldOffset));
+        }
+        return value;
+    }
+
+    // Sources own a copy of the root, the loser may outlive this collector
+    std::string root = m_rootPath;
+    std::string path = attribute;
+    return HedgedSource::Get(hedgeName).Run(
+        [root, path]() { return SysfsCollector(root).ReadAttribute(path); },
+        [root, structureType, fieldOffset]() {
+            return SysfsCollector(root).ReadDmiTableString(structureType, fieldOffset);
+        });
+}
+
+/**
+ * @brief Get motherboard serial number
+ */
+std::string SysfsCollector::GetMotherboardSerial() const {
+    return ReadDmiIdentifier("sysfs.motherboardSerial", "sys/class/dmi/id/board_serial",
+                             kSmbiosBaseboardInformation, kSmbiosSerialNumberOffset);
+}
+
+/**
+ * @brief Get BIOS (system) serial number
+ *
+ * Win32_BIOS.SerialNumber reports the SMBIOS system serial, which sysfs
+ * exposes as product_serial.
+ */
+std::string SysfsCollector::GetBiosSerial() const {
+    return ReadDmiIdentifier("sysfs.biosSerial", "sys/class/dmi/id/product_serial",
+                             kSmbiosSystemInformation, kSmbiosSerialNumberOffset);
+}
+
+/**
+ * @brief Get disk drive serial numbers, ordered by block device name
+ */
+std::vector<std::string> SysfsCollector::GetDiskSerials() const {
+    std::vector<std::string> serials;
+
+    for (const std::string& name : ListDirectory("sys/block")) {
+        std::string device = "sys/block/" + name + "/device/";
+
+        std::string serial = ReadAttribute(device + "serial");
+        if (serial.empty()) {
+            // SCSI/SATA unit serial number VPD page: 4 byte header, then the serial
+            std::string page = ReadFile(ResolvePath(device + "vpd_pg80"));
+            if (page.size() > 4) {
+                serial = Trim(page.substr(4));
+            }
+        }
+        if (serial.empty()) {
+            serial = ReadAttribute(device + "wwid");
+        }
+
+        if (!serial.empty()) {
+            serials.push_back(serial);
+        }
+    }
+    return serials;
+}
+
+/**
+ * @brief Get network adapter MAC addresses, ordered by interface name
+ */
+std::vector<std::string> SysfsCollector::GetMacAddresses() const {
+    std::vector<std::string> addresses;
+
+    for (const std::string& name : ListDirectory("sys/class/net")) {
+        if (name == "lo") {
+            continue;
+        }
+
+        MacAddress mac;
+        std::string address = ReadAttribute("sys/class/net/" + name + "/address");
+        if (address.size() != 17 || !ParseMacAddress(address, mac) || mac.IsZero()) {
+            continue;  // Not an Ethernet-style address
+        }
+
+        addresses.push_back(FormatMacAddress(mac, MacFormat::Colon, true));
+    }
+    return addresses;
+}
+
+/**
+ * @brief Collect a single hardware component into a snapshot
+ */
+void SysfsCollector::CollectComponent(HardwareComponent component, HardwareInfo& info) const {
+    CollectComponentWith(*this, component, info);
+}
+
+/**
+ * @brief Collect every hardware component and the fingerprint
+ */
+HardwareInfo SysfsCollector::GetAllHardwareInfo() const {
+    HardwareInfo info;
+    for (uint32_t i = 0; i < kHardwareComponentCount; i++) {
+        CollectComponent(static_cast<HardwareComponent>(i), info);
+    }
+    info.fingerprint = ComputeFingerprint(info);
+    return info;
+}
+
+/**
+ * @brief Collect and fingerprint many roots concurrently
+ *
+ * Workers pull the next root index from a shared counter, so slow images
+ * do not hold up a statically assigned share of the batch.
+ */
+std::vector<RootCollectionResult> SysfsCollector::CollectBatch(const std::vector<std::string>& roots,
+                                                               unsigned concurrency) {
+    std::vector<RootCollectionResult> results(roots.size());
+    if (roots.empty()) {
+        return results;
+    }
+
+    if (concurrency == 0) {
+        concurrency = std::max(1u, std::thread::hardware_concurrency());
+    }
+    concurrency = static_cast<unsigned>(std::min<size_t>(concurrency, roots.size()));
+
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&]() {
+        size_t index;
+        while ((index = nextIndex.fetch_add(1)) < roots.size()) {
+            SysfsCollector collector(roots[index]);
+            RootCollectionResult& result = results[index];
+            result.root = roots[index];
+            result.success = collector.IsValidRoot();
+            if (result.success) {
+                result.snapshot = ArenaSnapshot(collector.GetAllHardwareInfo());
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < concurrency; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
@@ -0,0 +1,150 @@
+#ifndef SYSFS_COLLECTOR_H
+#define SYSFS_COLLECTOR_H
+
+#include "hardware_info.h"
+#include "arena_snapshot.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Result of collecting one root in a batch
+ */
+struct RootCollectionResult {
+    std::string root;
+    ArenaSnapshot snapshot;  // Includes the fingerprint; single allocation per root
+    bool success;                    // false if the root does not exist or is not a directory
+};
+
+/**
+ * @brief Hardware identifier collector for Linux sysfs/procfs trees
+ *
+ * Reads every identifier relative to a root directory, so it works equally
+ * on a live system (root "/"), a captured sysfs tree or a mounted golden
+ * image. Only plain file reads are used; nothing is executed inside the
+ * root and no privileges beyond read access are needed.
+ *
+ * Sources (relative to the root):
+ * - CPU ID: proc/cpuinfo, formatted like Win32_Processor.ProcessorId
+ * - Motherboard serial: sys/class/dmi/id/board_serial, then the raw DMI table
+ *   (hedged on the live system)
+ * - BIOS serial: sys/class/dmi/id/product_serial, then the raw DMI table
+ *   (hedged on the live system)
+ * - Disk serials: sys/block/<name>/device/{serial,vpd_pg80,wwid}
+ * - MAC addresses: sys/class/net/<name>/address
+ */
+class SysfsCollector {
+public:
+    /**
+     * @brief Construct a collector reading relative to a root directory
+     * @param rootPath Root directory ("/" for the running system)
+     */
+    explicit SysfsCollector(const std::string& rootPath);
+
+    /**
+     * @brief Get the root directory this collector reads from
+     * @return Root path
+     */
+    const std::string& GetRootPath() const;
+
+    /**
+     * @brief Check whether the root directory exists
+     * @return true if the root is an existing directory
+     */
+    bool IsValidRoot() const;
+
+    /**
+     * @brief Get CPU identifier in Win32_Processor.ProcessorId format
+     * @return CPU ID as string, empty if not available
+     */
+    std::string GetCpuId() const;
+
+    /**
+     * @brief Get motherboard serial number
+     * @return Motherboard serial number as string, empty if not available
+     */
+    std::string GetMotherboardSerial() const;
+
+    /**
+     * @brief Get BIOS (system) serial number
+     * @return BIOS serial number as string, empty if not available
+     */
+    std::string GetBiosSerial() const;
+
+    /**
+     * @brief Get disk drive serial numbers, ordered by block device name
+     * @return Vector of disk serial numbers
+     */
+    std::vector<std::string> GetDiskSerials() const;
+
+    /**
+     * @brief Get network adapter MAC addresses, ordered by interface name
+     * @return Vector of MAC addresses in "XX:XX:XX:XX:XX:XX" form
+     */
+    std::vector<std::string> GetMacAddresses() const;
+
+    /**
+     * @brief Collect a single hardware component into a snapshot
+     * @param component Component to collect
+     * @param info Snapshot receiving the component value
+     */
+    void CollectComponent(HardwareComponent component, HardwareInfo& info) const;
+
+    /**
+     * @brief Collect every hardware component and the fingerprint
+     * @return Snapshot of all hardware identifiers
+     */
+    HardwareInfo GetAllHardwareInfo() const;
+
+    /**
+     * @brief Collect and fingerprint many roots concurrently
+     * @param roots Root directories to collect
+     * @param concurrency Number of worker threads (0 picks the hardware concurrency)
+     * @return One result per root, in input order
+     */
+    static std::vector<RootCollectionResult> CollectBatch(const std::vector<std::string>& roots,
+                                                          unsigned concurrency);
+
+private:
+    /**
+     * @brief Read a sysfs attribute with surrounding whitespace removed
+     * @param relativePath Path relative to the root
+     * @return Attribute value, empty if missing
+     */
+    std::string ReadAttribute(const std::string& relativePath) const;
+
+    /**
+     * @brief Read a string field from the raw SMBIOS/DMI table
+     * @param structureType SMBIOS structure type (1 = system, 2 = baseboard)
+     * @param fieldOffset Offset of the string index byte in the structure
+     * @return Trimmed string value, empty if not present
+     */
+    std::string ReadDmiTableString(uint8_t structureType, uint8_t fieldOffset) const;
+
+    /**
+     * @brief Read a DMI identifier, hedging the two sources on the live system
+     * @param hedgeName HedgedSource name for the live system
+     * @param attribute sysfs attribute relative to the root
+     * @param structureType SMBIOS structure type holding the same string
+     * @param fieldOffset Offset of the string index byte in the structure
+     * @return Normalized value, empty if neither source has one
+     */
+    std::string ReadDmiIdentifier(const char* hedgeName, const char* attribute,
+                                  uint8_t structureType, uint8_t fieldOffset) const;
+
+    /**
+     * @brief List directory entry names, sorted
+     * @param relativePath Directory relative to the root
+     * @return Entry names, empty if the directory is missing
+     */
+    std::vector<std::string> ListDirectory(const std::string& relativePath) const;
+
+    /**
+     * @brief Build an absolute path below the root
+     */
+    std::string ResolvePath(const std::string& relativePath) const;
+
+private:
+    std::string m_rootPath;
+};
+
+#endif // SYSFS_COLLECTOR_H
@@ -0,0 +1,179 @@
+#include "utf16_transcoder.h"
+#include "cpu_features.h"
+
+#if defined(HWID_ARCH_X86)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UTF16_TRANSCODER_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UTF16_TRANSCODER_NEON 1
+#endif
+
+/**
+ * @brief Narrow a run of ASCII code units
+ * @param input Code units
+ * @param length Number of code units
+ * @param output Destination bytes
+ * @return Number of leading code units that were ASCII and have been copied
+ */
+using CopyAsciiPrefixFn = size_t (*)(const char16_t* input, size_t length, char* output);
+
+static size_t CopyAsciiPrefixScalar(const char16_t* input, size_t length, char* output) {
+    size_t i = 0;
+    while (i < length && input[i] < 0x80) {
+        output[i] = static_cast<char>(input[i]);
+        i++;
+    }
+    return i;
+}
+
+#if defined(UTF16_TRANSCODER_SSE2)
+static size_t CopyAsciiPrefixSse2(const char16_t* input, size_t length, char* output) {
+    size_t i = 0;
+    const __m128i highMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 16 <= length) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 8));
+        __m128i high = _mm_and_si128(_mm_or_si128(a, b), highMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packus_epi16(a, b));
+        i += 16;
+    }
+    return i + CopyAsciiPrefixScalar(input + i, length - i, output + i);
+}
+#elif defined(UTF16_TRANSCODER_NEON)
+static size_t CopyAsciiPrefixNeon(const char16_t* input, size_t length, char* output) {
+    size_t i = 0;
+    while (i + 16 <= length) {
+        uint16x8_t a = vld1q_u16(reinterpret_cast<const uint16_t*>(input + i));
+        uint16x8_t b = vld1q_u16(reinterpret_cast<const uint16_t*>(input + i + 8));
+        if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80) {
+            break;
+        }
+        vst1q_u8(reinterpret_cast<uint8_t*>(output + i), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+        i += 16;
+    }
+    return i + CopyAsciiPrefixScalar(input + i, length - i, output + i);
+}
+#endif
+
+#if defined(HWID_ARCH_X86)
+HWID_TARGET("avx2")
+static size_t CopyAsciiPrefixAvx2(const char16_t* input, size_t length, char* output) {
+    size_t i = 0;
+    const __m256i highMask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+    while (i + 32 <= length) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i + 16));
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), highMask)) {
+            break;
+        }
+        // packus works per 128-bit lane; restore the element order afterwards
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), packed);
+        i += 32;
+    }
+#if defined(UTF16_TRANSCODER_SSE2)
+    return i + CopyAsciiPrefixSse2(input + i, length - i, output + i);
+#else
+    return i + CopyAsciiPrefixScalar(input + i, length - i, output + i);
+#endif
+}
+#endif
+
+/**
+ * @brief Select the best ASCII narrowing kernel for the running CPU
+ */
+static CopyAsciiPrefixFn SelectCopyAsciiPrefix() {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    (void)cpu;
+#if defined(HWID_ARCH_X86)
+    if (cpu.avx2) {
+        RecordKernelVariant("utf16.copyAsciiPrefix", "avx2");
+        return CopyAsciiPrefixAvx2;
+    }
+#endif
+#if defined(UTF16_TRANSCODER_SSE2)
+    if (cpu.sse2) {
+        RecordKernelVariant("utf16.copyAsciiPrefix", "sse2");
+        return CopyAsciiPrefixSse2;
+    }
+#elif defined(UTF16_TRANSCODER_NEON)
+    if (cpu.neon) {
+        RecordKernelVariant("utf16.copyAsciiPrefix", "neon");
+        return CopyAsciiPrefixNeon;
+    }
+#endif
+    RecordKernelVariant("utf16.copyAsciiPrefix", "scalar");
+    return CopyAsciiPrefixScalar;
+}
+
+// Resolved while the module loads, before any transcoding
+static const CopyAsciiPrefixFn CopyAsciiPrefix = SelectCopyAsciiPrefix();
+
+/**
+ * @brief Transcode UTF-16 to UTF-8 in a single pass
+ */
+size_t TranscodeUtf16ToUtf8(const char16_t* input, size_t length, char* output, size_t* replacements) {
+    size_t in = 0;
+    size_t out = 0;
+    size_t replaced = 0;
+
+    while (in < length) {
+        size_t ascii = CopyAsciiPrefix(input + in, length - in, output + out);
+        in += ascii;
+        out += ascii;
+
+        // Non-ASCII code points until the next ASCII unit
+        while (in < length && input[in] >= 0x80) {
+            uint32_t unit = input[in++];
+            if (unit < 0x800) {
+                output[out++] = static_cast<char>(0xC0 | (unit >> 6));
+                output[out++] = static_cast<char>(0x80 | (unit & 0x3F));
+                continue;
+            }
+
+            if (unit >= 0xD800 && unit <= 0xDFFF) {
+                if (unit <= 0xDBFF && in < length && input[in] >= 0xDC00 && input[in] <= 0xDFFF) {
+                    uint32_t codePoint = 0x10000 + ((unit - 0xD800) << 10) + (input[in++] - 0xDC00);
+                    output[out++] = static_cast<char>(0xF0 | (codePoint >> 18));
+                    output[out++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                    output[out++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    output[out++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    continue;
+                }
+                unit = 0xFFFD;  // Unpaired surrogate
+                replaced++;
+            }
+
+            output[out++] = static_cast<char>(0xE0 | (unit >> 12));
+            output[out++] = static_cast<char>(0x80 | ((unit >> 6) & 0x3F));
+            output[out++] = static_cast<char>(0x80 | (unit & 0x3F));
+        }
+    }
+
+    if (replacements) {
+        *replacements = replaced;
+    }
+    return out;
+}
+
+/**
+ * @brief Transcode UTF-16 to a UTF-8 string
+ */
+std::string Utf16ToUtf8(const char16_t* input, size_t length) {
+    std::string result;
+    if (length == 0) {
+        return result;
+    }
+    // Size for the worst case once, then trim; no separate sizing pass
+    result.resize(length * kMaxUtf8BytesPerUtf16Unit);
+    result.resize(TranscodeUtf16ToUtf8(input, length, &result[0]));
+    return result;
+}
@@ -0,0 +1,37 @@
+#ifndef UTF16_TRANSCODER_H
+#define UTF16_TRANSCODER_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Worst-case UTF-8 bytes produced per UTF-16 code unit
+ *
+ * A BMP code unit takes at most 3 bytes; a surrogate pair takes 4 bytes
+ * for 2 units.
+ */
+constexpr size_t kMaxUtf8BytesPerUtf16Unit = 3;
+
+/**
+ * @brief Transcode UTF-16 to UTF-8 in a single pass
+ *
+ * Runs of ASCII are narrowed 8 or 16 code units at a time with SSE2, AVX2
+ * or NEON where available. Unpaired surrogates are replaced with U+FFFD.
+ *
+ * @param input UTF-16 code units
+ * @param length Number of code units
+ * @param output Buffer of at least length * kMaxUtf8BytesPerUtf16Unit bytes
+ * @param replacements Receives the number of unpaired surrogates replaced (optional)
+ * @return Number of bytes written
+ */
+size_t TranscodeUtf16ToUtf8(const char16_t* input, size_t length, char* output, size_t* replacements = nullptr);
+
+/**
+ * @brief Transcode UTF-16 to a UTF-8 string
+ * @param input UTF-16 code units
+ * @param length Number of code units
+ * @return UTF-8 string
+ */
+std::string Utf16ToUtf8(const char16_t* input, size_t length);
+
+#endif // UTF16_TRANSCODER_H
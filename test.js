@@ -100,8 +100,293 @@ async function testHardwareIdentification() {
             console.log(`   All Hardware Info: Error - ${error.message}`);
         }
         
+        // Test per-component deadlines
+        console.log('\n4. Testing component deadlines:');
+        try {
+            const info = hardwareId.getAllHardwareInfo({ componentTimeoutMs: 60000 });
+            console.log(`   Timed out: ${info.timedOut.length ? info.timedOut.join(', ') : 'none'}`);
+            if (info.timedOut.length === 0 && info.fingerprint !== hardwareId.getHardwareFingerprint()) {
+                throw new Error('Collection under a deadline returned a different fingerprint');
+            }
+            for (const componentTimeoutMs of [-1, 1.5, NaN, 2 ** 32]) {
+                let rejected = false;
+                try {
+                    hardwareId.getAllHardwareInfo({ componentTimeoutMs });
+                } catch (error) {
+                    rejected = error instanceof RangeError;
+                }
+                if (!rejected) {
+                    throw new Error(`componentTimeoutMs ${componentTimeoutMs} was not rejected`);
+                }
+            }
+            const { watchdog } = hardwareId.getCollectionStats();
+            console.log(`   Watchdog: ${watchdog.completed} completed, ${watchdog.timedOut} timed out, ${watchdog.failed} failed`);
+            if (watchdog.completed + watchdog.timedOut + watchdog.failed < 5) {
+                throw new Error('Watchdog did not run every component');
+            }
+        } catch (error) {
+            console.log(`   Component deadlines: Error - ${error.message}`);
+            process.exitCode = 1;
+        }
+        
+        // Test steady-state refresh
+        console.log('\n5. Testing steady-state refresh:');
+        try {
+            hardwareId.refresh();
+            const steady = hardwareId.refresh();
+            console.log(`   Changed components: ${steady.changed.length ? steady.changed.join(', ') : 'none'}`);
+            console.log(`   Refresh path allocations: ${steady.allocations}`);
+            if (steady.changed.length === 0 && !steady.fingerprintChanged && steady.allocations !== 0) {
+                throw new Error(`Unchanged refresh allocated ${steady.allocations} buffer(s)`);
+            }
+        } catch (error) {
+            console.log(`   Steady-state refresh: Error - ${error.message}`);
+            process.exitCode = 1;
+        }
+        
+        // Test prioritized asynchronous collection
+        console.log('\n6. Testing prioritized asynchronous collection:');
+        try {
+            const expected = hardwareId.getHardwareFingerprint();
+            const results = await Promise.all([
+                hardwareId.getAllHardwareInfoAsync({ priority: 'background' }),
+                hardwareId.getAllHardwareInfoAsync({ priority: 'interactive' }),
+                hardwareId.getAllHardwareInfoAsync()
+            ]);
+            const { scheduler } = hardwareId.getCollectionStats();
+            const completed = scheduler.interactive.completed + scheduler.normal.completed + scheduler.background.completed;
+            console.log(`   Completed: ${completed}, preemptions: ${scheduler.preemptions}`);
+            if (results.some((result) => result.fingerprint !== expected)) {
+                throw new Error('Asynchronous collection returned a different fingerprint');
+            }
+            if (completed < results.length) {
+                throw new Error(`Scheduler reports ${completed} of ${results.length} collections completed`);
+            }
+        } catch (error) {
+            console.log(`   Asynchronous collection: Error - ${error.message}`);
+            process.exitCode = 1;
+        }
+        
+        // Test change watchers
+        console.log('\n7. Testing change watchers:');
+        try {
+            let rejected = false;
+            try {
+                hardwareId.watch(() => {}, { debounceMs: -1 });
+            } catch (error) {
+                rejected = error instanceof TypeError;
+            }
+            if (!rejected) {
+                throw new Error('Invalid debounceMs was not rejected');
+            }
+            const stopSlow = hardwareId.watch(() => {}, { debounceMs: 1000 });
+            const stopFast = hardwareId.watch(() => {}, { debounceMs: 50 });
+            stopFast();
+            stopSlow();
+            console.log('   Watchers with different debounce periods: started and stopped');
+        } catch (error) {
+            console.log(`   Change watchers: ${error.message}`);
+            if (!/notification source/.test(error.message)) {
+                process.exitCode = 1;
+            }
+        }
+        
+        // Test binary snapshot encoding
+        console.log('\n8. Testing binary snapshot encoding:');
+        try {
+            const info = hardwareId.getAllHardwareInfo();
+            const encoded = hardwareId.encodeSnapshot(info);
+            const decoded = hardwareId.decodeSnapshot(encoded);
+            console.log(`   Encoded size: ${encoded.length} bytes (JSON: ${JSON.stringify(info).length} bytes)`);
+            console.log(`   MessagePack size: ${hardwareId.encodeSnapshot('msgpack').length} bytes, CBOR size: ${hardwareId.encodeSnapshot('cbor').length} bytes`);
+            if (!hardwareId.encodeSnapshot(decoded).equals(encoded)) {
+                throw new Error('Decoded snapshot does not re-encode to the same bytes');
+            }
+            const [json] = JSON.parse(hardwareId.encodeJson([info]).toString());
+            if (json.fingerprint !== info.fingerprint || json.cpuId !== info.cpuId) {
+                throw new Error('Native JSON does not match the snapshot');
+            }
+            const extra = { ratio: 0.1, third: 1 / 3, huge: 1e21, tags: ['a', 1.5, null, { nested: true }], when: new Date(0) };
+            const [report] = JSON.parse(hardwareId.encodeJson([{ ...info, ...extra, skipped: undefined }]).toString());
+            const expectedExtra = JSON.parse(JSON.stringify(extra));
+            if (Object.keys(expectedExtra).some((key) => JSON.stringify(report[key]) !== JSON.stringify(expectedExtra[key])) ||
+                'skipped' in report) {
+                throw new Error('Native JSON does not match JSON.stringify for extra properties');
+            }
+            const circular = { ...info };
+            circular.self = circular;
+            let circularRejected = false;
+            try {
+                hardwareId.encodeJson([circular]);
+            } catch (error) {
+                circularRejected = error instanceof TypeError;
+            }
+            if (!circularRejected) {
+                throw new Error('Circular entry was not rejected');
+            }
+            const deep = { ...info, nested: {} };
+            for (let level = 0, inner = deep.nested; level < 100; level++) {
+                inner = inner.next = {};
+            }
+            let depthRejected = false;
+            try {
+                hardwareId.encodeJson([deep]);
+            } catch (error) {
+                depthRejected = error instanceof RangeError;
+            }
+            if (!depthRejected) {
+                throw new Error('Deeply nested entry was not rejected with a RangeError');
+            }
+            const shared = { id: 1 };
+            const [repeated] = JSON.parse(hardwareId.encodeJson([{ ...info, first: shared, second: [shared] }]).toString());
+            if (repeated.second[0].id !== 1) {
+                throw new Error('Repeated non-circular reference was not written');
+            }
+            const key = hardwareId.getHardwareFingerprint({ encoding: 'raw' });
+            const label = hardwareId.encodeFingerprint(key, 'base32');
+            console.log(`   Fingerprint digest: ${hardwareId.encodeFingerprint(key, 'hex')} (base32 ${label})`);
+            if (!hardwareId.decodeFingerprint(label, 'base32').equals(key)) {
+                throw new Error('Fingerprint digest does not round-trip through base32');
+            }
+            const token = hardwareId.createToken('test-key', { info });
+            const tampered = Buffer.from(token);
+            tampered[40] ^= 1;
+            const valid = hardwareId.verifyTokens([token, tampered], 'test-key');
+            console.log(`   Attestation token: ${token.length} bytes, verified ${valid[0]}/${valid[1]} (valid/tampered)`);
+            if (valid[0] !== 1 || valid[1] !== 0) {
+                throw new Error('Attestation token verification mismatch');
+            }
+        } catch (error) {
+            console.log(`   Binary snapshot encoding: Error - ${error.message}`);
+            process.exitCode = 1;
+        }
+        
+        // Test the telemetry stream
+        console.log('\n9. Testing telemetry stream:');
+        try {
+            hardwareId.resetTelemetry();
+            const base = { cpuId: 'BFEBFBFF000906EA', motherboardSerial: 'MB-1', biosSerial: 'BIOS-1', diskSerials: ['WD-1'], macAddresses: [] };
+            const keyframe = hardwareId.encodeTelemetry(base, { keyframe: true });
+            const delta = hardwareId.encodeTelemetry({ ...base, biosSerial: 'BIOS-2' });
+            hardwareId.encodeTelemetry({ ...base, biosSerial: 'BIOS-3' });   // Lost in transit
+            const late = hardwareId.encodeTelemetry({ ...base, biosSerial: 'BIOS-4' });
+            const recovery = hardwareId.encodeTelemetry({ ...base, biosSerial: 'BIOS-4' }, { keyframe: true });
+            console.log(`   Frame sizes: keyframe ${keyframe.length} bytes, delta ${delta.length} bytes`);
+            
+            // Deltas from a device without a keyframe are not applied
+            const [orphan] = hardwareId.decodeTelemetry('test-device', delta);
+            if (!orphan.needKeyframe || orphan.snapshot !== null) {
+                throw new Error('Delta without a keyframe was applied');
+            }
+            const [first, second] = hardwareId.decodeTelemetry('test-device', Buffer.concat([keyframe, delta]));
+            if (!first.keyframe || first.needKeyframe || second.keyframe ||
+                JSON.stringify(second.changed) !== '["biosSerial"]' || second.snapshot.biosSerial !== 'BIOS-2') {
+                throw new Error('Keyframe and delta were not applied');
+            }
+            
+            // A lost heartbeat asks for a keyframe and keeps the last state
+            const [gap] = hardwareId.decodeTelemetry('test-device', late);
+            if (!gap.needKeyframe || gap.snapshot.biosSerial !== 'BIOS-2') {
+                throw new Error('Out-of-sequence delta was applied');
+            }
+            const [recovered] = hardwareId.decodeTelemetry('test-device', recovery);
+            if (!recovered.keyframe || recovered.needKeyframe || recovered.snapshot.biosSerial !== 'BIOS-4') {
+                throw new Error('Keyframe did not recover the stream');
+            }
+            console.log(`   Dropped frame: needKeyframe ${gap.needKeyframe}, recovered at sequence ${recovered.sequence}`);
+            
+            let truncatedRejected = false;
+            try {
+                hardwareId.decodeTelemetry('test-device', delta.subarray(0, delta.length - 1));
+            } catch (error) {
+                truncatedRejected = /offset 0\b/.test(error.message);
+            }
+            hardwareId.resetTelemetry('test-device');
+            const [afterReset] = hardwareId.decodeTelemetry('test-device', delta);
+            if (!truncatedRejected || !afterReset.needKeyframe || afterReset.snapshot !== null) {
+                throw new Error('Truncated frame or reset device state mismatch');
+            }
+        } catch (error) {
+            console.log(`   Telemetry stream: Error - ${error.message}`);
+            process.exitCode = 1;
+        }
+        
+        // Test the fleet registry
+        console.log('\n10. Testing fleet registry:');
+        try {
+            hardwareId.clearRegistry();
+            const board = { cpuId: 'BFEBFBFF000906EA', motherboardSerial: 'MB-1', biosSerial: 'BIOS-1' };
+            const first = { ...board, diskSerials: ['WD-1'], macAddresses: ['00:1A:2B:3C:4D:5E'], fingerprint: 'a1' };
+            const clone = JSON.parse(JSON.stringify(first));
+            const otherDisk = { ...first, diskSerials: ['WD-2'], fingerprint: 'a2' };
+            const noMac = { ...board, diskSerials: [], macAddresses: [], fingerprint: 'a3' };
+            const indices = hardwareId.registerRecords([first, clone, otherDisk, noMac]);
+            const ids = indices.map((index) => hardwareId.getRegisteredSnapshotId(index));
+            const stats = hardwareId.getRegistryStats();
+            console.log(`   Snapshot IDs: ${ids.join(', ')}; unique platforms ${stats.uniquePlatforms}, lists ${stats.uniqueLists}, snapshots ${stats.uniqueSnapshots}`);
+            if (ids[0] !== ids[1] || ids[0] === ids[2] || ids[2] === ids[3]) {
+                throw new Error('Equal records do not share a snapshot ID, or different ones do');
+            }
+            if (stats.uniquePlatforms !== 1 || stats.uniqueSnapshots !== 3) {
+                throw new Error('Component tuples were not hash-consed');
+            }
+            if (hardwareId.getRegisteredSnapshotId(indices.length) !== null) {
+                throw new Error('Unknown registry index returned a snapshot ID');
+            }
+            const stored = hardwareId.getRegisteredRecord(indices[1]);
+            if (stored.biosSerial !== clone.biosSerial || stored.diskSerials[0] !== clone.diskSerials[0]) {
+                throw new Error('Hash-consed record does not read back');
+            }
+            const byBios = Array.from(hardwareId.queryRegistry({ biosSerial: 'BIOS-1' }));
+            const byZeroPrefix = Array.from(hardwareId.queryRegistry({ macPrefix: '00' }));
+            if (byBios.length !== 4 || byZeroPrefix.includes(indices[3])) {
+                throw new Error(`Registry query mismatch: ${byBios} / ${byZeroPrefix}`);
+            }
+            hardwareId.clearRegistry();
+            let badTimeMessage = '';
+            try {
+                hardwareId.loadRegistrations(Buffer.from('{"cpuId":"C1","registeredAt":"not a date"}'));
+            } catch (error) {
+                badTimeMessage = error.message;
+            }
+            if (!/offset 29\b/.test(badTimeMessage) || hardwareId.getRegistryStats().records !== 0) {
+                throw new Error(`Unparseable registeredAt was not reported: '${badTimeMessage}'`);
+            }
+        } catch (error) {
+            console.log(`   Fleet registry: Error - ${error.message}`);
+            process.exitCode = 1;
+        }
+        
+        // Test CPU feature dispatch
+        console.log('\n11. Testing CPU feature dispatch:');
+        try {
+            const { cpu } = hardwareId.getCollectionStats();
+            const kernels = Object.entries(cpu.kernels);
+            console.log(`   Features: ${cpu.features.join(', ') || 'none'}`);
+            console.log(`   Kernels: ${kernels.map(([kernel, variant]) => `${kernel}=${variant}`).join(', ')}`);
+            if (!Array.isArray(cpu.features) || kernels.length === 0) {
+                throw new Error('No kernel variants reported');
+            }
+            // A fresh process with every extension disabled must fall back to scalar
+            const probe = "const h = require('./index'); process.stdout.write(JSON.stringify(h.getCollectionStats().cpu));";
+            const child = require('child_process').spawnSync(process.execPath, ['-e', probe], {
+                cwd: __dirname,
+                env: { ...process.env, HWID_DISABLE_CPU_FEATURES: 'all' },
+                encoding: 'utf8'
+            });
+            const fallback = JSON.parse(child.stdout);
+            const vectorized = Object.entries(fallback.kernels).filter(([, variant]) => variant !== 'scalar');
+            if (fallback.features.length !== 0 || vectorized.length !== 0) {
+                throw new Error(`HWID_DISABLE_CPU_FEATURES=all left ${vectorized.map(([kernel]) => kernel)} vectorized`);
+            }
+            console.log(`   With HWID_DISABLE_CPU_FEATURES=all: ${Object.keys(fallback.kernels).length} kernel(s) scalar`);
+        } catch (error) {
+            console.log(`   CPU feature dispatch: Error - ${error.message}`);
+            process.exitCode = 1;
+        }
+        
         // Test getHardwareSummary function
-        console.log('\n4. Testing hardware summary function:');
+        console.log('\n12. Testing hardware summary function:');
         try {
             const summary = hardwareId.getHardwareSummary();
             console.log('\n   Hardware Summary:');
@@ -111,7 +396,7 @@ async function testHardwareIdentification() {
         }
         
         // Test using the class directly
-        console.log('\n5. Testing direct class usage:');
+        console.log('\n13. Testing direct class usage:');
         try {
             const { HardwareId } = require('./index');
             const hwId = new HardwareId();
@@ -132,7 +417,7 @@ async function testHardwareIdentification() {
         console.error('\nUnexpected error during testing:', error);
     } finally {
         // Clean up
-        console.log('\n6. Cleaning up...');
+        console.log('\n14. Cleaning up...');
         try {
             hardwareId.cleanup();
             console.log('   Cleanup: SUCCESS');
@@ -186,7 +471,7 @@ if (require.main === module) {
     testHardwareIdentification()
         .then(() => {
             demonstrateUsage();
-            process.exit(0);
+            process.exit(process.exitCode || 0);
         })
         .catch((error) => {
             console.error('Test failed:', error);
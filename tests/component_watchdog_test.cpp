@@ -0,0 +1,147 @@
+/**
+ * @file component_watchdog_test.cpp
+ * @brief Deadlines, failures and stuck threads in ComponentWatchdog
+ *
+ * Also collects from a fake root whose motherboard serial is a FIFO
+ * nobody writes to, so the component hangs like a stuck device query and
+ * must be reported in timedOutComponents.
+ */
+
+#include "component_watchdog.h"
+#include "hardware_identifier.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Wait until no watchdog thread is stuck, at most a few seconds
+ */
+static bool WaitForStuckThreads(ComponentWatchdog& watchdog) {
+    for (int i = 0; i < 500; i++) {
+        if (watchdog.GetStats().stuckThreads == 0) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+/**
+ * @brief Completed, failed and abandoned tasks are counted apart
+ */
+static void CheckDeadlines(ComponentWatchdog& watchdog) {
+    ComponentWatchdogStats before = watchdog.GetStats();
+
+    std::shared_ptr<std::atomic<int>> runs = std::make_shared<std::atomic<int>>(0);
+    CHECK(watchdog.RunWithDeadline([runs]() { (*runs)++; }, std::chrono::milliseconds(5000)));
+    CHECK(*runs == 1);
+
+    // A task that throws fails without taking its thread down
+    CHECK(!watchdog.RunWithDeadline([]() { throw std::runtime_error("query failed"); },
+                                    std::chrono::milliseconds(5000)));
+    CHECK(watchdog.RunWithDeadline([runs]() { (*runs)++; }, std::chrono::milliseconds(5000)));
+    CHECK(*runs == 2);
+
+    // A task past its deadline is abandoned and holds its thread until it returns
+    std::shared_ptr<std::atomic<bool>> release = std::make_shared<std::atomic<bool>>(false);
+    CHECK(!watchdog.RunWithDeadline([release]() {
+        while (!*release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }, std::chrono::milliseconds(50)));
+    CHECK(watchdog.GetStats().stuckThreads == 1);
+    *release = true;
+    CHECK(WaitForStuckThreads(watchdog));
+
+    ComponentWatchdogStats after = watchdog.GetStats();
+    CHECK(after.completed - before.completed == 2);
+    CHECK(after.failed - before.failed == 1);
+    CHECK(after.timedOut - before.timedOut == 1);
+    CHECK(after.rejected == before.rejected);
+    CHECK(after.threads >= 1);
+}
+
+#ifndef _WIN32
+/**
+ * @brief A hung component is flagged and only blocks the fingerprint if required
+ */
+static void CheckHungComponent(ComponentWatchdog& watchdog, const fs::path& root) {
+    fs::create_directories(root / "sys/class/dmi/id");
+    std::ofstream(root / "sys/class/dmi/id/product_serial") << "BIOS-0123456789\n";
+    fs::create_directories(root / "sys/class/net/eth0");
+    std::ofstream(root / "sys/class/net/eth0/address") << "00:1a:2b:3c:4d:5e\n";
+    std::string fifo = (root / "sys/class/dmi/id/board_serial").string();
+    CHECK(mkfifo(fifo.c_str(), 0600) == 0);
+
+    std::shared_ptr<HardwareIdentifier> identifier = std::make_shared<HardwareIdentifier>();
+    identifier->SetRootPath(root.string());
+    CHECK(identifier->Initialize());
+
+    CollectionOptions options;
+    options.componentTimeoutMs = 200;
+    HardwareInfo info = identifier->GetAllHardwareInfo(options);
+    CHECK(info.timedOutComponents == ComponentBit(HardwareComponent::MotherboardSerial));
+    CHECK(info.motherboardSerial.empty());
+    CHECK(info.biosSerial == "BIOS-0123456789");
+    CHECK(info.macAddresses.size() == 1);
+    CHECK(info.fingerprint.empty());
+
+    // Outside the fingerprint profile the timeout is tolerated
+    options.requiredComponents = kAllHardwareComponents & ~ComponentBit(HardwareComponent::MotherboardSerial);
+    info = identifier->GetAllHardwareInfo(options);
+    CHECK(info.timedOutComponents == ComponentBit(HardwareComponent::MotherboardSerial));
+    CHECK(!info.fingerprint.empty());
+    CHECK(info.fingerprint == ComputeFingerprint(info));
+    CHECK(watchdog.GetStats().stuckThreads == 2);
+
+    // Opening the write end lets both abandoned reads return
+    int writer = open(fifo.c_str(), O_WRONLY | O_NONBLOCK);
+    CHECK(writer >= 0);
+    if (writer >= 0) {
+        close(writer);
+    }
+    CHECK(WaitForStuckThreads(watchdog));
+}
+#endif
+
+int main() {
+    ComponentWatchdog& watchdog = ComponentWatchdog::Instance();
+    CheckDeadlines(watchdog);
+
+#ifndef _WIN32
+    fs::path root = fs::temp_directory_path() / "component_watchdog_test_root";
+    fs::remove_all(root);
+    CheckHungComponent(watchdog, root);
+    fs::remove_all(root);
+#endif
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("component_watchdog_test: all checks passed\n");
+    return 0;
+}
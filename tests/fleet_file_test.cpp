@@ -0,0 +1,326 @@
+/**
+ * @file fleet_file_test.cpp
+ * @brief Fleet file round trip and rejection of damaged files
+ *
+ * Writes fleet files next to the test binary, reads every row back and
+ * runs queries against a row-by-row reference. Then truncates and patches
+ * a small file and checks that Open() rejects each damaged copy, and that
+ * no single-byte corruption that Open() accepts crashes a read.
+ */
+
+#include "fleet_file.h"
+#include "mac_address.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+// On-disk layout offsets, see the structures at the top of fleet_file.cpp
+static constexpr size_t kTrailerSize = 24;
+static constexpr size_t kFooterRowsPerGroup = 12;
+static constexpr size_t kFooterColumns = 16;
+static constexpr size_t kColumnInfoSize = 24;
+static constexpr size_t kFooterHeaderSize = kFooterColumns + 7 * kColumnInfoSize;
+static constexpr size_t kGroupRows = 8;
+
+/**
+ * @brief Owned row values behind the FleetScalarRow views
+ */
+struct StoredRow {
+    std::string cpuId;
+    std::string motherboardSerial;
+    std::string biosSerial;
+    std::string fingerprint;
+    std::string firstDiskSerial;
+    uint64_t primaryMac;
+    bool hasPrimaryMac;
+    int64_t registeredAtMs;
+};
+
+static std::vector<StoredRow> MakeRows(uint64_t count, bool hexFingerprints) {
+    std::vector<StoredRow> rows(count);
+    char text[32];
+    for (uint64_t i = 0; i < count; i++) {
+        StoredRow& row = rows[i];
+        snprintf(text, sizeof(text), "CPU-%llu", static_cast<unsigned long long>(i % 13));
+        row.cpuId = text;
+        snprintf(text, sizeof(text), "MB-%llu", static_cast<unsigned long long>(i % 1009));
+        row.motherboardSerial = text;
+        row.biosSerial = i % 3 ? "To be filled by O.E.M." : "BIOS-7";
+        if (hexFingerprints) {
+            snprintf(text, sizeof(text), "%llx", static_cast<unsigned long long>(i * 0x9E3779B97F4A7C15ULL | 1));
+        } else {
+            snprintf(text, sizeof(text), "fp-%llu", static_cast<unsigned long long>(i));
+        }
+        row.fingerprint = text;
+        row.firstDiskSerial = i % 5 ? "" : "WD-" + std::to_string(i);
+        // Every seventh row has no MAC; some others have the all-zero address
+        row.hasPrimaryMac = i % 7 != 0;
+        row.primaryMac = row.hasPrimaryMac && i % 11 ? (0x001A2B000000ULL | (i & 0xFFFFFF)) : 0;
+        row.registeredAtMs = 1700000000000LL + static_cast<int64_t>(i) * 1000 - (i % 2 ? 500 : 0);
+    }
+    return rows;
+}
+
+static bool Write(const std::string& path, const std::vector<StoredRow>& rows) {
+    std::string error;
+    bool written = WriteFleetFile(path, rows.size(), [&rows](uint64_t index, FleetScalarRow& row) {
+        const StoredRow& stored = rows[index];
+        row.cpuId = stored.cpuId;
+        row.motherboardSerial = stored.motherboardSerial;
+        row.biosSerial = stored.biosSerial;
+        row.fingerprint = stored.fingerprint;
+        row.firstDiskSerial = stored.firstDiskSerial;
+        row.primaryMac = stored.primaryMac;
+        row.hasPrimaryMac = stored.hasPrimaryMac;
+        row.registeredAtMs = stored.registeredAtMs;
+        return true;
+    }, error);
+    if (!written) {
+        fprintf(stderr, "%s\n", error.c_str());
+    }
+    return written;
+}
+
+static bool RowEquals(const FleetScalarRow& row, const StoredRow& stored) {
+    return row.cpuId == stored.cpuId && row.motherboardSerial == stored.motherboardSerial &&
+           row.biosSerial == stored.biosSerial && row.fingerprint == stored.fingerprint &&
+           row.firstDiskSerial == stored.firstDiskSerial && row.primaryMac == stored.primaryMac &&
+           row.hasPrimaryMac == stored.hasPrimaryMac &&
+           row.registeredAtMs == stored.registeredAtMs;
+}
+
+/**
+ * @brief Evaluate a query row by row
+ */
+static std::vector<uint64_t> ReferenceFilter(const std::vector<StoredRow>& rows, const FleetFileQuery& query) {
+    std::vector<uint64_t> matches;
+    for (uint64_t i = 0; i < rows.size(); i++) {
+        const StoredRow& row = rows[i];
+        bool match = true;
+        for (const auto& equal : query.equals) {
+            const std::string* value = nullptr;
+            switch (equal.first) {
+                case FleetFileColumn::CpuId:             value = &row.cpuId; break;
+                case FleetFileColumn::MotherboardSerial: value = &row.motherboardSerial; break;
+                case FleetFileColumn::BiosSerial:        value = &row.biosSerial; break;
+                case FleetFileColumn::Fingerprint:       value = &row.fingerprint; break;
+                case FleetFileColumn::FirstDiskSerial:   value = &row.firstDiskSerial; break;
+                default: break;
+            }
+            match = match && value && *value == equal.second;
+        }
+        match = match && (!query.hasMacPrefix ||
+                          (row.hasPrimaryMac && (row.primaryMac & query.macMask) == (query.macValue & query.macMask)));
+        match = match && (!query.hasRegisteredAfter || row.registeredAtMs >= query.registeredAfterMs);
+        match = match && (!query.hasRegisteredBefore || row.registeredAtMs < query.registeredBeforeMs);
+        if (match) {
+            matches.push_back(i);
+        }
+    }
+    return matches;
+}
+
+static void CheckRoundTrip(const std::string& path, uint64_t rowCount, bool hexFingerprints) {
+    std::vector<StoredRow> rows = MakeRows(rowCount, hexFingerprints);
+    CHECK(Write(path, rows));
+
+    FleetFileReader reader;
+    std::string error;
+    CHECK(reader.Open(path, error));
+    CHECK(reader.RowCount() == rowCount);
+    CHECK(reader.RowGroupCount() == (rowCount + kFleetFileRowsPerGroup - 1) / kFleetFileRowsPerGroup);
+    CHECK(reader.ColumnEncoding(FleetFileColumn::Fingerprint) ==
+          (hexFingerprints ? FleetFileEncoding::FixedWidth : FleetFileEncoding::Dictionary));
+
+    size_t mismatches = 0;
+    FleetScalarRow row;
+    for (uint64_t i = 0; i < rowCount; i++) {
+        if (!reader.ReadRow(i, row) || !RowEquals(row, rows[i])) {
+            mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(!reader.ReadRow(rowCount, row));
+
+    std::vector<FleetFileQuery> queries(8);
+    queries[0].equals = { { FleetFileColumn::CpuId, "CPU-4" }, { FleetFileColumn::BiosSerial, "BIOS-7" } };
+    queries[1].equals = { { FleetFileColumn::Fingerprint, rows[rowCount / 2].fingerprint } };
+    queries[2].equals = { { FleetFileColumn::MotherboardSerial, "MB-none" } };
+    queries[3].hasMacPrefix = ParseMacPrefix("00:1A:2B:00:01", queries[3].macValue, queries[3].macMask);
+    queries[4].hasRegisteredAfter = true;
+    queries[4].registeredAfterMs = rows[rowCount / 3].registeredAtMs;
+    queries[4].hasRegisteredBefore = true;
+    queries[4].registeredBeforeMs = rows[rowCount / 3 + 100].registeredAtMs;
+    queries[5].equals = { { FleetFileColumn::FirstDiskSerial, "" } };
+    queries[5].hasMacPrefix = ParseMacPrefix("00:1A:2B", queries[5].macValue, queries[5].macMask);
+    queries[6].hasMacPrefix = ParseMacPrefix("00", queries[6].macValue, queries[6].macMask);
+    queries[7].hasMacPrefix = ParseMacPrefix("00:00:00:00:00:00", queries[7].macValue, queries[7].macMask);
+    for (size_t q = 0; q < queries.size(); q++) {
+        FleetFileScanStats stats;
+        std::vector<uint64_t> actual = reader.Filter(queries[q], &stats);
+        if (actual != ReferenceFilter(rows, queries[q])) {
+            fprintf(stderr, "%s query %zu: %zu rows differ from the reference\n", path.c_str(), q, actual.size());
+            g_failures++;
+        }
+        CHECK(stats.rowGroups == reader.RowGroupCount());
+    }
+    reader.Close();
+    remove(path.c_str());
+}
+
+static std::vector<char> ReadBytes(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+static void WriteBytes(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+template <typename T>
+static T Load(const std::vector<char>& bytes, size_t offset) {
+    T value;
+    memcpy(&value, bytes.data() + offset, sizeof(value));
+    return value;
+}
+
+template <typename T>
+static std::vector<char> Patched(std::vector<char> bytes, size_t offset, T value) {
+    memcpy(bytes.data() + offset, &value, sizeof(value));
+    return bytes;
+}
+
+static bool Opens(const std::string& path, const std::vector<char>& bytes) {
+    WriteBytes(path, bytes);
+    FleetFileReader reader;
+    std::string error;
+    return reader.Open(path, error);
+}
+
+/**
+ * @brief Open a damaged copy and, if accepted, read everything in it
+ */
+static void ReadDamaged(const std::string& path, const std::vector<char>& bytes) {
+    WriteBytes(path, bytes);
+    FleetFileReader reader;
+    std::string error;
+    if (!reader.Open(path, error)) {
+        return;
+    }
+    FleetScalarRow row;
+    for (uint64_t i = 0; i < reader.RowCount(); i++) {
+        reader.ReadRow(i, row);
+    }
+    FleetFileQuery query;
+    query.equals = { { FleetFileColumn::CpuId, "CPU-1" } };
+    query.hasRegisteredAfter = true;
+    reader.Filter(query);
+}
+
+static void CheckDamagedFiles(const std::string& path) {
+    CHECK(Write(path, MakeRows(100, false)));
+    const std::vector<char> good = ReadBytes(path);
+    CHECK(Opens(path, good));
+
+    size_t footer = static_cast<size_t>(Load<uint64_t>(good, good.size() - kTrailerSize));
+    size_t group = footer + kFooterHeaderSize;
+    size_t cpuColumn = footer + kFooterColumns;
+    size_t macColumn = footer + kFooterColumns + 5 * kColumnInfoSize;
+    size_t dictionary = static_cast<size_t>(Load<uint64_t>(good, cpuColumn + 8));
+    uint64_t dictionaryCount = Load<uint64_t>(good, cpuColumn + 16);
+    CHECK(dictionaryCount == 13);
+
+    // Truncated anywhere
+    for (size_t size = 0; size < good.size(); size++) {
+        if (Opens(path, std::vector<char>(good.begin(), good.begin() + static_cast<std::ptrdiff_t>(size)))) {
+            fprintf(stderr, "truncated to %zu bytes: opened\n", size);
+            g_failures++;
+        }
+    }
+
+    // Row group size, which ReadRow() divides by
+    CHECK(!Opens(path, Patched<uint32_t>(good, footer + kFooterRowsPerGroup, 0)));
+    CHECK(!Opens(path, Patched<uint32_t>(good, footer + kFooterRowsPerGroup, 64)));
+
+    // Row group placement
+    CHECK(!Opens(path, Patched<uint64_t>(good, group, 1)));
+    CHECK(!Opens(path, Patched<uint64_t>(good, group, UINT64_MAX)));
+    CHECK(!Opens(path, Patched<uint32_t>(good, group + kGroupRows, 99)));
+    CHECK(!Opens(path, Patched<uint64_t>(good, footer, 101)));
+
+    // Column encodings
+    CHECK(!Opens(path, Patched<uint32_t>(good, cpuColumn, 0)));
+    CHECK(!Opens(path, Patched<uint32_t>(good, cpuColumn, 4)));
+    CHECK(!Opens(path, Patched<uint32_t>(good, macColumn, static_cast<uint32_t>(FleetFileEncoding::Dictionary))));
+
+    // Dictionary offset tables
+    uint64_t first = Load<uint64_t>(good, dictionary + 8);
+    CHECK(!Opens(path, Patched<uint64_t>(good, dictionary, 1)));
+    CHECK(!Opens(path, Patched<uint64_t>(good, dictionary + 16, first - 1)));
+    CHECK(!Opens(path, Patched<uint64_t>(good, dictionary + 8, UINT64_MAX)));
+    CHECK(!Opens(path, Patched<uint64_t>(good, dictionary + dictionaryCount * 8, UINT64_MAX / 2)));
+    CHECK(!Opens(path, Patched<uint64_t>(good, cpuColumn + 8, good.size())));
+    CHECK(!Opens(path, Patched<uint64_t>(good, cpuColumn + 16, UINT64_MAX)));
+
+    // Any single damaged byte either fails to open or reads safely
+    for (size_t offset = 0; offset < good.size(); offset++) {
+        std::vector<char> damaged = good;
+        damaged[offset] = static_cast<char>(damaged[offset] ^ 0xA5);
+        ReadDamaged(path, damaged);
+    }
+    remove(path.c_str());
+}
+
+/**
+ * @brief A record without a MAC never matches an all-zero prefix
+ */
+static void CheckMissingMac(const std::string& path) {
+    std::vector<StoredRow> rows = MakeRows(2, false);
+    rows[0].hasPrimaryMac = false;
+    rows[0].primaryMac = 0;
+    rows[1].hasPrimaryMac = true;
+    rows[1].primaryMac = 0x00AABBCCDDEEULL;
+    CHECK(Write(path, rows));
+
+    FleetFileReader reader;
+    std::string error;
+    CHECK(reader.Open(path, error));
+    FleetFileQuery query;
+    query.hasMacPrefix = ParseMacPrefix("00", query.macValue, query.macMask);
+    CHECK(reader.Filter(query) == std::vector<uint64_t>{ 1 });
+    FleetScalarRow row;
+    CHECK(reader.ReadRow(0, row) && !row.hasPrimaryMac && row.primaryMac == 0);
+    CHECK(reader.ReadRow(1, row) && row.hasPrimaryMac && row.primaryMac == 0x00AABBCCDDEEULL);
+    reader.Close();
+    remove(path.c_str());
+}
+
+int main() {
+    CheckMissingMac("fleet_file_test_mac.hwcol");
+
+    // Two row groups, the second partial
+    CheckRoundTrip("fleet_file_test_hex.hwcol", kFleetFileRowsPerGroup + 4464, true);
+    CheckRoundTrip("fleet_file_test_text.hwcol", 1000, false);
+    CheckDamagedFiles("fleet_file_test_damaged.hwcol");
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("fleet_file_test: all checks passed\n");
+    return 0;
+}
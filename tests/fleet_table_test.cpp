@@ -0,0 +1,165 @@
+/**
+ * @file fleet_table_test.cpp
+ * @brief FleetTable scans against a row-by-row reference
+ *
+ * ctest runs this twice, once as is and once with
+ * HWID_DISABLE_CPU_FEATURES=all, so the SIMD and scalar kernels are both
+ * checked against the same reference.
+ */
+
+#include "fleet_table.h"
+#include "cpu_features.h"
+#include "mac_address.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Row as appended, kept for the reference scan
+ */
+struct ReferenceRow {
+    InternId ids[5];
+    uint64_t mac;
+    bool hasMac;
+};
+
+/**
+ * @brief Deterministic generator so failures reproduce
+ */
+static uint32_t NextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/**
+ * @brief Evaluate predicates row by row
+ */
+static std::vector<uint32_t> ReferenceFilter(const std::vector<ReferenceRow>& rows,
+                                             const std::vector<FleetPredicate>& predicates) {
+    std::vector<uint32_t> matches;
+    for (uint32_t row = 0; row < rows.size(); row++) {
+        bool match = true;
+        for (const FleetPredicate& predicate : predicates) {
+            if (predicate.column == FleetColumn::PrimaryMac) {
+                match = match && rows[row].hasMac && (rows[row].mac & predicate.mask) == predicate.value;
+            } else {
+                match = match && rows[row].ids[static_cast<uint32_t>(predicate.column)] == predicate.value;
+            }
+        }
+        if (match) {
+            matches.push_back(row);
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Build a MAC predicate from prefix text
+ */
+static FleetPredicate MacPredicate(const char* prefix) {
+    FleetPredicate predicate = { FleetColumn::PrimaryMac, 0, 0 };
+    if (!ParseMacPrefix(prefix, predicate.value, predicate.mask)) {
+        fprintf(stderr, "bad prefix %s\n", prefix);
+        g_failures++;
+    }
+    return predicate;
+}
+
+int main() {
+    const char* disabled = getenv("HWID_DISABLE_CPU_FEATURES");
+    bool scalarOnly = disabled && strcmp(disabled, "all") == 0;
+    for (const auto& variant : GetKernelVariants()) {
+        if (variant.first.compare(0, 11, "fleetTable.") == 0) {
+            printf("%s: %s\n", variant.first.c_str(), variant.second.c_str());
+            if (scalarOnly) {
+                CHECK(variant.second == "scalar");
+            }
+        }
+    }
+
+    // Not a multiple of 64, so the last bitmap word is partial
+    const uint32_t kRows = 1000;
+    const uint64_t kOuis[] = { 0x001A2B, 0x000000, 0xF4F5E8 };
+    FleetTable table;
+    std::vector<ReferenceRow> rows;
+    uint32_t state = 0x9E3779B9;
+    for (uint32_t i = 0; i < kRows; i++) {
+        ReferenceRow row;
+        for (InternId& id : row.ids) {
+            id = NextRandom(state) % 7;
+        }
+        // One row in four has no MAC; some present ones are all-zero
+        row.hasMac = NextRandom(state) % 4 != 0;
+        uint64_t oui = kOuis[NextRandom(state) % 3];
+        uint64_t nic = NextRandom(state) % 3 == 0 ? 0 : (NextRandom(state) & 0xFFFFFF);
+        row.mac = row.hasMac ? (oui << 24 | nic) : 0;
+        CHECK(table.Append(row.ids, row.mac, row.hasMac) == i);
+        rows.push_back(row);
+    }
+    CHECK(table.Size() == kRows);
+    CHECK(!table.HasPrimaryMac(0) || rows[0].hasMac);
+
+    std::vector<std::vector<FleetPredicate>> queries = {
+        {},
+        { MacPredicate("00:00:00") },
+        { MacPredicate("00:00:00:00:00:00") },
+        { MacPredicate("00") },
+        { MacPredicate("00:1A:2B") },
+        { MacPredicate("F4:F5:E8"), FleetPredicate{ FleetColumn::CpuId, 3, 0 } },
+        { FleetPredicate{ FleetColumn::BiosSerial, 1, 0 }, FleetPredicate{ FleetColumn::FirstDiskSerial, 2, 0 } },
+        { FleetPredicate{ FleetColumn::Fingerprint, 99, 0 } },
+    };
+    for (size_t q = 0; q < queries.size(); q++) {
+        std::vector<uint32_t> expected = ReferenceFilter(rows, queries[q]);
+        for (unsigned threads : { 1u, 4u }) {
+            std::vector<uint32_t> actual = table.Filter(queries[q], threads);
+            if (actual != expected) {
+                fprintf(stderr, "query %zu with %u thread(s): %zu rows, expected %zu\n",
+                        q, threads, actual.size(), expected.size());
+                g_failures++;
+            }
+        }
+    }
+
+    // Rows without a MAC never match, not even the all-zero address
+    size_t macless = 0;
+    for (uint32_t row : table.Filter({}, 1)) {
+        if (!table.HasPrimaryMac(row)) {
+            macless++;
+            CHECK(table.PrimaryMac(row) == 0);
+        }
+    }
+    CHECK(macless > 0);
+    for (uint32_t row : table.Filter({ MacPredicate("00:00:00:00:00:00") }, 1)) {
+        CHECK(table.HasPrimaryMac(row));
+    }
+
+    table.Clear();
+    CHECK(table.Size() == 0);
+    CHECK(table.Filter({ MacPredicate("00") }, 1).empty());
+    uint64_t none = 0;
+    InternId ids[5] = { 0, 0, 0, 0, 0 };
+    table.Append(ids, none, false);
+    CHECK(table.Filter({ MacPredicate("00:00:00") }, 1).empty());
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("fleet_table_test: all checks passed\n");
+    return 0;
+}
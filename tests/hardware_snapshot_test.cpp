@@ -0,0 +1,223 @@
+/**
+ * @file hardware_snapshot_test.cpp
+ * @brief Round trips through HardwareSnapshot and ArenaSnapshot
+ *
+ * Covers inline and overflow fields, truncation of the bounded disk and
+ * MAC arrays, byte-level equality of equal snapshots, and copies of the
+ * single-block ArenaSnapshot.
+ */
+
+#include "hardware_snapshot.h"
+#include "arena_snapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Compare every field of two snapshots
+ */
+static bool SameInfo(const HardwareInfo& a, const HardwareInfo& b) {
+    return a.cpuId == b.cpuId && a.motherboardSerial == b.motherboardSerial && a.biosSerial == b.biosSerial &&
+           a.diskSerials == b.diskSerials && a.macAddresses == b.macAddresses && a.fingerprint == b.fingerprint &&
+           a.timedOutComponents == b.timedOutComponents;
+}
+
+/**
+ * @brief Identifiers with values on both sides of the inline capacity
+ */
+static HardwareInfo SampleInfo() {
+    HardwareInfo info;
+    info.cpuId = "BFEBFBFF000906EA";
+    info.motherboardSerial = std::string(SnapshotField::kInlineCapacity, 'M');
+    info.biosSerial = std::string(SnapshotField::kInlineCapacity + 1, 'B');
+    info.diskSerials = {"WD-WCC4N0123456", std::string(200, 'D'), ""};
+    info.macAddresses = {"00:1A:2B:3C:4D:5E", "00:1A:2B:3C:4D:5F"};
+    info.fingerprint = "5d0f9e1c2b3a4f60";
+    info.timedOutComponents = ComponentBit(HardwareComponent::BiosSerial);
+    return info;
+}
+
+static void CheckHardwareSnapshot() {
+    HardwareInfo info = SampleInfo();
+    HardwareSnapshot snapshot;
+    SnapshotArena arena;
+    SnapshotFromHardwareInfo(info, snapshot, arena);
+
+    CHECK(!snapshot.motherboardSerial.IsOverflow());
+    CHECK(snapshot.biosSerial.IsOverflow());
+    CHECK(snapshot.diskSerials[1].IsOverflow());
+    CHECK(arena.Size() == info.biosSerial.size() + info.diskSerials[1].size());
+    CHECK(snapshot.diskSerialCount == 3 && snapshot.macAddressCount == 2 && snapshot.droppedEntries == 0);
+    CHECK(GetSnapshotField(snapshot.biosSerial, arena) == info.biosSerial);
+    CHECK(SameInfo(SnapshotToHardwareInfo(snapshot, arena), info));
+
+    // A memcpy'd snapshot reads the same through the same arena
+    HardwareSnapshot copy;
+    memcpy(&copy, &snapshot, sizeof(copy));
+    CHECK(HashSnapshotBytes(copy) == HashSnapshotBytes(snapshot));
+    CHECK(SameInfo(SnapshotToHardwareInfo(copy, arena), info));
+
+    // Overwriting a field with a shorter value leaves no stale bytes behind
+    HardwareInfo shorter = info;
+    shorter.cpuId = "178BFBFF00800F82";
+    shorter.macAddresses[0] = "00:1A:2B";
+    HardwareSnapshot reference;
+    SnapshotArena referenceArena;
+    SnapshotFromHardwareInfo(shorter, reference, referenceArena);
+    SetSnapshotField(copy.cpuId, shorter.cpuId, arena);
+    SetSnapshotField(copy.macAddresses[0], shorter.macAddresses[0], arena);
+    CHECK(memcmp(&copy.cpuId, &reference.cpuId, sizeof(SnapshotField)) == 0);
+    CHECK(memcmp(&copy.macAddresses[0], &reference.macAddresses[0], sizeof(SnapshotField)) == 0);
+    CHECK(HashSnapshotBytes(copy) != HashSnapshotBytes(snapshot));
+
+    // Inline-only snapshots hash equal exactly when their values are equal
+    HardwareInfo small;
+    small.cpuId = "BFEBFBFF000906EA";
+    small.macAddresses = {"00:1A:2B:3C:4D:5E"};
+    HardwareSnapshot first;
+    HardwareSnapshot second;
+    SnapshotArena unused;
+    SnapshotFromHardwareInfo(small, first, unused);
+    SnapshotFromHardwareInfo(small, second, unused);
+    CHECK(unused.Size() == 0);
+    CHECK(HashSnapshotBytes(first) == HashSnapshotBytes(second));
+    small.macAddresses[0] = "00:1A:2B:3C:4D:5F";
+    SnapshotFromHardwareInfo(small, second, unused);
+    CHECK(HashSnapshotBytes(first) != HashSnapshotBytes(second));
+
+    ClearSnapshot(second);
+    HardwareSnapshot zero;
+    memset(&zero, 0, sizeof(zero));
+    CHECK(memcmp(&second, &zero, sizeof(zero)) == 0);
+    CHECK(SameInfo(SnapshotToHardwareInfo(second, unused), HardwareInfo()));
+}
+
+/**
+ * @brief Entries beyond the inline arrays are counted and dropped
+ */
+static void CheckTruncation() {
+    HardwareInfo info;
+    for (size_t i = 0; i < HardwareSnapshot::kMaxDiskSerials + 3; i++) {
+        info.diskSerials.push_back("DISK-" + std::to_string(i));
+    }
+    for (size_t i = 0; i < HardwareSnapshot::kMaxMacAddresses + 1; i++) {
+        char address[18];
+        snprintf(address, sizeof(address), "00:1A:2B:3C:4D:%02X", static_cast<unsigned>(i));
+        info.macAddresses.push_back(address);
+    }
+
+    HardwareSnapshot snapshot;
+    SnapshotArena arena;
+    SnapshotFromHardwareInfo(info, snapshot, arena);
+    CHECK(snapshot.diskSerialCount == HardwareSnapshot::kMaxDiskSerials);
+    CHECK(snapshot.macAddressCount == HardwareSnapshot::kMaxMacAddresses);
+    CHECK(snapshot.droppedEntries == 4);
+
+    HardwareInfo expanded = SnapshotToHardwareInfo(snapshot, arena);
+    CHECK(expanded.diskSerials ==
+          std::vector<std::string>(info.diskSerials.begin(),
+                                   info.diskSerials.begin() + HardwareSnapshot::kMaxDiskSerials));
+    CHECK(expanded.macAddresses ==
+          std::vector<std::string>(info.macAddresses.begin(),
+                                   info.macAddresses.begin() + HardwareSnapshot::kMaxMacAddresses));
+
+    // A snapshot re-filled from fewer entries forgets the dropped count
+    info.diskSerials.resize(1);
+    info.macAddresses.clear();
+    SnapshotFromHardwareInfo(info, snapshot, arena);
+    CHECK(snapshot.diskSerialCount == 1 && snapshot.macAddressCount == 0 && snapshot.droppedEntries == 0);
+}
+
+static void CheckSnapshotArena() {
+    SnapshotArena arena;
+    uint32_t first = arena.Append("first");
+    uint32_t second = arena.Append("second");
+    CHECK(first == 0 && second == 5);
+    CHECK(arena.View(second, 6) == "second");
+    CHECK(arena.View(second, 7).empty());
+    CHECK(arena.View(100, 1).empty());
+
+    size_t capacity = arena.Capacity();
+    arena.Clear();
+    CHECK(arena.Size() == 0 && arena.Capacity() == capacity);
+}
+
+static void CheckArenaSnapshot() {
+    ArenaSnapshot empty;
+    CHECK(empty.IsEmpty());
+    CHECK(empty.AllocatedBytes() == 0);
+    CHECK(empty.CpuId().empty() && empty.DiskSerialCount() == 0 && empty.MacAddressCount() == 0);
+    CHECK(SameInfo(empty.ToHardwareInfo(), HardwareInfo()));
+
+    // Unlike HardwareSnapshot, every entry is kept
+    HardwareInfo info = SampleInfo();
+    for (size_t i = 0; i < HardwareSnapshot::kMaxDiskSerials + 3; i++) {
+        info.diskSerials.push_back("DISK-" + std::to_string(i));
+    }
+    ArenaSnapshot snapshot(info);
+    CHECK(!snapshot.IsEmpty());
+    CHECK(snapshot.CpuId() == info.cpuId);
+    CHECK(snapshot.BiosSerial() == info.biosSerial);
+    CHECK(snapshot.Fingerprint() == info.fingerprint);
+    CHECK(snapshot.DiskSerialCount() == info.diskSerials.size());
+    CHECK(snapshot.DiskSerial(1) == info.diskSerials[1]);
+    CHECK(snapshot.DiskSerial(2).empty());
+    CHECK(snapshot.MacAddress(1) == info.macAddresses[1]);
+    CHECK(snapshot.TimedOutComponents() == info.timedOutComponents);
+    CHECK(SameInfo(snapshot.ToHardwareInfo(), info));
+
+    // One block holds the strings and a small offset table
+    size_t stringBytes = info.cpuId.size() + info.motherboardSerial.size() + info.biosSerial.size() +
+                         info.fingerprint.size();
+    for (const std::string& value : info.diskSerials) {
+        stringBytes += value.size();
+    }
+    for (const std::string& value : info.macAddresses) {
+        stringBytes += value.size();
+    }
+    size_t entries = info.diskSerials.size() + info.macAddresses.size();
+    CHECK(snapshot.AllocatedBytes() > stringBytes + entries * 2 * sizeof(uint32_t));
+    CHECK(snapshot.AllocatedBytes() < stringBytes + entries * 2 * sizeof(uint32_t) + 128);
+
+    // Copies own their block; moves hand it over
+    ArenaSnapshot copy(snapshot);
+    CHECK(copy.AllocatedBytes() == snapshot.AllocatedBytes());
+    CHECK(copy.CpuId().data() != snapshot.CpuId().data());
+    CHECK(SameInfo(copy.ToHardwareInfo(), info));
+    ArenaSnapshot assigned;
+    assigned = copy;
+    assigned = assigned;
+    CHECK(SameInfo(assigned.ToHardwareInfo(), info));
+    ArenaSnapshot moved(std::move(copy));
+    CHECK(copy.IsEmpty());
+    CHECK(SameInfo(moved.ToHardwareInfo(), info));
+    assigned = ArenaSnapshot(HardwareInfo());
+    CHECK(!assigned.IsEmpty());
+    CHECK(SameInfo(assigned.ToHardwareInfo(), HardwareInfo()));
+}
+
+int main() {
+    CheckHardwareSnapshot();
+    CheckTruncation();
+    CheckSnapshotArena();
+    CheckArenaSnapshot();
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("hardware_snapshot_test: all checks passed\n");
+    return 0;
+}
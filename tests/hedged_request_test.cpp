@@ -0,0 +1,196 @@
+/**
+ * @file hedged_request_test.cpp
+ * @brief Hedging decisions, hedge delay percentile and nested hedges
+ *
+ * Fake sources either answer at once, sleep, or block until released, so
+ * each case knows which source must win and whether the secondary had to
+ * be started. Every case uses its own source name, since stats and latency
+ * samples are kept per name for the life of the process.
+ */
+
+#include "hedged_request.h"
+#include "component_watchdog.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Get the stats of one hedged source
+ */
+static HedgeStats StatsOf(const std::string& name) {
+    for (const HedgeStats& stats : HedgedSource::GetAllStats()) {
+        if (stats.name == name) {
+            return stats;
+        }
+    }
+    return HedgeStats();
+}
+
+/**
+ * @brief Source that blocks until its release flag is set
+ */
+static HedgedSource::Source Blocking(std::shared_ptr<std::atomic<bool>> release, const char* value) {
+    return [release, value]() {
+        while (!*release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return std::string(value);
+    };
+}
+
+/**
+ * @brief Source that sleeps before answering
+ */
+static HedgedSource::Source Sleeping(int milliseconds, const char* value) {
+    return [milliseconds, value]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        return std::string(value);
+    };
+}
+
+/**
+ * @brief Wait until no watchdog thread is stuck, at most a few seconds
+ */
+static bool WaitForStuckThreads() {
+    for (int i = 0; i < 500; i++) {
+        if (ComponentWatchdog::Instance().GetStats().stuckThreads == 0) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+/**
+ * @brief Which source wins, and when the secondary is started
+ */
+static void CheckDecisions() {
+    // A primary answering within the hedge delay is never hedged
+    CHECK(HedgedSource::Get("test.fast").Run([]() { return std::string(" MB-1 \n"); },
+                                             []() { return std::string("MB-2"); }) == "MB-1");
+    HedgeStats stats = StatsOf("test.fast");
+    CHECK(stats.requests == 1 && stats.hedged == 0 && stats.primaryWins == 1 && stats.secondaryWins == 0);
+    CHECK(stats.lastWinner == "primary");
+    CHECK(stats.hedgeDelayMs == 50);
+
+    // An empty primary starts the secondary at once instead of after the delay
+    CHECK(HedgedSource::Get("test.empty").Run([]() { return std::string(" \0 ", 3); },
+                                              []() { return std::string("MB-2"); }) == "MB-2");
+    stats = StatsOf("test.empty");
+    CHECK(stats.hedged == 1 && stats.secondaryWins == 1 && stats.lastWinner == "secondary");
+    CHECK(stats.lastLatencyMs < 40);
+
+    // So does a primary that throws
+    CHECK(HedgedSource::Get("test.throwing").Run([]() -> std::string { throw std::runtime_error("no WMI"); },
+                                                 []() { return std::string("MB-2"); }) == "MB-2");
+    CHECK(StatsOf("test.throwing").secondaryWins == 1);
+
+    // A slow primary is hedged after the delay and abandoned once the secondary wins
+    std::shared_ptr<std::atomic<bool>> release = std::make_shared<std::atomic<bool>>(false);
+    CHECK(HedgedSource::Get("test.slow").Run(Blocking(release, "MB-1"),
+                                             []() { return std::string("MB-2"); }) == "MB-2");
+    stats = StatsOf("test.slow");
+    CHECK(stats.hedged == 1 && stats.secondaryWins == 1 && stats.primaryWins == 0);
+    CHECK(stats.lastLatencyMs >= 50);
+    CHECK(ComponentWatchdog::Instance().GetStats().stuckThreads == 1);
+    *release = true;
+    CHECK(WaitForStuckThreads());
+
+    // The primary still wins if it answers first after the secondary was started
+    CHECK(HedgedSource::Get("test.bothSlow").Run(Sleeping(60, "MB-1"), Sleeping(500, "MB-2")) == "MB-1");
+    stats = StatsOf("test.bothSlow");
+    CHECK(stats.hedged == 1 && stats.primaryWins == 1);
+    CHECK(WaitForStuckThreads());
+
+    CHECK(HedgedSource::Get("test.none").Run([]() { return std::string(); },
+                                             []() { return std::string("\t"); }).empty());
+    stats = StatsOf("test.none");
+    CHECK(stats.empty == 1 && stats.lastWinner == "none");
+}
+
+/**
+ * @brief The hedge delay follows the 95th percentile of primary latencies
+ *
+ * The secondary answers empty, so every request waits for the primary and
+ * records its latency before returning.
+ */
+static void CheckHedgeDelay() {
+    auto none = []() { return std::string(); };
+
+    // Seven samples are too few; the initial delay still applies
+    HedgedSource& source = HedgedSource::Get("test.percentile");
+    CHECK(source.Run(Sleeping(30, "MB-1"), none) == "MB-1");
+    CHECK(source.Run(Sleeping(30, "MB-1"), none) == "MB-1");
+    for (int i = 0; i < 5; i++) {
+        CHECK(source.Run(Sleeping(0, "MB-1"), none) == "MB-1");
+    }
+    CHECK(StatsOf("test.percentile").hedgeDelayMs == 50);
+
+    // With 20 samples the 95th percentile is the 19th smallest, a slow one
+    for (int i = 0; i < 13; i++) {
+        CHECK(source.Run(Sleeping(0, "MB-1"), none) == "MB-1");
+    }
+    double delayMs = StatsOf("test.percentile").hedgeDelayMs;
+    CHECK(delayMs >= 30 && delayMs < 1000);
+
+    // With only one slow sample in 20 it is a fast one, floored at 1 ms
+    HedgedSource& fast = HedgedSource::Get("test.percentileFast");
+    CHECK(fast.Run(Sleeping(30, "MB-1"), none) == "MB-1");
+    for (int i = 0; i < 19; i++) {
+        CHECK(fast.Run(Sleeping(0, "MB-1"), none) == "MB-1");
+    }
+    delayMs = StatsOf("test.percentileFast").hedgeDelayMs;
+    CHECK(delayMs >= 1 && delayMs < 30);
+    CHECK(StatsOf("test.percentileFast").hedged == 0);
+}
+
+/**
+ * @brief A hedge inside an abandoned watchdog task counts its threads as stuck
+ */
+static void CheckNestedHedge() {
+    ComponentWatchdog& watchdog = ComponentWatchdog::Instance();
+    std::shared_ptr<std::atomic<bool>> release = std::make_shared<std::atomic<bool>>(false);
+    std::shared_ptr<std::string> value = std::make_shared<std::string>();
+
+    // The hedge delay (50 ms) passes well before the deadline, so both sources run
+    bool finished = watchdog.RunWithDeadline([release, value]() {
+        *value = HedgedSource::Get("test.nested").Run(Blocking(release, "MB-1"), Blocking(release, "MB-2"));
+    }, std::chrono::milliseconds(300));
+    CHECK(!finished);
+    CHECK(watchdog.GetStats().stuckThreads == 3);
+
+    *release = true;
+    CHECK(WaitForStuckThreads());
+    CHECK(*value == "MB-1" || *value == "MB-2");
+    CHECK(StatsOf("test.nested").hedged == 1);
+}
+
+int main() {
+    CHECK(NormalizeIdentifier(std::string(" \tMB-1\0\0", 8)) == "MB-1");
+    CHECK(NormalizeIdentifier(std::string(" \0\n", 3)).empty());
+
+    CheckDecisions();
+    CheckHedgeDelay();
+    CheckNestedHedge();
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("hedged_request_test: all checks passed\n");
+    return 0;
+}
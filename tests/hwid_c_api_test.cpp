@@ -0,0 +1,226 @@
+/**
+ * @file hwid_c_api_test.cpp
+ * @brief Behaviour of the C interface in hwid.h
+ *
+ * Collects from a fake system root written to a temporary directory, so the
+ * expected values are known, and checks the status codes and the
+ * size-query protocol of every getter.
+ */
+
+#include "hwid.h"
+#include "hedged_request.h"
+#include "snapshot_codec.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Write a file below the fake root, creating its directories
+ */
+static void WriteRootFile(const fs::path& root, const std::string& relativePath, const std::string& content) {
+    fs::path path = root / relativePath;
+    fs::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << content;
+}
+
+/**
+ * @brief Build a root with one CPU, board and BIOS serials, two disks and two adapters
+ */
+static void WriteFakeRoot(const fs::path& root) {
+    WriteRootFile(root, "proc/cpuinfo",
+                  "processor\t: 0\n"
+                  "cpu family\t: 6\n"
+                  "model\t\t: 158\n"
+                  "stepping\t: 10\n"
+                  "flags\t\t: fpu vme de pse tsc msr pae mce cx8 apic sep mtrr pge mca cmov pat pse36 clflush "
+                  "dts acpi mmx fxsr sse sse2 ss ht tm pbe\n"
+                  "\n");
+    WriteRootFile(root, "sys/class/dmi/id/board_serial", "MB-0123456789\n");
+    WriteRootFile(root, "sys/class/dmi/id/product_serial", "BIOS-0123456789\n");
+    WriteRootFile(root, "sys/block/sda/device/serial", "WD-WCC4N0123456\n");
+    WriteRootFile(root, "sys/block/sdb/device/serial", "S3Z9NB0K123456\n");
+    WriteRootFile(root, "sys/class/net/eth0/address", "00:1a:2b:3c:4d:5e\n");
+    WriteRootFile(root, "sys/class/net/eth1/address", "00:1a:2b:3c:4d:5f\n");
+    WriteRootFile(root, "sys/class/net/lo/address", "00:00:00:00:00:00\n");
+}
+
+/**
+ * @brief Read a component with a size query followed by a sized call
+ */
+static std::string Component(const hwid_handle* handle, const char* name) {
+    size_t size = 0;
+    CHECK(hwid_get_component(handle, name, nullptr, &size) == HWID_ERROR_BUFFER_TOO_SMALL);
+    std::vector<char> buffer(size);
+    CHECK(hwid_get_component(handle, name, buffer.data(), &size) == HWID_OK);
+    CHECK(size == buffer.size() && buffer.back() == '\0');
+    return std::string(buffer.data());
+}
+
+/**
+ * @brief Read the fingerprint in one encoding
+ */
+static std::vector<uint8_t> Fingerprint(const hwid_handle* handle, hwid_fingerprint_encoding encoding) {
+    size_t size = 0;
+    CHECK(hwid_get_fingerprint(handle, encoding, nullptr, &size) == HWID_ERROR_BUFFER_TOO_SMALL);
+    std::vector<uint8_t> buffer(size);
+    CHECK(hwid_get_fingerprint(handle, encoding, buffer.data(), &size) == HWID_OK);
+    CHECK(size == buffer.size());
+    return buffer;
+}
+
+/**
+ * @brief Read the snapshot in one format
+ */
+static std::vector<uint8_t> Snapshot(const hwid_handle* handle, hwid_snapshot_format format) {
+    size_t size = 0;
+    CHECK(hwid_get_snapshot(handle, format, nullptr, &size) == HWID_ERROR_BUFFER_TOO_SMALL);
+    std::vector<uint8_t> buffer(size);
+    CHECK(hwid_get_snapshot(handle, format, buffer.data(), &size) == HWID_OK);
+    CHECK(size == buffer.size());
+    return buffer;
+}
+
+int main() {
+    CHECK(hwid_version() == HWID_VERSION);
+    CHECK(strcmp(hwid_status_string(HWID_OK), "ok") == 0);
+    CHECK(strcmp(hwid_status_string(HWID_ERROR_BUFFER_TOO_SMALL), "buffer too small") == 0);
+    CHECK(strcmp(hwid_status_string(static_cast<hwid_status>(7)), "unknown status") == 0);
+
+    CHECK(hwid_component_count() == 5);
+    CHECK(strcmp(hwid_component_name(0), "cpuId") == 0);
+    CHECK(strcmp(hwid_component_name(4), "macAddresses") == 0);
+    CHECK(hwid_component_name(hwid_component_count()) == nullptr);
+
+    // Argument checks need no handle
+    hwid_handle* handle = nullptr;
+    size_t size = 0;
+    int timedOut = 0;
+    CHECK(hwid_open(nullptr, nullptr) == HWID_ERROR_INVALID_ARGUMENT);
+    CHECK(hwid_collect(nullptr, 0) == HWID_ERROR_INVALID_ARGUMENT);
+    CHECK(hwid_get_component(nullptr, "cpuId", nullptr, &size) == HWID_ERROR_INVALID_ARGUMENT);
+    CHECK(hwid_get_fingerprint(nullptr, HWID_FINGERPRINT_HEX, nullptr, &size) == HWID_ERROR_INVALID_ARGUMENT);
+    CHECK(hwid_get_snapshot(nullptr, HWID_SNAPSHOT_JSON, nullptr, &size) == HWID_ERROR_INVALID_ARGUMENT);
+    hwid_close(nullptr);
+
+    fs::path missing = fs::temp_directory_path() / "hwid_c_api_test_missing";
+    fs::remove_all(missing);
+    CHECK(hwid_open(missing.string().c_str(), &handle) == HWID_ERROR_UNAVAILABLE);
+    CHECK(handle == nullptr);
+
+    fs::path root = fs::temp_directory_path() / "hwid_c_api_test_root";
+    fs::remove_all(root);
+    WriteFakeRoot(root);
+    CHECK(hwid_open(root.string().c_str(), &handle) == HWID_OK);
+    if (!handle) {
+        fprintf(stderr, "hwid_open failed, skipping the remaining checks\n");
+        fs::remove_all(root);
+        return 1;
+    }
+
+    // Getters refuse until a collection succeeded
+    CHECK(hwid_get_component(handle, "cpuId", nullptr, &size) == HWID_ERROR_NOT_COLLECTED);
+    CHECK(hwid_component_timed_out(handle, "cpuId", &timedOut) == HWID_ERROR_NOT_COLLECTED);
+    CHECK(hwid_get_fingerprint(handle, HWID_FINGERPRINT_HEX, nullptr, &size) == HWID_ERROR_NOT_COLLECTED);
+    CHECK(hwid_get_snapshot(handle, HWID_SNAPSHOT_JSON, nullptr, &size) == HWID_ERROR_NOT_COLLECTED);
+
+    CHECK(hwid_collect(handle, 5000) == HWID_OK);
+    CHECK(hwid_get_component(handle, "serialNumber", nullptr, &size) == HWID_ERROR_NOT_FOUND);
+    CHECK(hwid_get_component(handle, nullptr, nullptr, &size) == HWID_ERROR_INVALID_ARGUMENT);
+    CHECK(hwid_get_component(handle, "cpuId", nullptr, nullptr) == HWID_ERROR_INVALID_ARGUMENT);
+    CHECK(hwid_component_timed_out(handle, "cpuId", nullptr) == HWID_ERROR_INVALID_ARGUMENT);
+    for (size_t i = 0; i < hwid_component_count(); i++) {
+        timedOut = -1;
+        CHECK(hwid_component_timed_out(handle, hwid_component_name(i), &timedOut) == HWID_OK);
+        CHECK(timedOut == 0);
+    }
+
+    CHECK(Component(handle, "cpuId") == "BFEBFBFF000906EA");
+    CHECK(Component(handle, "motherboardSerial") == "MB-0123456789");
+    CHECK(Component(handle, "biosSerial") == "BIOS-0123456789");
+    CHECK(Component(handle, "diskSerials") == "WD-WCC4N0123456\nS3Z9NB0K123456");
+    CHECK(Component(handle, "macAddresses") == "00:1A:2B:3C:4D:5E\n00:1A:2B:3C:4D:5F");
+
+    // A buffer one byte short reports the size and writes nothing
+    char small[16];
+    memset(small, 'x', sizeof(small));
+    size = strlen("BFEBFBFF000906EA");
+    CHECK(hwid_get_component(handle, "cpuId", small, &size) == HWID_ERROR_BUFFER_TOO_SMALL);
+    CHECK(size == sizeof(small) + 1);
+    CHECK(small[0] == 'x');
+
+    std::vector<uint8_t> legacy = Fingerprint(handle, HWID_FINGERPRINT_LEGACY);
+    std::vector<uint8_t> raw = Fingerprint(handle, HWID_FINGERPRINT_RAW);
+    std::vector<uint8_t> hex = Fingerprint(handle, HWID_FINGERPRINT_HEX);
+    std::vector<uint8_t> base32 = Fingerprint(handle, HWID_FINGERPRINT_BASE32);
+    std::vector<uint8_t> base64url = Fingerprint(handle, HWID_FINGERPRINT_BASE64URL);
+    // The legacy text has no fixed length: leading zero digits are dropped
+    CHECK(legacy.size() >= 2 && legacy.size() <= 2 * sizeof(size_t) + 1 && legacy.back() == '\0');
+    CHECK(strspn(reinterpret_cast<const char*>(legacy.data()), "0123456789abcdef") == legacy.size() - 1);
+    CHECK(raw.size() == 32);
+    CHECK(hex.size() == 65 && base32.size() == 53 && base64url.size() == 44);
+    std::string expectedHex;
+    for (uint8_t byte : raw) {
+        char digits[3];
+        snprintf(digits, sizeof(digits), "%02x", byte);
+        expectedHex += digits;
+    }
+    CHECK(reinterpret_cast<const char*>(hex.data()) == expectedHex);
+    CHECK(hwid_get_fingerprint(handle, static_cast<hwid_fingerprint_encoding>(7), nullptr, &size) ==
+          HWID_ERROR_INVALID_ARGUMENT);
+
+    std::vector<uint8_t> json = Snapshot(handle, HWID_SNAPSHOT_JSON);
+    std::string jsonText(reinterpret_cast<const char*>(json.data()));
+    CHECK(json.back() == '\0');
+    CHECK(jsonText.find("\"cpuId\":\"BFEBFBFF000906EA\"") != std::string::npos);
+    CHECK(jsonText.find(std::string("\"fingerprint\":\"") + reinterpret_cast<const char*>(legacy.data()) + "\"") !=
+          std::string::npos);
+
+    std::vector<uint8_t> binary = Snapshot(handle, HWID_SNAPSHOT_BINARY);
+    HardwareInfo decoded;
+    CHECK(DecodeSnapshot(binary.data(), binary.size(), decoded) == SnapshotDecodeStatus::Ok);
+    CHECK(decoded.biosSerial == "BIOS-0123456789");
+    CHECK(decoded.macAddresses.size() == 2);
+    CHECK(decoded.fingerprint == reinterpret_cast<const char*>(legacy.data()));
+    CHECK(!Snapshot(handle, HWID_SNAPSHOT_MSGPACK).empty());
+    CHECK(!Snapshot(handle, HWID_SNAPSHOT_CBOR).empty());
+
+    // A removed device shows up on the next collection; only the first disk is fingerprinted
+    fs::remove_all(root / "sys/block/sdb");
+    CHECK(hwid_collect(handle, 0) == HWID_OK);
+    CHECK(Component(handle, "diskSerials") == "WD-WCC4N0123456");
+    CHECK(Fingerprint(handle, HWID_FINGERPRINT_RAW) == raw);
+    fs::remove_all(root / "sys/block/sda");
+    CHECK(hwid_collect(handle, 0) == HWID_OK);
+    CHECK(Component(handle, "diskSerials").empty());
+    CHECK(Fingerprint(handle, HWID_FINGERPRINT_RAW) != raw);
+
+    hwid_close(handle);
+    fs::remove_all(root);
+
+    // Offline roots are read directly, never through the live system's hedges
+    for (const HedgeStats& stats : HedgedSource::GetAllStats()) {
+        CHECK(stats.name.compare(0, 6, "sysfs.") != 0 || stats.requests == 0);
+    }
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("hwid_c_api_test: all checks passed\n");
+    return 0;
+}
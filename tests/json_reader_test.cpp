@@ -0,0 +1,96 @@
+/**
+ * @file json_reader_test.cpp
+ * @brief Registration parsing and error offsets of ReadJsonRegistrations()
+ */
+
+#include "json_reader.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Parse text, returning the error offset or SIZE_MAX on success
+ */
+static size_t Read(const std::string& text, std::vector<JsonRegistration>& records, unsigned threads = 1) {
+    records.clear();
+    size_t errorOffset = 0;
+    if (!ReadJsonRegistrations(text.data(), text.size(), threads, records, errorOffset)) {
+        return errorOffset;
+    }
+    return SIZE_MAX;
+}
+
+int main() {
+    std::vector<JsonRegistration> records;
+
+    // Registration file, getAllHardwareInfo() shape and epoch milliseconds
+    std::string valid =
+        "{\"registeredAt\":\"2024-03-01T12:00:00.250Z\",\"fingerprint\":\"ab\","
+        "\"hardware\":{\"cpuId\":\"C1\",\"firstDiskSerial\":\"D1\",\"firstMacAddress\":\"00:1A:2B:3C:4D:5E\"}}\n"
+        "{\"cpuId\":\"C2\",\"diskSerials\":[\"D2\",\"D3\"],\"macAddresses\":[],\"registeredAt\":1709294400000}\n"
+        "[{\"cpuId\":\"C3\",\"registeredAt\":\"2024-03-01T13:00:00+01:00\"},{\"cpuId\":\"C4\",\"registeredAt\":null}]\n";
+    CHECK(Read(valid, records) == SIZE_MAX);
+    CHECK(records.size() == 4);
+    if (records.size() == 4) {
+        CHECK(records[0].registeredAtMs == 1709294400250LL);
+        CHECK(records[0].info.fingerprint == "ab");
+        CHECK(records[0].info.diskSerials == std::vector<std::string>{ "D1" });
+        CHECK(records[1].registeredAtMs == 1709294400000LL);
+        CHECK(records[1].info.diskSerials.size() == 2);
+        CHECK(records[2].registeredAtMs == 1709294400000LL);
+        CHECK(records[0].hasRegisteredAt && records[1].hasRegisteredAt && records[2].hasRegisteredAt);
+        CHECK(!records[3].hasRegisteredAt);
+    }
+
+    // The epoch is a registration time like any other, not a missing one
+    CHECK(Read("{\"cpuId\":\"C1\",\"registeredAt\":0}{\"cpuId\":\"C2\",\"registeredAt\":\"1970-01-01T00:00:00Z\"}",
+               records) == SIZE_MAX);
+    CHECK(records.size() == 2);
+    for (const JsonRegistration& record : records) {
+        CHECK(record.hasRegisteredAt && record.registeredAtMs == 0);
+    }
+
+    // A registeredAt that is not a timestamp fails at the value, like any malformed field
+    std::string first = "{\"cpuId\":\"C1\",\"registeredAt\":\"2024-03-01\"}\n";
+    std::string badText = first + "{\"cpuId\":\"C2\",\"registeredAt\":\"yesterday\"}\n";
+    CHECK(Read(badText, records) == badText.find("\"yesterday\""));
+    CHECK(records.empty());
+
+    std::string badNumber = "{\"cpuId\":\"C1\",\"registeredAt\":1e300}";
+    CHECK(Read(badNumber, records) == badNumber.find("1e300"));
+
+    std::string badJson = "{\"cpuId\":\"C1\",\"registeredAt\":\"2024-03-01T12:00:00Z\"";
+    CHECK(Read(badJson, records) == badJson.size());
+
+    // The parallel path reports the same error
+    std::string large;
+    std::string line = "{\"cpuId\":\"BFEBFBFF000906EA\",\"registeredAt\":\"2024-03-01T12:00:00Z\"}\n";
+    while (large.size() < (8u << 20)) {
+        large += line;
+    }
+    size_t badOffset = large.size();
+    large += "{\"cpuId\":\"C2\",\"registeredAt\":\"not a date\"}\n";
+    large += line;
+    CHECK(Read(large, records, 4) == badOffset + std::string("{\"cpuId\":\"C2\",\"registeredAt\":").size());
+    large.erase(badOffset, large.find('\n', badOffset) + 1 - badOffset);
+    CHECK(Read(large, records, 4) == SIZE_MAX);
+    CHECK(records.size() == large.size() / line.size());
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("json_reader_test: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file json_writer_test.cpp
+ * @brief JsonWriter output checked against expected JSON text
+ */
+
+#include "json_writer.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+static std::string NumberText(double value) {
+    std::string out;
+    JsonWriter writer(out);
+    writer.Number(value);
+    return out;
+}
+
+/**
+ * @brief Deterministic generator so failures reproduce
+ */
+static uint64_t NextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+int main() {
+    // Same text as JavaScript's Number#toString
+    CHECK(NumberText(0) == "0");
+    CHECK(NumberText(-0.0) == "0");
+    CHECK(NumberText(42) == "42");
+    CHECK(NumberText(-7) == "-7");
+    CHECK(NumberText(0.1) == "0.1");
+    CHECK(NumberText(1.5) == "1.5");
+    CHECK(NumberText(9007199254740992.0) == "9007199254740992");
+    CHECK(NumberText(9007199254740994.0) == "9007199254740994");
+    CHECK(NumberText(1152921504606846976.0) == "1152921504606847000");
+    CHECK(NumberText(-1e20) == "-100000000000000000000");
+    CHECK(NumberText(123456789012345678901.0) == "123456789012345680000");
+    CHECK(NumberText(1e21) == "1e+21");
+    CHECK(NumberText(1.5e21) == "1.5e+21");
+    CHECK(NumberText(1.7976931348623157e308) == "1.7976931348623157e+308");
+    CHECK(NumberText(0.1 + 0.2) == "0.30000000000000004");
+    CHECK(NumberText(123.456) == "123.456");
+    CHECK(NumberText(-0.001) == "-0.001");
+    CHECK(NumberText(1e-6) == "0.000001");
+    CHECK(NumberText(1.25e-6) == "0.00000125");
+    CHECK(NumberText(1e-7) == "1e-7");
+    CHECK(NumberText(-2.5e-8) == "-2.5e-8");
+    CHECK(NumberText(5e-324) == "5e-324");
+    CHECK(NumberText(std::numeric_limits<double>::quiet_NaN()) == "null");
+    CHECK(NumberText(std::numeric_limits<double>::infinity()) == "null");
+    CHECK(NumberText(-std::numeric_limits<double>::infinity()) == "null");
+
+    // Every finite double parses back to itself
+    size_t lossy = 0;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    double samples[] = { 1.0 / 3, 0.1 + 0.2, 5e-324, 1.7976931348623157e308, 123.456, -2.5e-8 };
+    for (double sample : samples) {
+        lossy += strtod(NumberText(sample).c_str(), nullptr) != sample;
+    }
+    for (int i = 0; i < 100000; i++) {
+        uint64_t bits = NextRandom(state);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        lossy += strtod(NumberText(value).c_str(), nullptr) != value;
+    }
+    CHECK(lossy == 0);
+
+    // Numbers take part in separators like any other value
+    std::string out;
+    JsonWriter writer(out);
+    writer.BeginObject();
+    writer.Key("ratio");
+    writer.Number(0.25);
+    writer.Key("values");
+    writer.BeginArray();
+    writer.Number(1);
+    writer.Number(2.5);
+    writer.Null();
+    writer.EndArray();
+    writer.EndObject();
+    CHECK(out == "{\"ratio\":0.25,\"values\":[1,2.5,null]}");
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("json_writer_test: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file mac_address_test.cpp
+ * @brief MAC address parsing and formatting
+ *
+ * Table-driven over the colon, dash, dotted and bare forms, both letter
+ * cases and malformed input, followed by a format/parse round trip of
+ * pseudo-random addresses.
+ */
+
+#include "mac_address.h"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+#define CHECK_CASE(condition, text) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed for \"%s\": %s\n", __FILE__, __LINE__, \
+                    std::string(text).c_str(), #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+struct ParseCase {
+    std::string_view text;
+    uint64_t value;
+};
+
+static const ParseCase kValidAddresses[] = {
+    {"00:1A:2B:3C:4D:5E", 0x001A2B3C4D5EULL},
+    {"00-1A-2B-3C-4D-5E", 0x001A2B3C4D5EULL},
+    {"001A.2B3C.4D5E", 0x001A2B3C4D5EULL},
+    {"001A2B3C4D5E", 0x001A2B3C4D5EULL},
+    {"00:1a:2b:3c:4d:5e", 0x001A2B3C4D5EULL},
+    {"aA:bB:cC:dD:eE:fF", 0xAABBCCDDEEFFULL},
+    {"9f-8E-7d-6C-5b-4A", 0x9F8E7D6C5B4AULL},
+    {"0123.4567.89aB", 0x0123456789ABULL},
+    {"fedcBA987654", 0xFEDCBA987654ULL},
+    {"00:00:00:00:00:00", 0},
+    {"FF:FF:FF:FF:FF:FF", MacAddress::kMask},
+};
+
+static const std::string_view kInvalidAddresses[] = {
+    // Lengths of no known form
+    "",
+    "0",
+    "00:1A:2B:3C:4D",
+    "00:1A:2B:3C:4D:5",
+    "00:1A:2B:3C:4D:5E:",
+    "00:1A:2B:3C:4D:5E:6F",
+    "001A.2B3C.4D5",
+    "001A.2B3C.4D5E.",
+    "001A2B3C4D5",
+    "001A2B3C4D5E0",
+    // Characters other than hex digits, in every position class
+    "G0:1A:2B:3C:4D:5E",
+    "00:1A:2B:3C:4D:5G",
+    "00:1A:2B:3C:4D:5g",
+    "00:1A:2B:3C:4D:5@",
+    "00:1A:2B:3C:4D:5`",
+    "00:1A:2B:3C:4D:5/",
+    "00:1A:2B:3C:4D:5:",
+    "0x:1A:2B:3C:4D:5E",
+    " 0:1A:2B:3C:4D:5E",
+    "00:1A:2B:3C:4D: E",
+    "\xC0\xB0:1A:2B:3C:4D:5E",
+    std::string_view("00:1A:2B:3C:4D:5\0", 17),
+    "001A.2B3C.4D5G",
+    "001A2B3C4D5Z",
+    "0x1A2B3C4D5E",
+    // Separators that are missing, mixed or in the wrong form
+    "00:1A-2B:3C:4D:5E",
+    "00-1A-2B-3C-4D:5E",
+    "00.1A.2B.3C.4D.5E",
+    "00 1A 2B 3C 4D 5E",
+    "001:A2:B3C:4D:5E0",
+    "001A:2B3C:4D5E",
+    "001A-2B3C-4D5E",
+    "001A.2B3C:4D5E",
+    "00.1A2B3C.4D5E",
+};
+
+struct FormatCase {
+    uint64_t value;
+    MacFormat format;
+    bool uppercase;
+    std::string_view text;
+};
+
+static const FormatCase kFormats[] = {
+    {0x001A2B3C4D5EULL, MacFormat::Colon, true, "00:1A:2B:3C:4D:5E"},
+    {0x001A2B3C4D5EULL, MacFormat::Colon, false, "00:1a:2b:3c:4d:5e"},
+    {0x001A2B3C4D5EULL, MacFormat::Dash, true, "00-1A-2B-3C-4D-5E"},
+    {0x001A2B3C4D5EULL, MacFormat::Dash, false, "00-1a-2b-3c-4d-5e"},
+    {0x001A2B3C4D5EULL, MacFormat::Dot, true, "001A.2B3C.4D5E"},
+    {0x001A2B3C4D5EULL, MacFormat::Dot, false, "001a.2b3c.4d5e"},
+    {0x001A2B3C4D5EULL, MacFormat::Bare, true, "001A2B3C4D5E"},
+    {0x001A2B3C4D5EULL, MacFormat::Bare, false, "001a2b3c4d5e"},
+    {0, MacFormat::Colon, true, "00:00:00:00:00:00"},
+    {MacAddress::kMask, MacFormat::Dot, false, "ffff.ffff.ffff"},
+    {0xA0B1C2D3E4F5ULL, MacFormat::Bare, true, "A0B1C2D3E4F5"},
+};
+
+struct PrefixCase {
+    std::string_view text;
+    bool valid;
+    uint64_t value;
+    uint64_t mask;
+};
+
+static const PrefixCase kPrefixes[] = {
+    {"00:1A:2B", true, 0x001A2B000000ULL, 0xFFFFFF000000ULL},
+    {"00-1a-2B", true, 0x001A2B000000ULL, 0xFFFFFF000000ULL},
+    {"001A.2B", true, 0x001A2B000000ULL, 0xFFFFFF000000ULL},
+    {"fe", true, 0xFE0000000000ULL, 0xFF0000000000ULL},
+    {"00:1A:2B:3C:4D:5E", true, 0x001A2B3C4D5EULL, MacAddress::kMask},
+    {"", false, 0, 0},
+    {":", false, 0, 0},
+    {"0", false, 0, 0},
+    {"00:1", false, 0, 0},
+    {"00:1A:2B:3C:4D:5E:6F", false, 0, 0},
+    {"0G", false, 0, 0},
+    {"00 1A", false, 0, 0},
+};
+
+int main() {
+    for (const ParseCase& test : kValidAddresses) {
+        MacAddress mac;
+        CHECK_CASE(ParseMacAddress(test.text, mac), test.text);
+        CHECK_CASE(mac.value == test.value, test.text);
+    }
+
+    for (std::string_view text : kInvalidAddresses) {
+        MacAddress mac;
+        mac.value = 0x123456789ABCULL;
+        CHECK_CASE(!ParseMacAddress(text, mac), text);
+    }
+
+    for (const FormatCase& test : kFormats) {
+        MacAddress mac;
+        mac.value = test.value;
+        CHECK_CASE(FormatMacAddress(mac, test.format, test.uppercase) == test.text, test.text);
+
+        // The buffer form writes exactly the reported length and no terminator
+        char buffer[kMaxMacAddressLength + 1];
+        buffer[test.text.size()] = '#';
+        size_t length = FormatMacAddress(mac, test.format, test.uppercase, buffer);
+        CHECK_CASE(std::string_view(buffer, length) == test.text, test.text);
+        CHECK_CASE(buffer[test.text.size()] == '#', test.text);
+    }
+    CHECK(FormatMacAddress(MacAddress()) == "00:00:00:00:00:00");
+
+    for (const PrefixCase& test : kPrefixes) {
+        uint64_t value = 0;
+        uint64_t mask = 0;
+        bool valid = ParseMacPrefix(test.text, value, mask);
+        CHECK_CASE(valid == test.valid, test.text);
+        if (valid && test.valid) {
+            CHECK_CASE(value == test.value && mask == test.mask, test.text);
+        }
+    }
+
+    // Every form and case parses back to the address it was formatted from
+    const MacFormat formats[] = {MacFormat::Colon, MacFormat::Dash, MacFormat::Dot, MacFormat::Bare};
+    std::mt19937_64 random(78);
+    for (int i = 0; i < 10000; i++) {
+        MacAddress mac;
+        mac.value = random() & MacAddress::kMask;
+        for (MacFormat format : formats) {
+            for (bool uppercase : {true, false}) {
+                std::string text = FormatMacAddress(mac, format, uppercase);
+                MacAddress parsed;
+                CHECK_CASE(ParseMacAddress(text, parsed) && parsed == mac, text);
+            }
+        }
+    }
+
+    MacAddress multicast;
+    CHECK(ParseMacAddress("01:00:5E:00:00:FB", multicast));
+    CHECK(multicast.IsMulticast() && !multicast.IsLocallyAdministered() && !multicast.IsBroadcast());
+    CHECK(multicast.Oui() == 0x01005E);
+    MacAddress local;
+    CHECK(ParseMacAddress("02:42:AC:11:00:02", local));
+    CHECK(local.IsLocallyAdministered() && !local.IsMulticast());
+    MacAddress broadcast;
+    CHECK(ParseMacAddress("FF:FF:FF:FF:FF:FF", broadcast));
+    CHECK(broadcast.IsBroadcast() && broadcast.IsMulticast());
+
+    std::vector<MacAddress> macs = {local, multicast, broadcast, local, multicast};
+    SortUniqueMacAddresses(macs);
+    CHECK(macs.size() == 3);
+    CHECK(macs[0] == multicast && macs[1] == local && macs[2] == broadcast);
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("mac_address_test: all checks passed\n");
+    return 0;
+}
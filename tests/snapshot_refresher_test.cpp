@@ -0,0 +1,172 @@
+/**
+ * @file snapshot_refresher_test.cpp
+ * @brief Allocation behaviour of SnapshotRefresher
+ *
+ * Replaces the global operator new to count every heap allocation made
+ * while Refresh() runs, and checks that a refresh in which nothing changed
+ * allocates nothing and that RefreshResult::allocations agrees.
+ */
+
+#include "snapshot_refresher.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+static size_t g_allocations = 0;
+static int g_failures = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    void* memory = malloc(size ? size : 1);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+// GCC pairs the free() below with operator new as written at the call site
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Collector copying from a fixed system description
+ */
+struct FakeSystem {
+    HardwareInfo values;
+    uint32_t hungComponents = 0;
+
+    bool Collect(HardwareComponent component, HardwareInfo& info) const {
+        if (hungComponents & ComponentBit(component)) {
+            return false;
+        }
+        CopyComponent(component, values, info);
+        return true;
+    }
+};
+
+/**
+ * @brief Refresh and report the heap allocations made meanwhile
+ */
+static size_t CountedRefresh(SnapshotRefresher& refresher, const SnapshotRefresher::Collector& collect,
+                             RefreshResult& result) {
+    size_t before = g_allocations;
+    result = refresher.Refresh(collect);
+    return g_allocations - before;
+}
+
+int main() {
+    FakeSystem system;
+    system.values.cpuId = "BFEBFBFF000906EA";
+    system.values.motherboardSerial = "MB-0123456789-ABCDEF";
+    system.values.biosSerial = "BIOS-0123456789-ABCDEF";
+    system.values.diskSerials = {"WD-WCC4N0123456789", "S3Z9NB0K123456789"};
+    system.values.macAddresses = {"00:1A:2B:3C:4D:5E", "00:1A:2B:3C:4D:5F"};
+
+    SnapshotRefresher refresher;
+    SnapshotRefresher::Collector collect = [&system](HardwareComponent component, HardwareInfo& info) {
+        return system.Collect(component, info);
+    };
+    RefreshResult result;
+
+    CountedRefresh(refresher, collect, result);
+    CHECK(result.changedComponents == kAllHardwareComponents);
+    CHECK(result.fingerprintChanged);
+    CHECK(result.allocations > 0);
+    CHECK(GetSnapshotField(refresher.Snapshot().biosSerial, refresher.Arena()) == "BIOS-0123456789-ABCDEF");
+    CHECK(GetSnapshotField(refresher.Snapshot().fingerprint, refresher.Arena()) == ComputeFingerprint(system.values));
+
+    // Steady state: nothing changed, nothing allocated
+    for (int i = 0; i < 3; i++) {
+        size_t allocated = CountedRefresh(refresher, collect, result);
+        CHECK(allocated == 0);
+        CHECK(result.allocations == 0);
+        CHECK(result.changedComponents == 0);
+        CHECK(!result.fingerprintChanged);
+    }
+
+    // A value that outgrows its buffer allocates, and the count says so
+    system.values.biosSerial = "BIOS-0123456789-ABCDEF-0123456789-ABCDEF";
+    size_t allocated = CountedRefresh(refresher, collect, result);
+    CHECK(allocated > 0);
+    CHECK(result.allocations > 0);
+    CHECK(result.changedComponents == ComponentBit(HardwareComponent::BiosSerial));
+    CHECK(result.fingerprintChanged);
+    CHECK(GetSnapshotField(refresher.Snapshot().biosSerial, refresher.Arena()) ==
+          "BIOS-0123456789-ABCDEF-0123456789-ABCDEF");
+
+    // Shorter values and a removed device fit the existing buffers
+    system.values.biosSerial = "BIOS-0123456789";
+    system.values.macAddresses.pop_back();
+    allocated = CountedRefresh(refresher, collect, result);
+    CHECK(allocated == 0);
+    CHECK(result.allocations == 0);
+    CHECK(result.changedComponents ==
+          (ComponentBit(HardwareComponent::BiosSerial) | ComponentBit(HardwareComponent::MacAddresses)));
+    CHECK(refresher.Snapshot().macAddressCount == 1);
+
+    // A timed-out component keeps its previous value without allocating
+    system.hungComponents = ComponentBit(HardwareComponent::DiskSerials);
+    allocated = CountedRefresh(refresher, collect, result);
+    CHECK(allocated == 0);
+    CHECK(result.changedComponents == 0);
+    CHECK(refresher.Snapshot().diskSerialCount == 2);
+
+    RefreshStats stats = refresher.GetStats();
+    CHECK(stats.refreshes == 7);
+    CHECK(stats.unchangedRefreshes == 3);
+
+    // Entries beyond the inline capacity still count, and Current() keeps them
+    SnapshotRefresher hostRefresher;
+    system.hungComponents = 0;
+    system.values.macAddresses.clear();
+    for (int i = 0; i < 12; i++) {
+        char address[18];
+        snprintf(address, sizeof(address), "02:42:AC:11:00:%02X", i);
+        system.values.macAddresses.push_back(address);
+    }
+    CountedRefresh(hostRefresher, collect, result);
+    CHECK(hostRefresher.Snapshot().macAddressCount == HardwareSnapshot::kMaxMacAddresses);
+    CHECK(hostRefresher.Current().macAddresses == system.values.macAddresses);
+    allocated = CountedRefresh(hostRefresher, collect, result);
+    CHECK(allocated == 0);
+    CHECK(result.changedComponents == 0);
+
+    system.values.macAddresses[8] = "02:42:AC:11:00:FF";
+    allocated = CountedRefresh(hostRefresher, collect, result);
+    CHECK(allocated == 0);
+    CHECK(result.changedComponents == ComponentBit(HardwareComponent::MacAddresses));
+    CHECK(!result.fingerprintChanged);
+    CHECK(hostRefresher.Current().macAddresses[8] == "02:42:AC:11:00:FF");
+
+    system.values.macAddresses.pop_back();
+    CountedRefresh(hostRefresher, collect, result);
+    CHECK(result.changedComponents == ComponentBit(HardwareComponent::MacAddresses));
+    CHECK(hostRefresher.Current().macAddresses.size() == 11);
+    CountedRefresh(hostRefresher, collect, result);
+    CHECK(result.changedComponents == 0);
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("snapshot_refresher_test: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file sysfs_collector_test.cpp
+ * @brief Reading identifiers from fake sysfs/procfs trees
+ *
+ * Each case writes a small tree below a temporary directory and checks the
+ * values SysfsCollector reads from it, including the fallback sources,
+ * missing files and a root that does not exist.
+ */
+
+#include "sysfs_collector.h"
+#include "smbios_table.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Write a file below a fake root, creating its directories
+ */
+static void WriteRootFile(const fs::path& root, const std::string& relativePath, const std::string& content) {
+    fs::path path = root / relativePath;
+    fs::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << content;
+}
+
+/**
+ * @brief Build a raw DMI table with system and baseboard serials
+ */
+static std::string DmiTable(const std::string& systemSerial, const std::string& baseboardSerial) {
+    std::string table;
+    const std::pair<uint8_t, const std::string*> structures[] = {
+        {kSmbiosSystemInformation, &systemSerial},
+        {kSmbiosBaseboardInformation, &baseboardSerial},
+    };
+    for (const auto& structure : structures) {
+        // Type, length, handle, manufacturer string 1, two unset strings, serial string 2
+        const char formatted[8] = {static_cast<char>(structure.first), 8, 0, 0, 1, 0, 0, 2};
+        table.append(formatted, sizeof(formatted));
+        table += "Vendor";
+        table += '\0';
+        table += *structure.second;
+        table += '\0';
+        table += '\0';
+    }
+    const char end[6] = {127, 4, 0, 0, 0, 0};
+    table.append(end, sizeof(end));
+    return table;
+}
+
+/**
+ * @brief Every source present in its preferred form
+ */
+static void CheckCompleteRoot(const fs::path& root) {
+    WriteRootFile(root, "proc/cpuinfo",
+                  "processor\t: 0\n"
+                  "cpu family\t: 6\n"
+                  "model\t\t: 158\n"
+                  "stepping\t: 10\n"
+                  "flags\t\t: fpu vme de pse tsc msr pae mce cx8 apic sep mtrr pge mca cmov pat pse36 clflush "
+                  "dts acpi mmx fxsr sse sse2 ss ht tm pbe\n"
+                  "\n"
+                  "processor\t: 1\n"
+                  "cpu family\t: 23\n");
+    WriteRootFile(root, "sys/class/dmi/id/board_serial", "  MB-0123456789 \n");
+    WriteRootFile(root, "sys/class/dmi/id/product_serial", "BIOS-0123456789\n");
+    WriteRootFile(root, "sys/firmware/dmi/tables/DMI", DmiTable("TABLE-SYSTEM", "TABLE-BOARD"));
+    WriteRootFile(root, "sys/block/sda/device/serial", "WD-WCC4N0123456\n");
+    WriteRootFile(root, "sys/block/sdb/device/vpd_pg80", std::string("\0\x80\0\x0e", 4) + "  S3Z9NB0K1234 ");
+    WriteRootFile(root, "sys/block/sdc/device/wwid", "naa.5000c500a1b2c3d4\n");
+    fs::create_directories(root / "sys/block/loop0/device");
+    WriteRootFile(root, "sys/class/net/eth1/address", "00:1a:2b:3c:4d:5f\n");
+    WriteRootFile(root, "sys/class/net/eth0/address", "00:1a:2b:3c:4d:5e\n");
+    WriteRootFile(root, "sys/class/net/lo/address", "00:00:00:00:00:00\n");
+    WriteRootFile(root, "sys/class/net/dummy0/address", "00:00:00:00:00:00\n");
+    WriteRootFile(root, "sys/class/net/ib0/address", "80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00\n");
+    WriteRootFile(root, "sys/class/net/wlan0/address", "zz:1a:2b:3c:4d:60\n");
+
+    SysfsCollector collector(root.string());
+    CHECK(collector.GetRootPath() == root.string());
+    CHECK(collector.IsValidRoot());
+    CHECK(collector.GetCpuId() == "BFEBFBFF000906EA");
+    CHECK(collector.GetMotherboardSerial() == "MB-0123456789");
+    CHECK(collector.GetBiosSerial() == "BIOS-0123456789");
+    CHECK(collector.GetDiskSerials() ==
+          std::vector<std::string>({"WD-WCC4N0123456", "S3Z9NB0K1234", "naa.5000c500a1b2c3d4"}));
+    CHECK(collector.GetMacAddresses() == std::vector<std::string>({"00:1A:2B:3C:4D:5E", "00:1A:2B:3C:4D:5F"}));
+
+    HardwareInfo info = collector.GetAllHardwareInfo();
+    CHECK(info.cpuId == "BFEBFBFF000906EA");
+    CHECK(info.macAddresses.size() == 2);
+    CHECK(!info.fingerprint.empty());
+    CHECK(info.fingerprint == ComputeFingerprint(info));
+}
+
+/**
+ * @brief Missing or blank DMI attributes fall back to the raw DMI table
+ */
+static void CheckDmiTableFallback(const fs::path& root) {
+    WriteRootFile(root, "sys/class/dmi/id/board_serial", " \n");
+    WriteRootFile(root, "sys/firmware/dmi/tables/DMI", DmiTable("TABLE-SYSTEM", "TABLE-BOARD"));
+
+    SysfsCollector collector(root.string());
+    CHECK(collector.GetMotherboardSerial() == "TABLE-BOARD");
+    CHECK(collector.GetBiosSerial() == "TABLE-SYSTEM");
+}
+
+/**
+ * @brief An existing root without any of the source files
+ */
+static void CheckMissingFiles(const fs::path& root) {
+    fs::create_directories(root);
+    WriteRootFile(root, "sys/class/net/eth0/mtu", "1500\n");
+    fs::create_directories(root / "sys/block/sda/device");
+
+    SysfsCollector collector(root.string());
+    CHECK(collector.IsValidRoot());
+    CHECK(collector.GetCpuId().empty());
+    CHECK(collector.GetMotherboardSerial().empty());
+    CHECK(collector.GetBiosSerial().empty());
+    CHECK(collector.GetDiskSerials().empty());
+    CHECK(collector.GetMacAddresses().empty());
+
+    // A processor block without flags cannot be turned into a ProcessorId
+    WriteRootFile(root, "proc/cpuinfo", "processor\t: 0\ncpu family\t: 6\nmodel\t\t: 158\nstepping\t: 10\n");
+    CHECK(collector.GetCpuId().empty());
+}
+
+/**
+ * @brief A root that does not exist reads as empty and fails in a batch
+ */
+static void CheckMissingRoot(const fs::path& missing, const fs::path& existing) {
+    SysfsCollector collector(missing.string());
+    CHECK(!collector.IsValidRoot());
+    CHECK(collector.GetCpuId().empty());
+    CHECK(collector.GetMotherboardSerial().empty());
+    CHECK(collector.GetBiosSerial().empty());
+    CHECK(collector.GetDiskSerials().empty());
+    CHECK(collector.GetMacAddresses().empty());
+
+    std::vector<RootCollectionResult> results =
+        SysfsCollector::CollectBatch({missing.string(), existing.string()}, 2);
+    CHECK(results.size() == 2);
+    CHECK(results[0].root == missing.string() && !results[0].success);
+    CHECK(results[1].root == existing.string() && results[1].success);
+    CHECK(results[1].snapshot.CpuId() == "BFEBFBFF000906EA");
+}
+
+int main() {
+    fs::path base = fs::temp_directory_path() / "sysfs_collector_test";
+    fs::remove_all(base);
+
+    CheckCompleteRoot(base / "complete");
+    CheckDmiTableFallback(base / "dmi_table");
+    CheckMissingFiles(base / "missing_files");
+    CheckMissingRoot(base / "does_not_exist", base / "complete");
+
+    fs::remove_all(base);
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("sysfs_collector_test: all checks passed\n");
+    return 0;
+}
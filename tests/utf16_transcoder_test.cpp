@@ -0,0 +1,195 @@
+/**
+ * @file utf16_transcoder_test.cpp
+ * @brief UTF-16 to UTF-8 transcoding against a code-point reference
+ *
+ * ctest runs this twice, once as is and once with
+ * HWID_DISABLE_CPU_FEATURES=all, so the SIMD and scalar ASCII kernels are
+ * both checked. ASCII runs of every length up to a few vector widths move
+ * the first non-ASCII unit across each kernel's block and tail boundaries.
+ */
+
+#include "utf16_transcoder.h"
+#include "cpu_features.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Append a code point as UTF-8
+ */
+static void AppendUtf8(uint32_t codePoint, std::string& output) {
+    if (codePoint < 0x80) {
+        output += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        output += static_cast<char>(0xC0 | (codePoint >> 6));
+        output += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        output += static_cast<char>(0xE0 | (codePoint >> 12));
+        output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        output += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        output += static_cast<char>(0xF0 | (codePoint >> 18));
+        output += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        output += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+/**
+ * @brief Decode code points one unit at a time and re-encode them
+ */
+static std::string Reference(const std::u16string& input, size_t& replacements) {
+    std::string output;
+    replacements = 0;
+    for (size_t i = 0; i < input.size(); i++) {
+        uint32_t unit = input[i];
+        bool high = unit >= 0xD800 && unit <= 0xDBFF;
+        bool low = unit >= 0xDC00 && unit <= 0xDFFF;
+        if (high && i + 1 < input.size() && input[i + 1] >= 0xDC00 && input[i + 1] <= 0xDFFF) {
+            AppendUtf8(0x10000 + ((unit - 0xD800) << 10) + (input[++i] - 0xDC00u), output);
+        } else if (high || low) {
+            AppendUtf8(0xFFFD, output);
+            replacements++;
+        } else {
+            AppendUtf8(unit, output);
+        }
+    }
+    return output;
+}
+
+/**
+ * @brief Transcode through both entry points and compare with the reference
+ *
+ * The input sits in a buffer of exactly its length and the output in one
+ * of exactly the documented worst case, so sanitizer builds catch any
+ * read or write beyond them.
+ */
+static bool Matches(const std::u16string& text) {
+    size_t expectedReplacements = 0;
+    std::string expected = Reference(text, expectedReplacements);
+
+    std::vector<char16_t> input(text.begin(), text.end());
+    std::vector<char> output(input.size() * kMaxUtf8BytesPerUtf16Unit);
+    size_t replacements = ~size_t(0);
+    size_t length = TranscodeUtf16ToUtf8(input.data(), input.size(), output.data(), &replacements);
+
+    return std::string(output.data(), length) == expected &&
+           replacements == expectedReplacements &&
+           Utf16ToUtf8(input.data(), input.size()) == expected;
+}
+
+struct TranscodeCase {
+    std::u16string input;
+    std::string utf8;
+    size_t replacements;
+};
+
+int main() {
+    const char* disabled = getenv("HWID_DISABLE_CPU_FEATURES");
+    bool scalarOnly = disabled && strcmp(disabled, "all") == 0;
+    bool reported = false;
+    for (const auto& variant : GetKernelVariants()) {
+        if (variant.first == "utf16.copyAsciiPrefix") {
+            printf("%s: %s\n", variant.first.c_str(), variant.second.c_str());
+            reported = true;
+            if (scalarOnly) {
+                CHECK(variant.second == "scalar");
+            }
+        }
+    }
+    CHECK(reported);
+
+    const TranscodeCase kCases[] = {
+        {u"", "", 0},
+        {u"BFEBFBFF000906EA", "BFEBFBFF000906EA", 0},
+        {std::u16string(1, u'\0'), std::string(1, '\0'), 0},
+        {u"\u007F\u0080", "\x7F\xC2\x80", 0},
+        {u"Caf\u00E9", "Caf\xC3\xA9", 0},
+        {u"\u07FF\u0800", "\xDF\xBF\xE0\xA0\x80", 0},
+        {u"\u20AC 100", "\xE2\x82\xAC 100", 0},
+        {u"\uD7FF\uE000\uFFFD\uFFFF", "\xED\x9F\xBF\xEE\x80\x80\xEF\xBF\xBD\xEF\xBF\xBF", 0},
+        {u"\U00010000", "\xF0\x90\x80\x80", 0},
+        {u"disk \U0001F600!", "disk \xF0\x9F\x98\x80!", 0},
+        {u"\U0010FFFF", "\xF4\x8F\xBF\xBF", 0},
+        {std::u16string(1, 0xD800), "\xEF\xBF\xBD", 1},
+        {std::u16string(1, 0xDFFF), "\xEF\xBF\xBD", 1},
+        {std::u16string({0xD83D, u'A'}), "\xEF\xBF\xBD" "A", 1},
+        {std::u16string({0xDE00, 0xD83D}), "\xEF\xBF\xBD\xEF\xBF\xBD", 2},
+        {std::u16string({0xD83D, 0xD83D, 0xDE00}), "\xEF\xBF\xBD\xF0\x9F\x98\x80", 1},
+        {std::u16string({u'x', 0xD83D, 0xDE00, 0xDE00}), "x\xF0\x9F\x98\x80\xEF\xBF\xBD", 1},
+    };
+    for (const TranscodeCase& test : kCases) {
+        std::vector<char> output(test.input.size() * kMaxUtf8BytesPerUtf16Unit + 1);
+        size_t replacements = ~size_t(0);
+        size_t length = TranscodeUtf16ToUtf8(test.input.data(), test.input.size(), output.data(), &replacements);
+        CHECK(std::string(output.data(), length) == test.utf8);
+        CHECK(replacements == test.replacements);
+        CHECK(Utf16ToUtf8(test.input.data(), test.input.size()) == test.utf8);
+        CHECK(Matches(test.input));
+    }
+
+    // One non-ASCII unit or a surrogate pair after ASCII runs of every length
+    const std::u16string kInserts[] = {
+        u"\u00E9", u"\u20AC", u"\U0001F600", std::u16string(1, 0xD800), std::u16string(1, 0xDC00), u"\u0080",
+    };
+    for (size_t prefix = 0; prefix <= 70; prefix++) {
+        std::u16string ascii;
+        for (size_t i = 0; i < prefix; i++) {
+            ascii += static_cast<char16_t>(0x20 + (i * 7) % 0x5F);
+        }
+        CHECK(Matches(ascii));
+        for (const std::u16string& insert : kInserts) {
+            CHECK(Matches(ascii + insert));
+            CHECK(Matches(ascii + insert + ascii));
+            CHECK(Matches(insert + ascii + insert));
+        }
+    }
+
+    // Random mixtures weighted towards ASCII runs and surrogates
+    uint32_t state = 0x85EBCA6B;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+    for (int round = 0; round < 2000; round++) {
+        std::u16string text;
+        size_t length = next() % 200;
+        for (size_t i = 0; i < length; i++) {
+            uint32_t kind = next() % 16;
+            if (kind < 9) {
+                text += static_cast<char16_t>(next() % 0x80);
+            } else if (kind < 11) {
+                text += static_cast<char16_t>(0x80 + next() % 0x780);
+            } else if (kind < 13) {
+                text += static_cast<char16_t>(0x800 + next() % 0xF800);
+            } else if (kind < 15) {
+                text += static_cast<char16_t>(0xD800 + next() % 0x400);
+                text += static_cast<char16_t>(0xDC00 + next() % 0x400);
+            } else {
+                text += static_cast<char16_t>(0xD800 + next() % 0x800);
+            }
+        }
+        CHECK(Matches(text));
+    }
+
+    if (g_failures) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("utf16_transcoder_test: all checks passed\n");
+    return 0;
+}